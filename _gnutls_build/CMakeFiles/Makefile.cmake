@@ -0,0 +1,189 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "lib/gtest/googletest-prefix/tmp/googletest-mkdirs.cmake"
+  "/root/repo/api/CMakeLists.txt"
+  "/root/repo/api/examples/CMakeLists.txt"
+  "/root/repo/api/examples/tutorials/CMakeLists.txt"
+  "/root/repo/api/src/CMakeLists.txt"
+  "/root/repo/api/tests/CMakeLists.txt"
+  "/root/repo/core/CMakeLists.txt"
+  "/root/repo/core/bench/CMakeLists.txt"
+  "/root/repo/core/src/CMakeLists.txt"
+  "/root/repo/core/src/bootstrap/CMakeLists.txt"
+  "/root/repo/core/src/client/CMakeLists.txt"
+  "/root/repo/core/src/common/CMakeLists.txt"
+  "/root/repo/core/src/erbium/CMakeLists.txt"
+  "/root/repo/core/src/server/CMakeLists.txt"
+  "/root/repo/core/tests/CMakeLists.txt"
+  "/root/repo/daemon/CMakeLists.txt"
+  "/root/repo/daemon/src/CMakeLists.txt"
+  "/root/repo/daemon/src/bootstrap/CMakeLists.txt"
+  "/root/repo/daemon/src/client/CMakeLists.txt"
+  "/root/repo/daemon/src/server/CMakeLists.txt"
+  "/root/repo/daemon/tests/CMakeLists.txt"
+  "/root/repo/daemon/tests/server/CMakeLists.txt"
+  "/root/repo/lib/CMakeLists.txt"
+  "/root/repo/lib/b64/CMakeLists.txt"
+  "/root/repo/lib/gtest/CMakeLists.txt"
+  "/root/repo/lib/hmac/CMakeLists.txt"
+  "/root/repo/lib/xml/CMakeLists.txt"
+  "/root/repo/tools/CMakeLists.txt"
+  "/root/repo/tools/tests/gtest/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/ExternalProject.cmake"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/RepositoryInfo.txt.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/cfgcmd.txt.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/gitclone.cmake.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/mkdirs.cmake.in"
+  "/usr/share/cmake-3.25/Modules/FindGit.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/b64/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/hmac/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/xml/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/gtest/googletest-prefix/tmp/googletest-mkdirs.cmake"
+  "lib/gtest/googletest-prefix/tmp/googletest-gitclone.cmake"
+  "lib/gtest/googletest-prefix/src/googletest-stamp/googletest-gitinfo.txt"
+  "lib/gtest/googletest-prefix/tmp/googletest-cfgcmd.txt"
+  "lib/gtest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/src/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/src/bootstrap/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/src/client/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/src/server/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/src/erbium/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "core/bench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "daemon/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "daemon/src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "daemon/src/bootstrap/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "daemon/src/client/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "daemon/src/server/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "daemon/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "daemon/tests/server/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "api/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "api/src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "api/examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "api/examples/tutorials/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "api/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/tests/gtest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  "lib/gtest/CMakeFiles/googletest.dir/DependInfo.cmake"
+  "core/src/common/CMakeFiles/awa_common_static.dir/DependInfo.cmake"
+  "core/src/bootstrap/CMakeFiles/awa_bootstrap_server_object.dir/DependInfo.cmake"
+  "core/src/bootstrap/CMakeFiles/awa_bootstrap_server_static.dir/DependInfo.cmake"
+  "core/src/bootstrap/CMakeFiles/awa_bootstrap_server_shared.dir/DependInfo.cmake"
+  "core/src/client/CMakeFiles/awa_static.dir/DependInfo.cmake"
+  "core/src/client/CMakeFiles/awa_static_shared.dir/DependInfo.cmake"
+  "core/src/server/CMakeFiles/awa_server_object.dir/DependInfo.cmake"
+  "core/src/server/CMakeFiles/awa_server_static.dir/DependInfo.cmake"
+  "core/src/server/CMakeFiles/awa_server_shared.dir/DependInfo.cmake"
+  "core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/DependInfo.cmake"
+  "core/tests/CMakeFiles/test_core_runner.dir/DependInfo.cmake"
+  "core/bench/CMakeFiles/bench_dtls.dir/DependInfo.cmake"
+  "core/bench/CMakeFiles/bench_coap_request.dir/DependInfo.cmake"
+  "core/bench/CMakeFiles/bench_observers.dir/DependInfo.cmake"
+  "daemon/src/bootstrap/CMakeFiles/awa_bootstrapd.dir/DependInfo.cmake"
+  "daemon/src/client/CMakeFiles/awa_clientd.dir/DependInfo.cmake"
+  "daemon/src/server/CMakeFiles/awa_serverd.dir/DependInfo.cmake"
+  "daemon/tests/CMakeFiles/test_daemon_runner.dir/DependInfo.cmake"
+  "daemon/tests/server/CMakeFiles/test_server_runner.dir/DependInfo.cmake"
+  "api/src/CMakeFiles/Awa_object.dir/DependInfo.cmake"
+  "api/src/CMakeFiles/Awa_static.dir/DependInfo.cmake"
+  "api/src/CMakeFiles/Awa_shared.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-get-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-get-contains-path-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-get-array-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-set-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-set-create-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-set-array-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-defineset-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-delete-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-subscribe-to-change-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-subscribe-to-execute-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/client-definition-iterator-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-list-clients-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-read-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-write-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-write-create-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-write-create-unspecified-instance-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-delete-object-instance-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-observe-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-defineset-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-execute-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-execute-arguments-example.dir/DependInfo.cmake"
+  "api/examples/CMakeFiles/server-event-example.dir/DependInfo.cmake"
+  "api/examples/tutorials/CMakeFiles/client-tutorial1.dir/DependInfo.cmake"
+  "api/examples/tutorials/CMakeFiles/client-tutorial2.dir/DependInfo.cmake"
+  "api/examples/tutorials/CMakeFiles/server-tutorial.dir/DependInfo.cmake"
+  "api/examples/tutorials/CMakeFiles/static-client-tutorial1.dir/DependInfo.cmake"
+  "api/examples/tutorials/CMakeFiles/static-client-tutorial2.dir/DependInfo.cmake"
+  "api/examples/tutorials/CMakeFiles/static-client-tutorial3.dir/DependInfo.cmake"
+  "api/tests/CMakeFiles/test_api_runner.dir/DependInfo.cmake"
+  "api/tests/CMakeFiles/test_static_api_runner.dir/DependInfo.cmake"
+  "tools/CMakeFiles/Tools_object.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-define.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-client-define.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-client-explore.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-client-get.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-client-set.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-client-delete.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-client-subscribe.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-explore.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-list-clients.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-read.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-write.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-delete.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-execute.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-write-attributes.dir/DependInfo.cmake"
+  "tools/CMakeFiles/awa-server-observe.dir/DependInfo.cmake"
+  "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/api
+# Build directory: /root/repo/_gnutls_build/api
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("src")
+subdirs("examples")
+subdirs("tests")
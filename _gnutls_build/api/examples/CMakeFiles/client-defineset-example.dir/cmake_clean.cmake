@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-defineset-example.dir/client-defineset-example.c.o"
+  "CMakeFiles/client-defineset-example.dir/client-defineset-example.c.o.d"
+  "client-defineset-example"
+  "client-defineset-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-defineset-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-definition-iterator-example.dir/client-definition-iterator-example.c.o"
+  "CMakeFiles/client-definition-iterator-example.dir/client-definition-iterator-example.c.o.d"
+  "client-definition-iterator-example"
+  "client-definition-iterator-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-definition-iterator-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
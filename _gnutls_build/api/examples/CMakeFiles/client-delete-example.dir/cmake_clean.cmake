@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-delete-example.dir/client-delete-example.c.o"
+  "CMakeFiles/client-delete-example.dir/client-delete-example.c.o.d"
+  "client-delete-example"
+  "client-delete-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-delete-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
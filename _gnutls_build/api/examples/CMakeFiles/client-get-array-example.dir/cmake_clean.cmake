@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-get-array-example.dir/client-get-array-example.c.o"
+  "CMakeFiles/client-get-array-example.dir/client-get-array-example.c.o.d"
+  "client-get-array-example"
+  "client-get-array-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-get-array-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/api/examples/client-get-contains-path-example.c" "api/examples/CMakeFiles/client-get-contains-path-example.dir/client-get-contains-path-example.c.o" "gcc" "api/examples/CMakeFiles/client-get-contains-path-example.dir/client-get-contains-path-example.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/api/src/CMakeFiles/Awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-get-contains-path-example.dir/client-get-contains-path-example.c.o"
+  "CMakeFiles/client-get-contains-path-example.dir/client-get-contains-path-example.c.o.d"
+  "client-get-contains-path-example"
+  "client-get-contains-path-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-get-contains-path-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
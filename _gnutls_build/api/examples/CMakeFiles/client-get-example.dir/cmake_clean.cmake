@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-get-example.dir/client-get-example.c.o"
+  "CMakeFiles/client-get-example.dir/client-get-example.c.o.d"
+  "client-get-example"
+  "client-get-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-get-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-set-array-example.dir/client-set-array-example.c.o"
+  "CMakeFiles/client-set-array-example.dir/client-set-array-example.c.o.d"
+  "client-set-array-example"
+  "client-set-array-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-set-array-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-set-create-example.dir/client-set-create-example.c.o"
+  "CMakeFiles/client-set-create-example.dir/client-set-create-example.c.o.d"
+  "client-set-create-example"
+  "client-set-create-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-set-create-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
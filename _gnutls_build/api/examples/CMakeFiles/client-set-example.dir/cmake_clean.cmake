@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-set-example.dir/client-set-example.c.o"
+  "CMakeFiles/client-set-example.dir/client-set-example.c.o.d"
+  "client-set-example"
+  "client-set-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-set-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
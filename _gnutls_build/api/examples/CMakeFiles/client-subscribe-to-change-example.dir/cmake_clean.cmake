@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-subscribe-to-change-example.dir/client-subscribe-to-change-example.c.o"
+  "CMakeFiles/client-subscribe-to-change-example.dir/client-subscribe-to-change-example.c.o.d"
+  "client-subscribe-to-change-example"
+  "client-subscribe-to-change-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-subscribe-to-change-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
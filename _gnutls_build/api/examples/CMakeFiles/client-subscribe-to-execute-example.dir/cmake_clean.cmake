@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-subscribe-to-execute-example.dir/client-subscribe-to-execute-example.c.o"
+  "CMakeFiles/client-subscribe-to-execute-example.dir/client-subscribe-to-execute-example.c.o.d"
+  "client-subscribe-to-execute-example"
+  "client-subscribe-to-execute-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-subscribe-to-execute-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
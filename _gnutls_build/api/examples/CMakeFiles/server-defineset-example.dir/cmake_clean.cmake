@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-defineset-example.dir/server-defineset-example.c.o"
+  "CMakeFiles/server-defineset-example.dir/server-defineset-example.c.o.d"
+  "server-defineset-example"
+  "server-defineset-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-defineset-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-delete-object-instance-example.dir/server-delete-object-instance-example.c.o"
+  "CMakeFiles/server-delete-object-instance-example.dir/server-delete-object-instance-example.c.o.d"
+  "server-delete-object-instance-example"
+  "server-delete-object-instance-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-delete-object-instance-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-event-example.dir/server-event-example.c.o"
+  "CMakeFiles/server-event-example.dir/server-event-example.c.o.d"
+  "server-event-example"
+  "server-event-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-event-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-execute-arguments-example.dir/server-execute-arguments-example.c.o"
+  "CMakeFiles/server-execute-arguments-example.dir/server-execute-arguments-example.c.o.d"
+  "server-execute-arguments-example"
+  "server-execute-arguments-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-execute-arguments-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
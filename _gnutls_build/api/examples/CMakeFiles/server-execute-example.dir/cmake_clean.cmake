@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-execute-example.dir/server-execute-example.c.o"
+  "CMakeFiles/server-execute-example.dir/server-execute-example.c.o.d"
+  "server-execute-example"
+  "server-execute-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-execute-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
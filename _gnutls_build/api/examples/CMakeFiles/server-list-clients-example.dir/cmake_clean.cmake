@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-list-clients-example.dir/server-list-clients-example.c.o"
+  "CMakeFiles/server-list-clients-example.dir/server-list-clients-example.c.o.d"
+  "server-list-clients-example"
+  "server-list-clients-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-list-clients-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-observe-example.dir/server-observe-example.c.o"
+  "CMakeFiles/server-observe-example.dir/server-observe-example.c.o.d"
+  "server-observe-example"
+  "server-observe-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-observe-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-read-example.dir/server-read-example.c.o"
+  "CMakeFiles/server-read-example.dir/server-read-example.c.o.d"
+  "server-read-example"
+  "server-read-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-read-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-write-create-example.dir/server-write-create-example.c.o"
+  "CMakeFiles/server-write-create-example.dir/server-write-create-example.c.o.d"
+  "server-write-create-example"
+  "server-write-create-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-write-create-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-write-create-unspecified-instance-example.dir/server-write-create-unspecified-instance-example.c.o"
+  "CMakeFiles/server-write-create-unspecified-instance-example.dir/server-write-create-unspecified-instance-example.c.o.d"
+  "server-write-create-unspecified-instance-example"
+  "server-write-create-unspecified-instance-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-write-create-unspecified-instance-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
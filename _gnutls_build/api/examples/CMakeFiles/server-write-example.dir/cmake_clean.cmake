@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-write-example.dir/server-write-example.c.o"
+  "CMakeFiles/server-write-example.dir/server-write-example.c.o.d"
+  "server-write-example"
+  "server-write-example.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-write-example.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
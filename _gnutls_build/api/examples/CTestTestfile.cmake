@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/api/examples
+# Build directory: /root/repo/_gnutls_build/api/examples
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("tutorials")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-tutorial1.dir/client-tutorial1.c.o"
+  "CMakeFiles/client-tutorial1.dir/client-tutorial1.c.o.d"
+  "client-tutorial1"
+  "client-tutorial1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-tutorial1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
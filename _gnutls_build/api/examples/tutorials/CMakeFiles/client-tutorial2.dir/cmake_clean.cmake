@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/client-tutorial2.dir/client-tutorial2.c.o"
+  "CMakeFiles/client-tutorial2.dir/client-tutorial2.c.o.d"
+  "client-tutorial2"
+  "client-tutorial2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/client-tutorial2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
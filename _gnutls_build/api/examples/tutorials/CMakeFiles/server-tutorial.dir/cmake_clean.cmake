@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/server-tutorial.dir/server-tutorial.c.o"
+  "CMakeFiles/server-tutorial.dir/server-tutorial.c.o.d"
+  "server-tutorial"
+  "server-tutorial.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/server-tutorial.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
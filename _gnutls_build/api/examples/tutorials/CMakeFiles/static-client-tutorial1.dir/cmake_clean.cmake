@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/static-client-tutorial1.dir/static-client-tutorial1.c.o"
+  "CMakeFiles/static-client-tutorial1.dir/static-client-tutorial1.c.o.d"
+  "static-client-tutorial1"
+  "static-client-tutorial1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/static-client-tutorial1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
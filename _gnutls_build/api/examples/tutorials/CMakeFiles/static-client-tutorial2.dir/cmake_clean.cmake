@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/static-client-tutorial2.dir/static-client-tutorial2.c.o"
+  "CMakeFiles/static-client-tutorial2.dir/static-client-tutorial2.c.o.d"
+  "static-client-tutorial2"
+  "static-client-tutorial2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/static-client-tutorial2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/static-client-tutorial3.dir/static-client-tutorial3.c.o"
+  "CMakeFiles/static-client-tutorial3.dir/static-client-tutorial3.c.o.d"
+  "static-client-tutorial3"
+  "static-client-tutorial3.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/static-client-tutorial3.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
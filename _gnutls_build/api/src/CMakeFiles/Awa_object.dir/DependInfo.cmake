@@ -0,0 +1,83 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/core/src/common/lwm2m_debug.c" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_debug.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_debug.c.o.d"
+  "/root/repo/core/src/common/lwm2m_definition.c" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_definition.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_definition.c.o.d"
+  "/root/repo/core/src/common/lwm2m_list.c" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_list.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_list.c.o.d"
+  "/root/repo/core/src/common/lwm2m_result.c" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_result.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_result.c.o.d"
+  "/root/repo/core/src/common/lwm2m_tree_node.c" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_tree_node.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_tree_node.c.o.d"
+  "/root/repo/core/src/common/lwm2m_types.c" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_types.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_types.c.o.d"
+  "/root/repo/daemon/src/common/lwm2m_xml_serdes.c" "api/src/CMakeFiles/Awa_object.dir/__/__/daemon/src/common/lwm2m_xml_serdes.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/__/__/daemon/src/common/lwm2m_xml_serdes.c.o.d"
+  "/root/repo/daemon/src/common/xml.c" "api/src/CMakeFiles/Awa_object.dir/__/__/daemon/src/common/xml.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/__/__/daemon/src/common/xml.c.o.d"
+  "/root/repo/api/src/arrays.c" "api/src/CMakeFiles/Awa_object.dir/arrays.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/arrays.c.o.d"
+  "/root/repo/api/src/boolean_array.c" "api/src/CMakeFiles/Awa_object.dir/boolean_array.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/boolean_array.c.o.d"
+  "/root/repo/api/src/changeset.c" "api/src/CMakeFiles/Awa_object.dir/changeset.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/changeset.c.o.d"
+  "/root/repo/api/src/client_define_operation.c" "api/src/CMakeFiles/Awa_object.dir/client_define_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/client_define_operation.c.o.d"
+  "/root/repo/api/src/client_delete_operation.c" "api/src/CMakeFiles/Awa_object.dir/client_delete_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/client_delete_operation.c.o.d"
+  "/root/repo/api/src/client_iterator.c" "api/src/CMakeFiles/Awa_object.dir/client_iterator.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/client_iterator.c.o.d"
+  "/root/repo/api/src/client_notification.c" "api/src/CMakeFiles/Awa_object.dir/client_notification.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/client_notification.c.o.d"
+  "/root/repo/api/src/client_session.c" "api/src/CMakeFiles/Awa_object.dir/client_session.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/client_session.c.o.d"
+  "/root/repo/api/src/client_subscribe.c" "api/src/CMakeFiles/Awa_object.dir/client_subscribe.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/client_subscribe.c.o.d"
+  "/root/repo/api/src/client_subscribe_response.c" "api/src/CMakeFiles/Awa_object.dir/client_subscribe_response.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/client_subscribe_response.c.o.d"
+  "/root/repo/api/src/define_common.c" "api/src/CMakeFiles/Awa_object.dir/define_common.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/define_common.c.o.d"
+  "/root/repo/api/src/define_operation.c" "api/src/CMakeFiles/Awa_object.dir/define_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/define_operation.c.o.d"
+  "/root/repo/api/src/error.c" "api/src/CMakeFiles/Awa_object.dir/error.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/error.c.o.d"
+  "/root/repo/api/src/execute_operation.c" "api/src/CMakeFiles/Awa_object.dir/execute_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/execute_operation.c.o.d"
+  "/root/repo/api/src/float_array.c" "api/src/CMakeFiles/Awa_object.dir/float_array.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/float_array.c.o.d"
+  "/root/repo/api/src/get_operation.c" "api/src/CMakeFiles/Awa_object.dir/get_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/get_operation.c.o.d"
+  "/root/repo/api/src/get_response.c" "api/src/CMakeFiles/Awa_object.dir/get_response.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/get_response.c.o.d"
+  "/root/repo/api/src/integer_array.c" "api/src/CMakeFiles/Awa_object.dir/integer_array.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/integer_array.c.o.d"
+  "/root/repo/api/src/ipc.c" "api/src/CMakeFiles/Awa_object.dir/ipc.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/ipc.c.o.d"
+  "/root/repo/api/src/iterator.c" "api/src/CMakeFiles/Awa_object.dir/iterator.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/iterator.c.o.d"
+  "/root/repo/api/src/list.c" "api/src/CMakeFiles/Awa_object.dir/list.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/list.c.o.d"
+  "/root/repo/api/src/list_clients_operation.c" "api/src/CMakeFiles/Awa_object.dir/list_clients_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/list_clients_operation.c.o.d"
+  "/root/repo/api/src/log.c" "api/src/CMakeFiles/Awa_object.dir/log.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/log.c.o.d"
+  "/root/repo/api/src/lwm2m_error.c" "api/src/CMakeFiles/Awa_object.dir/lwm2m_error.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/lwm2m_error.c.o.d"
+  "/root/repo/api/src/map.c" "api/src/CMakeFiles/Awa_object.dir/map.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/map.c.o.d"
+  "/root/repo/api/src/objectlink_array.c" "api/src/CMakeFiles/Awa_object.dir/objectlink_array.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/objectlink_array.c.o.d"
+  "/root/repo/api/src/objects_tree.c" "api/src/CMakeFiles/Awa_object.dir/objects_tree.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/objects_tree.c.o.d"
+  "/root/repo/api/src/observe_operation.c" "api/src/CMakeFiles/Awa_object.dir/observe_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/observe_operation.c.o.d"
+  "/root/repo/api/src/opaque_array.c" "api/src/CMakeFiles/Awa_object.dir/opaque_array.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/opaque_array.c.o.d"
+  "/root/repo/api/src/operation_common.c" "api/src/CMakeFiles/Awa_object.dir/operation_common.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/operation_common.c.o.d"
+  "/root/repo/api/src/path.c" "api/src/CMakeFiles/Awa_object.dir/path.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/path.c.o.d"
+  "/root/repo/api/src/path_iterator.c" "api/src/CMakeFiles/Awa_object.dir/path_iterator.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/path_iterator.c.o.d"
+  "/root/repo/api/src/path_result.c" "api/src/CMakeFiles/Awa_object.dir/path_result.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/path_result.c.o.d"
+  "/root/repo/api/src/queue.c" "api/src/CMakeFiles/Awa_object.dir/queue.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/queue.c.o.d"
+  "/root/repo/api/src/read_operation.c" "api/src/CMakeFiles/Awa_object.dir/read_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/read_operation.c.o.d"
+  "/root/repo/api/src/registered_entity_iterator.c" "api/src/CMakeFiles/Awa_object.dir/registered_entity_iterator.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/registered_entity_iterator.c.o.d"
+  "/root/repo/api/src/response_common.c" "api/src/CMakeFiles/Awa_object.dir/response_common.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/response_common.c.o.d"
+  "/root/repo/api/src/server_define_operation.c" "api/src/CMakeFiles/Awa_object.dir/server_define_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/server_define_operation.c.o.d"
+  "/root/repo/api/src/server_delete_operation.c" "api/src/CMakeFiles/Awa_object.dir/server_delete_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/server_delete_operation.c.o.d"
+  "/root/repo/api/src/server_events.c" "api/src/CMakeFiles/Awa_object.dir/server_events.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/server_events.c.o.d"
+  "/root/repo/api/src/server_notification.c" "api/src/CMakeFiles/Awa_object.dir/server_notification.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/server_notification.c.o.d"
+  "/root/repo/api/src/server_operation.c" "api/src/CMakeFiles/Awa_object.dir/server_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/server_operation.c.o.d"
+  "/root/repo/api/src/server_response.c" "api/src/CMakeFiles/Awa_object.dir/server_response.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/server_response.c.o.d"
+  "/root/repo/api/src/server_session.c" "api/src/CMakeFiles/Awa_object.dir/server_session.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/server_session.c.o.d"
+  "/root/repo/api/src/session_common.c" "api/src/CMakeFiles/Awa_object.dir/session_common.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/session_common.c.o.d"
+  "/root/repo/api/src/set_operation.c" "api/src/CMakeFiles/Awa_object.dir/set_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/set_operation.c.o.d"
+  "/root/repo/api/src/set_write_common.c" "api/src/CMakeFiles/Awa_object.dir/set_write_common.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/set_write_common.c.o.d"
+  "/root/repo/api/src/string_array.c" "api/src/CMakeFiles/Awa_object.dir/string_array.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/string_array.c.o.d"
+  "/root/repo/api/src/string_iterator.c" "api/src/CMakeFiles/Awa_object.dir/string_iterator.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/string_iterator.c.o.d"
+  "/root/repo/api/src/subscribe_observe_common.c" "api/src/CMakeFiles/Awa_object.dir/subscribe_observe_common.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/subscribe_observe_common.c.o.d"
+  "/root/repo/api/src/time_array.c" "api/src/CMakeFiles/Awa_object.dir/time_array.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/time_array.c.o.d"
+  "/root/repo/api/src/unsupported.c" "api/src/CMakeFiles/Awa_object.dir/unsupported.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/unsupported.c.o.d"
+  "/root/repo/api/src/utils.c" "api/src/CMakeFiles/Awa_object.dir/utils.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/utils.c.o.d"
+  "/root/repo/api/src/value.c" "api/src/CMakeFiles/Awa_object.dir/value.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/value.c.o.d"
+  "/root/repo/api/src/write_attributes_operation.c" "api/src/CMakeFiles/Awa_object.dir/write_attributes_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/write_attributes_operation.c.o.d"
+  "/root/repo/api/src/write_mode.c" "api/src/CMakeFiles/Awa_object.dir/write_mode.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/write_mode.c.o.d"
+  "/root/repo/api/src/write_operation.c" "api/src/CMakeFiles/Awa_object.dir/write_operation.c.o" "gcc" "api/src/CMakeFiles/Awa_object.dir/write_operation.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,137 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_debug.c.o"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_debug.c.o.d"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_definition.c.o"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_definition.c.o.d"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_list.c.o"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_list.c.o.d"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_result.c.o"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_result.c.o.d"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_tree_node.c.o"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_tree_node.c.o.d"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_types.c.o"
+  "CMakeFiles/Awa_object.dir/__/__/core/src/common/lwm2m_types.c.o.d"
+  "CMakeFiles/Awa_object.dir/__/__/daemon/src/common/lwm2m_xml_serdes.c.o"
+  "CMakeFiles/Awa_object.dir/__/__/daemon/src/common/lwm2m_xml_serdes.c.o.d"
+  "CMakeFiles/Awa_object.dir/__/__/daemon/src/common/xml.c.o"
+  "CMakeFiles/Awa_object.dir/__/__/daemon/src/common/xml.c.o.d"
+  "CMakeFiles/Awa_object.dir/arrays.c.o"
+  "CMakeFiles/Awa_object.dir/arrays.c.o.d"
+  "CMakeFiles/Awa_object.dir/boolean_array.c.o"
+  "CMakeFiles/Awa_object.dir/boolean_array.c.o.d"
+  "CMakeFiles/Awa_object.dir/changeset.c.o"
+  "CMakeFiles/Awa_object.dir/changeset.c.o.d"
+  "CMakeFiles/Awa_object.dir/client_define_operation.c.o"
+  "CMakeFiles/Awa_object.dir/client_define_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/client_delete_operation.c.o"
+  "CMakeFiles/Awa_object.dir/client_delete_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/client_iterator.c.o"
+  "CMakeFiles/Awa_object.dir/client_iterator.c.o.d"
+  "CMakeFiles/Awa_object.dir/client_notification.c.o"
+  "CMakeFiles/Awa_object.dir/client_notification.c.o.d"
+  "CMakeFiles/Awa_object.dir/client_session.c.o"
+  "CMakeFiles/Awa_object.dir/client_session.c.o.d"
+  "CMakeFiles/Awa_object.dir/client_subscribe.c.o"
+  "CMakeFiles/Awa_object.dir/client_subscribe.c.o.d"
+  "CMakeFiles/Awa_object.dir/client_subscribe_response.c.o"
+  "CMakeFiles/Awa_object.dir/client_subscribe_response.c.o.d"
+  "CMakeFiles/Awa_object.dir/define_common.c.o"
+  "CMakeFiles/Awa_object.dir/define_common.c.o.d"
+  "CMakeFiles/Awa_object.dir/define_operation.c.o"
+  "CMakeFiles/Awa_object.dir/define_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/error.c.o"
+  "CMakeFiles/Awa_object.dir/error.c.o.d"
+  "CMakeFiles/Awa_object.dir/execute_operation.c.o"
+  "CMakeFiles/Awa_object.dir/execute_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/float_array.c.o"
+  "CMakeFiles/Awa_object.dir/float_array.c.o.d"
+  "CMakeFiles/Awa_object.dir/get_operation.c.o"
+  "CMakeFiles/Awa_object.dir/get_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/get_response.c.o"
+  "CMakeFiles/Awa_object.dir/get_response.c.o.d"
+  "CMakeFiles/Awa_object.dir/integer_array.c.o"
+  "CMakeFiles/Awa_object.dir/integer_array.c.o.d"
+  "CMakeFiles/Awa_object.dir/ipc.c.o"
+  "CMakeFiles/Awa_object.dir/ipc.c.o.d"
+  "CMakeFiles/Awa_object.dir/iterator.c.o"
+  "CMakeFiles/Awa_object.dir/iterator.c.o.d"
+  "CMakeFiles/Awa_object.dir/list.c.o"
+  "CMakeFiles/Awa_object.dir/list.c.o.d"
+  "CMakeFiles/Awa_object.dir/list_clients_operation.c.o"
+  "CMakeFiles/Awa_object.dir/list_clients_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/log.c.o"
+  "CMakeFiles/Awa_object.dir/log.c.o.d"
+  "CMakeFiles/Awa_object.dir/lwm2m_error.c.o"
+  "CMakeFiles/Awa_object.dir/lwm2m_error.c.o.d"
+  "CMakeFiles/Awa_object.dir/map.c.o"
+  "CMakeFiles/Awa_object.dir/map.c.o.d"
+  "CMakeFiles/Awa_object.dir/objectlink_array.c.o"
+  "CMakeFiles/Awa_object.dir/objectlink_array.c.o.d"
+  "CMakeFiles/Awa_object.dir/objects_tree.c.o"
+  "CMakeFiles/Awa_object.dir/objects_tree.c.o.d"
+  "CMakeFiles/Awa_object.dir/observe_operation.c.o"
+  "CMakeFiles/Awa_object.dir/observe_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/opaque_array.c.o"
+  "CMakeFiles/Awa_object.dir/opaque_array.c.o.d"
+  "CMakeFiles/Awa_object.dir/operation_common.c.o"
+  "CMakeFiles/Awa_object.dir/operation_common.c.o.d"
+  "CMakeFiles/Awa_object.dir/path.c.o"
+  "CMakeFiles/Awa_object.dir/path.c.o.d"
+  "CMakeFiles/Awa_object.dir/path_iterator.c.o"
+  "CMakeFiles/Awa_object.dir/path_iterator.c.o.d"
+  "CMakeFiles/Awa_object.dir/path_result.c.o"
+  "CMakeFiles/Awa_object.dir/path_result.c.o.d"
+  "CMakeFiles/Awa_object.dir/queue.c.o"
+  "CMakeFiles/Awa_object.dir/queue.c.o.d"
+  "CMakeFiles/Awa_object.dir/read_operation.c.o"
+  "CMakeFiles/Awa_object.dir/read_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/registered_entity_iterator.c.o"
+  "CMakeFiles/Awa_object.dir/registered_entity_iterator.c.o.d"
+  "CMakeFiles/Awa_object.dir/response_common.c.o"
+  "CMakeFiles/Awa_object.dir/response_common.c.o.d"
+  "CMakeFiles/Awa_object.dir/server_define_operation.c.o"
+  "CMakeFiles/Awa_object.dir/server_define_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/server_delete_operation.c.o"
+  "CMakeFiles/Awa_object.dir/server_delete_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/server_events.c.o"
+  "CMakeFiles/Awa_object.dir/server_events.c.o.d"
+  "CMakeFiles/Awa_object.dir/server_notification.c.o"
+  "CMakeFiles/Awa_object.dir/server_notification.c.o.d"
+  "CMakeFiles/Awa_object.dir/server_operation.c.o"
+  "CMakeFiles/Awa_object.dir/server_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/server_response.c.o"
+  "CMakeFiles/Awa_object.dir/server_response.c.o.d"
+  "CMakeFiles/Awa_object.dir/server_session.c.o"
+  "CMakeFiles/Awa_object.dir/server_session.c.o.d"
+  "CMakeFiles/Awa_object.dir/session_common.c.o"
+  "CMakeFiles/Awa_object.dir/session_common.c.o.d"
+  "CMakeFiles/Awa_object.dir/set_operation.c.o"
+  "CMakeFiles/Awa_object.dir/set_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/set_write_common.c.o"
+  "CMakeFiles/Awa_object.dir/set_write_common.c.o.d"
+  "CMakeFiles/Awa_object.dir/string_array.c.o"
+  "CMakeFiles/Awa_object.dir/string_array.c.o.d"
+  "CMakeFiles/Awa_object.dir/string_iterator.c.o"
+  "CMakeFiles/Awa_object.dir/string_iterator.c.o.d"
+  "CMakeFiles/Awa_object.dir/subscribe_observe_common.c.o"
+  "CMakeFiles/Awa_object.dir/subscribe_observe_common.c.o.d"
+  "CMakeFiles/Awa_object.dir/time_array.c.o"
+  "CMakeFiles/Awa_object.dir/time_array.c.o.d"
+  "CMakeFiles/Awa_object.dir/unsupported.c.o"
+  "CMakeFiles/Awa_object.dir/unsupported.c.o.d"
+  "CMakeFiles/Awa_object.dir/utils.c.o"
+  "CMakeFiles/Awa_object.dir/utils.c.o.d"
+  "CMakeFiles/Awa_object.dir/value.c.o"
+  "CMakeFiles/Awa_object.dir/value.c.o.d"
+  "CMakeFiles/Awa_object.dir/write_attributes_operation.c.o"
+  "CMakeFiles/Awa_object.dir/write_attributes_operation.c.o.d"
+  "CMakeFiles/Awa_object.dir/write_mode.c.o"
+  "CMakeFiles/Awa_object.dir/write_mode.c.o.d"
+  "CMakeFiles/Awa_object.dir/write_operation.c.o"
+  "CMakeFiles/Awa_object.dir/write_operation.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/Awa_object.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
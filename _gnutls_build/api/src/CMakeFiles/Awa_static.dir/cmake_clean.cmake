@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libawa.a"
+  "libawa.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/Awa_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
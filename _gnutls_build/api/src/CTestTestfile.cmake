@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/api/src
+# Build directory: /root/repo/_gnutls_build/api/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
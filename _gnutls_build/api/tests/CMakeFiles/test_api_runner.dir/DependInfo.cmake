@@ -0,0 +1,85 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/api/tests/support/main/main_cmdline.c" "api/tests/CMakeFiles/test_api_runner.dir/support/main/main_cmdline.c.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/support/main/main_cmdline.c.o.d"
+  "/root/repo/api/tests/client/test_client.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client.cc.o.d"
+  "/root/repo/api/tests/client/test_client_define_defaults.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_define_defaults.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_define_defaults.cc.o.d"
+  "/root/repo/api/tests/client/test_client_define_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_define_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_define_operation.cc.o.d"
+  "/root/repo/api/tests/client/test_client_delete_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_delete_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_delete_operation.cc.o.d"
+  "/root/repo/api/tests/client/test_client_iterator.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_iterator.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_iterator.cc.o.d"
+  "/root/repo/api/tests/client/test_client_objdefs_from_file.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_objdefs_from_file.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_objdefs_from_file.cc.o.d"
+  "/root/repo/api/tests/client/test_client_session.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_session.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_client_session.cc.o.d"
+  "/root/repo/api/tests/client/test_get_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_get_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_get_operation.cc.o.d"
+  "/root/repo/api/tests/client/test_set_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_set_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_set_operation.cc.o.d"
+  "/root/repo/api/tests/client/test_subscribe_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_subscribe_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/client/test_subscribe_operation.cc.o.d"
+  "/root/repo/api/tests/common/test_array_types.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_array_types.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_array_types.cc.o.d"
+  "/root/repo/api/tests/common/test_bootstrap.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_bootstrap.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_bootstrap.cc.o.d"
+  "/root/repo/api/tests/common/test_client_server_interaction.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_client_server_interaction.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_client_server_interaction.cc.o.d"
+  "/root/repo/api/tests/common/test_daemon.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_daemon.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_daemon.cc.o.d"
+  "/root/repo/api/tests/common/test_define_common.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_define_common.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_define_common.cc.o.d"
+  "/root/repo/api/tests/common/test_define_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_define_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_define_operation.cc.o.d"
+  "/root/repo/api/tests/common/test_error.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_error.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_error.cc.o.d"
+  "/root/repo/api/tests/common/test_ipc.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_ipc.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_ipc.cc.o.d"
+  "/root/repo/api/tests/common/test_iterator.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_iterator.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_iterator.cc.o.d"
+  "/root/repo/api/tests/common/test_list.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_list.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_list.cc.o.d"
+  "/root/repo/api/tests/common/test_log.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_log.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_log.cc.o.d"
+  "/root/repo/api/tests/common/test_lwm2m_error.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_lwm2m_error.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_lwm2m_error.cc.o.d"
+  "/root/repo/api/tests/common/test_map.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_map.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_map.cc.o.d"
+  "/root/repo/api/tests/common/test_objects_tree.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_objects_tree.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_objects_tree.cc.o.d"
+  "/root/repo/api/tests/common/test_operation_common.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_operation_common.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_operation_common.cc.o.d"
+  "/root/repo/api/tests/common/test_path.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_path.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_path.cc.o.d"
+  "/root/repo/api/tests/common/test_path_iterator.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_path_iterator.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_path_iterator.cc.o.d"
+  "/root/repo/api/tests/common/test_path_result.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_path_result.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_path_result.cc.o.d"
+  "/root/repo/api/tests/common/test_queue.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_queue.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_queue.cc.o.d"
+  "/root/repo/api/tests/common/test_response_common.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_response_common.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_response_common.cc.o.d"
+  "/root/repo/api/tests/common/test_session_common.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_session_common.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_session_common.cc.o.d"
+  "/root/repo/api/tests/common/test_string_iterator.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_string_iterator.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_string_iterator.cc.o.d"
+  "/root/repo/api/tests/common/test_subscribe_observe_common.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_subscribe_observe_common.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_subscribe_observe_common.cc.o.d"
+  "/root/repo/api/tests/common/test_utils.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_utils.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_utils.cc.o.d"
+  "/root/repo/api/tests/common/test_value.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_value.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_value.cc.o.d"
+  "/root/repo/api/tests/common/test_xmltree.cc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_xmltree.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/common/test_xmltree.cc.o.d"
+  "/root/repo/api/tests/server/test_changeset.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_changeset.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_changeset.cc.o.d"
+  "/root/repo/api/tests/server/test_execute_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_execute_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_execute_operation.cc.o.d"
+  "/root/repo/api/tests/server/test_list_clients_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_list_clients_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_list_clients_operation.cc.o.d"
+  "/root/repo/api/tests/server/test_observe_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_observe_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_observe_operation.cc.o.d"
+  "/root/repo/api/tests/server/test_read_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_read_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_read_operation.cc.o.d"
+  "/root/repo/api/tests/server/test_server.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server.cc.o.d"
+  "/root/repo/api/tests/server/test_server_define_defaults.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_define_defaults.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_define_defaults.cc.o.d"
+  "/root/repo/api/tests/server/test_server_define_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_define_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_define_operation.cc.o.d"
+  "/root/repo/api/tests/server/test_server_delete_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_delete_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_delete_operation.cc.o.d"
+  "/root/repo/api/tests/server/test_server_events.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_events.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_events.cc.o.d"
+  "/root/repo/api/tests/server/test_server_notification.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_notification.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_notification.cc.o.d"
+  "/root/repo/api/tests/server/test_server_objdefs_from_file.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_objdefs_from_file.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_objdefs_from_file.cc.o.d"
+  "/root/repo/api/tests/server/test_server_response.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_response.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_response.cc.o.d"
+  "/root/repo/api/tests/server/test_server_session.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_session.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_server_session.cc.o.d"
+  "/root/repo/api/tests/server/test_set_write_common.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_set_write_common.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_set_write_common.cc.o.d"
+  "/root/repo/api/tests/server/test_write_attributes_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_write_attributes_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_write_attributes_operation.cc.o.d"
+  "/root/repo/api/tests/server/test_write_operation.cc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_write_operation.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/server/test_write_operation.cc.o.d"
+  "/root/repo/api/tests/support/daemon.cc" "api/tests/CMakeFiles/test_api_runner.dir/support/daemon.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/support/daemon.cc.o.d"
+  "/root/repo/api/tests/support/log.cc" "api/tests/CMakeFiles/test_api_runner.dir/support/log.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/support/log.cc.o.d"
+  "/root/repo/api/tests/support/main/main.cc" "api/tests/CMakeFiles/test_api_runner.dir/support/main/main.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/support/main/main.cc.o.d"
+  "/root/repo/api/tests/support/process.cc" "api/tests/CMakeFiles/test_api_runner.dir/support/process.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/support/process.cc.o.d"
+  "/root/repo/api/tests/support/static_api_support.cc" "api/tests/CMakeFiles/test_api_runner.dir/support/static_api_support.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/support/static_api_support.cc.o.d"
+  "/root/repo/api/tests/support/support.cc" "api/tests/CMakeFiles/test_api_runner.dir/support/support.cc.o" "gcc" "api/tests/CMakeFiles/test_api_runner.dir/support/support.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/core/src/client/CMakeFiles/awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/common/CMakeFiles/awa_common_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/api/src/CMakeFiles/Awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,129 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_api_runner.dir/client/test_client.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_client.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_client_define_defaults.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_client_define_defaults.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_client_define_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_client_define_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_client_delete_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_client_delete_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_client_iterator.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_client_iterator.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_client_objdefs_from_file.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_client_objdefs_from_file.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_client_session.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_client_session.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_get_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_get_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_set_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_set_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/client/test_subscribe_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/client/test_subscribe_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_array_types.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_array_types.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_bootstrap.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_bootstrap.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_client_server_interaction.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_client_server_interaction.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_daemon.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_daemon.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_define_common.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_define_common.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_define_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_define_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_error.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_error.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_ipc.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_ipc.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_iterator.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_iterator.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_list.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_list.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_log.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_log.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_lwm2m_error.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_lwm2m_error.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_map.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_map.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_objects_tree.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_objects_tree.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_operation_common.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_operation_common.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_path.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_path.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_path_iterator.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_path_iterator.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_path_result.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_path_result.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_queue.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_queue.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_response_common.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_response_common.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_session_common.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_session_common.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_string_iterator.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_string_iterator.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_subscribe_observe_common.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_subscribe_observe_common.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_utils.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_utils.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_value.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_value.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/common/test_xmltree.cc.o"
+  "CMakeFiles/test_api_runner.dir/common/test_xmltree.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_changeset.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_changeset.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_execute_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_execute_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_list_clients_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_list_clients_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_observe_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_observe_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_read_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_read_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server_define_defaults.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server_define_defaults.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server_define_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server_define_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server_delete_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server_delete_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server_events.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server_events.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server_notification.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server_notification.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server_objdefs_from_file.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server_objdefs_from_file.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server_response.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server_response.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_server_session.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_server_session.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_set_write_common.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_set_write_common.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_write_attributes_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_write_attributes_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/server/test_write_operation.cc.o"
+  "CMakeFiles/test_api_runner.dir/server/test_write_operation.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/support/daemon.cc.o"
+  "CMakeFiles/test_api_runner.dir/support/daemon.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/support/log.cc.o"
+  "CMakeFiles/test_api_runner.dir/support/log.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/support/main/main.cc.o"
+  "CMakeFiles/test_api_runner.dir/support/main/main.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/support/main/main_cmdline.c.o"
+  "CMakeFiles/test_api_runner.dir/support/main/main_cmdline.c.o.d"
+  "CMakeFiles/test_api_runner.dir/support/process.cc.o"
+  "CMakeFiles/test_api_runner.dir/support/process.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/support/static_api_support.cc.o"
+  "CMakeFiles/test_api_runner.dir/support/static_api_support.cc.o.d"
+  "CMakeFiles/test_api_runner.dir/support/support.cc.o"
+  "CMakeFiles/test_api_runner.dir/support/support.cc.o.d"
+  "test_api_runner"
+  "test_api_runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/test_api_runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,37 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/api/tests/support/main/main_cmdline.c" "api/tests/CMakeFiles/test_static_api_runner.dir/support/main/main_cmdline.c.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/main/main_cmdline.c.o.d"
+  "/root/repo/api/tests/static-client/test_static_api.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api.cc.o.d"
+  "/root/repo/api/tests/static-client/test_static_api_create_delete.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_create_delete.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_create_delete.cc.o.d"
+  "/root/repo/api/tests/static-client/test_static_api_get_resource_instance_pointer.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_get_resource_instance_pointer.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_get_resource_instance_pointer.cc.o.d"
+  "/root/repo/api/tests/static-client/test_static_api_handlers.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_handlers.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_handlers.cc.o.d"
+  "/root/repo/api/tests/static-client/test_static_api_with_pointer.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_with_pointer.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_with_pointer.cc.o.d"
+  "/root/repo/api/tests/support/daemon.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/daemon.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/daemon.cc.o.d"
+  "/root/repo/api/tests/support/log.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/log.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/log.cc.o.d"
+  "/root/repo/api/tests/support/main/main.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/main/main.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/main/main.cc.o.d"
+  "/root/repo/api/tests/support/process.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/process.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/process.cc.o.d"
+  "/root/repo/api/tests/support/static_api_support.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/static_api_support.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/static_api_support.cc.o.d"
+  "/root/repo/api/tests/support/support.cc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/support.cc.o" "gcc" "api/tests/CMakeFiles/test_static_api_runner.dir/support/support.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/core/src/client/CMakeFiles/awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/common/CMakeFiles/awa_common_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/api/src/CMakeFiles/Awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
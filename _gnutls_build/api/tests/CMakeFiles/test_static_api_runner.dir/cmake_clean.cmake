@@ -0,0 +1,33 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_create_delete.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_create_delete.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_get_resource_instance_pointer.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_get_resource_instance_pointer.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_handlers.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_handlers.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_with_pointer.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/static-client/test_static_api_with_pointer.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/support/daemon.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/support/daemon.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/support/log.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/support/log.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/support/main/main.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/support/main/main.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/support/main/main_cmdline.c.o"
+  "CMakeFiles/test_static_api_runner.dir/support/main/main_cmdline.c.o.d"
+  "CMakeFiles/test_static_api_runner.dir/support/process.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/support/process.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/support/static_api_support.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/support/static_api_support.cc.o.d"
+  "CMakeFiles/test_static_api_runner.dir/support/support.cc.o"
+  "CMakeFiles/test_static_api_runner.dir/support/support.cc.o.d"
+  "test_static_api_runner"
+  "test_static_api_runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/test_static_api_runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_coap_request.dir/bench_coap_request.c.o"
+  "CMakeFiles/bench_coap_request.dir/bench_coap_request.c.o.d"
+  "bench_coap_request"
+  "bench_coap_request.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_coap_request.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
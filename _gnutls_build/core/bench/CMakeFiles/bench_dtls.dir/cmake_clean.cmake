@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_dtls.dir/bench_dtls.c.o"
+  "CMakeFiles/bench_dtls.dir/bench_dtls.c.o.d"
+  "bench_dtls"
+  "bench_dtls.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_dtls.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/core/src
+# Build directory: /root/repo/_gnutls_build/core/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("common")
+subdirs("bootstrap")
+subdirs("client")
+subdirs("server")
+subdirs("erbium")
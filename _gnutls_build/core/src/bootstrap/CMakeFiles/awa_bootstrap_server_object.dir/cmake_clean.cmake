@@ -0,0 +1,27 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_bootstrap_config.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_bootstrap_config.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_opaque.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_opaque.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_plaintext.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_plaintext.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_prettyprint.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_prettyprint.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_serdes.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_serdes.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_tlv.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_tlv.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_tree_builder.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/common/lwm2m_tree_builder.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/server/lwm2m_object_defs.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/__/server/lwm2m_object_defs.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/lwm2m_bootstrap.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/lwm2m_bootstrap.c.o.d"
+  "CMakeFiles/awa_bootstrap_server_object.dir/lwm2m_bootstrap_core.c.o"
+  "CMakeFiles/awa_bootstrap_server_object.dir/lwm2m_bootstrap_core.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_bootstrap_server_object.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
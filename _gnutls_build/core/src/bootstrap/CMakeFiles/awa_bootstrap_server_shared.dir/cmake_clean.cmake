@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "liblwm2mbootstrapserver.pdb"
+  "liblwm2mbootstrapserver.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_bootstrap_server_shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
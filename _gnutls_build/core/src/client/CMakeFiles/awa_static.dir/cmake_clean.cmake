@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_bootstrap_config.c.o"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_bootstrap_config.c.o.d"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_observers.c.o"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_observers.c.o.d"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_opaque.c.o"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_opaque.c.o.d"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_plaintext.c.o"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_plaintext.c.o.d"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_prettyprint.c.o"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_prettyprint.c.o.d"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_serdes.c.o"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_serdes.c.o.d"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_tlv.c.o"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_tlv.c.o.d"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_tree_builder.c.o"
+  "CMakeFiles/awa_static.dir/__/common/lwm2m_tree_builder.c.o.d"
+  "CMakeFiles/awa_static.dir/lwm2m_acl_object.c.o"
+  "CMakeFiles/awa_static.dir/lwm2m_acl_object.c.o.d"
+  "CMakeFiles/awa_static.dir/lwm2m_bootstrap.c.o"
+  "CMakeFiles/awa_static.dir/lwm2m_bootstrap.c.o.d"
+  "CMakeFiles/awa_static.dir/lwm2m_client_core.c.o"
+  "CMakeFiles/awa_static.dir/lwm2m_client_core.c.o.d"
+  "CMakeFiles/awa_static.dir/lwm2m_object_tree.c.o"
+  "CMakeFiles/awa_static.dir/lwm2m_object_tree.c.o.d"
+  "CMakeFiles/awa_static.dir/lwm2m_registration.c.o"
+  "CMakeFiles/awa_static.dir/lwm2m_registration.c.o.d"
+  "CMakeFiles/awa_static.dir/lwm2m_security_object.c.o"
+  "CMakeFiles/awa_static.dir/lwm2m_security_object.c.o.d"
+  "CMakeFiles/awa_static.dir/lwm2m_server_object.c.o"
+  "CMakeFiles/awa_static.dir/lwm2m_server_object.c.o.d"
+  "CMakeFiles/awa_static.dir/lwm2m_static.c.o"
+  "CMakeFiles/awa_static.dir/lwm2m_static.c.o.d"
+  "libawa_static.a"
+  "libawa_static.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
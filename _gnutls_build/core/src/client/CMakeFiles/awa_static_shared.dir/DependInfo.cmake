@@ -0,0 +1,38 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/core/src/common/lwm2m_bootstrap_config.c" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_bootstrap_config.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_bootstrap_config.c.o.d"
+  "/root/repo/core/src/common/lwm2m_observers.c" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_observers.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_observers.c.o.d"
+  "/root/repo/core/src/common/lwm2m_opaque.c" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_opaque.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_opaque.c.o.d"
+  "/root/repo/core/src/common/lwm2m_plaintext.c" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_plaintext.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_plaintext.c.o.d"
+  "/root/repo/core/src/common/lwm2m_prettyprint.c" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_prettyprint.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_prettyprint.c.o.d"
+  "/root/repo/core/src/common/lwm2m_serdes.c" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_serdes.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_serdes.c.o.d"
+  "/root/repo/core/src/common/lwm2m_tlv.c" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_tlv.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_tlv.c.o.d"
+  "/root/repo/core/src/common/lwm2m_tree_builder.c" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_tree_builder.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/__/common/lwm2m_tree_builder.c.o.d"
+  "/root/repo/core/src/client/lwm2m_acl_object.c" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_acl_object.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_acl_object.c.o.d"
+  "/root/repo/core/src/client/lwm2m_bootstrap.c" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_bootstrap.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_bootstrap.c.o.d"
+  "/root/repo/core/src/client/lwm2m_client_core.c" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_client_core.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_client_core.c.o.d"
+  "/root/repo/core/src/client/lwm2m_object_tree.c" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_object_tree.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_object_tree.c.o.d"
+  "/root/repo/core/src/client/lwm2m_registration.c" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_registration.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_registration.c.o.d"
+  "/root/repo/core/src/client/lwm2m_security_object.c" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_security_object.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_security_object.c.o.d"
+  "/root/repo/core/src/client/lwm2m_server_object.c" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_server_object.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_server_object.c.o.d"
+  "/root/repo/core/src/client/lwm2m_static.c" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_static.c.o" "gcc" "core/src/client/CMakeFiles/awa_static_shared.dir/lwm2m_static.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/core/src/common/CMakeFiles/awa_common_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/core/src/client
+# Build directory: /root/repo/_gnutls_build/core/src/client
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,43 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/core/src/common/coap_abstraction_erbium.c" "core/src/common/CMakeFiles/awa_common_static.dir/coap_abstraction_erbium.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/coap_abstraction_erbium.c.o.d"
+  "/root/repo/core/src/common/coap_exchange_index.c" "core/src/common/CMakeFiles/awa_common_static.dir/coap_exchange_index.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/coap_exchange_index.c.o.d"
+  "/root/repo/core/src/common/dtls_abstraction_gnutls.c" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_abstraction_gnutls.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_abstraction_gnutls.c.o.d"
+  "/root/repo/core/src/common/dtls_cookie.c" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_cookie.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_cookie.c.o.d"
+  "/root/repo/core/src/common/dtls_handshake_pool.c" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_handshake_pool.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_handshake_pool.c.o.d"
+  "/root/repo/core/src/common/dtls_keystore.c" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_keystore.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_keystore.c.o.d"
+  "/root/repo/core/src/common/dtls_resumption_cache.c" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_resumption_cache.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_resumption_cache.c.o.d"
+  "/root/repo/core/src/common/dtls_session_table.c" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_session_table.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/dtls_session_table.c.o.d"
+  "/root/repo/core/src/common/lwm2m_attributes.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_attributes.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_attributes.c.o.d"
+  "/root/repo/core/src/common/lwm2m_deadline_queue.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_deadline_queue.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_deadline_queue.c.o.d"
+  "/root/repo/core/src/common/lwm2m_debug.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_debug.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_debug.c.o.d"
+  "/root/repo/core/src/common/lwm2m_definition.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_definition.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_definition.c.o.d"
+  "/root/repo/core/src/common/lwm2m_endpoints.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_endpoints.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_endpoints.c.o.d"
+  "/root/repo/core/src/common/lwm2m_hash_table.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_hash_table.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_hash_table.c.o.d"
+  "/root/repo/core/src/common/lwm2m_list.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_list.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_list.c.o.d"
+  "/root/repo/core/src/common/lwm2m_object_store.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_object_store.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_object_store.c.o.d"
+  "/root/repo/core/src/common/lwm2m_result.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_result.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_result.c.o.d"
+  "/root/repo/core/src/common/lwm2m_tree_node.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_tree_node.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_tree_node.c.o.d"
+  "/root/repo/core/src/common/lwm2m_types.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_types.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_types.c.o.d"
+  "/root/repo/core/src/common/lwm2m_util.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_util.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_util.c.o.d"
+  "/root/repo/core/src/common/lwm2m_util_linux.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_util_linux.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_util_linux.c.o.d"
+  "/root/repo/core/src/common/lwm2m_util_posix.c" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_util_posix.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/lwm2m_util_posix.c.o.d"
+  "/root/repo/core/src/common/network_abstraction_posix.c" "core/src/common/CMakeFiles/awa_common_static.dir/network_abstraction_posix.c.o" "gcc" "core/src/common/CMakeFiles/awa_common_static.dir/network_abstraction_posix.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa_common_static.dir/coap_abstraction_erbium.c.o"
+  "CMakeFiles/awa_common_static.dir/coap_abstraction_erbium.c.o.d"
+  "CMakeFiles/awa_common_static.dir/coap_exchange_index.c.o"
+  "CMakeFiles/awa_common_static.dir/coap_exchange_index.c.o.d"
+  "CMakeFiles/awa_common_static.dir/dtls_abstraction_gnutls.c.o"
+  "CMakeFiles/awa_common_static.dir/dtls_abstraction_gnutls.c.o.d"
+  "CMakeFiles/awa_common_static.dir/dtls_cookie.c.o"
+  "CMakeFiles/awa_common_static.dir/dtls_cookie.c.o.d"
+  "CMakeFiles/awa_common_static.dir/dtls_handshake_pool.c.o"
+  "CMakeFiles/awa_common_static.dir/dtls_handshake_pool.c.o.d"
+  "CMakeFiles/awa_common_static.dir/dtls_keystore.c.o"
+  "CMakeFiles/awa_common_static.dir/dtls_keystore.c.o.d"
+  "CMakeFiles/awa_common_static.dir/dtls_resumption_cache.c.o"
+  "CMakeFiles/awa_common_static.dir/dtls_resumption_cache.c.o.d"
+  "CMakeFiles/awa_common_static.dir/dtls_session_table.c.o"
+  "CMakeFiles/awa_common_static.dir/dtls_session_table.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_attributes.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_attributes.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_deadline_queue.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_deadline_queue.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_debug.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_debug.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_definition.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_definition.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_endpoints.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_endpoints.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_hash_table.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_hash_table.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_list.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_list.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_object_store.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_object_store.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_result.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_result.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_tree_node.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_tree_node.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_types.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_types.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_util.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_util.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_util_linux.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_util_linux.c.o.d"
+  "CMakeFiles/awa_common_static.dir/lwm2m_util_posix.c.o"
+  "CMakeFiles/awa_common_static.dir/lwm2m_util_posix.c.o.d"
+  "CMakeFiles/awa_common_static.dir/network_abstraction_posix.c.o"
+  "CMakeFiles/awa_common_static.dir/network_abstraction_posix.c.o.d"
+  "liblwm2mcommon.a"
+  "liblwm2mcommon.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_common_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap-block1.c.o"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap-block1.c.o.d"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap-engine.c.o"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap-engine.c.o.d"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap-separate.c.o"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap-separate.c.o.d"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap-transactions.c.o"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap-transactions.c.o.d"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap.c.o"
+  "CMakeFiles/awa_erbiumstatic.dir/er-coap.c.o.d"
+  "liberbiumstatic.a"
+  "liberbiumstatic.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_erbiumstatic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/core/src/erbium/er-coap-block1.c" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap-block1.c.o" "gcc" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap-block1.c.o.d"
+  "/root/repo/core/src/erbium/er-coap-engine.c" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap-engine.c.o" "gcc" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap-engine.c.o.d"
+  "/root/repo/core/src/erbium/er-coap-separate.c" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap-separate.c.o" "gcc" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap-separate.c.o.d"
+  "/root/repo/core/src/erbium/er-coap-transactions.c" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap-transactions.c.o" "gcc" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap-transactions.c.o.d"
+  "/root/repo/core/src/erbium/er-coap.c" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap.c.o" "gcc" "core/src/erbium/CMakeFiles/awa_erbiumstatic_shared.dir/er-coap.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
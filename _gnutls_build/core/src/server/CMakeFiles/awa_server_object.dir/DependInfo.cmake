@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/core/src/common/lwm2m_opaque.c" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_opaque.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_opaque.c.o.d"
+  "/root/repo/core/src/common/lwm2m_plaintext.c" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_plaintext.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_plaintext.c.o.d"
+  "/root/repo/core/src/common/lwm2m_prettyprint.c" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_prettyprint.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_prettyprint.c.o.d"
+  "/root/repo/core/src/common/lwm2m_serdes.c" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_serdes.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_serdes.c.o.d"
+  "/root/repo/core/src/common/lwm2m_tlv.c" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_tlv.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_tlv.c.o.d"
+  "/root/repo/core/src/common/lwm2m_tree_builder.c" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_tree_builder.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/__/common/lwm2m_tree_builder.c.o.d"
+  "/root/repo/core/src/server/lwm2m_object_defs.c" "core/src/server/CMakeFiles/awa_server_object.dir/lwm2m_object_defs.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/lwm2m_object_defs.c.o.d"
+  "/root/repo/core/src/server/lwm2m_registration.c" "core/src/server/CMakeFiles/awa_server_object.dir/lwm2m_registration.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/lwm2m_registration.c.o.d"
+  "/root/repo/core/src/server/lwm2m_server_core.c" "core/src/server/CMakeFiles/awa_server_object.dir/lwm2m_server_core.c.o" "gcc" "core/src/server/CMakeFiles/awa_server_object.dir/lwm2m_server_core.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "liblwm2mserver.a"
+  "liblwm2mserver.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_server_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,46 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/core/tests/lwm2m_device_object.c" "core/tests/CMakeFiles/test_core_runner.dir/lwm2m_device_object.c.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/lwm2m_device_object.c.o.d"
+  "/root/repo/core/tests/main.cc" "core/tests/CMakeFiles/test_core_runner.dir/main.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/main.cc.o.d"
+  "/root/repo/core/tests/test_coap_exchange_index.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_coap_exchange_index.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_coap_exchange_index.cc.o.d"
+  "/root/repo/core/tests/test_deadline_queue.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_deadline_queue.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_deadline_queue.cc.o.d"
+  "/root/repo/core/tests/test_definition_registry.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_definition_registry.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_definition_registry.cc.o.d"
+  "/root/repo/core/tests/test_dtls_cookie.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_cookie.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_cookie.cc.o.d"
+  "/root/repo/core/tests/test_dtls_handshake_pool.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_handshake_pool.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_handshake_pool.cc.o.d"
+  "/root/repo/core/tests/test_dtls_keystore.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_keystore.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_keystore.cc.o.d"
+  "/root/repo/core/tests/test_dtls_resumption_cache.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_resumption_cache.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_resumption_cache.cc.o.d"
+  "/root/repo/core/tests/test_dtls_session_table.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_session_table.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_dtls_session_table.cc.o.d"
+  "/root/repo/core/tests/test_hash_table.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_hash_table.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_hash_table.cc.o.d"
+  "/root/repo/core/tests/test_lwm2m_core.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_core.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_core.cc.o.d"
+  "/root/repo/core/tests/test_lwm2m_observers.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_observers.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_observers.cc.o.d"
+  "/root/repo/core/tests/test_lwm2m_tree.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_tree.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_tree.cc.o.d"
+  "/root/repo/core/tests/test_lwm2m_tree_builder.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_tree_builder.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_tree_builder.cc.o.d"
+  "/root/repo/core/tests/test_lwm2m_types.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_types.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_lwm2m_types.cc.o.d"
+  "/root/repo/core/tests/test_network_abstraction.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_network_abstraction.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_network_abstraction.cc.o.d"
+  "/root/repo/core/tests/test_object_store_interface.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_object_store_interface.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_object_store_interface.cc.o.d"
+  "/root/repo/core/tests/test_object_tree.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_object_tree.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_object_tree.cc.o.d"
+  "/root/repo/core/tests/test_plaintext.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_plaintext.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_plaintext.cc.o.d"
+  "/root/repo/core/tests/test_prettyprint.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_prettyprint.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_prettyprint.cc.o.d"
+  "/root/repo/core/tests/test_template.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_template.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_template.cc.o.d"
+  "/root/repo/core/tests/test_tlv.cc" "core/tests/CMakeFiles/test_core_runner.dir/test_tlv.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/test_tlv.cc.o.d"
+  "/root/repo/core/tests/unit_support.cc" "core/tests/CMakeFiles/test_core_runner.dir/unit_support.cc.o" "gcc" "core/tests/CMakeFiles/test_core_runner.dir/unit_support.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/core/src/client/CMakeFiles/awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/common/CMakeFiles/awa_common_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,57 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_core_runner.dir/lwm2m_device_object.c.o"
+  "CMakeFiles/test_core_runner.dir/lwm2m_device_object.c.o.d"
+  "CMakeFiles/test_core_runner.dir/main.cc.o"
+  "CMakeFiles/test_core_runner.dir/main.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_coap_exchange_index.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_coap_exchange_index.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_deadline_queue.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_deadline_queue.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_definition_registry.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_definition_registry.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_dtls_cookie.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_dtls_cookie.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_dtls_handshake_pool.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_dtls_handshake_pool.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_dtls_keystore.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_dtls_keystore.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_dtls_resumption_cache.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_dtls_resumption_cache.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_dtls_session_table.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_dtls_session_table.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_hash_table.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_hash_table.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_core.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_core.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_observers.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_observers.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_tree.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_tree.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_tree_builder.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_tree_builder.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_types.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_lwm2m_types.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_network_abstraction.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_network_abstraction.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_object_store_interface.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_object_store_interface.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_object_tree.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_object_tree.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_plaintext.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_plaintext.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_prettyprint.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_prettyprint.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_template.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_template.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/test_tlv.cc.o"
+  "CMakeFiles/test_core_runner.dir/test_tlv.cc.o.d"
+  "CMakeFiles/test_core_runner.dir/unit_support.cc.o"
+  "CMakeFiles/test_core_runner.dir/unit_support.cc.o.d"
+  "test_core_runner"
+  "test_core_runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/test_core_runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
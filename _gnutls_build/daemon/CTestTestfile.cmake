@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/daemon
+# Build directory: /root/repo/_gnutls_build/daemon
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("src")
+subdirs("tests")
+subdirs("tests/server")
@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/daemon/src
+# Build directory: /root/repo/_gnutls_build/daemon/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("bootstrap")
+subdirs("client")
+subdirs("server")
@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/daemon/src/common/lwm2m_event_loop.c" "daemon/src/bootstrap/CMakeFiles/awa_bootstrapd.dir/__/common/lwm2m_event_loop.c.o" "gcc" "daemon/src/bootstrap/CMakeFiles/awa_bootstrapd.dir/__/common/lwm2m_event_loop.c.o.d"
+  "/root/repo/daemon/src/bootstrap/awa_bootstrapd_cmdline.c" "daemon/src/bootstrap/CMakeFiles/awa_bootstrapd.dir/awa_bootstrapd_cmdline.c.o" "gcc" "daemon/src/bootstrap/CMakeFiles/awa_bootstrapd.dir/awa_bootstrapd_cmdline.c.o.d"
+  "/root/repo/daemon/src/bootstrap/lwm2m_bootstrap_server.c" "daemon/src/bootstrap/CMakeFiles/awa_bootstrapd.dir/lwm2m_bootstrap_server.c.o" "gcc" "daemon/src/bootstrap/CMakeFiles/awa_bootstrapd.dir/lwm2m_bootstrap_server.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/core/src/bootstrap/CMakeFiles/awa_bootstrap_server_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/common/CMakeFiles/awa_common_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa_bootstrapd.dir/__/common/lwm2m_event_loop.c.o"
+  "CMakeFiles/awa_bootstrapd.dir/__/common/lwm2m_event_loop.c.o.d"
+  "CMakeFiles/awa_bootstrapd.dir/awa_bootstrapd_cmdline.c.o"
+  "CMakeFiles/awa_bootstrapd.dir/awa_bootstrapd_cmdline.c.o.d"
+  "CMakeFiles/awa_bootstrapd.dir/lwm2m_bootstrap_server.c.o"
+  "CMakeFiles/awa_bootstrapd.dir/lwm2m_bootstrap_server.c.o.d"
+  "awa_bootstrapd"
+  "awa_bootstrapd.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_bootstrapd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/error.c.o"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/error.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/log.c.o"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/log.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/lwm2m_error.c.o"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/lwm2m_error.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/objects_tree.c.o"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/objects_tree.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/path.c.o"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/path.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/utils.c.o"
+  "CMakeFiles/awa_clientd.dir/__/__/__/api/src/utils.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/common/ipc_session.c.o"
+  "CMakeFiles/awa_clientd.dir/__/common/ipc_session.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/common/lwm2m_event_loop.c.o"
+  "CMakeFiles/awa_clientd.dir/__/common/lwm2m_event_loop.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/common/lwm2m_ipc.c.o"
+  "CMakeFiles/awa_clientd.dir/__/common/lwm2m_ipc.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/common/lwm2m_xml_interface.c.o"
+  "CMakeFiles/awa_clientd.dir/__/common/lwm2m_xml_interface.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/common/lwm2m_xml_serdes.c.o"
+  "CMakeFiles/awa_clientd.dir/__/common/lwm2m_xml_serdes.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/common/objdefs.c.o"
+  "CMakeFiles/awa_clientd.dir/__/common/objdefs.c.o.d"
+  "CMakeFiles/awa_clientd.dir/__/common/xml.c.o"
+  "CMakeFiles/awa_clientd.dir/__/common/xml.c.o.d"
+  "CMakeFiles/awa_clientd.dir/awa_clientd_cmdline.c.o"
+  "CMakeFiles/awa_clientd.dir/awa_clientd_cmdline.c.o.d"
+  "CMakeFiles/awa_clientd.dir/lwm2m_client.c.o"
+  "CMakeFiles/awa_clientd.dir/lwm2m_client.c.o.d"
+  "CMakeFiles/awa_clientd.dir/lwm2m_client_xml_handlers.c.o"
+  "CMakeFiles/awa_clientd.dir/lwm2m_client_xml_handlers.c.o.d"
+  "awa_clientd"
+  "awa_clientd.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_clientd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
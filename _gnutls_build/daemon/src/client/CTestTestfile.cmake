@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/daemon/src/client
+# Build directory: /root/repo/_gnutls_build/daemon/src/client
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/error.c.o"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/error.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/log.c.o"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/log.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/lwm2m_error.c.o"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/lwm2m_error.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/objects_tree.c.o"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/objects_tree.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/path.c.o"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/path.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/utils.c.o"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/utils.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/write_mode.c.o"
+  "CMakeFiles/awa_serverd.dir/__/__/__/api/src/write_mode.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/common/ipc_session.c.o"
+  "CMakeFiles/awa_serverd.dir/__/common/ipc_session.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_event_loop.c.o"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_event_loop.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_events.c.o"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_events.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_ipc.c.o"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_ipc.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_xml_interface.c.o"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_xml_interface.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_xml_serdes.c.o"
+  "CMakeFiles/awa_serverd.dir/__/common/lwm2m_xml_serdes.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/common/objdefs.c.o"
+  "CMakeFiles/awa_serverd.dir/__/common/objdefs.c.o.d"
+  "CMakeFiles/awa_serverd.dir/__/common/xml.c.o"
+  "CMakeFiles/awa_serverd.dir/__/common/xml.c.o.d"
+  "CMakeFiles/awa_serverd.dir/awa_serverd_cmdline.c.o"
+  "CMakeFiles/awa_serverd.dir/awa_serverd_cmdline.c.o.d"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server.c.o"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server.c.o.d"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_registration_store.c.o"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_registration_store.c.o.d"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_shard_router.c.o"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_shard_router.c.o.d"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_xml_events.c.o"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_xml_events.c.o.d"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_xml_handlers.c.o"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_xml_handlers.c.o.d"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_xml_registered_entity_tree.c.o"
+  "CMakeFiles/awa_serverd.dir/lwm2m_server_xml_registered_entity_tree.c.o.d"
+  "awa_serverd"
+  "awa_serverd.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa_serverd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,41 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/api/src/error.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/error.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/error.c.o.d"
+  "/root/repo/api/src/log.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/log.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/log.c.o.d"
+  "/root/repo/api/src/lwm2m_error.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/lwm2m_error.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/lwm2m_error.c.o.d"
+  "/root/repo/api/src/objects_tree.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/objects_tree.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/objects_tree.c.o.d"
+  "/root/repo/api/src/path.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/path.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/path.c.o.d"
+  "/root/repo/api/src/utils.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/utils.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/__/api/src/utils.c.o.d"
+  "/root/repo/daemon/src/client/lwm2m_client_xml_handlers.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/client/lwm2m_client_xml_handlers.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/client/lwm2m_client_xml_handlers.c.o.d"
+  "/root/repo/daemon/src/common/ipc_session.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/ipc_session.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/ipc_session.c.o.d"
+  "/root/repo/daemon/src/common/lwm2m_event_loop.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_event_loop.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_event_loop.c.o.d"
+  "/root/repo/daemon/src/common/lwm2m_ipc.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_ipc.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_ipc.c.o.d"
+  "/root/repo/daemon/src/common/lwm2m_xml_interface.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_xml_interface.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_xml_interface.c.o.d"
+  "/root/repo/daemon/src/common/lwm2m_xml_serdes.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_xml_serdes.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_xml_serdes.c.o.d"
+  "/root/repo/daemon/src/common/objdefs.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/objdefs.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/objdefs.c.o.d"
+  "/root/repo/daemon/src/common/xml.c" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/xml.c.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/__/src/common/xml.c.o.d"
+  "/root/repo/daemon/tests/main.cc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/main.cc.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/main.cc.o.d"
+  "/root/repo/daemon/tests/test_event_loop.cc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/test_event_loop.cc.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/test_event_loop.cc.o.d"
+  "/root/repo/daemon/tests/test_xml.cc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/test_xml.cc.o" "gcc" "daemon/tests/CMakeFiles/test_daemon_runner.dir/test_xml.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/core/src/client/CMakeFiles/awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/common/CMakeFiles/awa_common_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/error.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/error.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/log.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/log.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/lwm2m_error.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/lwm2m_error.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/objects_tree.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/objects_tree.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/path.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/path.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/utils.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/__/api/src/utils.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/src/client/lwm2m_client_xml_handlers.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/src/client/lwm2m_client_xml_handlers.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/ipc_session.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/ipc_session.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_event_loop.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_event_loop.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_ipc.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_ipc.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_xml_interface.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_xml_interface.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_xml_serdes.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/lwm2m_xml_serdes.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/objdefs.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/objdefs.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/xml.c.o"
+  "CMakeFiles/test_daemon_runner.dir/__/src/common/xml.c.o.d"
+  "CMakeFiles/test_daemon_runner.dir/main.cc.o"
+  "CMakeFiles/test_daemon_runner.dir/main.cc.o.d"
+  "CMakeFiles/test_daemon_runner.dir/test_event_loop.cc.o"
+  "CMakeFiles/test_daemon_runner.dir/test_event_loop.cc.o.d"
+  "CMakeFiles/test_daemon_runner.dir/test_xml.cc.o"
+  "CMakeFiles/test_daemon_runner.dir/test_xml.cc.o.d"
+  "test_daemon_runner"
+  "test_daemon_runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/test_daemon_runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,44 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/api/src/error.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/error.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/error.c.o.d"
+  "/root/repo/api/src/log.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/log.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/log.c.o.d"
+  "/root/repo/api/src/lwm2m_error.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/lwm2m_error.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/lwm2m_error.c.o.d"
+  "/root/repo/api/src/objects_tree.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/objects_tree.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/objects_tree.c.o.d"
+  "/root/repo/api/src/path.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/path.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/path.c.o.d"
+  "/root/repo/api/src/utils.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/utils.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/utils.c.o.d"
+  "/root/repo/api/src/write_mode.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/write_mode.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/__/api/src/write_mode.c.o.d"
+  "/root/repo/daemon/src/common/ipc_session.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/ipc_session.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/ipc_session.c.o.d"
+  "/root/repo/daemon/src/common/lwm2m_ipc.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_ipc.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_ipc.c.o.d"
+  "/root/repo/daemon/src/common/lwm2m_xml_interface.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_xml_interface.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_xml_interface.c.o.d"
+  "/root/repo/daemon/src/common/lwm2m_xml_serdes.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_xml_serdes.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_xml_serdes.c.o.d"
+  "/root/repo/daemon/src/common/xml.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/xml.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/common/xml.c.o.d"
+  "/root/repo/daemon/src/server/lwm2m_server_registration_store.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_registration_store.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_registration_store.c.o.d"
+  "/root/repo/daemon/src/server/lwm2m_server_shard_router.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_shard_router.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_shard_router.c.o.d"
+  "/root/repo/daemon/src/server/lwm2m_server_xml_registered_entity_tree.c" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_xml_registered_entity_tree.c.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_xml_registered_entity_tree.c.o.d"
+  "/root/repo/daemon/tests/main.cc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/main.cc.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/__/main.cc.o.d"
+  "/root/repo/daemon/tests/server/test_registered_entity_tree.cc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/test_registered_entity_tree.cc.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/test_registered_entity_tree.cc.o.d"
+  "/root/repo/daemon/tests/server/test_registration.cc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/test_registration.cc.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/test_registration.cc.o.d"
+  "/root/repo/daemon/tests/server/test_registration_store.cc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/test_registration_store.cc.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/test_registration_store.cc.o.d"
+  "/root/repo/daemon/tests/server/test_shard_router.cc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/test_shard_router.cc.o" "gcc" "daemon/tests/server/CMakeFiles/test_server_runner.dir/test_shard_router.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/core/src/server/CMakeFiles/awa_server_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/common/CMakeFiles/awa_common_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/core/src/erbium/CMakeFiles/awa_erbiumstatic.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,49 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/error.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/error.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/log.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/log.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/lwm2m_error.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/lwm2m_error.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/objects_tree.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/objects_tree.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/path.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/path.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/utils.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/utils.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/write_mode.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/__/api/src/write_mode.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/ipc_session.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/ipc_session.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_ipc.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_ipc.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_xml_interface.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_xml_interface.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_xml_serdes.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/lwm2m_xml_serdes.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/xml.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/src/common/xml.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_registration_store.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_registration_store.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_shard_router.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_shard_router.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_xml_registered_entity_tree.c.o"
+  "CMakeFiles/test_server_runner.dir/__/__/src/server/lwm2m_server_xml_registered_entity_tree.c.o.d"
+  "CMakeFiles/test_server_runner.dir/__/main.cc.o"
+  "CMakeFiles/test_server_runner.dir/__/main.cc.o.d"
+  "CMakeFiles/test_server_runner.dir/test_registered_entity_tree.cc.o"
+  "CMakeFiles/test_server_runner.dir/test_registered_entity_tree.cc.o.d"
+  "CMakeFiles/test_server_runner.dir/test_registration.cc.o"
+  "CMakeFiles/test_server_runner.dir/test_registration.cc.o.d"
+  "CMakeFiles/test_server_runner.dir/test_registration_store.cc.o"
+  "CMakeFiles/test_server_runner.dir/test_registration_store.cc.o.d"
+  "CMakeFiles/test_server_runner.dir/test_shard_router.cc.o"
+  "CMakeFiles/test_server_runner.dir/test_shard_router.cc.o.d"
+  "test_server_runner"
+  "test_server_runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/test_server_runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
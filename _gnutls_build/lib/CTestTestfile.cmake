@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/lib
+# Build directory: /root/repo/_gnutls_build/lib
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("b64")
+subdirs("hmac")
+subdirs("xml")
+subdirs("gtest")
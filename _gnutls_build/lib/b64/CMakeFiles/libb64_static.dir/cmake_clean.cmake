@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libb64_static.dir/b64.c.o"
+  "CMakeFiles/libb64_static.dir/b64.c.o.d"
+  "libb64.a"
+  "libb64.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/libb64_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
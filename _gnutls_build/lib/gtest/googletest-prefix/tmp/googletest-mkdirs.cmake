@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/_gnutls_build/gtest-src"
+  "/root/repo/_gnutls_build/gtest-build"
+  "/root/repo/_gnutls_build/lib/gtest/googletest-prefix"
+  "/root/repo/_gnutls_build/lib/gtest/googletest-prefix/tmp"
+  "/root/repo/_gnutls_build/lib/gtest/googletest-prefix/src/googletest-stamp"
+  "/root/repo/_gnutls_build/lib/gtest/googletest-prefix/src"
+  "/root/repo/_gnutls_build/lib/gtest/googletest-prefix/src/googletest-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/_gnutls_build/lib/gtest/googletest-prefix/src/googletest-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/_gnutls_build/lib/gtest/googletest-prefix/src/googletest-stamp${cfgdir}") # cfgdir has leading slash
+endif()
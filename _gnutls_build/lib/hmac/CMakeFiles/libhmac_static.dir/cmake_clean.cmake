@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libhmac_static.dir/hmac.c.o"
+  "CMakeFiles/libhmac_static.dir/hmac.c.o.d"
+  "libhmac.a"
+  "libhmac.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/libhmac_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libxml_static.dir/xmlparser.c.o"
+  "CMakeFiles/libxml_static.dir/xmlparser.c.o.d"
+  "CMakeFiles/libxml_static.dir/xmltree.c.o"
+  "CMakeFiles/libxml_static.dir/xmltree.c.o.d"
+  "libxml.a"
+  "libxml.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/libxml_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Tools_object.dir/changeset_common.c.o"
+  "CMakeFiles/Tools_object.dir/changeset_common.c.o.d"
+  "CMakeFiles/Tools_object.dir/tools_common.c.o"
+  "CMakeFiles/Tools_object.dir/tools_common.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/Tools_object.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tools/awa-client-define.c" "tools/CMakeFiles/awa-client-define.dir/awa-client-define.c.o" "gcc" "tools/CMakeFiles/awa-client-define.dir/awa-client-define.c.o.d"
+  "/root/repo/tools/awa-client-define_cmdline.c" "tools/CMakeFiles/awa-client-define.dir/awa-client-define_cmdline.c.o" "gcc" "tools/CMakeFiles/awa-client-define.dir/awa-client-define_cmdline.c.o.d"
+  "/root/repo/tools/define_common.c" "tools/CMakeFiles/awa-client-define.dir/define_common.c.o" "gcc" "tools/CMakeFiles/awa-client-define.dir/define_common.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/api/src/CMakeFiles/Awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-client-define.dir/awa-client-define.c.o"
+  "CMakeFiles/awa-client-define.dir/awa-client-define.c.o.d"
+  "CMakeFiles/awa-client-define.dir/awa-client-define_cmdline.c.o"
+  "CMakeFiles/awa-client-define.dir/awa-client-define_cmdline.c.o.d"
+  "CMakeFiles/awa-client-define.dir/define_common.c.o"
+  "CMakeFiles/awa-client-define.dir/define_common.c.o.d"
+  "awa-client-define"
+  "awa-client-define.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-client-define.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-client-delete.dir/awa-client-delete.c.o"
+  "CMakeFiles/awa-client-delete.dir/awa-client-delete.c.o.d"
+  "CMakeFiles/awa-client-delete.dir/awa-client-delete_cmdline.c.o"
+  "CMakeFiles/awa-client-delete.dir/awa-client-delete_cmdline.c.o.d"
+  "awa-client-delete"
+  "awa-client-delete.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-client-delete.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
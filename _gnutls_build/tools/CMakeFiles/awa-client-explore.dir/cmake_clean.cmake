@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-client-explore.dir/awa-client-explore.c.o"
+  "CMakeFiles/awa-client-explore.dir/awa-client-explore.c.o.d"
+  "CMakeFiles/awa-client-explore.dir/awa-client-explore_cmdline.c.o"
+  "CMakeFiles/awa-client-explore.dir/awa-client-explore_cmdline.c.o.d"
+  "awa-client-explore"
+  "awa-client-explore.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-client-explore.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
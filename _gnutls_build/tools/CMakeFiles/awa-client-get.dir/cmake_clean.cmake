@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-client-get.dir/awa-client-get.c.o"
+  "CMakeFiles/awa-client-get.dir/awa-client-get.c.o.d"
+  "CMakeFiles/awa-client-get.dir/awa-client-get_cmdline.c.o"
+  "CMakeFiles/awa-client-get.dir/awa-client-get_cmdline.c.o.d"
+  "awa-client-get"
+  "awa-client-get.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-client-get.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-client-set.dir/awa-client-set.c.o"
+  "CMakeFiles/awa-client-set.dir/awa-client-set.c.o.d"
+  "CMakeFiles/awa-client-set.dir/awa-client-set_cmdline.c.o"
+  "CMakeFiles/awa-client-set.dir/awa-client-set_cmdline.c.o.d"
+  "awa-client-set"
+  "awa-client-set.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-client-set.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
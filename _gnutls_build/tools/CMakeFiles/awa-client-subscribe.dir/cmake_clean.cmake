@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-client-subscribe.dir/awa-client-subscribe.c.o"
+  "CMakeFiles/awa-client-subscribe.dir/awa-client-subscribe.c.o.d"
+  "CMakeFiles/awa-client-subscribe.dir/awa-client-subscribe_cmdline.c.o"
+  "CMakeFiles/awa-client-subscribe.dir/awa-client-subscribe_cmdline.c.o.d"
+  "awa-client-subscribe"
+  "awa-client-subscribe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-client-subscribe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
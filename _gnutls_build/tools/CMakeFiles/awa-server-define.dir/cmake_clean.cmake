@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-define.dir/awa-server-define.c.o"
+  "CMakeFiles/awa-server-define.dir/awa-server-define.c.o.d"
+  "CMakeFiles/awa-server-define.dir/awa-server-define_cmdline.c.o"
+  "CMakeFiles/awa-server-define.dir/awa-server-define_cmdline.c.o.d"
+  "CMakeFiles/awa-server-define.dir/define_common.c.o"
+  "CMakeFiles/awa-server-define.dir/define_common.c.o.d"
+  "awa-server-define"
+  "awa-server-define.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-define.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-delete.dir/awa-server-delete.c.o"
+  "CMakeFiles/awa-server-delete.dir/awa-server-delete.c.o.d"
+  "CMakeFiles/awa-server-delete.dir/awa-server-delete_cmdline.c.o"
+  "CMakeFiles/awa-server-delete.dir/awa-server-delete_cmdline.c.o.d"
+  "awa-server-delete"
+  "awa-server-delete.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-delete.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
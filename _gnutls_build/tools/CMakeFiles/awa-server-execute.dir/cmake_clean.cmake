@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-execute.dir/awa-server-execute.c.o"
+  "CMakeFiles/awa-server-execute.dir/awa-server-execute.c.o.d"
+  "CMakeFiles/awa-server-execute.dir/awa-server-execute_cmdline.c.o"
+  "CMakeFiles/awa-server-execute.dir/awa-server-execute_cmdline.c.o.d"
+  "awa-server-execute"
+  "awa-server-execute.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-execute.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
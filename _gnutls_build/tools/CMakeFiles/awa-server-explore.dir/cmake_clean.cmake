@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-explore.dir/awa-server-explore.c.o"
+  "CMakeFiles/awa-server-explore.dir/awa-server-explore.c.o.d"
+  "CMakeFiles/awa-server-explore.dir/awa-server-explore_cmdline.c.o"
+  "CMakeFiles/awa-server-explore.dir/awa-server-explore_cmdline.c.o.d"
+  "awa-server-explore"
+  "awa-server-explore.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-explore.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
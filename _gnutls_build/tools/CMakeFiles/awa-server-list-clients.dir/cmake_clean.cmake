@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-list-clients.dir/awa-server-list-clients.c.o"
+  "CMakeFiles/awa-server-list-clients.dir/awa-server-list-clients.c.o.d"
+  "CMakeFiles/awa-server-list-clients.dir/awa-server-list-clients_cmdline.c.o"
+  "CMakeFiles/awa-server-list-clients.dir/awa-server-list-clients_cmdline.c.o.d"
+  "awa-server-list-clients"
+  "awa-server-list-clients.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-list-clients.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
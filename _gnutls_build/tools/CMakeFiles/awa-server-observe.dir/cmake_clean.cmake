@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-observe.dir/awa-server-observe.c.o"
+  "CMakeFiles/awa-server-observe.dir/awa-server-observe.c.o.d"
+  "CMakeFiles/awa-server-observe.dir/awa-server-observe_cmdline.c.o"
+  "CMakeFiles/awa-server-observe.dir/awa-server-observe_cmdline.c.o.d"
+  "awa-server-observe"
+  "awa-server-observe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-observe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
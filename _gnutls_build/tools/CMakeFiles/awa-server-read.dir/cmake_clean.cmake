@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-read.dir/awa-server-read.c.o"
+  "CMakeFiles/awa-server-read.dir/awa-server-read.c.o.d"
+  "CMakeFiles/awa-server-read.dir/awa-server-read_cmdline.c.o"
+  "CMakeFiles/awa-server-read.dir/awa-server-read_cmdline.c.o.d"
+  "awa-server-read"
+  "awa-server-read.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-read.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-write-attributes.dir/awa-server-write-attributes.c.o"
+  "CMakeFiles/awa-server-write-attributes.dir/awa-server-write-attributes.c.o.d"
+  "CMakeFiles/awa-server-write-attributes.dir/awa-server-write-attributes_cmdline.c.o"
+  "CMakeFiles/awa-server-write-attributes.dir/awa-server-write-attributes_cmdline.c.o.d"
+  "awa-server-write-attributes"
+  "awa-server-write-attributes.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-write-attributes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
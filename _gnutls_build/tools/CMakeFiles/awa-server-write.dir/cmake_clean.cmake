@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/awa-server-write.dir/awa-server-write.c.o"
+  "CMakeFiles/awa-server-write.dir/awa-server-write.c.o.d"
+  "CMakeFiles/awa-server-write.dir/awa-server-write_cmdline.c.o"
+  "CMakeFiles/awa-server-write.dir/awa-server-write_cmdline.c.o.d"
+  "awa-server-write"
+  "awa-server-write.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/awa-server-write.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/api/tests/support/main/main_cmdline.c" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/main/main_cmdline.c.o" "gcc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/main/main_cmdline.c.o.d"
+  "/root/repo/tools/tools_common.c" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/tools_common.c.o" "gcc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/tools_common.c.o.d"
+  "/root/repo/api/tests/support/daemon.cc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/daemon.cc.o" "gcc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/daemon.cc.o.d"
+  "/root/repo/api/tests/support/log.cc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/log.cc.o" "gcc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/log.cc.o.d"
+  "/root/repo/api/tests/support/main/main.cc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/main/main.cc.o" "gcc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/main/main.cc.o.d"
+  "/root/repo/api/tests/support/process.cc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/process.cc.o" "gcc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/process.cc.o.d"
+  "/root/repo/api/tests/support/support.cc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/support.cc.o" "gcc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/support.cc.o.d"
+  "/root/repo/tools/tests/gtest/test_tools_common.cc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/test_tools_common.cc.o" "gcc" "tools/tests/gtest/CMakeFiles/test_tools_runner.dir/test_tools_common.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gnutls_build/api/src/CMakeFiles/Awa_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/xml/CMakeFiles/libxml_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/b64/CMakeFiles/libb64_static.dir/DependInfo.cmake"
+  "/root/repo/_gnutls_build/lib/hmac/CMakeFiles/libhmac_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/daemon.cc.o"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/daemon.cc.o.d"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/log.cc.o"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/log.cc.o.d"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/main/main.cc.o"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/main/main.cc.o.d"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/main/main_cmdline.c.o"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/main/main_cmdline.c.o.d"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/process.cc.o"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/process.cc.o.d"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/support.cc.o"
+  "CMakeFiles/test_tools_runner.dir/__/__/__/api/tests/support/support.cc.o.d"
+  "CMakeFiles/test_tools_runner.dir/__/__/tools_common.c.o"
+  "CMakeFiles/test_tools_runner.dir/__/__/tools_common.c.o.d"
+  "CMakeFiles/test_tools_runner.dir/test_tools_common.cc.o"
+  "CMakeFiles/test_tools_runner.dir/test_tools_common.cc.o.d"
+  "test_tools_runner"
+  "test_tools_runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/test_tools_runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
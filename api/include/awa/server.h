@@ -340,6 +340,18 @@ AwaError AwaServerSession_PathToIDs(const AwaServerSession * session, const char
  */
 AwaServerListClientsOperation * AwaServerListClientsOperation_New(const AwaServerSession * session);
 
+/**
+ * @brief Restrict a List Clients operation to clients that have registered the specified object.
+ *        The daemon resolves the filter from its object index, so only the matching clients
+ *        (and, for each, only the registered entities of that object) are returned.
+ * @param[in] operation The List Clients operation to restrict.
+ * @param[in] objectID The object ID that listed clients must support.
+ * @return AwaError_Success on success.
+ * @return AwaError_OperationInvalid if the operation is not valid.
+ * @return AwaError_IDInvalid if the object ID is not valid.
+ */
+AwaError AwaServerListClientsOperation_SetObjectFilter(AwaServerListClientsOperation * operation, AwaObjectID objectID);
+
 /**
  * @brief Process the List Clients operation by sending it to the Core.
  *        If successful, the response can be obtained with AwaServerListClientsOperation_GetResponse
@@ -367,6 +379,7 @@ const AwaServerListClientsResponse * AwaServerListClientsOperation_GetResponse(c
 /**
  * @brief Create a new Registered Entity iterator for a List Clients Response, used to iterate through the list of
  *        objects and object instances that exist within the client the response relates to.
+ *        Entities are ordered by object ID, then object instance ID, not in the order the client registered them.
  *        The resulting iterator is owned by the caller and should eventually be freed with AwaRegisteredEntityIterator_Free.
  *        This function can only be successful after a List Clients operation has been successfully processed.
  * @param[in] response A pointer to the List Clients response to search.
@@ -1773,6 +1786,7 @@ AwaClientIterator * AwaServerClientDeregisterEvent_NewClientIterator(const AwaSe
 /**
  * @brief Create a new Registered Entity iterator for a Client Register Event, used to iterate through the list of
  *        objects and object instances that exist within the client the event relates to.
+ *        Entities are ordered by object ID, then object instance ID, not in the order the client registered them.
  *        The resulting iterator is owned by the caller and should eventually be freed with ::AwaRegisteredEntityIterator_Free.
  *        This function can only be successful within a Client Register Event callback.
  * @param[in] event A pointer to the Client Register Event to search.
@@ -1785,6 +1799,7 @@ AwaRegisteredEntityIterator * AwaServerClientRegisterEvent_NewRegisteredEntityIt
 /**
  * @brief Create a new Registered Entity iterator for a Client Update Event, used to iterate through the list of
  *        objects and object instances that exist within the client the event relates to.
+ *        Entities are ordered by object ID, then object instance ID, not in the order the client registered them.
  *        The resulting iterator is owned by the caller and should eventually be freed with ::AwaRegisteredEntityIterator_Free.
  *        This function can only be successful within a Client Update Event callback.
  * @param[in] event A pointer to the Client Update Event to search.
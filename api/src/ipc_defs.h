@@ -59,6 +59,7 @@ typedef int IPCSessionID;
 
 // Server request message types:
 #define IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS           "ListClients"
+#define IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS_WITH_OBJECT "ListClientsWithObject"
 #define IPC_MESSAGE_SUB_TYPE_WRITE                  "Write"
 #define IPC_MESSAGE_SUB_TYPE_READ                   "Read"
 #define IPC_MESSAGE_SUB_TYPE_OBSERVE                "Observe"
@@ -31,6 +31,7 @@
 #include "registered_entity_iterator.h"
 #include "map.h"
 #include "objects_tree.h"
+#include "path.h"
 
 struct _AwaServerListClientsResponse
 {
@@ -42,6 +43,7 @@ struct _AwaServerListClientsOperation
     ServerOperation * ServerOperation;
     ServerResponse * ServerResponse;
     MapType * ClientResponseMap;         // stores built-on-demand Response instances
+    AwaObjectID ObjectFilter;            // only list clients supporting this object, or AWA_INVALID_ID for all clients
 };
 
 AwaServerListClientsOperation * AwaServerListClientsOperation_New(const AwaServerSession * session)
@@ -57,6 +59,7 @@ AwaServerListClientsOperation * AwaServerListClientsOperation_New(const AwaServe
             {
                 memset(operation, 0, sizeof(*operation));
                 operation->ServerResponse = NULL;
+                operation->ObjectFilter = AWA_INVALID_ID;
                 operation->ServerOperation = ServerOperation_New(session);
                 if (operation->ServerOperation != NULL)
                 {
@@ -106,6 +109,28 @@ AwaError AwaServerListClientsOperation_Free(AwaServerListClientsOperation ** ope
     return result;
 }
 
+AwaError AwaServerListClientsOperation_SetObjectFilter(AwaServerListClientsOperation * operation, AwaObjectID objectID)
+{
+    AwaError result = AwaError_Unspecified;
+    if (operation != NULL)
+    {
+        if (Path_IsIDValid(objectID))
+        {
+            operation->ObjectFilter = objectID;
+            result = AwaError_Success;
+        }
+        else
+        {
+            result = LogErrorWithEnum(AwaError_IDInvalid, "Invalid object ID %d", objectID);
+        }
+    }
+    else
+    {
+        result = LogErrorWithEnum(AwaError_OperationInvalid, "Operation is NULL");
+    }
+    return result;
+}
+
 AwaError AwaServerListClientsOperation_Perform(AwaServerListClientsOperation * operation, AwaTimeout timeout)
 {
     AwaError result = AwaError_Unspecified;
@@ -115,8 +140,24 @@ AwaError AwaServerListClientsOperation_Perform(AwaServerListClientsOperation * o
         if (operation != NULL)
         {
             // build an IPC message and inject our content (object paths) into it
-            IPCMessage * request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, ServerOperation_GetSessionID(operation->ServerOperation));
+            IPCMessage * request = NULL;
             IPCMessage * response = NULL;
+            if (operation->ObjectFilter != AWA_INVALID_ID)
+            {
+                // the server looks the object up in its index and only returns matching clients
+                char path[MAX_PATH_LENGTH] = { 0 };
+                TreeNode objectsTree = ObjectsTree_New();
+                Path_MakePath(path, sizeof(path), operation->ObjectFilter, AWA_INVALID_ID, AWA_INVALID_ID);
+                ObjectsTree_AddPath(objectsTree, path, NULL);
+
+                request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS_WITH_OBJECT, ServerOperation_GetSessionID(operation->ServerOperation));
+                IPCMessage_AddContent(request, objectsTree);
+                Tree_Delete(objectsTree);
+            }
+            else
+            {
+                request = IPCMessage_NewPlus(IPC_MESSAGE_TYPE_REQUEST, IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, ServerOperation_GetSessionID(operation->ServerOperation));
+            }
 
             // a timeout of 0 means an infinite timeout
             result = IPC_SendAndReceive(ServerSession_GetChannel(ServerOperation_GetSession(operation->ServerOperation)), request, &response, timeout);
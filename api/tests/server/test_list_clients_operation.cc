@@ -106,6 +106,74 @@ TEST_F(TestListClientsOperationWithConnectedSession, AwaServerListClientsOperati
     AwaServerListClientsOperation_Free(&operation);
 }
 
+TEST_F(TestListClientsOperation, AwaServerListClientsOperation_SetObjectFilter_handles_null_operation)
+{
+    EXPECT_EQ(AwaError_OperationInvalid, AwaServerListClientsOperation_SetObjectFilter(NULL, 3));
+}
+
+TEST_F(TestListClientsOperationWithConnectedSession, AwaServerListClientsOperation_SetObjectFilter_handles_invalid_id)
+{
+    AwaServerListClientsOperation * operation = AwaServerListClientsOperation_New(session_);
+    EXPECT_EQ(AwaError_IDInvalid, AwaServerListClientsOperation_SetObjectFilter(operation, AWA_INVALID_ID));
+    AwaServerListClientsOperation_Free(&operation);
+}
+
+TEST_F(TestListClientsOperationWithConnectedSession, AwaServerListClientsOperation_SetObjectFilter_with_no_clients)
+{
+    AwaServerListClientsOperation * operation = AwaServerListClientsOperation_New(session_);
+    EXPECT_EQ(AwaError_Success, AwaServerListClientsOperation_SetObjectFilter(operation, 3));
+    EXPECT_EQ(AwaError_Success, AwaServerListClientsOperation_Perform(operation, global::timeout));
+    AwaClientIterator * iterator = AwaServerListClientsOperation_NewClientIterator(operation);
+    EXPECT_TRUE(NULL != iterator);
+    EXPECT_FALSE(AwaClientIterator_Next(iterator));
+    AwaClientIterator_Free(&iterator);
+    AwaServerListClientsOperation_Free(&operation);
+}
+
+TEST_F(TestListClientsOperationWithConnectedSession, AwaServerListClientsOperation_SetObjectFilter_excludes_non_matching_clients)
+{
+    AwaClientDaemonHorde horde( { "TestClient1" }, 61000);
+    ASSERT_TRUE(WaitForRegistration(session_, horde.GetClientIDs(), 1000));
+
+    AwaServerListClientsOperation * operation = AwaServerListClientsOperation_New(session_);
+    EXPECT_EQ(AwaError_Success, AwaServerListClientsOperation_SetObjectFilter(operation, 9999));
+    EXPECT_EQ(AwaError_Success, AwaServerListClientsOperation_Perform(operation, global::timeout));
+    AwaClientIterator * iterator = AwaServerListClientsOperation_NewClientIterator(operation);
+    EXPECT_TRUE(NULL != iterator);
+    EXPECT_FALSE(AwaClientIterator_Next(iterator));
+    AwaClientIterator_Free(&iterator);
+    AwaServerListClientsOperation_Free(&operation);
+}
+
+TEST_F(TestListClientsOperationWithConnectedSession, AwaServerListClientsOperation_SetObjectFilter_returns_matching_entities)
+{
+    AwaClientDaemonHorde horde( { "TestClient1" }, 61000);
+    ASSERT_TRUE(WaitForRegistration(session_, horde.GetClientIDs(), 1000));
+
+    AwaServerListClientsOperation * operation = AwaServerListClientsOperation_New(session_);
+    EXPECT_EQ(AwaError_Success, AwaServerListClientsOperation_SetObjectFilter(operation, 2));
+    EXPECT_EQ(AwaError_Success, AwaServerListClientsOperation_Perform(operation, global::timeout));
+    const AwaServerListClientsResponse * response = AwaServerListClientsOperation_GetResponse(operation, "TestClient1");
+    ASSERT_TRUE(NULL != response);
+
+    AwaRegisteredEntityIterator * iterator = AwaServerListClientsResponse_NewRegisteredEntityIterator(response);
+    ASSERT_TRUE(NULL != iterator);
+
+    std::vector<std::string> expectedPaths { "/2/0", "/2/1", "/2/2", "/2/3" };
+    std::vector<std::string> actualPaths;
+    while (AwaRegisteredEntityIterator_Next(iterator))
+    {
+        actualPaths.push_back(AwaRegisteredEntityIterator_GetPath(iterator));
+    }
+
+    EXPECT_EQ(expectedPaths.size(), actualPaths.size());
+    if (expectedPaths.size() == actualPaths.size())
+        EXPECT_TRUE(std::is_permutation(expectedPaths.begin(), expectedPaths.end(), actualPaths.begin()));
+
+    AwaRegisteredEntityIterator_Free(&iterator);
+    AwaServerListClientsOperation_Free(&operation);
+}
+
 //DISABLED_AwaServerListClientsOperation_Perform_handles_zero_timeout
 
 //DISABLED_AwaServerListClientsOperation_Perform_handles_short_timeout
@@ -0,0 +1,49 @@
+#!/bin/bash -x
+
+#/************************************************************************************************************************
+# Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+# following conditions are met:
+#     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+#        following disclaimer.
+#     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+#        following disclaimer in the documentation and/or other materials provided with the distribution.
+#     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+#        products derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+# INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+# USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Build each CoAP and DTLS backend the CMake options expose, and run the core tests against it.
+# Usage: ci/build-backends.sh [backend...]   (default: all)
+
+set -o errexit
+
+BACKENDS=${@:-"gnutls mbedtls cyassl tinydtls libcoap"}
+
+for BACKEND in $BACKENDS
+do
+  case $BACKEND in
+    gnutls)   OPTIONS="-DWITH_GNUTLS=ON" ;;
+    mbedtls)  OPTIONS="-DWITH_MBEDTLS=ON" ;;
+    cyassl)   OPTIONS="-DWITH_CYASSL=ON" ;;
+    tinydtls) OPTIONS="-DWITH_TINYDTLS=ON" ;;
+    libcoap)  OPTIONS="-DWITH_LIBCOAP=ON" ;;
+    *)
+      echo "Unknown backend $BACKEND"
+      exit 1
+      ;;
+  esac
+
+  BUILD_DIR=build.$BACKEND
+  rm -rf $BUILD_DIR
+  make BUILD_DIR=$BUILD_DIR CMAKE_OPTIONS="$CMAKE_OPTIONS $OPTIONS"
+  $BUILD_DIR/core/tests/test_core_runner
+done
@@ -60,6 +60,9 @@ mkdir -p $BUILD_DIR
 make BUILD_DIR=$BUILD_DIR CMAKE_OPTIONS="$CMAKE_OPTIONS"
 make BUILD_DIR=$BUILD_DIR CMAKE_OPTIONS="$CMAKE_OPTIONS" tests
 
+# build and test the other CoAP and DTLS backends
+ci/build-backends.sh
+
 # prepare coverage results
 (
   cd $BUILD_DIR
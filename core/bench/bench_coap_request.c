@@ -0,0 +1,250 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+/* Benchmark of the cost to submit a CoAP request to a client whose address is already known, as the server does for
+ * each request from an IPC application. It compares:
+ *
+ *  - by URI: formatting the client's address and the path into a URI, as the server used to, then parsing and
+ *    resolving the URI again in the CoAP abstraction
+ *  - by address: passing the client's address and the path with coap_SubmitRequest
+ *
+ * A UDP socket in the same process stands in for the client and acknowledges each request, outside of the timed part,
+ * so only the time to build and send the request is measured.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "coap_abstraction.h"
+#include "lwm2m_debug.h"
+
+#define BENCH_COAP_PORT             (15780)
+#define BENCH_MAX_DATAGRAM          (1500)
+#define BENCH_MAX_URI               (128)
+#define BENCH_RESPONSE_TIMEOUT_MS   (1000)
+#define BENCH_WARMUP_REQUESTS       (1000)    // Untimed requests before each measurement
+
+#define DEFAULT_REQUESTS            (20000)
+
+typedef void (*SubmitFunction)(const AddressType * client, int instance);
+
+static int clientSocket = -1;
+static CoapInfo * coap = NULL;
+static int responses = 0;
+
+static double GetTime(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void ResponseCallback(void * context, AddressType * addr, const char * responsePath, int responseCode,
+                             AwaContentType contentType, char * payload, size_t payloadLen)
+{
+    responses++;
+}
+
+// Same formatting as the server did for each request
+static void SubmitByURI(const AddressType * client, int instance)
+{
+    char uri[BENCH_MAX_URI];
+    char buffer[INET6_ADDRSTRLEN];
+    const char * ip = inet_ntop(AF_INET, &client->Addr.Sin.sin_addr, buffer, sizeof(buffer));
+    sprintf(uri, "coap://%s:%d/3/0/%d", ip, ntohs(client->Addr.Sin.sin_port), instance);
+    coap_GetRequest(NULL, uri, AwaContentType_ApplicationPlainText, ResponseCallback);
+}
+
+static void SubmitByAddress(const AddressType * client, int instance)
+{
+    char path[BENCH_MAX_URI];
+    CoapRequest request;
+    sprintf(path, "/3/0/%d", instance);
+
+    memset(&request, 0, sizeof(request));
+    request.type = COAP_GET_REQUEST;
+    request.addr = *client;
+    request.path = path;
+    request.contentType = AwaContentType_ApplicationPlainText;
+    coap_SubmitRequest(&request, ResponseCallback, NULL);
+}
+
+// Acknowledge the request with an empty 2.05 Content response, echoing its message ID and token
+static bool Acknowledge(void)
+{
+    uint8_t datagram[BENCH_MAX_DATAGRAM];
+    struct sockaddr_storage from;
+    socklen_t fromLength = sizeof(from);
+    int tokenLength;
+    ssize_t length = recvfrom(clientSocket, datagram, sizeof(datagram), 0, (struct sockaddr *)&from, &fromLength);
+    if (length < 4)
+    {
+        return false;
+    }
+
+    tokenLength = datagram[0] & 0x0f;
+    if (length < 4 + tokenLength)
+    {
+        return false;
+    }
+    datagram[0] = 0x60 | tokenLength;   // version 1, acknowledgement
+    datagram[1] = 0x45;                 // 2.05 Content
+    return sendto(clientSocket, datagram, 4 + tokenLength, 0, (struct sockaddr *)&from, fromLength) == 4 + tokenLength;
+}
+
+static bool WaitForResponse(int expected)
+{
+    struct pollfd fd = { .fd = coap->fd, .events = POLLIN };
+    while (responses < expected)
+    {
+        if (poll(&fd, 1, BENCH_RESPONSE_TIMEOUT_MS) <= 0)
+        {
+            return false;
+        }
+        coap_HandleMessage();
+    }
+    return true;
+}
+
+// Returns the mean time in seconds to submit a request, or a negative value if a request was not answered
+static double Run(const char * name, SubmitFunction submit, const AddressType * client, int requests)
+{
+    double elapsed = 0;
+    int i;
+
+    responses = 0;
+    for (i = -BENCH_WARMUP_REQUESTS; i < requests; i++)
+    {
+        double start = GetTime();
+        submit(client, (i + BENCH_WARMUP_REQUESTS) % 8);
+        if (i >= 0)
+        {
+            elapsed += GetTime() - start;
+        }
+
+        if (!Acknowledge() || !WaitForResponse(i + BENCH_WARMUP_REQUESTS + 1))
+        {
+            fprintf(stderr, "%s: request %d was not answered\n", name, i);
+            return -1;
+        }
+        coap_Process();
+    }
+
+    printf("  %-12s %8.0f ns/request\n", name, elapsed * 1e9 / requests);
+    return elapsed / requests;
+}
+
+static void PrintUsage(const char * program)
+{
+    printf("Usage: %s [OPTIONS]\n"
+           "  -n, --requests=N         requests to submit each way (default %d)\n"
+           "  -v, --verbose            log the CoAP abstraction's messages\n"
+           "  -h, --help               print this help and exit\n",
+           program, DEFAULT_REQUESTS);
+}
+
+int main(int argc, char ** argv)
+{
+    static const struct option longOptions[] =
+    {
+        { "requests", required_argument, NULL, 'n' },
+        { "verbose",  no_argument,       NULL, 'v' },
+        { "help",     no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+    int logLevel = DebugLevel_Error;
+    int requests = DEFAULT_REQUESTS;
+    int result = EXIT_FAILURE;
+    AddressType client;
+    double byURI, byAddress;
+    int option;
+
+    while ((option = getopt_long(argc, argv, "n:vh", longOptions, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                requests = atoi(optarg);
+                break;
+            case 'v':
+                logLevel = DebugLevel_Debug;
+                break;
+            case 'h':
+                PrintUsage(argv[0]);
+                return EXIT_SUCCESS;
+            default:
+                PrintUsage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (requests < 1)
+    {
+        fprintf(stderr, "Requests must be positive\n");
+        return EXIT_FAILURE;
+    }
+    Lwm2m_SetLogLevel(logLevel);
+
+    memset(&client, 0, sizeof(client));
+    client.Size = sizeof(client.Addr.Sin);
+    client.Addr.Sin.sin_family = AF_INET;
+    client.Addr.Sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if ((clientSocket < 0) || (bind(clientSocket, &client.Addr.Sa, client.Size) != 0) ||
+        (getsockname(clientSocket, &client.Addr.Sa, &client.Size) != 0))
+    {
+        perror("Failed to bind client socket");
+        goto error;
+    }
+
+    coap = coap_Init("127.0.0.1", BENCH_COAP_PORT, false, logLevel);
+    if (coap == NULL)
+    {
+        fprintf(stderr, "Failed to initialise CoAP on port %d\n", BENCH_COAP_PORT);
+        goto error;
+    }
+
+    printf("CoAP library: %s, %d requests\n", coap_LibraryName, requests);
+    byURI = Run("by URI", SubmitByURI, &client, requests);
+    byAddress = Run("by address", SubmitByAddress, &client, requests);
+    if ((byURI > 0) && (byAddress > 0))
+    {
+        printf("  speedup      %8.2fx\n", byURI / byAddress);
+        result = EXIT_SUCCESS;
+    }
+    coap_Destroy();
+
+error:
+    if (clientSocket >= 0)
+    {
+        close(clientSocket);
+    }
+    return result;
+}
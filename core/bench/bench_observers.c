@@ -0,0 +1,225 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+/* Benchmark of the client's observer bookkeeping, through the interface in lwm2m_observers.h. Several servers each
+ * observe an integer resource in many object instances, with gt and stp attributes at the object level and pmax at
+ * the object instance level. Each iteration changes one of the resources so that it crosses the gt threshold, then
+ * sends the notifications that are due, through a callback that only counts them. It reports the time per change to
+ * match the observers and check their attributes, and the time per notification to send it and schedule the next.
+ * Changes to an observer within a millisecond of its last notification are coalesced (pmin is 0, and a notification
+ * is sent once more than pmin has elapsed), so there are fewer notifications than changes times servers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include <getopt.h>
+#include <arpa/inet.h>
+
+#include "lwm2m_core.h"
+#include "lwm2m_observers.h"
+#include "lwm2m_objects.h"
+#include "lwm2m_security_object.h"
+#include "lwm2m_server_object.h"
+#include "lwm2m_bootstrap_config.h"
+
+#define BENCH_OBJECT                (1000)
+#define BENCH_RESOURCE              (0)
+#define BENCH_SERVER_PORT           (5683)
+#define BENCH_THRESHOLD             (50)      // Values alternate either side of gt, so every change is notified
+
+#define DEFAULT_SERVERS             (4)
+#define DEFAULT_INSTANCES           (250)
+#define DEFAULT_CHANGES             (200000)
+
+static uint64_t notifications = 0;
+
+static double GetTime(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static int Notify(void * context, AddressType * addr, int sequence, const char * token, int tokenLength, ObjectIDType objectID,
+                  ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, AwaContentType contentType, void * contextData)
+{
+    notifications++;
+    return 0;
+}
+
+static void GetServerAddress(int server, AddressType * address)
+{
+    memset(address, 0, sizeof(*address));
+    address->Size = sizeof(address->Addr.Sin);
+    address->Addr.Sin.sin_family = AF_INET;
+    address->Addr.Sin.sin_port = htons(BENCH_SERVER_PORT + server);
+    address->Addr.Sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+}
+
+static void AddServer(Lwm2mContextType * context, int server)
+{
+    BootstrapInfo info;
+    memset(&info, 0, sizeof(info));
+    snprintf(info.SecurityInfo.ServerURI, sizeof(info.SecurityInfo.ServerURI), "coap://127.0.0.1:%d", BENCH_SERVER_PORT + server);
+    info.SecurityInfo.Bootstrap = false;
+    info.SecurityInfo.SecurityMode = 0;
+    info.SecurityInfo.ServerID = server + 1;
+    info.ServerInfo.ShortServerID = server + 1;
+    info.ServerInfo.LifeTime = 60;
+    info.ServerInfo.MinPeriod = 0;
+    info.ServerInfo.MaxPeriod = -1;
+    strcpy(info.ServerInfo.Binding, "U");
+    BootstrapInformation_Apply(context, &info);
+}
+
+static void SetAttributes(Lwm2mContextType * context, int shortServerID, int instances)
+{
+    AttributeStore * store = Lwm2mCore_GetAttributes(context);
+    NotificationAttributes * objectAttributes = AttributeStore_LookupNotificationAttributes(store, shortServerID, BENCH_OBJECT, -1, -1);
+    int instance;
+
+    objectAttributes->GreaterThan = BENCH_THRESHOLD;
+    objectAttributes->Valid[AttributeTypeEnum_GreaterThan] = true;
+    objectAttributes->Step = 1;
+    objectAttributes->Valid[AttributeTypeEnum_Step] = true;
+
+    for (instance = 0; instance < instances; instance++)
+    {
+        NotificationAttributes * instanceAttributes = AttributeStore_LookupNotificationAttributes(store, shortServerID, BENCH_OBJECT, instance, -1);
+        instanceAttributes->MaximumPeriod = 3600;
+        instanceAttributes->Valid[AttributeTypeEnum_MaximumPeriod] = true;
+    }
+}
+
+static void PrintUsage(const char * program)
+{
+    printf("Usage: %s [OPTIONS]\n"
+           "  -s, --servers=N          servers observing each resource (default %d)\n"
+           "  -i, --instances=N        object instances, each with an observed resource (default %d)\n"
+           "  -n, --changes=N          resource changes to make (default %d)\n"
+           "  -h, --help               print this help and exit\n",
+           program, DEFAULT_SERVERS, DEFAULT_INSTANCES, DEFAULT_CHANGES);
+}
+
+int main(int argc, char ** argv)
+{
+    static const struct option longOptions[] =
+    {
+        { "servers",   required_argument, NULL, 's' },
+        { "instances", required_argument, NULL, 'i' },
+        { "changes",   required_argument, NULL, 'n' },
+        { "help",      no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+    int servers = DEFAULT_SERVERS;
+    int instances = DEFAULT_INSTANCES;
+    int changes = DEFAULT_CHANGES;
+    Lwm2mContextType * context;
+    double start, markElapsed = 0, updateElapsed = 0;
+    int option, server, instance, i;
+
+    while ((option = getopt_long(argc, argv, "s:i:n:h", longOptions, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 's':
+                servers = atoi(optarg);
+                break;
+            case 'i':
+                instances = atoi(optarg);
+                break;
+            case 'n':
+                changes = atoi(optarg);
+                break;
+            case 'h':
+                PrintUsage(argv[0]);
+                return EXIT_SUCCESS;
+            default:
+                PrintUsage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if ((servers < 1) || (instances < 1) || (changes < 1))
+    {
+        fprintf(stderr, "Servers, instances and changes must be positive\n");
+        return EXIT_FAILURE;
+    }
+    Lwm2m_SetLogLevel(DebugLevel_Error);
+
+    context = Lwm2mCore_Init(NULL, "bench");
+    Lwm2m_RegisterSecurityObject(context);
+    Lwm2m_RegisterServerObject(context);
+    Lwm2mCore_RegisterObjectType(context, "Sensor", BENCH_OBJECT, MultipleInstancesEnum_Multiple, MandatoryEnum_Optional, &defaultObjectOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, "Value", BENCH_OBJECT, BENCH_RESOURCE, AwaResourceType_Integer, MultipleInstancesEnum_Single,
+                                   MandatoryEnum_Mandatory, AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+
+    for (instance = 0; instance < instances; instance++)
+    {
+        AwaInteger value = 0;
+        Lwm2mCore_CreateObjectInstance(context, BENCH_OBJECT, instance);
+        Lwm2mCore_SetResourceInstanceValue(context, BENCH_OBJECT, instance, BENCH_RESOURCE, 0, &value, sizeof(value));
+    }
+
+    for (server = 0; server < servers; server++)
+    {
+        AddressType address;
+        AddServer(context, server);
+        SetAttributes(context, server + 1, instances);
+
+        GetServerAddress(server, &address);
+        for (instance = 0; instance < instances; instance++)
+        {
+            Lwm2m_Observe(context, &address, "tokn", 4, BENCH_OBJECT, instance, BENCH_RESOURCE, AwaContentType_ApplicationPlainText, Notify, NULL);
+        }
+    }
+    Lwm2m_RescheduleObservers(context);
+
+    // the first pmax notifications are due straight away
+    Lwm2m_UpdateObservers(context);
+    notifications = 0;
+
+    for (i = 0; i < changes; i++)
+    {
+        // each instance's value alternates between 0 and twice the threshold
+        AwaInteger value = ((i / instances) % 2 == 0) ? 2 * BENCH_THRESHOLD : 0;
+
+        start = GetTime();
+        Lwm2m_MarkObserversChanged(context, BENCH_OBJECT, i % instances, BENCH_RESOURCE, &value, sizeof(value));
+        markElapsed += GetTime() - start;
+
+        start = GetTime();
+        Lwm2m_UpdateObservers(context);
+        updateElapsed += GetTime() - start;
+    }
+
+    printf("%d servers, %d observers, %d changes\n", servers, servers * instances, changes);
+    printf("  %8.0f ns/change to match observers and check their attributes\n", markElapsed * 1e9 / changes);
+    printf("  %8.0f ns/notification to send and reschedule (%" PRIu64 " notifications)\n",
+           notifications ? updateElapsed * 1e9 / notifications : 0.0, notifications);
+
+    Lwm2mCore_Destroy(context);
+    return EXIT_SUCCESS;
+}
@@ -217,18 +217,25 @@ static void BootstrapTransactionCallback(void * context, AddressType * addr, con
     }
 }
 
-void Lwm2mBootstrap_BootStrapUpdate(Lwm2mContextType * context)
+int Lwm2mBootstrap_BootStrapUpdate(Lwm2mContextType * context)
 {
     // Loop through bootstrap request queue and send responses for each client
     int i;
+    int waiting = 0;
     for (i = 0 ; i < MAX_CLIENTS; i++)
     {
         // Kick start sending bootstrap with callback
         if (bootStrapQueue[i].Used && (bootStrapQueue[i].ObjectID == 0) && (bootStrapQueue[i].ObjectInstanceID == -1))
         {
             BootstrapTransactionCallback(&bootStrapQueue[i], &bootStrapQueue[i].Addr, NULL, AwaResult_Success, 0, NULL, 0);
+
+            if (bootStrapQueue[i].Used && (bootStrapQueue[i].ObjectID == 0) && (bootStrapQueue[i].ObjectInstanceID == -1))
+            {
+                waiting++;
+            }
         }
     }
+    return waiting;
 }
 
 // Initialise the boot strap mechanism, create the /bs endpoint
@@ -39,7 +39,8 @@ bool Lwm2mBootstrap_BootStrapInit(Lwm2mContextType * context, const char ** conf
 
 void Lwm2mBootstrap_Destroy(void);
 
-void Lwm2mBootstrap_BootStrapUpdate(Lwm2mContextType * context);
+// Start bootstrapping clients that have sent a bootstrap request. Returns the number still waiting to start.
+int Lwm2mBootstrap_BootStrapUpdate(Lwm2mContextType * context);
 
 #ifdef __cplusplus
 }
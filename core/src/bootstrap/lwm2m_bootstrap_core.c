@@ -198,9 +198,8 @@ int Lwm2mCore_Process(Lwm2mContextType * context)
 {
     int nextTick = 10;
 
-    Lwm2mBootstrap_BootStrapUpdate(context);
-
-    return nextTick;
+    // bootstrapping progresses from transaction callbacks once started, so only poll while a client waits to start
+    return (Lwm2mBootstrap_BootStrapUpdate(context) > 0) ? nextTick : -1;
 }
 
 void Lwm2mCore_Destroy(Lwm2mContextType * context)
@@ -46,7 +46,9 @@ extern "C" {
 
 Lwm2mContextType * Lwm2mCore_Init(CoapInfo * coap);
 
-// Update the LWM2M state machine, process any message timeouts, registration attempts etc.
+/* Update the LWM2M state machine, process any message timeouts, registration attempts etc. Returns the time in
+ * milliseconds until the next update is needed, or -1 if there is nothing to do until the next request.
+ */
 int Lwm2mCore_Process(Lwm2mContextType * context);
 int Lwm2mCore_GetEndPointClientName(Lwm2mContextType * context, char * buffer, int len);
 void Lwm2mCore_GetObjectList(Lwm2mContextType * context, char * altPath, char * buffer, int len, bool updated);
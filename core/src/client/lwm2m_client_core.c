@@ -62,6 +62,9 @@ struct _Lwm2mContextType
     char EndPointName[MAX_ENDPOINT_NAME_LENGTH];  // Client EndPoint name
     bool UseFactoryBootstrap;                 // Factory bootstrap information has been loaded from file.
     struct ListHead ObserverList;
+    HashTable ObserverIndex;                  // "Lwm2mObserverType" by object, object instance and resource ID
+    DeadlineQueue ObserverQueue;              // "Lwm2mObserverType" by when the next notification is due
+    uint32_t NotificationCoalescePeriod;      // Milliseconds to hold changed observers so they are notified together, 0 to disable
     void * ApplicationContext;
 };
 
@@ -1868,6 +1871,7 @@ static int HandleWriteAttributesRequest(void * ctxt, AddressType * addr, const c
             {
                 // Query was fully checked - copy attributes
                 memcpy(attributes, &temp, sizeof(NotificationAttributes));
+                Lwm2m_RescheduleObservers(context);
                 *responseCode = AwaResult_SuccessChanged;
             }
             Lwm2mCore_FreeQueryPairs(pairs, numPairs);
@@ -2317,7 +2321,12 @@ int Lwm2mCore_Process(Lwm2mContextType * context)
         Lwm2m_UpdateBootStrapState(context);
     }
 
-    Lwm2m_UpdateObservers(context);
+    // the registration and bootstrap state machines are polled, but notifications are sent when due
+    int32_t observerTimeout = Lwm2m_UpdateObservers(context);
+    if ((observerTimeout >= 0) && (observerTimeout < nextTick))
+    {
+        nextTick = observerTimeout;
+    }
     return nextTick;
 }
 
@@ -2352,6 +2361,17 @@ void Lwm2mCore_SetFactoryBootstrap(Lwm2mContextType * context, const BootstrapIn
     }
 }
 
+void Lwm2mCore_SetNotificationCoalescePeriod(Lwm2mContextType * context, uint32_t periodMs)
+{
+    context->NotificationCoalescePeriod = periodMs;
+    Lwm2m_RescheduleObservers(context);
+}
+
+uint32_t Lwm2mCore_GetNotificationCoalescePeriod(Lwm2mContextType * context)
+{
+    return context->NotificationCoalescePeriod;
+}
+
 struct ListHead * Lwm2mCore_GetServerList(Lwm2mContextType * context)
 {
     return &context->ServerList;
@@ -2367,6 +2387,16 @@ struct ListHead * Lwm2mCore_GetObserverList(Lwm2mContextType * context)
     return &context->ObserverList;
 }
 
+HashTable * Lwm2mCore_GetObserverIndex(Lwm2mContextType * context)
+{
+    return &context->ObserverIndex;
+}
+
+DeadlineQueue * Lwm2mCore_GetObserverQueue(Lwm2mContextType * context)
+{
+    return &context->ObserverQueue;
+}
+
 AttributeStore * Lwm2mCore_GetAttributes(Lwm2mContextType * context)
 {
     return context->AttributeStore;
@@ -2412,6 +2442,11 @@ Lwm2mContextType * Lwm2mCore_New(void)
     Lwm2mContextType * context = &Lwm2mContext;
 
     ListInit(&context->ObserverList);
+    context->NotificationCoalescePeriod = 0;
+    if ((HashTable_Init(&context->ObserverIndex, 0) != 0) || (DeadlineQueue_Init(&context->ObserverQueue) != 0))
+    {
+        Lwm2m_Error("Failed to allocate observer index\n");
+    }
     ListInit(&context->ServerList);
     Lwm2mObjectTree_Init(&context->ObjectTree);
 
@@ -2507,4 +2542,6 @@ void Lwm2mCore_Destroy(Lwm2mContextType * context)
     AttributeStore_Destroy(context->AttributeStore);
     DefinitionRegistry_Destroy(context->Definitions);
     Lwm2m_FreeObservers(context);
+    HashTable_Destroy(&context->ObserverIndex);
+    DeadlineQueue_Destroy(&context->ObserverQueue);
 }
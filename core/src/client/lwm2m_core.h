@@ -72,6 +72,14 @@ void Lwm2mCore_SetDefaultContentType(AwaContentType contentType);
 
 void Lwm2mCore_SetFactoryBootstrap(Lwm2mContextType * context, const BootstrapInfo * factoryBootstrapInformation);
 
+/* Hold notifications of changes for up to periodMs milliseconds, so observers that change within the same period are
+ * notified together: the resource observers of an object instance go out in one pass, and an observer of the whole
+ * object instance sends one notification for all of its resources that changed. The minimum and maximum periods still
+ * apply. A period of 0 (the default) notifies each observer as soon as its minimum period allows.
+ */
+void Lwm2mCore_SetNotificationCoalescePeriod(Lwm2mContextType * context, uint32_t periodMs);
+uint32_t Lwm2mCore_GetNotificationCoalescePeriod(Lwm2mContextType * context);
+
 // Update the LWM2M state machine, process any message timeouts, registration attempts etc.
 int Lwm2mCore_Process(Lwm2mContextType * context);
 
@@ -148,6 +156,8 @@ AwaObjectInstanceID Lwm2mCore_AddSeverObjects(Lwm2mContextType * context);
 struct ListHead * Lwm2mCore_GetServerList(Lwm2mContextType * context);
 struct ListHead * Lwm2mCore_GetSecurityObjectList(Lwm2mContextType * context);
 struct ListHead * Lwm2mCore_GetObserverList(Lwm2mContextType * context);
+HashTable * Lwm2mCore_GetObserverIndex(Lwm2mContextType * context);
+DeadlineQueue * Lwm2mCore_GetObserverQueue(Lwm2mContextType * context);
 AttributeStore * Lwm2mCore_GetAttributes(Lwm2mContextType * context);
 
 Lwm2mBootStrapState Lwm2mCore_GetBootstrapState(Lwm2mContextType * context);
@@ -210,6 +210,7 @@ static int Lwm2mSecurity_DeleteObjectInstance(Lwm2mContextType * context, Object
         {
             if(RemoveSecurityInfo(context, objectInstanceID))
             {
+                Lwm2m_RescheduleObservers(context);
                 result = 0;
             }
         }
@@ -485,6 +486,8 @@ static int Lwm2mSecurity_ResourceWriteHandler(void * context, ObjectIDType objec
         if (result > 0)
         {
             *changed = true;
+            // observers cache the short server ID for their address
+            Lwm2m_RescheduleObservers(context);
         }
     }
     return result;
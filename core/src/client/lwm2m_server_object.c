@@ -259,6 +259,7 @@ static int Lwm2mServer_ResourceWriteHandler(void * context, ObjectIDType objectI
                     result = sizeof(server->DefaultMinimumPeriod);
                     WarnOfInsufficientData(result, srcBufferLen);
                     *changed = true;
+                    Lwm2m_RescheduleObservers(context);
                 }
                 break;
             }
@@ -277,6 +278,7 @@ static int Lwm2mServer_ResourceWriteHandler(void * context, ObjectIDType objectI
                     result = sizeof(server->DefaultMaximumPeriod);
                     WarnOfInsufficientData(result, srcBufferLen);
                     *changed = true;
+                    Lwm2m_RescheduleObservers(context);
                 }
                 break;
             }
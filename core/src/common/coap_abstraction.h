@@ -77,12 +77,39 @@ extern const char * coap_LibraryName;
 
 CoapInfo * coap_Init(const char * ipAddress, int port, bool secure, int logLevel);
 
+/* As coap_Init, but bind the port so that other processes can share it (SO_REUSEPORT). The kernel spreads
+ * incoming datagrams over the sharing sockets by source address, so each peer is always served by the same process.
+ */
+CoapInfo * coap_InitShared(const char * ipAddress, int port, bool secure, int logLevel);
+
 void coap_Reset(const char * uri);
 void coap_SetCertificate(const uint8_t * cert, int certLength, AwaCertificateFormat format);
 void coap_SetPSK(const char * identity, const uint8_t * key, int keyLength);
 
+// Look up the PSK of each client identity in keyStore, which must outlive the CoAP context (see DTLS_SetKeyStore)
+void coap_SetKeyStore(DTLS_KeyStore * keyStore);
+
+// Run DTLS handshakes with clients on workers threads (see DTLS_SetHandshakeWorkers). Returns false if not supported.
+bool coap_SetHandshakeWorkers(int workers);
+
+/* Receive and send up to batchSize datagrams per system call. Each coap_HandleMessage() then handles every datagram
+ * of the batch received, and responses are queued until the batch is full or coap_Process() is called, so callers
+ * must call coap_Process() before waiting for the next message. The CoapInfo fd may change, so wait on it only
+ * after setting the batch size. Returns false if batching is not supported.
+ */
+bool coap_SetBatchSize(int batchSize);
+
+// Batch size used by the daemons
+#ifndef COAP_BATCH_SIZE
+    #define COAP_BATCH_SIZE (32)
+#endif
+
 int coap_Destroy(void);
-void coap_Process(void);
+
+/* Send any due retransmissions, time out unanswered transactions and send any queued datagrams. Returns the time
+ * in milliseconds until coap_Process() next needs to be called, or -1 if there is nothing pending.
+ */
+int coap_Process(void);
 void coap_HandleMessage(void);
 
 void coap_SetLogLevel(int logLevel);
@@ -93,6 +120,12 @@ void coap_PutRequest(void * context, const char * path, AwaContentType contentTy
 void coap_DeleteRequest(void * context, const char * path, TransactionCallback callback);
 void coap_Observe(void * context, const char * path, AwaContentType contentType, TransactionCallback transactionCallback, NotificationFreeCallback notificationFreeCallback);
 void coap_CancelObserve(void * context, const char * path, AwaContentType contentType, TransactionCallback callback);
+/* Send a request of type COAP_GET_REQUEST to COAP_CANCEL_OBSERVE_REQUEST to the peer at request->addr, with the path
+ * (such as "/3/0/1") and query (NULL if none) given separately, so that no URI is formatted, parsed and resolved for
+ * the request. The token fields are unused, and notificationFreeCallback is only used by observe requests.
+ */
+void coap_SubmitRequest(CoapRequest * request, TransactionCallback callback, NotificationFreeCallback notificationFreeCallback);
+
 void coap_SendNotify(AddressType * addr, const char * path, const char * token, int tokenSize, AwaContentType contentType, const char * payload, int payloadLen, int sequence);
 
 void coap_SetContext(void * ctxt);
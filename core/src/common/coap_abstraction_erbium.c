@@ -59,6 +59,11 @@ const char * coap_LibraryName = "Erbium";
 #define MAX_COAP_TRANSACTIONS (2)
 #endif
 
+// Interval between attempts to send a transaction that failed to send (e.g. during a DTLS handshake)
+#ifndef COAP_SEND_RETRY_INTERVAL_MS
+#define COAP_SEND_RETRY_INTERVAL_MS (1000)
+#endif
+
 int CurrentTransactionIndex = 0;
 TransactionType CurrentTransaction[MAX_COAP_TRANSACTIONS];
 
@@ -89,9 +94,8 @@ static int coap_HandleRequest(void *packet, void *response, uint8_t *buffer, uin
 static int addObserve(NetworkAddress * remoteAddress, char * path, TransactionCallback callback, void * context);
 static int removeObserve(NetworkAddress * remoteAddress, char * path);
 
-CoapInfo * coap_Init(const char * ipAddress, int port, bool secure, int logLevel)
+static CoapInfo * Init(const char * ipAddress, int port, NetworkSocketType socketType)
 {
-    (void) logLevel;
     CoapInfo * result = NULL;
     memset(CurrentTransaction, 0, sizeof(CurrentTransaction));
     memset(Observations, 0, sizeof(Observations));
@@ -99,10 +103,7 @@ CoapInfo * coap_Init(const char * ipAddress, int port, bool secure, int logLevel
     coap_init_transactions();
     coap_set_service_callback(coap_HandleRequest);
     DTLS_Init();
-    if (secure)
-    	networkSocket = NetworkSocket_New(ipAddress, NetworkSocketType_UDP | NetworkSocketType_Secure, port);
-    else
-    	networkSocket = NetworkSocket_New(ipAddress, NetworkSocketType_UDP, port);
+    networkSocket = NetworkSocket_New(ipAddress, socketType, port);
     if (networkSocket)
     {
         if (NetworkSocket_StartListening(networkSocket))
@@ -119,6 +120,18 @@ CoapInfo * coap_Init(const char * ipAddress, int port, bool secure, int logLevel
     return result;
 }
 
+CoapInfo * coap_Init(const char * ipAddress, int port, bool secure, int logLevel)
+{
+    (void) logLevel;
+    return Init(ipAddress, port, secure ? (NetworkSocketType_UDP | NetworkSocketType_Secure) : NetworkSocketType_UDP);
+}
+
+CoapInfo * coap_InitShared(const char * ipAddress, int port, bool secure, int logLevel)
+{
+    (void) logLevel;
+    return Init(ipAddress, port, (secure ? (NetworkSocketType_UDP | NetworkSocketType_Secure) : NetworkSocketType_UDP) | NetworkSocketType_Shared);
+}
+
 
 void coap_Reset(const char * uri)
 {
@@ -140,6 +153,25 @@ void coap_SetPSK(const char * identity, const uint8_t * key, int keyLength)
 	NetworkSocket_SetPSK(networkSocket, identity, key, keyLength);
 }
 
+void coap_SetKeyStore(DTLS_KeyStore * keyStore)
+{
+	NetworkSocket_SetKeyStore(networkSocket, keyStore);
+}
+
+bool coap_SetHandshakeWorkers(int workers)
+{
+	return NetworkSocket_SetHandshakeWorkers(networkSocket, workers);
+}
+
+bool coap_SetBatchSize(int batchSize)
+{
+    bool result = NetworkSocket_SetBatchSize(networkSocket, batchSize);
+
+    // batching may wait on a different descriptor
+    coapInfo.fd = NetworkSocket_GetFileDescriptor(networkSocket);
+    return result;
+}
+
 void coap_SetLogLevel(int logLevel)
 {
     (void)logLevel;
@@ -367,39 +399,23 @@ void coap_CoapRequestCallback(void *callback_data, void *response)
     }
 }
 
-void coap_createCoapRequest(coap_method_t method, const char * uri, AwaContentType contentType, ObserveState observeState,
-        const char * payload, int payloadLen, TransactionCallback callback, void * context)
+// Send a request to remoteAddress, with a path of MAX_COAP_PATH bytes without a leading '/'
+static void sendRequest(coap_method_t method, NetworkAddress * remoteAddress, char * path, const char * query, AwaContentType contentType,
+        ObserveState observeState, const char * payload, int payloadLen, TransactionCallback callback, void * context)
 {
     coap_packet_t request;
-    char path[MAX_COAP_PATH] =
-    { 0 };
-    char query[128] =
-    { 0 };
     coap_transaction_t *transaction;
-    NetworkAddress * remoteAddress = NetworkAddress_New(uri, strlen(uri));
-
-    if (!remoteAddress)
-    {
-        return;
-    }
 
     if ((strcmp(DTLS_LibraryName, "None") == 0) && NetworkAddress_IsSecure(remoteAddress))
     {
-        NetworkAddress_Free(&remoteAddress);
-        Lwm2m_Error("Cannot send request to %s - not built with DTLS support\n\n", uri);
+        Lwm2m_Error("Cannot send request to /%s - not built with DTLS support\n\n", path);
         return;
     }
 
-    coap_getPathQueryFromURI(uri, path, query);
-
-    Lwm2m_Info("Coap request: %s\n", uri);
-    //Lwm2m_Debug("Coap request path: %s\n", path);
-    //Lwm2m_Debug("Coap request query: %s\n", query);
-
     coap_init_message(&request, COAP_TYPE_CON, method, coap_get_mid());
 
     coap_set_header_uri_path(&request, path);
-    if (strlen(query) > 0)
+    if ((query != NULL) && (strlen(query) > 0))
         coap_set_header_uri_query(&request, query);
     // TODO - REVIEW: Erbium must copy path/query from request - else mem out of scope
 
@@ -472,25 +488,121 @@ void coap_createCoapRequest(coap_method_t method, const char * uri, AwaContentTy
     }
 }
 
+void coap_createCoapRequest(coap_method_t method, const char * uri, AwaContentType contentType, ObserveState observeState,
+        const char * payload, int payloadLen, TransactionCallback callback, void * context)
+{
+    char path[MAX_COAP_PATH] =
+    { 0 };
+    char query[128] =
+    { 0 };
+    NetworkAddress * remoteAddress = NetworkAddress_New(uri, strlen(uri));
+
+    if (!remoteAddress)
+    {
+        return;
+    }
+
+    coap_getPathQueryFromURI(uri, path, query);
+
+    Lwm2m_Info("Coap request: %s\n", uri);
+    //Lwm2m_Debug("Coap request path: %s\n", path);
+    //Lwm2m_Debug("Coap request query: %s\n", query);
+
+    sendRequest(method, remoteAddress, path, query, contentType, observeState, payload, payloadLen, callback, context);
+    NetworkAddress_Free(&remoteAddress);
+}
+
+void coap_SubmitRequest(CoapRequest * request, TransactionCallback callback, NotificationFreeCallback notificationFreeCallback)
+{
+    coap_method_t method;
+    ObserveState observeState = ObserveState_None;
+    char path[MAX_COAP_PATH] =
+    { 0 };
+    const char * requestPath = request->path;
+    NetworkAddress * remoteAddress;
+
+    (void)notificationFreeCallback;
+    switch (request->type)
+    {
+        case COAP_GET_REQUEST:
+            method = COAP_GET;
+            break;
+        case COAP_PUT_REQUEST:
+            method = COAP_PUT;
+            break;
+        case COAP_POST_REQUEST:
+            method = COAP_POST;
+            break;
+        case COAP_DELETE_REQUEST:
+            method = COAP_DELETE;
+            break;
+        case COAP_OBSERVE_REQUEST:
+            method = COAP_GET;
+            observeState = ObserveState_Establish;
+            break;
+        case COAP_CANCEL_OBSERVE_REQUEST:
+            method = COAP_GET;
+            observeState = ObserveState_Cancel;
+            break;
+        default:
+            Lwm2m_Error("Unsupported request type %d\n", request->type);
+            return;
+    }
+
+    while (*requestPath == '/')
+    {
+        requestPath++;
+    }
+    if (strlen(requestPath) >= sizeof(path))
+    {
+        Lwm2m_Error("Request path too long: %s\n", request->path);
+        return;
+    }
+    strcpy(path, requestPath);
+
+    remoteAddress = NetworkAddress_FromAddressType(&request->addr);
+    if (!remoteAddress)
+    {
+        return;
+    }
+
+    Lwm2m_Info("Coap request: /%s%s%s\n", path, request->query ? "?" : "", request->query ? request->query : "");
+    sendRequest(method, remoteAddress, path, request->query, request->contentType, observeState,
+                request->requestContent, request->requestContentLen, callback, request->ctxt);
+    NetworkAddress_Free(&remoteAddress);
+}
+
 int coap_Destroy(void)
 {
     Lwm2m_Info("Close port: \n");     //  TODO - remove
     if (networkSocket)
+    {
+        // stop the handshake workers, which send with the socket
+        NetworkSocket_SetHandshakeWorkers(networkSocket, 0);
         NetworkSocket_Free(&networkSocket);
+    }
     // TODO - close any open sessions
 //    coap_free_context(coapContext);
 //    DestroyLists();
     return 0;
 }
 
-void coap_Process(void)
+int coap_Process(void)
 {
-    coap_check_transactions();
+    // Erbium sends transactions immediately; only those that failed to send are retried here
+    int timeout = (coap_check_transactions() > 0) ? COAP_SEND_RETRY_INTERVAL_MS : -1;
+    NetworkSocket_Flush(networkSocket);
+    return timeout;
 }
 
 void coap_HandleMessage(void)
 {
-    coap_receive(networkSocket);
+    // handle the whole batch received, rather than waiting on the socket again for each datagram
+    do
+    {
+        coap_receive(networkSocket);
+    }
+    while (NetworkSocket_GetPendingReads(networkSocket) > 0);
 }
 
 void coap_GetRequest(void * context, const char * path, AwaContentType contentType, TransactionCallback callback)
@@ -563,6 +675,7 @@ void coap_SendNotify(AddressType * addr, const char * path, const char * token,
 
             coap_send_transaction(transaction); // for NON confirmable messages this will call coap_clear_transaction();
         }
+        NetworkAddress_Free(&remoteAddress);
     }
 }
 
@@ -605,7 +718,7 @@ static int addObserve(NetworkAddress * remoteAddress, char * path, TransactionCa
     }
     if (observation)
     {
-        observation->Address = remoteAddress;
+        observation->Address = NetworkAddress_Retain(remoteAddress);
         int length = strlen(path);
         memcpy(observation->Path, path, length);
         observation->Path[length] = '\0';
@@ -637,14 +750,14 @@ static int addObserve(NetworkAddress * remoteAddress, char * path, TransactionCa
 
 static int removeObserve(NetworkAddress * remoteAddress, char * path)
 {
-    (void)remoteAddress;
     int result = 0;
     int index;
     for (index = 0; index < MAX_COAP_OBSERVATIONS; index++)
     {
-        if ((NetworkAddress_Compare(Observations[index].Address, sourceAddress) == 0) && (strcmp(Observations[index].Path,path) == 0))
+        if ((NetworkAddress_Compare(Observations[index].Address, remoteAddress) == 0) && (strcmp(Observations[index].Path,path) == 0))
         {
             result = Observations[index].Token;
+            NetworkAddress_Free(&Observations[index].Address);
             memset(&Observations[index],0, sizeof(Observation));
             break;
         }
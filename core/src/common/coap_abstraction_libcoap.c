@@ -44,6 +44,7 @@
 #include "lwm2m_util.h"
 #include "lwm2m_list.h"
 #include "lwm2m_debug.h"
+#include "coap_exchange_index.h"
 
 #define WITH_POSIX 1
 //#define  COAP_4_1_1  // build against libcoap 4.1.1 (last released version)
@@ -65,9 +66,9 @@
 typedef struct
 {
     struct ListHead List;
+    CoapTransactionEntry Entry;             // Index by transaction ID
     TransactionCallback Callback;
     NotificationFreeCallback NotificationFreeCallback;
-    coap_tid_t TransactionID;
     AddressType Address;
     void * Context;
     char * Path;
@@ -76,19 +77,18 @@ typedef struct
 typedef struct
 {
     struct ListHead List;
+    CoapObservationEntry Entry;             // Index by peer address and token
     TransactionCallback Callback;
-    char Token[8];
-    int TokenLength;
     char * Path;
     void * Context;
     NotificationFreeCallback FreeCallback;
-    AddressType * Address;
 } NotificationHandler;
 
 const char * coap_LibraryName = "libcoap";
 
 static struct ListHead transactionCallbackList;
 static struct ListHead notifyCallbackList;
+static CoapExchangeIndex exchanges;
 static coap_context_t * coapContext = NULL;
 static void * context = NULL;
 static CoapInfo coapInfo;
@@ -169,44 +169,40 @@ static void coap_CoapAddressTypeToAddressType(coap_address_t * coapAddress, Addr
 /* Notification handler, used by the server to map a callback to a token in a notification packet
  * this is not required on the client, as the client can simply use the object store
  */
-static NotificationHandler * lookup_NotificationHandler(char * token, int tokenLength)
+static NotificationHandler * lookup_NotificationHandler(AddressType * address, char * token, int tokenLength)
 {
-    struct ListHead * i;
-    ListForEach(i, &notifyCallbackList)
-    {
-        NotificationHandler * notify = ListEntry(i, NotificationHandler, List);
-        if ((notify->TokenLength == tokenLength) && (memcmp(notify->Token, token, tokenLength) == 0))
-        {
-            return notify;
-        }
-    }
-    return NULL;
+    CoapObservationEntry * entry = CoapExchangeIndex_GetObservation(&exchanges, address, token, tokenLength);
+    return entry ? HashTableContainer(entry, NotificationHandler, Entry) : NULL;
 }
 
 static int create_NotificationHandler(char * token, int tokenLength, void * context, char * path, TransactionCallback callback,
                                       NotificationFreeCallback freeCallback, AddressType * address)
 {
-    int result = -1;
     NotificationHandler * notify = malloc(sizeof(NotificationHandler));
-    if (notify != NULL)
+    if (notify == NULL)
     {
-        notify->TokenLength = tokenLength;
-        memcpy(notify->Token, token, tokenLength);
-        notify->Context = context;
-        notify->Callback = callback;
-        notify->FreeCallback = freeCallback;
-        notify->Path = strdup(path);
-        notify->Address = address;
-
-        ListAdd(&notify->List, &notifyCallbackList);
-        result = 0;
+        return -1;
     }
-    return result;
+
+    memset(notify, 0, sizeof(*notify));
+    if (CoapExchangeIndex_AddObservation(&exchanges, &notify->Entry, address, token, tokenLength) != 0)
+    {
+        free(notify);
+        return -1;
+    }
+    notify->Context = context;
+    notify->Callback = callback;
+    notify->FreeCallback = freeCallback;
+    notify->Path = strdup(path);
+
+    ListAdd(&notify->List, &notifyCallbackList);
+    return 0;
 }
 
 static int remove_NotificationHandler(NotificationHandler * notify)
 {
     ListRemove(&notify->List);
+    CoapExchangeIndex_RemoveObservation(&exchanges, &notify->Entry);
 
     free(notify->Path);
     free(notify);
@@ -215,16 +211,8 @@ static int remove_NotificationHandler(NotificationHandler * notify)
 
 static TransactionType * lookup_Transaction(coap_tid_t transactionID)
 {
-    struct ListHead * i;
-    ListForEach(i, &transactionCallbackList)
-    {
-        TransactionType * transaction = ListEntry(i, TransactionType, List);
-        if (transaction->TransactionID == transactionID)
-        {
-            return transaction;
-        }
-    }
-    return NULL;
+    CoapTransactionEntry * entry = CoapExchangeIndex_GetTransaction(&exchanges, transactionID);
+    return entry ? HashTableContainer(entry, TransactionType, Entry) : NULL;
 }
 
 static int create_Transaction(coap_tid_t transactionID, coap_address_t * address, const char * path, void * context,
@@ -236,21 +224,19 @@ static int create_Transaction(coap_tid_t transactionID, coap_address_t * address
         return -1;
     }
 
-    TransactionType * transaction = lookup_Transaction(transactionID);
-    if (transaction)
+    TransactionType * transaction = malloc(sizeof(TransactionType));
+    if (!transaction)
     {
-        // already exists
         return -1;
     }
 
-    transaction = malloc(sizeof(TransactionType));
-    if (!transaction)
+    memset(transaction, 0, sizeof(*transaction));
+    if (CoapExchangeIndex_AddTransaction(&exchanges, &transaction->Entry, transactionID) != 0)
     {
+        // already exists
+        free(transaction);
         return -1;
     }
-
-    memset(transaction, 0, sizeof(*transaction));
-    transaction->TransactionID = transactionID;
     transaction->Context = context;
     transaction->Callback = transactionCallback;
     transaction->NotificationFreeCallback = notificationFreeCallback;
@@ -258,13 +244,13 @@ static int create_Transaction(coap_tid_t transactionID, coap_address_t * address
     transaction->Path = strdup(path);
 
     ListAdd(&transaction->List, &transactionCallbackList);
-
     return 0;
 }
 
 static int remove_Transaction(TransactionType * transaction)
 {
     ListRemove(&transaction->List);
+    CoapExchangeIndex_RemoveTransaction(&exchanges, &transaction->Entry);
     free(transaction->Path);
     free(transaction);
     return 0;
@@ -736,7 +722,7 @@ void coap_ResponseHandler(struct coap_context_t * ctx,
                 if (option != NULL)
                 {
                     // if we have established an observation, then create a new observer
-                    if (!lookup_NotificationHandler(received->hdr->token, received->hdr->token_length))
+                    if (!lookup_NotificationHandler(&transaction->Address, (char *)received->hdr->token, received->hdr->token_length))
                     {
                         create_NotificationHandler(received->hdr->token, received->hdr->token_length, transaction->Context, responsePath, transaction->Callback, transaction->NotificationFreeCallback, &transaction->Address);
                     }
@@ -744,7 +730,7 @@ void coap_ResponseHandler(struct coap_context_t * ctx,
                 else
                 {
                     // Client responded without the observe options set, so clean up and notification handlers
-                    NotificationHandler * notify = lookup_NotificationHandler(received->hdr->token, received->hdr->token_length);
+                    NotificationHandler * notify = lookup_NotificationHandler(&transaction->Address, (char *)received->hdr->token, received->hdr->token_length);
                     if (notify != NULL)
                     {
                         remove_NotificationHandler(notify);
@@ -765,7 +751,9 @@ void coap_ResponseHandler(struct coap_context_t * ctx,
         if ((received->hdr->type == COAP_MESSAGE_CON) || (received->hdr->type == COAP_MESSAGE_NON))
         {
             // Notification message, lookup handler
-            NotificationHandler * notify = lookup_NotificationHandler(received->hdr->token, received->hdr->token_length);
+            AddressType peer;
+            coap_CoapAddressTypeToAddressType((coap_address_t *)remote, &peer);
+            NotificationHandler * notify = lookup_NotificationHandler(&peer, (char *)received->hdr->token, received->hdr->token_length);
             if (notify != NULL)
             {
                 if (!coap_get_data(received, &len, &databuf))
@@ -773,7 +761,7 @@ void coap_ResponseHandler(struct coap_context_t * ctx,
                     Lwm2m_Error("Failed to read data from unsolicited response message for %d\n", id);
                 }
 
-                notify->Callback(notify->Context, notify->Address, notify->Path, COAP_OPTION_TO_RESPONSE_CODE(received->hdr->code), contentType, databuf, len);
+                notify->Callback(notify->Context, &notify->Entry.Address, notify->Path, COAP_OPTION_TO_RESPONSE_CODE(received->hdr->code), contentType, databuf, len);
             }
         }
     }
@@ -859,12 +847,13 @@ void coap_HandleMessage(void)
 #endif
 }
 
-void coap_Process(void)
+int coap_Process(void)
 {
     coap_context_t * ctx = coapContext;
 
     coap_queue_t *nextpdu;
     coap_tick_t now;
+    int timeout = -1;
 
     nextpdu = coap_peek_next( ctx );
 
@@ -889,23 +878,30 @@ void coap_Process(void)
             }
             else
             {
-                // update transaction ID
-                transaction->TransactionID = tid;
+                // a retransmission may be sent with a new transaction ID
+                CoapExchangeIndex_SetTransactionID(&exchanges, &transaction->Entry, tid);
             }
         }
 
         nextpdu = coap_peek_next( ctx );
     }
+
+    if (nextpdu != NULL)
+    {
+        // queue times are relative to the send queue base time, in coap ticks
+        coap_tick_t remaining = nextpdu->t - (now - ctx->sendqueue_basetime);
+        timeout = (int)((remaining * 1000 + COAP_TICKS_PER_SECOND - 1) / COAP_TICKS_PER_SECOND);
+    }
+    return timeout;
 }
 
-static void coap_SendRequest(int messageType, void * context, char * token, int tokenSize, const char * path, AwaContentType contentType,
-                             const char * payload, int payloadLen, TransactionCallback transactionCallback, NotificationFreeCallback notificationFreeCallback)
+// Send a request to dst, with a path without a leading '/'
+static void sendRequest(int messageType, void * context, char * token, int tokenSize, coap_address_t * dst, int port,
+                        const char * path, size_t pathLength, const char * query, size_t queryLength, AwaContentType contentType,
+                        const char * payload, int payloadLen, TransactionCallback transactionCallback, NotificationFreeCallback notificationFreeCallback)
 {
-    AddressType addr;
-    coap_address_t dst;
     coap_pdu_t *request;
     coap_tid_t tid;
-    coap_uri_t uri;
 
     enum { BUFSIZE = 1024 };
     unsigned char _buf[BUFSIZE];
@@ -915,20 +911,6 @@ static void coap_SendRequest(int messageType, void * context, char * token, int
     unsigned short msgID;
     unsigned char * tokenValue;
 
-    coap_split_uri((char *)path, strlen(path), &uri);
-
-    // resolve destination address where server should be sent
-    if (!Lwm2mCore_ResolveAddressByName(uri.host.s, uri.host.length, &addr))
-    {
-        Lwm2m_Error("failed to resolve address\n");
-        return;
-    }
-
-    memcpy(&dst.addr, &addr.Addr, sizeof(addr.Addr));
-
-    dst.size = addr.Size;
-    dst.addr.sin.sin_port = htons(uri.port);
-
     msgID = coap_new_message_id(coapContext);
     request = coap_pdu_init(COAP_MESSAGE_CON, messageType & 0x0F,
             msgID, COAP_MAX_PDU_SIZE);
@@ -960,17 +942,17 @@ static void coap_SendRequest(int messageType, void * context, char * token, int
         coap_add_option(request, COAP_OPTION_OBSERVE, coap_encode_var_bytes(buf, COAP_OBSERVE_CANCEL), buf);
     }
 
-    if (uri.port != COAP_DEFAULT_PORT)
+    if (port != COAP_DEFAULT_PORT)
     {
         unsigned char portbuf[2];
         coap_add_option(request, COAP_OPTION_URI_PORT,
-                coap_encode_var_bytes(portbuf, uri.port), portbuf);
+                coap_encode_var_bytes(portbuf, port), portbuf);
     }
 
-    if (uri.path.length && ((messageType & COAP_MESSAGE_NOTIFY) == 0))
+    if (pathLength && ((messageType & COAP_MESSAGE_NOTIFY) == 0))
     {
         buflen = BUFSIZE;
-        res = coap_split_path(uri.path.s, uri.path.length, buf, &buflen);
+        res = coap_split_path((const unsigned char *)path, pathLength, buf, &buflen);
 
         while (res--)
         {
@@ -991,10 +973,10 @@ static void coap_SendRequest(int messageType, void * context, char * token, int
         }
     }
 
-    if (uri.query.length > 0)
+    if (queryLength > 0)
     {
         buflen = BUFSIZE;
-        res = coap_split_query(uri.query.s, uri.query.length, buf, &buflen);
+        res = coap_split_query((const unsigned char *)query, queryLength, buf, &buflen);
 
         while (res--)
         {
@@ -1019,9 +1001,9 @@ static void coap_SendRequest(int messageType, void * context, char * token, int
     }
 
 #ifdef COAP_4_1_1
-    tid = coap_send_confirmed(coapContext, &dst, request);
+    tid = coap_send_confirmed(coapContext, dst, request);
 #else
-    tid = coap_send_confirmed(coapContext, coapContext->endpoint, &dst, request);
+    tid = coap_send_confirmed(coapContext, coapContext->endpoint, dst, request);
 #endif
     if (tid == COAP_INVALID_TID)
     {
@@ -1031,8 +1013,79 @@ static void coap_SendRequest(int messageType, void * context, char * token, int
 
     if (transactionCallback != NULL)
     {
-        create_Transaction(tid, &dst, uri.path.s, context, transactionCallback, notificationFreeCallback);
+        create_Transaction(tid, dst, path, context, transactionCallback, notificationFreeCallback);
+    }
+}
+
+static void coap_SendRequest(int messageType, void * context, char * token, int tokenSize, const char * path, AwaContentType contentType,
+                             const char * payload, int payloadLen, TransactionCallback transactionCallback, NotificationFreeCallback notificationFreeCallback)
+{
+    AddressType addr;
+    coap_address_t dst;
+    coap_uri_t uri;
+
+    coap_split_uri((char *)path, strlen(path), &uri);
+
+    // resolve destination address where server should be sent
+    if (!Lwm2mCore_ResolveAddressByName(uri.host.s, uri.host.length, &addr))
+    {
+        Lwm2m_Error("failed to resolve address\n");
+        return;
     }
+
+    memcpy(&dst.addr, &addr.Addr, sizeof(addr.Addr));
+
+    dst.size = addr.Size;
+    dst.addr.sin.sin_port = htons(uri.port);
+
+    sendRequest(messageType, context, token, tokenSize, &dst, uri.port, (const char *)uri.path.s, uri.path.length,
+                (const char *)uri.query.s, uri.query.length, contentType, payload, payloadLen, transactionCallback, notificationFreeCallback);
+}
+
+void coap_SubmitRequest(CoapRequest * request, TransactionCallback callback, NotificationFreeCallback notificationFreeCallback)
+{
+    int messageType;
+    coap_address_t dst;
+    const char * path = request->path;
+
+    switch (request->type)
+    {
+        case COAP_GET_REQUEST:
+            messageType = COAP_REQUEST_GET;
+            break;
+        case COAP_PUT_REQUEST:
+            messageType = COAP_REQUEST_PUT;
+            break;
+        case COAP_POST_REQUEST:
+            messageType = COAP_REQUEST_POST;
+            break;
+        case COAP_DELETE_REQUEST:
+            messageType = COAP_REQUEST_DELETE;
+            break;
+        case COAP_OBSERVE_REQUEST:
+            messageType = COAP_REQUEST_GET | COAP_MESSAGE_OBSERVE;
+            break;
+        case COAP_CANCEL_OBSERVE_REQUEST:
+            messageType = COAP_REQUEST_GET | COAP_MESSAGE_CANCEL_OBSERVE;
+            break;
+        default:
+            Lwm2m_Error("Unsupported request type %d\n", request->type);
+            return;
+    }
+
+    coap_address_init(&dst);
+    memcpy(&dst.addr, &request->addr.Addr, sizeof(request->addr.Addr));
+    dst.size = (request->addr.Addr.Sa.sa_family == AF_INET6) ? sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+
+    while (*path == '/')
+    {
+        path++;
+    }
+
+    // sin_port and sin6_port are at the same offset
+    sendRequest(messageType, request->ctxt, NULL, 0, &dst, ntohs(request->addr.Addr.Sin.sin_port), path, strlen(path),
+                request->query, (request->query != NULL) ? strlen(request->query) : 0, request->contentType,
+                request->requestContent, request->requestContentLen, callback, notificationFreeCallback);
 }
 
 void coap_PostRequest(void * context, const char * path, AwaContentType contentType, const char * payload, int payloadLen, TransactionCallback callback)
@@ -1153,8 +1206,35 @@ CoapInfo * coap_Init(const char * ipAddress, int port, bool secure, int logLevel
 
     ListInit(&transactionCallbackList);
     ListInit(&notifyCallbackList);
+    if (CoapExchangeIndex_Init(&exchanges) != 0)
+    {
+        goto error;
+    }
 
     return &coapInfo;
+
+error:
+    Lwm2m_Error("Failed to allocate memory for CoAP transactions\n");
+    coap_free_context(coapContext);
+    coapContext = NULL;
+    return NULL;
+}
+
+CoapInfo * coap_InitShared(const char * ipAddress, int port, bool secure, int logLevel)
+{
+    // libcoap binds its own socket, so the port cannot be shared
+    (void)ipAddress;
+    (void)port;
+    (void)secure;
+    (void)logLevel;
+    Lwm2m_Error("Shared CoAP ports are not supported with libcoap\n");
+    return NULL;
+}
+
+bool coap_SetBatchSize(int batchSize)
+{
+    // libcoap reads and sends on its own socket
+    return batchSize == 1;
 }
 
 void coap_SetCertificate(const uint8_t * cert, int certLength, AwaCertificateFormat format)
@@ -1171,6 +1251,16 @@ void coap_SetPSK(const char * identity, const uint8_t * key, int keyLength)
     (void)keyLength;
 }
 
+void coap_SetKeyStore(DTLS_KeyStore * keyStore)
+{
+    (void)keyStore;
+}
+
+bool coap_SetHandshakeWorkers(int workers)
+{
+    return workers == 0;
+}
+
 void coap_SetLogLevel(int logLevel)
 {
     coap_set_log_level(logLevel);
@@ -1206,6 +1296,8 @@ static void DestroyLists(void)
             free(notify);
         }
     }
+
+    CoapExchangeIndex_Destroy(&exchanges);
 }
 
 int coap_Destroy(void)
@@ -0,0 +1,137 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+#include <string.h>
+
+#include "coap_exchange_index.h"
+#include "lwm2m_util.h"
+
+static uint32_t HashObservation(AddressType * address, const void * token, int tokenLength)
+{
+    return HashTable_HashBytes(Lwm2mCore_HashAddress(address), token, tokenLength);
+}
+
+int CoapExchangeIndex_Init(CoapExchangeIndex * index)
+{
+    if (index == NULL)
+    {
+        return -1;
+    }
+    memset(index, 0, sizeof(*index));
+    if (HashTable_Init(&index->Transactions, 0) != 0)
+    {
+        return -1;
+    }
+    if (HashTable_Init(&index->Observations, 0) != 0)
+    {
+        HashTable_Destroy(&index->Transactions);
+        return -1;
+    }
+    return 0;
+}
+
+void CoapExchangeIndex_Destroy(CoapExchangeIndex * index)
+{
+    if (index != NULL)
+    {
+        HashTable_Destroy(&index->Transactions);
+        HashTable_Destroy(&index->Observations);
+    }
+}
+
+int CoapExchangeIndex_AddTransaction(CoapExchangeIndex * index, CoapTransactionEntry * entry, int transactionID)
+{
+    if (CoapExchangeIndex_GetTransaction(index, transactionID) != NULL)
+    {
+        return -1;
+    }
+    entry->TransactionID = transactionID;
+    HashTable_Add(&index->Transactions, &entry->Entry, HashTable_HashInt((uint32_t)transactionID));
+    return 0;
+}
+
+CoapTransactionEntry * CoapExchangeIndex_GetTransaction(CoapExchangeIndex * index, int transactionID)
+{
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &index->Transactions, HashTable_HashInt((uint32_t)transactionID))
+    {
+        CoapTransactionEntry * transaction = HashTableContainer(entry, CoapTransactionEntry, Entry);
+        if (transaction->TransactionID == transactionID)
+        {
+            return transaction;
+        }
+    }
+    return NULL;
+}
+
+void CoapExchangeIndex_SetTransactionID(CoapExchangeIndex * index, CoapTransactionEntry * entry, int transactionID)
+{
+    if (entry->TransactionID != transactionID)
+    {
+        HashTable_Remove(&index->Transactions, &entry->Entry);
+        entry->TransactionID = transactionID;
+        HashTable_Add(&index->Transactions, &entry->Entry, HashTable_HashInt((uint32_t)transactionID));
+    }
+}
+
+void CoapExchangeIndex_RemoveTransaction(CoapExchangeIndex * index, CoapTransactionEntry * entry)
+{
+    HashTable_Remove(&index->Transactions, &entry->Entry);
+}
+
+int CoapExchangeIndex_AddObservation(CoapExchangeIndex * index, CoapObservationEntry * entry, AddressType * address,
+                                     const void * token, int tokenLength)
+{
+    if ((tokenLength < 0) || (tokenLength > COAP_EXCHANGE_MAX_TOKEN_LENGTH) ||
+        (CoapExchangeIndex_GetObservation(index, address, token, tokenLength) != NULL))
+    {
+        return -1;
+    }
+    entry->Address = *address;
+    memcpy(entry->Token, token, tokenLength);
+    entry->TokenLength = tokenLength;
+    HashTable_Add(&index->Observations, &entry->Entry, HashObservation(&entry->Address, entry->Token, tokenLength));
+    return 0;
+}
+
+CoapObservationEntry * CoapExchangeIndex_GetObservation(CoapExchangeIndex * index, AddressType * address, const void * token, int tokenLength)
+{
+    HashTableEntry * entry;
+    if ((tokenLength < 0) || (tokenLength > COAP_EXCHANGE_MAX_TOKEN_LENGTH))
+    {
+        return NULL;
+    }
+    HashTable_ForEachWithHash(entry, &index->Observations, HashObservation(address, token, tokenLength))
+    {
+        CoapObservationEntry * observation = HashTableContainer(entry, CoapObservationEntry, Entry);
+        if ((observation->TokenLength == tokenLength) && (memcmp(observation->Token, token, tokenLength) == 0) &&
+            (Lwm2mCore_CompareAddresses(&observation->Address, address) == 0))
+        {
+            return observation;
+        }
+    }
+    return NULL;
+}
+
+void CoapExchangeIndex_RemoveObservation(CoapExchangeIndex * index, CoapObservationEntry * entry)
+{
+    HashTable_Remove(&index->Observations, &entry->Entry);
+}
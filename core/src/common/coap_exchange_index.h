@@ -0,0 +1,113 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+#ifndef COAP_EXCHANGE_INDEX_H
+#define COAP_EXCHANGE_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lwm2m_hash_table.h"
+#include "lwm2m_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Outstanding exchanges of a CoAP backend: requests waiting for their response, indexed by transaction
+ *  (message) ID, and observations waiting for notifications, indexed by peer address and token. The backend
+ *  embeds an entry in its own structure and keeps ownership of it:
+ *
+ *     typedef struct {
+ *         CoapTransactionEntry Entry;
+ *         ... callback, context ...
+ *     } Transaction;
+ *
+ *     CoapExchangeIndex_AddTransaction(&exchanges, &transaction->Entry, transactionID);
+ *
+ *     CoapTransactionEntry * entry = CoapExchangeIndex_GetTransaction(&exchanges, transactionID);
+ *     Transaction * transaction = HashTableContainer(entry, Transaction, Entry);
+ *
+ *  Tokens are only unique per peer (RFC 7252, 5.3.1), so an observation is found by the token of a
+ *  notification together with the address it came from.
+ */
+
+#define COAP_EXCHANGE_MAX_TOKEN_LENGTH      (8)
+
+typedef struct
+{
+    HashTableEntry Entry;
+    int TransactionID;
+
+} CoapTransactionEntry;
+
+typedef struct
+{
+    HashTableEntry Entry;
+    AddressType Address;                            // Peer the notifications come from
+    uint8_t Token[COAP_EXCHANGE_MAX_TOKEN_LENGTH];
+    int TokenLength;
+
+} CoapObservationEntry;
+
+typedef struct
+{
+    HashTable Transactions;
+    HashTable Observations;
+
+} CoapExchangeIndex;
+
+int CoapExchangeIndex_Init(CoapExchangeIndex * index);
+
+// Release the index. Entries are owned by the caller and are not freed.
+void CoapExchangeIndex_Destroy(CoapExchangeIndex * index);
+
+// Index a transaction by its ID. Fails if another transaction has the ID.
+int CoapExchangeIndex_AddTransaction(CoapExchangeIndex * index, CoapTransactionEntry * entry, int transactionID);
+
+// Return the transaction with the ID, or NULL if there is none
+CoapTransactionEntry * CoapExchangeIndex_GetTransaction(CoapExchangeIndex * index, int transactionID);
+
+// Change the ID of a transaction, such as when a retransmission is sent with a new ID
+void CoapExchangeIndex_SetTransactionID(CoapExchangeIndex * index, CoapTransactionEntry * entry, int transactionID);
+
+// Remove a transaction. Removing a zero-initialised or already removed entry has no effect.
+void CoapExchangeIndex_RemoveTransaction(CoapExchangeIndex * index, CoapTransactionEntry * entry);
+
+/* Index an observation by peer address and token. Fails if the token is longer than COAP_EXCHANGE_MAX_TOKEN_LENGTH,
+ * or if the peer already has an observation with the token.
+ */
+int CoapExchangeIndex_AddObservation(CoapExchangeIndex * index, CoapObservationEntry * entry, AddressType * address,
+                                     const void * token, int tokenLength);
+
+// Return the observation of the peer with the token, or NULL if there is none
+CoapObservationEntry * CoapExchangeIndex_GetObservation(CoapExchangeIndex * index, AddressType * address, const void * token, int tokenLength);
+
+// Remove an observation. Removing a zero-initialised or already removed entry has no effect.
+void CoapExchangeIndex_RemoveObservation(CoapExchangeIndex * index, CoapObservationEntry * entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COAP_EXCHANGE_INDEX_H
@@ -33,6 +33,11 @@ extern "C" {
 #endif
 
 #include "network_abstraction.h"
+#include "dtls_session_table.h"
+#include "dtls_resumption_cache.h"
+#include "dtls_cookie.h"
+#include "dtls_keystore.h"
+#include "dtls_handshake_pool.h"
 
 typedef enum
 {
@@ -49,22 +54,60 @@ typedef NetworkTransmissionError (*DTLS_NetworkSendCallback)(NetworkAddress * de
 
 extern const char * DTLS_LibraryName;
 
+// Most bytes a record adds to its plain text: header, explicit IV or nonce, MAC or tag, and block padding
+#define DTLS_MAX_RECORD_OVERHEAD    (128)
+
 void DTLS_Init(void);
 
 void DTLS_Shutdown(void);
 
+// decryptBuffer may be encrypted, to decrypt the record in place
 bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encryptedLength, uint8_t * decryptBuffer, int decryptBufferLength, int * decryptedLength, void *context);
 
+/* Encrypt plainText into a record of at most plainTextLength + DTLS_MAX_RECORD_OVERHEAD bytes. encryptedBuffer may
+ * be plainText, to encrypt in place.
+ */
 bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTextLength, uint8_t * encryptedBuffer, int encryptedBufferLength, int * encryptedLength, void *context);
 
 void DTLS_Reset(NetworkAddress * address);
 
 void DTLS_SetCertificate(const uint8_t * cert, int certLength, AwaCertificateFormat format);
 
+// The callback is also called from handshake workers, see DTLS_SetHandshakeWorkers
 void DTLS_SetNetworkSendCallback(DTLS_NetworkSendCallback sendCallback);
 
 void DTLS_SetPSK(const char * identity, const uint8_t * key, int keyLength);
 
+/* Look up the key of the identity each client presents to a server in store, instead of using the key set with
+ * DTLS_SetPSK for every identity. The store is not copied, and NULL removes it.
+ */
+void DTLS_SetKeyStore(DTLS_KeyStore * store);
+
+// Limit the number and estimated memory of the sessions, and free sessions idle for idleTimeout milliseconds (0 disables a limit). Call after DTLS_Init.
+void DTLS_SetSessionLimits(uint32_t maxSessions, size_t maxMemory, uint32_t idleTimeout);
+
+void DTLS_GetSessionStatistics(DTLS_SessionTableStatistics * statistics);
+
+// Keep up to maxEntries earlier sessions that peers can resume within lifetime milliseconds (0 disables a limit). Call after DTLS_Init.
+void DTLS_SetResumptionLimits(uint32_t maxEntries, uint32_t lifetime);
+
+void DTLS_GetResumptionStatistics(DTLS_ResumptionCacheStatistics * statistics);
+
+// Cookie exchanges with peers that have no session yet (all zero for libraries that exchange cookies themselves)
+void DTLS_GetCookieStatistics(DTLS_CookieStatistics * statistics);
+
+/* Run the handshakes of sessions with clients on workers threads (0 runs them inline again), so that a burst of
+ * handshakes does not delay the records of established sessions. Workers send handshake records with the network
+ * send callback, and look up keys in the key store, so both must be thread-safe. Returns -1 if the library does not
+ * support handshake workers. Call after DTLS_Init.
+ */
+int DTLS_SetHandshakeWorkers(unsigned int workers);
+
+void DTLS_GetHandshakeStatistics(DTLS_HandshakePoolStatistics * statistics);
+
+// Whether the calling thread is a handshake worker
+bool DTLS_IsHandshakeWorker(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include "lwm2m_debug.h"
+#include "lwm2m_util.h"
 #include "dtls_abstraction.h"
 
 #ifndef CYASSL_DTLS
@@ -44,7 +45,7 @@
 
 typedef struct
 {
-    NetworkAddress * NetworkAddress;
+    DTLS_SessionEntry Entry;
     CYASSL * Session;
     CYASSL_CTX * Context;
     bool SessionEstablished;
@@ -54,13 +55,12 @@ typedef struct
     int BufferLength;
 }DTLS_Session;
 
-#ifndef MAX_DTLS_SESSIONS
-    #define MAX_DTLS_SESSIONS 3
-#endif
+// Rough estimate of the record buffers and handshake state CyaSSL allocates per session
+#define CYASSL_SESSION_MEMORY (20 * 1024)
 
 const char * DTLS_LibraryName = "CyaSSL";
 
-static DTLS_Session sessions[MAX_DTLS_SESSIONS];
+static DTLS_SessionTable sessions;
 
 static uint8_t * certificate = NULL;
 static int certificateLength = 0;
@@ -70,12 +70,16 @@ static const char * pskIdentity = NULL;
 static const uint8_t * pskKey = NULL;
 static int pskKeyLength = 0;
 
+// Keys of the identities clients present to the server, if not pskKey for all
+static DTLS_KeyStore * keyStore = NULL;
+
 static DTLS_NetworkSendCallback NetworkSend = NULL;
 
 static DTLS_Session * AllocateSession(NetworkAddress * address, bool client, void * context);
 static DTLS_Session * GetSession(NetworkAddress * address);
 static void FreeSession(DTLS_Session * session);
-static void SetupNewSession(int index, NetworkAddress * networkAddress, bool client);
+static void FreeSessionEntry(DTLS_SessionEntry * entry);
+static DTLS_Session * SetupNewSession(NetworkAddress * networkAddress, bool client);
 static int DecryptCallBack(CYASSL *sslSessioon, char *recieveBuffer, int receiveBufferLegth, void *vp);
 static int EncryptCallBack(CYASSL *sslSessioon, char *sendBuffer, int sendBufferLength, void *vp);
 static unsigned int PSKCallBack(CYASSL *sslSession, const char* hint, char* identity, unsigned int id_max_len, unsigned char* key, unsigned int key_max_len);
@@ -145,7 +149,7 @@ void WOLFSSL_BUFFER(byte* buffer, word32 length)
 
 void DTLS_Init(void)
 {
-    memset(sessions,0,sizeof(DTLS_Session) * MAX_DTLS_SESSIONS);
+    DTLS_SessionTable_Init(&sessions, sizeof(DTLS_Session), CYASSL_SESSION_MEMORY, FreeSessionEntry);
     CyaSSL_Init();
 #ifdef DEBUG_WOLFSSL
     CyaSSL_Debugging_ON();
@@ -156,14 +160,7 @@ void DTLS_Init(void)
 
 void DTLS_Shutdown(void)
 {
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
-    {
-        if (sessions[index].Context)
-        {
-            FreeSession(&sessions[index]);
-        }
-    }
+    DTLS_SessionTable_Destroy(&sessions);
     CyaSSL_Cleanup();
 }
 
@@ -202,6 +199,52 @@ void DTLS_SetPSK(const char * identity, const uint8_t * key, int keyLength)
     }
 }
 
+void DTLS_SetKeyStore(DTLS_KeyStore * store)
+{
+    keyStore = store;
+}
+
+void DTLS_SetSessionLimits(uint32_t maxSessions, size_t maxMemory, uint32_t idleTimeout)
+{
+    DTLS_SessionTable_SetLimits(&sessions, maxSessions, maxMemory, idleTimeout);
+}
+
+void DTLS_GetSessionStatistics(DTLS_SessionTableStatistics * statistics)
+{
+    DTLS_SessionTable_GetStatistics(&sessions, statistics);
+}
+
+// Sessions are not resumed with CyaSSL
+void DTLS_SetResumptionLimits(uint32_t maxEntries, uint32_t lifetime)
+{
+    (void)maxEntries;
+    (void)lifetime;
+}
+
+void DTLS_GetResumptionStatistics(DTLS_ResumptionCacheStatistics * statistics)
+{
+    DTLS_ResumptionCache_GetStatistics(NULL, statistics);
+}
+
+void DTLS_GetCookieStatistics(DTLS_CookieStatistics * statistics)
+{
+    DTLS_CookieVerifier_GetStatistics(NULL, statistics);
+}
+
+int DTLS_SetHandshakeWorkers(unsigned int workers)
+{
+    return (workers == 0) ? 0 : -1;
+}
+
+void DTLS_GetHandshakeStatistics(DTLS_HandshakePoolStatistics * statistics)
+{
+    memset(statistics, 0, sizeof(DTLS_HandshakePoolStatistics));
+}
+
+bool DTLS_IsHandshakeWorker(void)
+{
+    return false;
+}
 
 bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encryptedLength, uint8_t * decryptBuffer, int decryptBufferLength, int * decryptedLength, void *context)
 {
@@ -220,6 +263,10 @@ bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encry
         {
             *decryptedLength = CyaSSL_read(session->Session, decryptBuffer, decryptBufferLength);
             result = (*decryptedLength > 0);
+            if (result)
+            {
+                DTLS_SessionTable_AddDecrypted(&session->Entry, *decryptedLength);
+            }
         }
         else
         {
@@ -250,10 +297,16 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
             session->Buffer = encryptedBuffer;
             session->BufferLength = encryptedBufferLength;
             int written = CyaSSL_write(session->Session, plainText, plainTextLength);
+            // anything CyaSSL sends outside a write, such as the close notify, goes to the peer rather than this buffer
+            CyaSSL_SetIOSend(session->Context, SSLSendCallBack);
             if (written >= 0)
             {
                 *encryptedLength = encryptedBufferLength - session->BufferLength;
                 result = (*encryptedLength > 0);
+                if (result)
+                {
+                    DTLS_SessionTable_AddEncrypted(&session->Entry, plainTextLength);
+                }
             }
         }
         else
@@ -283,18 +336,11 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
 
 static DTLS_Session * AllocateSession(NetworkAddress * address, bool client, void * context)
 {
-    DTLS_Session * result = NULL;
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+    DTLS_Session * result = SetupNewSession(address, client);
+    if (result)
     {
-        if (!sessions[index].Context)
-        {
-            SetupNewSession(index, address, client);
-            sessions[index].UserContext = context;
-            CyaSSL_SetIOSend(sessions[index].Context, SSLSendCallBack);
-            result = &sessions[index];
-            break;
-        }
+        result->UserContext = context;
+        CyaSSL_SetIOSend(result->Context, SSLSendCallBack);
     }
     return result;
 }
@@ -302,14 +348,10 @@ static DTLS_Session * AllocateSession(NetworkAddress * address, bool client, voi
 static DTLS_Session * GetSession(NetworkAddress * address)
 {
     DTLS_Session * result = NULL;
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+    DTLS_SessionEntry * entry = DTLS_SessionTable_Get(&sessions, address, Lwm2mCore_GetTickCountMs());
+    if (entry)
     {
-        if (NetworkAddress_Compare(sessions[index].NetworkAddress,address) == 0)
-        {
-            result = &sessions[index];
-            break;
-        }
+        result = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
     }
     return result;
 }
@@ -318,24 +360,33 @@ static void FreeSession(DTLS_Session * session)
 {
     if (session)
     {
-        if (session->Session)
-        {
-            CyaSSL_shutdown(session->Session);
-            CyaSSL_free(session->Session);
-        }
-        if (session->Context)
-        {
-            CyaSSL_CTX_free(session->Context);
-        }
-        memset(session,0, sizeof(DTLS_Session));
+        DTLS_SessionTable_Free(&sessions, &session->Entry);
+    }
+}
+
+static void FreeSessionEntry(DTLS_SessionEntry * entry)
+{
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
+    if (session->Session)
+    {
+        CyaSSL_shutdown(session->Session);
+        CyaSSL_free(session->Session);
+    }
+    if (session->Context)
+    {
+        CyaSSL_CTX_free(session->Context);
     }
 }
 
 
-static void SetupNewSession(int index, NetworkAddress * networkAddress, bool client)
+static DTLS_Session * SetupNewSession(NetworkAddress * networkAddress, bool client)
 {
-    DTLS_Session * session = &sessions[index];
-    session->NetworkAddress = networkAddress;
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&sessions, networkAddress, Lwm2mCore_GetTickCountMs());
+    if (!entry)
+    {
+        return NULL;
+    }
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
     session->Client = client;
     if (client)
         session->Context =  CyaSSL_CTX_new(CyaDTLSv1_2_client_method());
@@ -372,21 +423,23 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
             CyaSSL_CTX_use_certificate_buffer(session->Context, certificatePart, certificatePartLength, format);
             CyaSSL_CTX_use_PrivateKey_buffer(session->Context, privateKey, privateKeyLength, format);
         }
-        if (pskIdentity)
+        bool psk = (pskIdentity != NULL) || (!client && (keyStore != NULL));
+        if (psk)
         {
             if (client)
                 CyaSSL_CTX_set_psk_client_callback(session->Context, PSKCallBack);
             else
             {
                 CyaSSL_CTX_set_psk_server_callback(session->Context, ServerPSKCallBack);
-                CyaSSL_CTX_use_psk_identity_hint(session->Context, pskIdentity);
+                if (pskIdentity)
+                    CyaSSL_CTX_use_psk_identity_hint(session->Context, pskIdentity);
             }
         }
-        if (certificate &&  pskIdentity)
+        if (certificate &&  psk)
             CyaSSL_CTX_set_cipher_list(session->Context, CERTCIPHERSUITES ":" PSKCIPHERSUITES );
         else if (certificate)
             CyaSSL_CTX_set_cipher_list(session->Context, CERTCIPHERSUITES);
-        else if (pskIdentity)
+        else if (psk)
             CyaSSL_CTX_set_cipher_list(session->Context, PSKCIPHERSUITES);
 //        if (caCertificate)
 //        {
@@ -399,19 +452,26 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
         if (session->Session)
         {
             CyaSSL_dtls_set_peer(session->Session, networkAddress, sizeof(struct sockaddr_storage));
-            CyaSSL_set_fd(session->Session, index);
+            CyaSSL_SetIOReadCtx(session->Session, session);
+            CyaSSL_SetIOWriteCtx(session->Session, session);
             CyaSSL_set_using_nonblock(session->Session, 1);
             CyaSSL_SetIORecv(session->Context, DecryptCallBack);
         }
     }
+    if (!session->Session)
+    {
+        FreeSession(session);
+        session = NULL;
+    }
+    return session;
 }
 
 
 static int DecryptCallBack(CYASSL *sslSessioon, char *recieveBuffer, int receiveBufferLegth, void *vp)
 {
     int result;
-    int index = CyaSSL_get_fd(sslSessioon);
-    DTLS_Session * session = &sessions[index];
+    (void)sslSessioon;
+    DTLS_Session * session = (DTLS_Session *)vp;
     if (session->BufferLength > 0)
     {
         if (receiveBufferLegth < session->BufferLength)
@@ -436,8 +496,8 @@ static int DecryptCallBack(CYASSL *sslSessioon, char *recieveBuffer, int receive
 static int EncryptCallBack(CYASSL *sslSessioon, char *sendBuffer, int sendBufferLength, void *vp)
 {
     int result;
-    int index = CyaSSL_get_fd(sslSessioon);
-    DTLS_Session * session = &sessions[index];
+    (void)sslSessioon;
+    DTLS_Session * session = (DTLS_Session *)vp;
     if (session->BufferLength > 0)
     {
         if (sendBufferLength < session->BufferLength)
@@ -461,6 +521,16 @@ static int EncryptCallBack(CYASSL *sslSessioon, char *sendBuffer, int sendBuffer
 
 static unsigned int ServerPSKCallBack(WOLFSSL *sslSessioon, const char* identity, unsigned char* key, unsigned int key_max_len)
 {
+    if (keyStore)
+    {
+        int keyLength = DTLS_KeyStore_Lookup(keyStore, identity, strlen(identity), key, key_max_len);
+        if (keyLength < 0)
+        {
+            Lwm2m_Debug("Unknown PSK identity %s\n", identity);
+            return 0;
+        }
+        return keyLength;
+    }
     memcpy(key, pskKey, pskKeyLength);
     return pskKeyLength;
 }
@@ -478,11 +548,11 @@ static unsigned int PSKCallBack(CYASSL *sslSession, const char* hint, char* iden
 static int SSLSendCallBack(CYASSL *sslSessioon, char *sendBuffer, int sendBufferLength, void *vp)
 {
     int result;
-    int index = CyaSSL_get_fd(sslSessioon);
-    DTLS_Session * session = &sessions[index];
+    (void)sslSessioon;
+    DTLS_Session * session = (DTLS_Session *)vp;
     if (NetworkSend)
     {
-        NetworkTransmissionError error = NetworkSend(session->NetworkAddress, sendBuffer, sendBufferLength, session->UserContext);
+        NetworkTransmissionError error = NetworkSend(session->Entry.NetworkAddress, sendBuffer, sendBufferLength, session->UserContext);
         switch(error)
         {
             case NetworkTransmissionError_None:
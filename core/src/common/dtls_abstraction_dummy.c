@@ -60,6 +60,54 @@ void DTLS_SetPSK(const char * identity, const uint8_t * key, int keyLength)
 	(void)keyLength;
 }
 
+void DTLS_SetKeyStore(DTLS_KeyStore * store)
+{
+	(void)store;
+}
+
+void DTLS_SetSessionLimits(uint32_t maxSessions, size_t maxMemory, uint32_t idleTimeout)
+{
+	(void)maxSessions;
+	(void)maxMemory;
+	(void)idleTimeout;
+}
+
+void DTLS_GetSessionStatistics(DTLS_SessionTableStatistics * statistics)
+{
+	DTLS_SessionTable_GetStatistics(NULL, statistics);
+}
+
+void DTLS_SetResumptionLimits(uint32_t maxEntries, uint32_t lifetime)
+{
+	(void)maxEntries;
+	(void)lifetime;
+}
+
+void DTLS_GetResumptionStatistics(DTLS_ResumptionCacheStatistics * statistics)
+{
+	DTLS_ResumptionCache_GetStatistics(NULL, statistics);
+}
+
+void DTLS_GetCookieStatistics(DTLS_CookieStatistics * statistics)
+{
+	DTLS_CookieVerifier_GetStatistics(NULL, statistics);
+}
+
+int DTLS_SetHandshakeWorkers(unsigned int workers)
+{
+	return (workers == 0) ? 0 : -1;
+}
+
+void DTLS_GetHandshakeStatistics(DTLS_HandshakePoolStatistics * statistics)
+{
+	memset(statistics, 0, sizeof(DTLS_HandshakePoolStatistics));
+}
+
+bool DTLS_IsHandshakeWorker(void)
+{
+	return false;
+}
+
 
 bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encryptedLength, uint8_t * decryptBuffer, int decryptBufferLength, int * decryptedLength, void *context)
 {
@@ -68,7 +116,7 @@ bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encry
     bool result = false;
     if (encryptedLength <= decryptBufferLength && encryptedLength > 0)
     {
-        memcpy(decryptBuffer, encrypted, encryptedLength);
+        memmove(decryptBuffer, encrypted, encryptedLength);
         *decryptedLength = encryptedLength;
         result = true;
     }
@@ -82,7 +130,7 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
     bool result = false;
     if (plainTextLength <= encryptedBufferLength && plainTextLength > 0)
     {
-        memcpy(encryptedBuffer, plainText, plainTextLength);
+        memmove(encryptedBuffer, plainText, plainTextLength);
         *encryptedLength = plainTextLength;
         result = true;
     }
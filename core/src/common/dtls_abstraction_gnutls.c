@@ -24,12 +24,16 @@
 #include <string.h>
 
 #include "lwm2m_debug.h"
+#include "lwm2m_util.h"
 #include "dtls_abstraction.h"
 
 #include <errno.h>
+#include <pthread.h>
 
 #include <gnutls/gnutls.h>
 #include <gnutls/x509.h>
+#include <gnutls/dtls.h>
+#include <gnutls/crypto.h>
 
 
 //GnuTLS added DTLS in 2.99.0
@@ -47,23 +51,40 @@ typedef enum
 
 typedef struct
 {
-    NetworkAddress * NetworkAddress;
+    DTLS_SessionEntry Entry;
+    DTLS_HandshakeJob Handshake;        // Owns the session while a handshake worker runs it
     gnutls_session_t Session;
     void * Credentials;
     uint8_t CredentialType;
     bool SessionEstablished;
+    bool Client;
     void * UserContext;
     uint8_t * Buffer;
     int BufferLength;
 }DTLS_Session;
 
-#ifndef MAX_DTLS_SESSIONS
-    #define MAX_DTLS_SESSIONS 3
-#endif
+// Rough estimate of the record buffers and handshake state GnuTLS allocates per session
+#define GNUTLS_SESSION_MEMORY (20 * 1024)
+
+// GnuTLS does not accept resumption state older than 7 days
+#define GNUTLS_MAX_RESUMPTION_LIFETIME (7 * 24 * 60 * 60)
+
+#define CONTENT_TYPE_APPLICATION_DATA (23)
 
 const char * DTLS_LibraryName = "GnuTLS";
 
-static DTLS_Session sessions[MAX_DTLS_SESSIONS];
+static DTLS_SessionTable sessions;
+
+// Server sessions by session ID, and client sessions by server address
+static DTLS_ResumptionCache resumptionCache;
+static pthread_mutex_t resumptionLock = PTHREAD_MUTEX_INITIALIZER;     // Handshake workers store and fetch server sessions
+static gnutls_datum_t ticketKey;
+
+// Runs server handshakes, if not NULL
+static DTLS_HandshakePool * handshakePool = NULL;
+
+// Peers without a session must return a cookie before the server creates one
+static DTLS_CookieVerifier cookieVerifier;
 
 static uint8_t * certificate = NULL;
 static int certificateLength = 0;
@@ -73,6 +94,9 @@ static const char * pskIdentity = NULL;
 
 static  gnutls_datum_t pskKey;
 
+// Keys of the identities clients present to the server, if not pskKey for all
+static DTLS_KeyStore * keyStore = NULL;
+
 static  DTLS_NetworkSendCallback NetworkSend = NULL;
 
 //Comment out as init of DH params takes a while
@@ -82,8 +106,18 @@ static gnutls_certificate_credentials_t _CertCredentials = NULL;
 
 
 static DTLS_Session * GetSession(NetworkAddress * address);
-static void SetupNewSession(int index, NetworkAddress * networkAddress, bool client);
+static DTLS_Session * SetupNewSession(NetworkAddress * networkAddress, bool client);
 static void FreeSession(DTLS_Session * session);
+static bool Handshake(DTLS_Session * session);
+static DTLS_HandshakeResult HandshakeStep(DTLS_HandshakeJob * job, uint8_t * datagram, size_t length);
+static bool OffloadHandshake(DTLS_Session * session);
+static void CollectHandshakes(void);
+static int StoreResumptionState(void * context, gnutls_datum_t key, gnutls_datum_t data);
+static gnutls_datum_t FetchResumptionState(void * context, gnutls_datum_t key);
+static int RemoveResumptionState(void * context, gnutls_datum_t key);
+static void FreeSessionEntry(DTLS_SessionEntry * entry);
+static int CookieRandom(uint8_t * buffer, size_t length);
+static bool VerifyClientHello(NetworkAddress * sourceAddress, uint8_t * datagram, int datagramLength, DTLS_ClientHello * hello, void * context);
 static ssize_t DecryptCallBack(gnutls_transport_ptr_t context, void *recieveBuffer, size_t receiveBufferLegth);
 static ssize_t EncryptCallBack(gnutls_transport_ptr_t context, const void * sendBuffer,size_t sendBufferLength);
 static int PSKClientCallBack(gnutls_session_t session, char **username, gnutls_datum_t * key);
@@ -98,8 +132,15 @@ static int CertificateVerify(gnutls_session_t session);
 
 void DTLS_Init(void)
 {
-    memset(sessions,0,sizeof(DTLS_Session) * MAX_DTLS_SESSIONS);
+    DTLS_SessionTable_Init(&sessions, sizeof(DTLS_Session), GNUTLS_SESSION_MEMORY, FreeSessionEntry);
+    DTLS_ResumptionCache_Init(&resumptionCache);
+    DTLS_CookieVerifier_Init(&cookieVerifier, CookieRandom);
     gnutls_global_init();
+    if (gnutls_session_ticket_key_generate(&ticketKey) != GNUTLS_E_SUCCESS)
+    {
+        Lwm2m_Warning("Failed to generate DTLS session ticket key, sessions are only resumed by session ID\n");
+        memset(&ticketKey, 0, sizeof(ticketKey));
+    }
     //    unsigned int bits = gnutls_sec_param_to_pk_bits(GNUTLS_PK_DH, GNUTLS_SEC_PARAM_LEGACY);
     //    gnutls_dh_params_init(&_DHParameters);
     //    gnutls_dh_params_generate2(_DHParameters, bits);
@@ -112,13 +153,15 @@ void DTLS_Init(void)
 
 void DTLS_Shutdown(void)
 {
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+    DTLS_HandshakePool_Free(&handshakePool);
+    DTLS_SessionTable_Destroy(&sessions);
+    DTLS_ResumptionCache_Destroy(&resumptionCache);
+    DTLS_CookieVerifier_Destroy(&cookieVerifier);
+    if (ticketKey.data)
     {
-        if (sessions[index].Session)
-        {
-            FreeSession(&sessions[index]);
-        }
+        memset(ticketKey.data, 0, ticketKey.size);
+        gnutls_free(ticketKey.data);
+        memset(&ticketKey, 0, sizeof(ticketKey));
     }
     if (_CertCredentials)
     {
@@ -132,7 +175,9 @@ void DTLS_Shutdown(void)
 
 void DTLS_Reset(NetworkAddress * address)
 {
-    DTLS_Session * session = GetSession(address);
+    DTLS_Session * session;
+    CollectHandshakes();
+    session = GetSession(address);
     if (session)
     {
         FreeSession(session);
@@ -164,48 +209,137 @@ void DTLS_SetPSK(const char * identity, const uint8_t * key, int keyLength)
     }
 }
 
+void DTLS_SetKeyStore(DTLS_KeyStore * store)
+{
+    keyStore = store;
+}
+
+void DTLS_SetSessionLimits(uint32_t maxSessions, size_t maxMemory, uint32_t idleTimeout)
+{
+    DTLS_SessionTable_SetLimits(&sessions, maxSessions, maxMemory, idleTimeout);
+}
+
+void DTLS_GetSessionStatistics(DTLS_SessionTableStatistics * statistics)
+{
+    DTLS_SessionTable_GetStatistics(&sessions, statistics);
+}
+
+void DTLS_SetResumptionLimits(uint32_t maxEntries, uint32_t lifetime)
+{
+    pthread_mutex_lock(&resumptionLock);
+    DTLS_ResumptionCache_SetLimits(&resumptionCache, maxEntries, lifetime);
+    pthread_mutex_unlock(&resumptionLock);
+}
+
+void DTLS_GetResumptionStatistics(DTLS_ResumptionCacheStatistics * statistics)
+{
+    pthread_mutex_lock(&resumptionLock);
+    DTLS_ResumptionCache_GetStatistics(&resumptionCache, statistics);
+    pthread_mutex_unlock(&resumptionLock);
+}
+
+void DTLS_GetCookieStatistics(DTLS_CookieStatistics * statistics)
+{
+    DTLS_CookieVerifier_GetStatistics(&cookieVerifier, statistics);
+}
+
+int DTLS_SetHandshakeWorkers(unsigned int workers)
+{
+    // sessions handshaking on the old workers carry on inline, or on the new workers with their next record
+    DTLS_HandshakePool_Free(&handshakePool);
+    if (workers > 0)
+    {
+        handshakePool = DTLS_HandshakePool_New(workers, HandshakeStep);
+        if (!handshakePool)
+            return -1;
+    }
+    return 0;
+}
+
+void DTLS_GetHandshakeStatistics(DTLS_HandshakePoolStatistics * statistics)
+{
+    DTLS_HandshakePool_GetStatistics(handshakePool, statistics);
+}
+
+bool DTLS_IsHandshakeWorker(void)
+{
+    return DTLS_HandshakePool_IsWorker();
+}
+
 
 bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encryptedLength, uint8_t * decryptBuffer, int decryptBufferLength, int * decryptedLength, void *context)
 {
     bool result = false;
-    DTLS_Session * session = GetSession(sourceAddress);
+    DTLS_Session * session;
+
+    CollectHandshakes();
+    session = GetSession(sourceAddress);
+
     if (session)
     {
-        session->Buffer = encrypted;
-        session->BufferLength = encryptedLength;
         if (session->SessionEstablished)
         {
+            session->Buffer = encrypted;
+            session->BufferLength = encryptedLength;
             *decryptedLength = gnutls_read(session->Session, decryptBuffer, decryptBufferLength);
             result = (*decryptedLength > 0);
-            if (!result)
+            if (result)
+            {
+                DTLS_SessionTable_AddDecrypted(&session->Entry, *decryptedLength);
+            }
+            else
             {
                 FreeSession(session);
                 session = NULL;
             }
         }
+        else if (OffloadHandshake(session))
+        {
+            // application data sent as soon as the peer finished the handshake may arrive before the worker has, and
+            // is dropped rather than waiting for the worker: the peer retransmits it, and CollectHandshakes
+            // establishes the session in the meantime
+            *decryptedLength = 0;
+            if (encrypted[0] != CONTENT_TYPE_APPLICATION_DATA)
+                DTLS_HandshakePool_Submit(handshakePool, &session->Handshake, encrypted, encryptedLength);
+        }
         else
         {
             *decryptedLength = 0;
-            session->SessionEstablished = (gnutls_handshake(session->Session) == GNUTLS_E_SUCCESS);
+            session->Buffer = encrypted;
+            session->BufferLength = encryptedLength;
+            session->SessionEstablished = Handshake(session);
             if (session->SessionEstablished)
                 Lwm2m_Info("Session established");
         }
     }
 
-    if (!session)
+    DTLS_ClientHello hello;
+    if (!session && VerifyClientHello(sourceAddress, encrypted, encryptedLength, &hello, context))
     {
-        int index;
-        for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+        session = SetupNewSession(sourceAddress, false);
+        if (session)
         {
-            if (!sessions[index].Session)
+#if GNUTLS_VERSION_MAJOR >= 3
+            // continue the handshake from the ClientHello that returned the cookie
+            gnutls_dtls_prestate_st prestate;
+            memset(&prestate, 0, sizeof(prestate));
+            prestate.record_seq = hello.RecordSequence;
+            prestate.hsk_read_seq = hello.MessageSequence;
+            prestate.hsk_write_seq = 0;
+            gnutls_dtls_prestate_set(session->Session, &prestate);
+#endif
+            session->UserContext = context;
+            gnutls_transport_set_push_function(session->Session, SSLSendCallBack);
+            if (OffloadHandshake(session))
             {
-                SetupNewSession(index, sourceAddress, false);
-                sessions[index].UserContext = context;
-                gnutls_transport_set_push_function(sessions[index].Session, SSLSendCallBack);
-                sessions[index].Buffer = encrypted;
-                sessions[index].BufferLength = encryptedLength;
-                sessions[index].SessionEstablished = (gnutls_handshake(sessions[index].Session) == GNUTLS_E_SUCCESS);
-                break;
+                if (DTLS_HandshakePool_Submit(handshakePool, &session->Handshake, encrypted, encryptedLength) != 0)
+                    FreeSession(session);
+            }
+            else
+            {
+                session->Buffer = encrypted;
+                session->BufferLength = encryptedLength;
+                session->SessionEstablished = Handshake(session);
             }
         }
     }
@@ -215,7 +349,10 @@ bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encry
 bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTextLength, uint8_t * encryptedBuffer, int encryptedBufferLength, int * encryptedLength, void *context)
 {
     bool result = false;
-    DTLS_Session * session = GetSession(destAddress);
+    DTLS_Session * session;
+
+    CollectHandshakes();
+    session = GetSession(destAddress);
     if (session)
     {
         if (session->SessionEstablished)
@@ -228,31 +365,68 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
             {
                 *encryptedLength = encryptedBufferLength - session->BufferLength;
                 result = (*encryptedLength > 0);
+                if (result)
+                {
+                    DTLS_SessionTable_AddEncrypted(&session->Entry, plainTextLength);
+                }
+            }
+        }
+        else if (OffloadHandshake(session))
+        {
+            // an empty datagram has the worker retransmit, unless it is already busy with the session
+            if (!DTLS_HandshakeJob_IsActive(&session->Handshake))
+            {
+                session->UserContext = context;
+                DTLS_HandshakePool_Submit(handshakePool, &session->Handshake, NULL, 0);
             }
         }
         else
         {
             session->UserContext = context;
             gnutls_transport_set_push_function(session->Session, SSLSendCallBack);
-            session->SessionEstablished = (gnutls_handshake(session->Session) == GNUTLS_E_SUCCESS);
+            session->SessionEstablished = Handshake(session);
             if (session->SessionEstablished)
                 Lwm2m_Info("DTLS Session established\n");
         }
     }
     else
     {
-        int index;
-        for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+        session = SetupNewSession(destAddress, true);
+        if (session)
         {
-            if (!sessions[index].Session)
+            session->UserContext = context;
+            gnutls_transport_set_push_function(session->Session, SSLSendCallBack);
+            session->SessionEstablished = Handshake(session);
+        }
+    }
+    return result;
+}
+
+static int CookieRandom(uint8_t * buffer, size_t length)
+{
+    return (gnutls_rnd(GNUTLS_RND_KEY, buffer, length) == 0) ? 0 : -1;
+}
+
+// Answer a ClientHello without a valid cookie with a HelloVerifyRequest. Returns true if the peer may have a session.
+static bool VerifyClientHello(NetworkAddress * sourceAddress, uint8_t * datagram, int datagramLength, DTLS_ClientHello * hello, void * context)
+{
+    bool result = false;
+    uint8_t response[DTLS_HELLO_VERIFY_REQUEST_LENGTH];
+    size_t responseLength = 0;
+    switch (DTLS_CookieVerifier_CheckClientHello(&cookieVerifier, sourceAddress, datagram, datagramLength, hello,
+            response, sizeof(response), &responseLength, Lwm2mCore_GetTickCountMs()))
+    {
+        case DTLS_CookieResult_Verified:
+            result = true;
+            break;
+        case DTLS_CookieResult_HelloVerify:
+            if (NetworkSend)
             {
-                SetupNewSession(index, destAddress, true);
-                sessions[index].UserContext = context;
-                gnutls_transport_set_push_function(sessions[index].Session, SSLSendCallBack);
-                sessions[index].SessionEstablished = (gnutls_handshake(sessions[index].Session) == GNUTLS_E_SUCCESS);
-                break;
+                NetworkSend(sourceAddress, response, responseLength, context);
             }
-        }
+            break;
+        default:
+            break;
     }
     return result;
 }
@@ -260,22 +434,25 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
 static DTLS_Session * GetSession(NetworkAddress * address)
 {
     DTLS_Session * result = NULL;
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+    DTLS_SessionEntry * entry = DTLS_SessionTable_Get(&sessions, address, Lwm2mCore_GetTickCountMs());
+    if (entry)
     {
-        if (NetworkAddress_Compare(sessions[index].NetworkAddress,address) == 0)
-        {
-            result = &sessions[index];
-            break;
-        }
+        result = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
     }
     return result;
 }
 
-static void SetupNewSession(int index, NetworkAddress * networkAddress, bool client)
+static DTLS_Session * SetupNewSession(NetworkAddress * networkAddress, bool client)
 {
-    DTLS_Session * session = &sessions[index];
-    session->NetworkAddress = networkAddress;
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&sessions, networkAddress, Lwm2mCore_GetTickCountMs());
+    if (!entry)
+    {
+        return NULL;
+    }
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
+    DTLS_HandshakeJob_Init(&session->Handshake);
+    session->Client = client;
+    bool psk = (pskIdentity != NULL) || (!client && (keyStore != NULL));
     unsigned int flags;
 #if GNUTLS_VERSION_MAJOR >= 3
     if (client)
@@ -297,7 +474,7 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
 #endif
         gnutls_transport_set_ptr(session->Session, session);
 
-        if (certificate || !pskIdentity)
+        if (certificate || !psk)
         {
             if (_CertCredentials)
             {
@@ -328,7 +505,7 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
                 gnutls_credentials_set(session->Session, GNUTLS_CRD_CERTIFICATE, _CertCredentials);
             }
         }
-        if (pskIdentity)
+        if (psk)
         {
             if (client)
             {
@@ -370,16 +547,51 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
         if (!client)
         {
             gnutls_certificate_server_set_request(session->Session, GNUTLS_CERT_REQUEST); // GNUTLS_CERT_IGNORE  Don't require Client Cert
+
+            // resume sessions from tickets, or from the cache for clients that do not support tickets
+            int lifetime = GNUTLS_MAX_RESUMPTION_LIFETIME;
+            if ((resumptionCache.Lifetime > 0) && (resumptionCache.Lifetime / 1000 < GNUTLS_MAX_RESUMPTION_LIFETIME))
+                lifetime = resumptionCache.Lifetime / 1000;
+            gnutls_db_set_cache_expiration(session->Session, lifetime);
+            gnutls_db_set_retrieve_function(session->Session, FetchResumptionState);
+            gnutls_db_set_store_function(session->Session, StoreResumptionState);
+            gnutls_db_set_remove_function(session->Session, RemoveResumptionState);
+            gnutls_db_set_ptr(session->Session, &resumptionCache);
+            if (ticketKey.data)
+                gnutls_session_ticket_enable_server(session->Session, &ticketKey);
+        }
+        else
+        {
+            size_t stateLength;
+            pthread_mutex_lock(&resumptionLock);
+            const uint8_t * state = DTLS_ResumptionCache_FetchForAddress(&resumptionCache, networkAddress, &stateLength, Lwm2mCore_GetTickCountMs());
+            if (state)
+                gnutls_session_set_data(session->Session, state, stateLength);
+            pthread_mutex_unlock(&resumptionLock);
         }
 
 #if GNUTLS_VERSION_MAJOR >= 3
         gnutls_handshake_set_timeout(session->Session, GNUTLS_DEFAULT_HANDSHAKE_TIMEOUT);
 #endif
     }
+    else
+    {
+        session->Session = NULL;
+        FreeSession(session);
+        session = NULL;
+    }
+    return session;
 }
 
 static void FreeSession(DTLS_Session * session)
 {
+    DTLS_SessionTable_Free(&sessions, &session->Entry);
+}
+
+static void FreeSessionEntry(DTLS_SessionEntry * entry)
+{
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
+    DTLS_HandshakePool_Cancel(handshakePool, &session->Handshake);
     if (session->Credentials)
     {
         if (session->CredentialType == CredentialType_ClientPSK)
@@ -388,9 +600,125 @@ static void FreeSession(DTLS_Session * session)
             gnutls_psk_free_server_credentials(session->Credentials);
 
     }
-    gnutls_deinit(session->Session);
-    memset(session,0, sizeof(DTLS_Session));
+    if (session->Session)
+    {
+        gnutls_deinit(session->Session);
+    }
+}
 
+static bool Handshake(DTLS_Session * session)
+{
+    bool result = (gnutls_handshake(session->Session) == GNUTLS_E_SUCCESS);
+    if (result)
+    {
+        if (gnutls_session_is_resumed(session->Session))
+            Lwm2m_Debug("DTLS session resumed\n");
+
+        if (session->Client)
+        {
+            // keep the latest state, so the next session to this server can resume
+            gnutls_datum_t state;
+            if (gnutls_session_get_data2(session->Session, &state) == GNUTLS_E_SUCCESS)
+            {
+                pthread_mutex_lock(&resumptionLock);
+                DTLS_ResumptionCache_StoreForAddress(&resumptionCache, session->Entry.NetworkAddress, state.data, state.size, Lwm2mCore_GetTickCountMs());
+                pthread_mutex_unlock(&resumptionLock);
+                gnutls_free(state.data);
+            }
+        }
+    }
+    return result;
+}
+
+// Continue a server handshake on a handshake worker
+static DTLS_HandshakeResult HandshakeStep(DTLS_HandshakeJob * job, uint8_t * datagram, size_t length)
+{
+    DTLS_HandshakeResult result = DTLS_HandshakeResult_InProgress;
+    DTLS_Session * session = DTLS_SessionTableContainer(job, DTLS_Session, Handshake);
+    session->Buffer = datagram;
+    session->BufferLength = length;
+    int error = gnutls_handshake(session->Session);
+    if (error == GNUTLS_E_SUCCESS)
+    {
+        if (gnutls_session_is_resumed(session->Session))
+            Lwm2m_Debug("DTLS session resumed\n");
+        result = DTLS_HandshakeResult_Established;
+    }
+    else if (gnutls_error_is_fatal(error))
+    {
+        Lwm2m_Debug("DTLS handshake failed: %s\n", gnutls_strerror(error));
+        result = DTLS_HandshakeResult_Failed;
+    }
+    return result;
+}
+
+// Clients only have sessions with a few servers, so only servers hand their handshakes to workers
+static bool OffloadHandshake(DTLS_Session * session)
+{
+    return (handshakePool != NULL) && !session->Client;
+}
+
+// Take back the sessions whose handshakes the workers have finished
+static void CollectHandshakes(void)
+{
+    DTLS_HandshakeJob * job;
+    while ((job = DTLS_HandshakePool_TakeCompleted(handshakePool)) != NULL)
+    {
+        DTLS_Session * session = DTLS_SessionTableContainer(job, DTLS_Session, Handshake);
+        if (job->Result == DTLS_HandshakeResult_Established)
+        {
+            session->SessionEstablished = true;
+            Lwm2m_Info("Session established");
+        }
+        else
+        {
+            FreeSession(session);
+        }
+    }
+
+    // server sessions stored by the workers may have pushed out client sessions, whose addresses are freed here
+    pthread_mutex_lock(&resumptionLock);
+    DTLS_ResumptionCache_Release(&resumptionCache);
+    pthread_mutex_unlock(&resumptionLock);
+}
+
+static int StoreResumptionState(void * context, gnutls_datum_t key, gnutls_datum_t data)
+{
+    DTLS_ResumptionCache * cache = (DTLS_ResumptionCache *)context;
+    pthread_mutex_lock(&resumptionLock);
+    int result = DTLS_ResumptionCache_Store(cache, key.data, key.size, data.data, data.size, Lwm2mCore_GetTickCountMs());
+    pthread_mutex_unlock(&resumptionLock);
+    return result;
+}
+
+static gnutls_datum_t FetchResumptionState(void * context, gnutls_datum_t key)
+{
+    DTLS_ResumptionCache * cache = (DTLS_ResumptionCache *)context;
+    gnutls_datum_t result = { NULL, 0 };
+    size_t stateLength;
+    pthread_mutex_lock(&resumptionLock);
+    const uint8_t * state = DTLS_ResumptionCache_Fetch(cache, key.data, key.size, &stateLength, Lwm2mCore_GetTickCountMs());
+    if (state)
+    {
+        // GnuTLS frees the state it is given
+        result.data = gnutls_malloc(stateLength);
+        if (result.data)
+        {
+            memcpy(result.data, state, stateLength);
+            result.size = stateLength;
+        }
+    }
+    pthread_mutex_unlock(&resumptionLock);
+    return result;
+}
+
+static int RemoveResumptionState(void * context, gnutls_datum_t key)
+{
+    DTLS_ResumptionCache * cache = (DTLS_ResumptionCache *)context;
+    pthread_mutex_lock(&resumptionLock);
+    DTLS_ResumptionCache_Remove(cache, key.data, key.size);
+    pthread_mutex_unlock(&resumptionLock);
+    return 0;
 }
 
 #if GNUTLS_VERSION_MAJOR >= 3
@@ -467,7 +795,21 @@ static int PSKClientCallBack(gnutls_session_t session, char **username, gnutls_d
 static int PSKCallBack(gnutls_session_t session, const char *username, gnutls_datum_t * key)
 {
     (void)session;
-    (void)username;
+    if (keyStore)
+    {
+        uint8_t storedKey[DTLS_KEYSTORE_MAX_KEY_LENGTH];
+        int keyLength = DTLS_KeyStore_Lookup(keyStore, username, strlen(username), storedKey, sizeof(storedKey));
+        if (keyLength < 0)
+        {
+            Lwm2m_Debug("Unknown PSK identity %s\n", username);
+            return -1;
+        }
+        key->data = gnutls_malloc(keyLength);
+        key->size = keyLength;
+        memcpy(key->data, storedKey, keyLength);
+        memset(storedKey, 0, sizeof(storedKey));
+        return 0;
+    }
     key->data = gnutls_malloc(pskKey.size);
     key->size = pskKey.size;
     memcpy(key->data, pskKey.data, pskKey.size);
@@ -503,7 +845,7 @@ static ssize_t SSLSendCallBack(gnutls_transport_ptr_t context, const void * send
     DTLS_Session * session = (DTLS_Session *)context;
     if (NetworkSend)
     {
-        NetworkTransmissionError error = NetworkSend(session->NetworkAddress, sendBuffer, sendBufferLength, session->UserContext);
+        NetworkTransmissionError error = NetworkSend(session->Entry.NetworkAddress, sendBuffer, sendBufferLength, session->UserContext);
         if (error == NetworkTransmissionError_None)
             result = sendBufferLength;
         else
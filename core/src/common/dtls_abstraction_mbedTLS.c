@@ -21,13 +21,17 @@
 ************************************************************************************************************************/
 
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 
 #include "lwm2m_debug.h"
+#include "lwm2m_util.h"
 #include "dtls_abstraction.h"
 
 #include <errno.h>
 #include <stdio.h>
+#include <pthread.h>
 #define mbedtls_printf     printf
 #define mbedtls_fprintf    fprintf
 
@@ -42,27 +46,56 @@
 #include "mbedtls/certs.h"
 #include "mbedtls/timing.h"
 #include "mbedtls/pk.h"
-#include "mbedtls/ssl_cookie.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/ssl_ticket.h"
+#include "mbedtls/version.h"
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+// Length of the connection IDs servers ask clients to put in their records
+#ifndef DTLS_CONNECTION_ID_LENGTH
+#define DTLS_CONNECTION_ID_LENGTH (8)
+#endif
+#endif
+
+// mbedTLS added session serialisation in 2.19.0
+#if defined(MBEDTLS_SSL_CLI_C) && (MBEDTLS_VERSION_NUMBER >= 0x02130000)
+#define CLIENT_RESUMPTION_SUPPORTED
+#endif
 
 typedef struct
 {
-    NetworkAddress * NetworkAddress;
+    DTLS_SessionEntry Entry;
+    DTLS_HandshakeJob Handshake;        // Owns the session while a handshake worker runs it
     mbedtls_ssl_context Context;
     mbedtls_ssl_config Config;
+    mbedtls_timing_delay_context Timer;
+    int CipherSuites[6];                // The config refers to these, and workers read them during handshakes
     bool InUse;
     bool SessionEstablished;
+    bool Client;
     void * UserContext;
     uint8_t * Buffer;
     int BufferLength;
 } DTLS_Session;
 
-#ifndef MAX_DTLS_SESSIONS
-    #define MAX_DTLS_SESSIONS 3
-#endif
+// The input and output record buffers mbedTLS allocates per session
+#define MBEDTLS_SESSION_MEMORY (2 * MBEDTLS_SSL_MAX_CONTENT_LEN)
+
+#define CONTENT_TYPE_APPLICATION_DATA (23)
 
 const char * DTLS_LibraryName = "mbedTLS";
 
-static DTLS_Session sessions[MAX_DTLS_SESSIONS];
+static DTLS_SessionTable sessions;
+
+// Client sessions by server address. Servers resume sessions with the mbedTLS session cache and tickets.
+static DTLS_ResumptionCache resumptionCache;
+#if defined(MBEDTLS_SSL_CACHE_C)
+static mbedtls_ssl_cache_context serverCache;
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+static mbedtls_ssl_ticket_context ticketContext;
+static bool ticketsEnabled = false;
+#endif
 
 static uint8_t * certificate = NULL;
 static int certificateLength = 0;
@@ -72,58 +105,108 @@ static const char * pskIdentity = NULL;
 static const uint8_t * pskKey = NULL;
 static int pskKeyLength = 0;
 
+// Keys of the identities clients present to the server, if not pskKey for all
+static DTLS_KeyStore * keyStore = NULL;
+
 static DTLS_NetworkSendCallback NetworkSend = NULL;
 
-static int supportedCipherSuites[6];
+// Runs server handshakes, if not NULL
+static DTLS_HandshakePool * handshakePool = NULL;
+
+// Guards the state that handshake workers share: the random generator, cookie secrets, session cache and ticket keys
+static pthread_mutex_t sharedLock = PTHREAD_MUTEX_INITIALIZER;
 
 static DTLS_Session * GetSession(NetworkAddress * address);
-static void SetupNewSession(int index, NetworkAddress * networkAddress, bool client);
+static DTLS_Session * SetupNewSession(NetworkAddress * networkAddress, bool client);
 static void FreeSession(DTLS_Session * session);
+static void FreeSessionEntry(DTLS_SessionEntry * entry);
+static bool Handshake(DTLS_Session * session);
+static DTLS_HandshakeResult HandshakeStep(DTLS_HandshakeJob * job, uint8_t * datagram, size_t length);
+static bool OffloadHandshake(DTLS_Session * session);
+static void CollectHandshakes(void);
+static int LockedRandom(void * context, unsigned char * output, size_t length);
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int LockedCacheGet(void * context, mbedtls_ssl_session * session);
+static int LockedCacheSet(void * context, const mbedtls_ssl_session * session);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int LockedTicketWrite(void * context, const mbedtls_ssl_session * session, unsigned char * start, const unsigned char * end, size_t * length, uint32_t * lifetime);
+static int LockedTicketParse(void * context, mbedtls_ssl_session * session, unsigned char * buffer, size_t length);
+#endif
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+static bool SetConnectionId(DTLS_Session * session, bool client);
+#endif
+static void SetServerResumptionLimits(uint32_t maxEntries, uint32_t lifetime);
+#ifdef CLIENT_RESUMPTION_SUPPORTED
+static void LoadResumptionState(DTLS_Session * session);
+static void SaveResumptionState(DTLS_Session * session);
+#endif
 static int DecryptCallBack(void * context, unsigned char * recieveBuffer, size_t receiveBufferLegth);
 static int EncryptCallBack(void * context, const unsigned char * sendBuffer,size_t sendBufferLength);
 static int PSKCallBack(void * parameter, mbedtls_ssl_context * context, const unsigned char * identity, size_t identityLength);
 static int SSLSendCallBack(void * context, const unsigned char * sendBuffer, size_t sendBufferLength);
+static int CookieRandom(uint8_t * buffer, size_t length);
+static int CookieWrite(void * context, unsigned char ** cookie, unsigned char * end, const unsigned char * clientId, size_t clientIdLength);
+static int CookieCheck(void * context, const unsigned char * cookie, size_t cookieLength, const unsigned char * clientId, size_t clientIdLength);
+static bool VerifyClientHello(NetworkAddress * sourceAddress, uint8_t * datagram, int datagramLength, void * context);
 
 
 static mbedtls_entropy_context entropy;
 static mbedtls_ctr_drbg_context secureRandom;
-static mbedtls_timing_delay_context timer;
 static mbedtls_x509_crt cacert;
 static mbedtls_pk_context privateKey;
-static mbedtls_ssl_cookie_ctx cookie_context;
+
+// Peers without a session must return a cookie before the server creates one
+static DTLS_CookieVerifier cookieVerifier;
 
 #define SUCCESS (0)
 
 
 void DTLS_Init(void)
 {
-    memset(sessions, 0, sizeof(sessions));
+    DTLS_SessionTable_Init(&sessions, sizeof(DTLS_Session), MBEDTLS_SESSION_MEMORY, FreeSessionEntry);
     mbedtls_entropy_init(&entropy);
     mbedtls_ctr_drbg_init(&secureRandom);
     mbedtls_ctr_drbg_seed(&secureRandom, mbedtls_entropy_func, &entropy, NULL, 0);
     mbedtls_x509_crt_init(&cacert);
     mbedtls_pk_init(&privateKey);
-    mbedtls_ssl_cookie_init(&cookie_context);
-    mbedtls_ssl_cookie_setup(&cookie_context, mbedtls_ctr_drbg_random, &secureRandom);
+    DTLS_CookieVerifier_Init(&cookieVerifier, CookieRandom);
+
+    DTLS_ResumptionCache_Init(&resumptionCache);
+#if defined(MBEDTLS_SSL_CACHE_C)
+    mbedtls_ssl_cache_init(&serverCache);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+    mbedtls_ssl_ticket_init(&ticketContext);
+    ticketsEnabled = (mbedtls_ssl_ticket_setup(&ticketContext, mbedtls_ctr_drbg_random, &secureRandom, MBEDTLS_CIPHER_AES_256_GCM, DTLS_RESUMPTION_LIFETIME / 1000) == SUCCESS);
+    if (!ticketsEnabled)
+        Lwm2m_Warning("Failed to set up DTLS session tickets, sessions are only resumed by session ID\n");
+#endif
+    SetServerResumptionLimits(resumptionCache.MaxEntries, resumptionCache.Lifetime);
 }
 
 void DTLS_Shutdown(void)
 {
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
-    {
-        if (sessions[index].InUse)
-        {
-            FreeSession(&sessions[index]);
-        }
-    }
+    DTLS_HandshakePool_Free(&handshakePool);
+    DTLS_SessionTable_Destroy(&sessions);
+    DTLS_ResumptionCache_Destroy(&resumptionCache);
+    DTLS_CookieVerifier_Destroy(&cookieVerifier);
+#if defined(MBEDTLS_SSL_CACHE_C)
+    mbedtls_ssl_cache_free(&serverCache);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+    mbedtls_ssl_ticket_free(&ticketContext);
+    ticketsEnabled = false;
+#endif
     mbedtls_ctr_drbg_free(&secureRandom);
     mbedtls_entropy_free(&entropy);
 }
 
 void DTLS_Reset(NetworkAddress * address)
 {
-    DTLS_Session * session = GetSession(address);
+    DTLS_Session * session;
+    CollectHandshakes();
+    session = GetSession(address);
     if (session)
     {
         FreeSession(session);
@@ -159,47 +242,174 @@ void DTLS_SetPSK(const char * identity, const uint8_t * key, int keyLength)
     }
 }
 
+void DTLS_SetKeyStore(DTLS_KeyStore * store)
+{
+    keyStore = store;
+}
+
+void DTLS_SetSessionLimits(uint32_t maxSessions, size_t maxMemory, uint32_t idleTimeout)
+{
+    DTLS_SessionTable_SetLimits(&sessions, maxSessions, maxMemory, idleTimeout);
+}
+
+void DTLS_GetSessionStatistics(DTLS_SessionTableStatistics * statistics)
+{
+    DTLS_SessionTable_GetStatistics(&sessions, statistics);
+}
+
+void DTLS_SetResumptionLimits(uint32_t maxEntries, uint32_t lifetime)
+{
+    DTLS_ResumptionCache_SetLimits(&resumptionCache, maxEntries, lifetime);
+    pthread_mutex_lock(&sharedLock);
+    SetServerResumptionLimits(maxEntries, lifetime);
+    pthread_mutex_unlock(&sharedLock);
+}
+
+void DTLS_GetResumptionStatistics(DTLS_ResumptionCacheStatistics * statistics)
+{
+    DTLS_ResumptionCache_GetStatistics(&resumptionCache, statistics);
+}
+
+void DTLS_GetCookieStatistics(DTLS_CookieStatistics * statistics)
+{
+    pthread_mutex_lock(&sharedLock);
+    DTLS_CookieVerifier_GetStatistics(&cookieVerifier, statistics);
+    pthread_mutex_unlock(&sharedLock);
+}
+
+int DTLS_SetHandshakeWorkers(unsigned int workers)
+{
+    // sessions handshaking on the old workers carry on inline, or on the new workers with their next record
+    DTLS_HandshakePool_Free(&handshakePool);
+    if (workers > 0)
+    {
+        handshakePool = DTLS_HandshakePool_New(workers, HandshakeStep);
+        if (!handshakePool)
+            return -1;
+    }
+    return 0;
+}
+
+void DTLS_GetHandshakeStatistics(DTLS_HandshakePoolStatistics * statistics)
+{
+    DTLS_HandshakePool_GetStatistics(handshakePool, statistics);
+}
+
+bool DTLS_IsHandshakeWorker(void)
+{
+    return DTLS_HandshakePool_IsWorker();
+}
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+typedef struct
+{
+    uint8_t * Buffer;
+    int BufferLength;
+    int DecryptedLength;
+    bool Named;                 // The record named a session by its connection ID
+} MovedRecord;
+
+static bool DecryptMovedRecord(DTLS_SessionEntry * entry, uint8_t * record, size_t recordLength, void * context)
+{
+    MovedRecord * moved = (MovedRecord *)context;
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
+    moved->Named = true;
+    moved->DecryptedLength = 0;
+    if (session->SessionEstablished && !DTLS_HandshakeJob_IsActive(&session->Handshake))
+    {
+        session->Buffer = record;
+        session->BufferLength = recordLength;
+        moved->DecryptedLength = mbedtls_ssl_read(&session->Context, moved->Buffer, moved->BufferLength);
+    }
+    return (moved->DecryptedLength > 0);
+}
+#endif
+
 bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encryptedLength, uint8_t * decryptBuffer, int decryptBufferLength, int * decryptedLength, void *context)
 {
     bool result = false;
-    DTLS_Session * session = GetSession(sourceAddress);
+    DTLS_Session * session;
+
+    CollectHandshakes();
+    session = GetSession(sourceAddress);
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    if (!session)
+    {
+        // a peer whose address changed still puts the connection ID of its session in its records
+        MovedRecord moved = { decryptBuffer, decryptBufferLength, 0, false };
+        DTLS_SessionEntry * entry = DTLS_SessionTable_MoveByRecord(&sessions, sourceAddress, encrypted, encryptedLength, DTLS_CONNECTION_ID_LENGTH,
+                                                                   DecryptMovedRecord, &moved, Lwm2mCore_GetTickCountMs());
+        if (entry)
+        {
+            Lwm2m_Info("DTLS session moved to a new peer address\n");
+            *decryptedLength = moved.DecryptedLength;
+            DTLS_SessionTable_AddDecrypted(entry, *decryptedLength);
+            return true;
+        }
+        if (moved.Named)
+        {
+            // a record that cannot be decrypted does not end the session, as anyone can send a connection ID
+            *decryptedLength = 0;
+            return false;
+        }
+    }
+#endif
+
     if (session)
     {
-        session->Buffer = encrypted;
-        session->BufferLength = encryptedLength;
         if (session->SessionEstablished)
         {
+            session->Buffer = encrypted;
+            session->BufferLength = encryptedLength;
             *decryptedLength = mbedtls_ssl_read(&session->Context, decryptBuffer, decryptBufferLength);
             result = (*decryptedLength > 0);
-            if (!result)
+            if (result)
+            {
+                DTLS_SessionTable_AddDecrypted(&session->Entry, *decryptedLength);
+            }
+            else
             {
                 FreeSession(session);
                 session = NULL;
             }
         }
+        else if (OffloadHandshake(session))
+        {
+            // application data sent as soon as the peer finished the handshake may arrive before the worker has, and
+            // is dropped rather than waiting for the worker: the peer retransmits it, and CollectHandshakes
+            // establishes the session in the meantime
+            *decryptedLength = 0;
+            if (encrypted[0] != CONTENT_TYPE_APPLICATION_DATA)
+                DTLS_HandshakePool_Submit(handshakePool, &session->Handshake, encrypted, encryptedLength);
+        }
         else
         {
             *decryptedLength = 0;
-            session->SessionEstablished = (mbedtls_ssl_handshake(&session->Context) == SUCCESS);
+            session->Buffer = encrypted;
+            session->BufferLength = encryptedLength;
+            session->SessionEstablished = Handshake(session);
             if (session->SessionEstablished)
                 Lwm2m_Info("Session established");
         }
     }
 
-    if (!session)
+    if (!session && VerifyClientHello(sourceAddress, encrypted, encryptedLength, context))
     {
-        int index;
-        for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+        session = SetupNewSession(sourceAddress, false);
+        if (session)
         {
-            if (!sessions[index].InUse)
+            session->UserContext = context;
+            session->Context.f_send = SSLSendCallBack;
+            if (OffloadHandshake(session))
             {
-                SetupNewSession(index, sourceAddress, false);
-                sessions[index].UserContext = context;
-                sessions[index].Context.f_send = SSLSendCallBack;
-                sessions[index].Buffer = encrypted;
-                sessions[index].BufferLength = encryptedLength;
-                sessions[index].SessionEstablished = (mbedtls_ssl_handshake(&sessions[index].Context) == SUCCESS);
-                break;
+                if (DTLS_HandshakePool_Submit(handshakePool, &session->Handshake, encrypted, encryptedLength) != 0)
+                    FreeSession(session);
+            }
+            else
+            {
+                session->Buffer = encrypted;
+                session->BufferLength = encryptedLength;
+                session->SessionEstablished = Handshake(session);
             }
         }
     }
@@ -209,7 +419,10 @@ bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encry
 bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTextLength, uint8_t * encryptedBuffer, int encryptedBufferLength, int * encryptedLength, void *context)
 {
     bool result = false;
-    DTLS_Session * session = GetSession(destAddress);
+    DTLS_Session * session;
+
+    CollectHandshakes();
+    session = GetSession(destAddress);
     if (session)
     {
         if (session->SessionEstablished)
@@ -218,35 +431,100 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
             session->Buffer = encryptedBuffer;
             session->BufferLength = encryptedBufferLength;
             int written = mbedtls_ssl_write(&session->Context, plainText, plainTextLength);
+            // anything mbedTLS sends outside a write, such as alerts, goes to the peer rather than this buffer
+            session->Context.f_send = SSLSendCallBack;
             if (written >= 0)
             {
                 *encryptedLength = encryptedBufferLength - session->BufferLength;
                 result = (*encryptedLength > 0);
+                if (result)
+                {
+                    DTLS_SessionTable_AddEncrypted(&session->Entry, plainTextLength);
+                }
+            }
+        }
+        else if (OffloadHandshake(session))
+        {
+            // an empty datagram has the worker retransmit, unless it is already busy with the session
+            if (!DTLS_HandshakeJob_IsActive(&session->Handshake))
+            {
+                session->UserContext = context;
+                DTLS_HandshakePool_Submit(handshakePool, &session->Handshake, NULL, 0);
             }
         }
         else
         {
             session->UserContext = context;
             session->Context.f_send = SSLSendCallBack;
-            session->SessionEstablished = (mbedtls_ssl_handshake(&session->Context) == SUCCESS);
+            session->SessionEstablished = Handshake(session);
             if (session->SessionEstablished)
                 Lwm2m_Info("DTLS Session established\n");
         }
     }
     else
     {
-        int index;
-        for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+        session = SetupNewSession(destAddress, true);
+        if (session)
         {
-            if (!sessions[index].InUse)
+            session->UserContext = context;
+            session->Context.f_send = SSLSendCallBack;
+            session->SessionEstablished = Handshake(session);
+        }
+    }
+    return result;
+}
+
+// Called by the cookie verifier, with sharedLock held
+static int CookieRandom(uint8_t * buffer, size_t length)
+{
+    return (mbedtls_ctr_drbg_random(&secureRandom, buffer, length) == SUCCESS) ? 0 : -1;
+}
+
+static int CookieWrite(void * context, unsigned char ** cookie, unsigned char * end, const unsigned char * clientId, size_t clientIdLength)
+{
+    int result = MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+    pthread_mutex_lock(&sharedLock);
+    if ((end - *cookie >= DTLS_COOKIE_LENGTH) &&
+        (DTLS_CookieVerifier_WriteCookie(context, clientId, clientIdLength, *cookie, Lwm2mCore_GetTickCountMs()) == 0))
+    {
+        *cookie += DTLS_COOKIE_LENGTH;
+        result = SUCCESS;
+    }
+    pthread_mutex_unlock(&sharedLock);
+    return result;
+}
+
+static int CookieCheck(void * context, const unsigned char * cookie, size_t cookieLength, const unsigned char * clientId, size_t clientIdLength)
+{
+    pthread_mutex_lock(&sharedLock);
+    bool verified = DTLS_CookieVerifier_CheckCookie(context, clientId, clientIdLength, cookie, cookieLength, Lwm2mCore_GetTickCountMs());
+    pthread_mutex_unlock(&sharedLock);
+    return verified ? SUCCESS : -1;
+}
+
+// Answer a ClientHello without a valid cookie with a HelloVerifyRequest. Returns true if the peer may have a session.
+static bool VerifyClientHello(NetworkAddress * sourceAddress, uint8_t * datagram, int datagramLength, void * context)
+{
+    bool result = false;
+    uint8_t response[DTLS_HELLO_VERIFY_REQUEST_LENGTH];
+    size_t responseLength = 0;
+    pthread_mutex_lock(&sharedLock);
+    DTLS_CookieResult cookieResult = DTLS_CookieVerifier_CheckClientHello(&cookieVerifier, sourceAddress, datagram, datagramLength, NULL,
+            response, sizeof(response), &responseLength, Lwm2mCore_GetTickCountMs());
+    pthread_mutex_unlock(&sharedLock);
+    switch (cookieResult)
+    {
+        case DTLS_CookieResult_Verified:
+            result = true;
+            break;
+        case DTLS_CookieResult_HelloVerify:
+            if (NetworkSend)
             {
-                SetupNewSession(index, destAddress, true);
-                sessions[index].UserContext = context;
-                sessions[index].Context.f_send = SSLSendCallBack;
-                sessions[index].SessionEstablished = (mbedtls_ssl_handshake(&sessions[index].Context) == SUCCESS);
-                break;
+                NetworkSend(sourceAddress, response, responseLength, context);
             }
-        }
+            break;
+        default:
+            break;
     }
     return result;
 }
@@ -254,23 +532,26 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
 static DTLS_Session * GetSession(NetworkAddress * address)
 {
     DTLS_Session * result = NULL;
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+    DTLS_SessionEntry * entry = DTLS_SessionTable_Get(&sessions, address, Lwm2mCore_GetTickCountMs());
+    if (entry)
     {
-        if (NetworkAddress_Compare(sessions[index].NetworkAddress,address) == 0)
-        {
-            result = &sessions[index];
-            break;
-        }
+        result = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
     }
     return result;
 }
 
-static void SetupNewSession(int index, NetworkAddress * networkAddress, bool client)
+static DTLS_Session * SetupNewSession(NetworkAddress * networkAddress, bool client)
 {
     int flags;
-    DTLS_Session * session = &sessions[index];
-    session->NetworkAddress = networkAddress;
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&sessions, networkAddress, Lwm2mCore_GetTickCountMs());
+    if (!entry)
+    {
+        return NULL;
+    }
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
+    DTLS_HandshakeJob_Init(&session->Handshake);
+    session->Client = client;
+    bool psk = (pskIdentity != NULL) || (!client && (keyStore != NULL));
     mbedtls_ssl_context * context = &session->Context;
     mbedtls_ssl_config * config = &session->Config;
 
@@ -283,19 +564,30 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
     }
 
     mbedtls_ssl_config_defaults(config, flags, MBEDTLS_SSL_TRANSPORT_DATAGRAM, MBEDTLS_SSL_PRESET_DEFAULT);
-    mbedtls_ssl_conf_rng(config, mbedtls_ctr_drbg_random, &secureRandom);
+    mbedtls_ssl_conf_rng(config, LockedRandom, &secureRandom);
 
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    // clients do not need a connection ID, as servers do not move
+    mbedtls_ssl_conf_cid(config, client ? 0 : DTLS_CONNECTION_ID_LENGTH, MBEDTLS_SSL_UNEXPECTED_CID_IGNORE);
+#endif
     if (!client)
     {
-        mbedtls_ssl_conf_dtls_cookies(config, NULL, NULL, &cookie_context);
+        mbedtls_ssl_conf_dtls_cookies(config, CookieWrite, CookieCheck, &cookieVerifier);
+#if defined(MBEDTLS_SSL_CACHE_C)
+        mbedtls_ssl_conf_session_cache(config, &serverCache, LockedCacheGet, LockedCacheSet);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+        if (ticketsEnabled)
+            mbedtls_ssl_conf_session_tickets_cb(config, LockedTicketWrite, LockedTicketParse, &ticketContext);
+#endif
     }
 
     int cipherIndex = 0;
-    if (certificate || !pskIdentity)
+    if (certificate || !psk)
     {
-        supportedCipherSuites[cipherIndex] = MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CCM_8;
+        session->CipherSuites[cipherIndex] = MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CCM_8;
         cipherIndex++;
-        supportedCipherSuites[cipherIndex] = MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256;
+        session->CipherSuites[cipherIndex] = MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256;
         cipherIndex++;
         if (certificate)
         {
@@ -303,13 +595,13 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
         }
         mbedtls_ssl_conf_authmode(config, MBEDTLS_SSL_VERIFY_OPTIONAL);
     }
-    if (pskIdentity)
+    if (psk)
     {
-        supportedCipherSuites[cipherIndex] = MBEDTLS_TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA256;
+        session->CipherSuites[cipherIndex] = MBEDTLS_TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA256;
         cipherIndex++;
-        supportedCipherSuites[cipherIndex] = MBEDTLS_TLS_PSK_WITH_AES_128_CCM_8;
+        session->CipherSuites[cipherIndex] = MBEDTLS_TLS_PSK_WITH_AES_128_CCM_8;
         cipherIndex++;
-        supportedCipherSuites[cipherIndex] = MBEDTLS_TLS_PSK_WITH_AES_128_CBC_SHA256;
+        session->CipherSuites[cipherIndex] = MBEDTLS_TLS_PSK_WITH_AES_128_CBC_SHA256;
         cipherIndex++;
         if (client)
         {
@@ -323,26 +615,234 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
             mbedtls_ssl_conf_psk_cb(config, PSKCallBack, (void *)pskIdentity);
         }
     }
-    supportedCipherSuites[cipherIndex] = 0;
-    mbedtls_ssl_conf_ciphersuites(config, supportedCipherSuites);
+    session->CipherSuites[cipherIndex] = 0;
+    mbedtls_ssl_conf_ciphersuites(config, session->CipherSuites);
     mbedtls_ssl_init(context);
     if (mbedtls_ssl_setup(context, config) == SUCCESS)
     {
         mbedtls_ssl_set_bio(context, session, SSLSendCallBack, DecryptCallBack, NULL);
-        mbedtls_ssl_set_timer_cb(context, &timer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+        mbedtls_ssl_set_timer_cb(context, &session->Timer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
         session->InUse = true;
+        if (!client)
+        {
+            // the ClientHello returned a cookie made for this address
+            uint8_t clientId[NETWORK_ADDRESS_MAX_SERIALISED_LENGTH];
+            int clientIdLength = NetworkAddress_Serialise(networkAddress, clientId, sizeof(clientId));
+            mbedtls_ssl_set_client_transport_id(context, clientId, clientIdLength);
+        }
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+        if (!SetConnectionId(session, client))
+            Lwm2m_Warning("Failed to set DTLS connection ID, the session does not survive peer address changes\n");
+#endif
+#ifdef CLIENT_RESUMPTION_SUPPORTED
+        if (client)
+            LoadResumptionState(session);
+#endif
+    }
+    else
+    {
+        FreeSession(session);
+        session = NULL;
     }
+    return session;
 }
 
 static void FreeSession(DTLS_Session * session)
 {
-    mbedtls_ssl_close_notify(&session->Context);
-    mbedtls_ssl_session_reset(&session->Context);
+    DTLS_SessionTable_Free(&sessions, &session->Entry);
+}
+
+static void FreeSessionEntry(DTLS_SessionEntry * entry)
+{
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
+    DTLS_HandshakePool_Cancel(handshakePool, &session->Handshake);
+    if (session->InUse)
+    {
+        mbedtls_ssl_close_notify(&session->Context);
+        mbedtls_ssl_session_reset(&session->Context);
+    }
     mbedtls_ssl_free(&session->Context);
     mbedtls_ssl_config_free(&session->Config);
-    memset(session,0, sizeof(DTLS_Session));
 }
 
+static bool Handshake(DTLS_Session * session)
+{
+    bool result = (mbedtls_ssl_handshake(&session->Context) == SUCCESS);
+#ifdef CLIENT_RESUMPTION_SUPPORTED
+    if (result && session->Client)
+        SaveResumptionState(session);
+#endif
+    return result;
+}
+
+// Continue a server handshake on a handshake worker
+static DTLS_HandshakeResult HandshakeStep(DTLS_HandshakeJob * job, uint8_t * datagram, size_t length)
+{
+    DTLS_HandshakeResult result = DTLS_HandshakeResult_InProgress;
+    DTLS_Session * session = DTLS_SessionTableContainer(job, DTLS_Session, Handshake);
+    session->Buffer = datagram;
+    session->BufferLength = length;
+    int error = mbedtls_ssl_handshake(&session->Context);
+    if (error == SUCCESS)
+    {
+        result = DTLS_HandshakeResult_Established;
+    }
+    else if ((error != MBEDTLS_ERR_SSL_WANT_READ) && (error != MBEDTLS_ERR_SSL_WANT_WRITE))
+    {
+        Lwm2m_Debug("DTLS handshake failed: -0x%04X\n", (unsigned int)-error);
+        result = DTLS_HandshakeResult_Failed;
+    }
+    return result;
+}
+
+// Clients only have sessions with a few servers, so only servers hand their handshakes to workers
+static bool OffloadHandshake(DTLS_Session * session)
+{
+    return (handshakePool != NULL) && !session->Client;
+}
+
+// Take back the sessions whose handshakes the workers have finished
+static void CollectHandshakes(void)
+{
+    DTLS_HandshakeJob * job;
+    while ((job = DTLS_HandshakePool_TakeCompleted(handshakePool)) != NULL)
+    {
+        DTLS_Session * session = DTLS_SessionTableContainer(job, DTLS_Session, Handshake);
+        if (job->Result == DTLS_HandshakeResult_Established)
+        {
+            session->SessionEstablished = true;
+            Lwm2m_Info("Session established");
+        }
+        else
+        {
+            FreeSession(session);
+        }
+    }
+}
+
+static int LockedRandom(void * context, unsigned char * output, size_t length)
+{
+    pthread_mutex_lock(&sharedLock);
+    int result = mbedtls_ctr_drbg_random(context, output, length);
+    pthread_mutex_unlock(&sharedLock);
+    return result;
+}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int LockedCacheGet(void * context, mbedtls_ssl_session * session)
+{
+    pthread_mutex_lock(&sharedLock);
+    int result = mbedtls_ssl_cache_get(context, session);
+    pthread_mutex_unlock(&sharedLock);
+    return result;
+}
+
+static int LockedCacheSet(void * context, const mbedtls_ssl_session * session)
+{
+    pthread_mutex_lock(&sharedLock);
+    int result = mbedtls_ssl_cache_set(context, session);
+    pthread_mutex_unlock(&sharedLock);
+    return result;
+}
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+// The ticket context generates keys with secureRandom, which sharedLock also guards
+static int LockedTicketWrite(void * context, const mbedtls_ssl_session * session, unsigned char * start, const unsigned char * end, size_t * length, uint32_t * lifetime)
+{
+    pthread_mutex_lock(&sharedLock);
+    int result = mbedtls_ssl_ticket_write(context, session, start, end, length, lifetime);
+    pthread_mutex_unlock(&sharedLock);
+    return result;
+}
+
+static int LockedTicketParse(void * context, mbedtls_ssl_session * session, unsigned char * buffer, size_t length)
+{
+    pthread_mutex_lock(&sharedLock);
+    int result = mbedtls_ssl_ticket_parse(context, session, buffer, length);
+    pthread_mutex_unlock(&sharedLock);
+    return result;
+}
+#endif
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+// Offer a connection ID, with a random one unique to the session on servers
+static bool SetConnectionId(DTLS_Session * session, bool client)
+{
+    bool result = false;
+    if (client)
+    {
+        result = (mbedtls_ssl_set_cid(&session->Context, MBEDTLS_SSL_CID_ENABLED, NULL, 0) == SUCCESS);
+    }
+    else
+    {
+        unsigned char connectionId[DTLS_CONNECTION_ID_LENGTH];
+        int attempt;
+        for (attempt = 0; !result && (attempt < 3); attempt++)
+        {
+            result = (LockedRandom(&secureRandom, connectionId, sizeof(connectionId)) == SUCCESS) &&
+                     (DTLS_SessionTable_SetConnectionId(&sessions, &session->Entry, connectionId, sizeof(connectionId)) == 0);
+        }
+        if (result)
+        {
+            result = (mbedtls_ssl_set_cid(&session->Context, MBEDTLS_SSL_CID_ENABLED, connectionId, sizeof(connectionId)) == SUCCESS);
+        }
+    }
+    return result;
+}
+#endif
+
+static void SetServerResumptionLimits(uint32_t maxEntries, uint32_t lifetime)
+{
+#if defined(MBEDTLS_SSL_CACHE_C)
+    mbedtls_ssl_cache_set_max_entries(&serverCache, ((maxEntries > 0) && (maxEntries < INT_MAX)) ? (int)maxEntries : INT_MAX);
+#if defined(MBEDTLS_HAVE_TIME)
+    mbedtls_ssl_cache_set_timeout(&serverCache, lifetime / 1000);
+#endif
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+    // unlike the cache, a ticket lifetime of 0 expires tickets immediately
+    ticketContext.ticket_lifetime = (lifetime > 0) ? lifetime / 1000 : UINT32_MAX;
+#endif
+}
+
+#ifdef CLIENT_RESUMPTION_SUPPORTED
+static void LoadResumptionState(DTLS_Session * session)
+{
+    size_t stateLength;
+    const uint8_t * state = DTLS_ResumptionCache_FetchForAddress(&resumptionCache, session->Entry.NetworkAddress, &stateLength, Lwm2mCore_GetTickCountMs());
+    if (state)
+    {
+        mbedtls_ssl_session saved;
+        mbedtls_ssl_session_init(&saved);
+        if (mbedtls_ssl_session_load(&saved, state, stateLength) == SUCCESS)
+        {
+            mbedtls_ssl_set_session(&session->Context, &saved);
+        }
+        mbedtls_ssl_session_free(&saved);
+    }
+}
+
+// Keep the latest state, so the next session to this server can resume
+static void SaveResumptionState(DTLS_Session * session)
+{
+    mbedtls_ssl_session saved;
+    mbedtls_ssl_session_init(&saved);
+    if (mbedtls_ssl_get_session(&session->Context, &saved) == SUCCESS)
+    {
+        size_t stateLength = 0;
+        mbedtls_ssl_session_save(&saved, NULL, 0, &stateLength);
+        uint8_t * state = (uint8_t *)malloc(stateLength);
+        if (state && (mbedtls_ssl_session_save(&saved, state, stateLength, &stateLength) == SUCCESS))
+        {
+            DTLS_ResumptionCache_StoreForAddress(&resumptionCache, session->Entry.NetworkAddress, state, stateLength, Lwm2mCore_GetTickCountMs());
+        }
+        free(state);
+    }
+    mbedtls_ssl_session_free(&saved);
+}
+#endif
+
 static int DecryptCallBack(void * context, unsigned char * recieveBuffer, size_t receiveBufferLegth)
 {
     ssize_t result;
@@ -395,8 +895,24 @@ static int EncryptCallBack(void * context, const unsigned char * sendBuffer, siz
 
 static int PSKCallBack(void * parameter, mbedtls_ssl_context * context, const unsigned char * identity, size_t identityLength)
 {
-    mbedtls_ssl_set_hs_psk(context, pskKey, pskKeyLength);
-    return 0;
+    int result;
+    if (keyStore)
+    {
+        uint8_t storedKey[DTLS_KEYSTORE_MAX_KEY_LENGTH];
+        int keyLength = DTLS_KeyStore_Lookup(keyStore, (const char *)identity, identityLength, storedKey, sizeof(storedKey));
+        if (keyLength < 0)
+        {
+            Lwm2m_Debug("Unknown PSK identity %.*s\n", (int)identityLength, identity);
+            return MBEDTLS_ERR_SSL_UNKNOWN_IDENTITY;
+        }
+        result = mbedtls_ssl_set_hs_psk(context, storedKey, keyLength);
+        memset(storedKey, 0, sizeof(storedKey));
+    }
+    else
+    {
+        result = mbedtls_ssl_set_hs_psk(context, pskKey, pskKeyLength);
+    }
+    return result;
 }
 
 static int SSLSendCallBack(void * context, const unsigned char * sendBuffer, size_t sendBufferLength)
@@ -405,7 +921,7 @@ static int SSLSendCallBack(void * context, const unsigned char * sendBuffer, siz
     DTLS_Session * session = (DTLS_Session *)context;
     if (NetworkSend)
     {
-        NetworkTransmissionError error = NetworkSend(session->NetworkAddress, sendBuffer, sendBufferLength, session->UserContext);
+        NetworkTransmissionError error = NetworkSend(session->Entry.NetworkAddress, sendBuffer, sendBufferLength, session->UserContext);
         if (error == NetworkTransmissionError_None)
             result = sendBufferLength;
         else
@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include "lwm2m_debug.h"
+#include "lwm2m_util.h"
 #include "dtls_abstraction.h"
 
 #ifndef DTLSv12
@@ -53,7 +54,7 @@ typedef enum
 
 typedef struct
 {
-    NetworkAddress * NetworkAddress;
+    DTLS_SessionEntry Entry;
     session_t Session;
     dtls_context_t * Context;
     dtls_handler_t Callbacks;
@@ -66,13 +67,16 @@ typedef struct
     int BufferLength;
 }DTLS_Session;
 
-#ifndef MAX_DTLS_SESSIONS
-    #define MAX_DTLS_SESSIONS 3
+// The peer and, unless it is shared, the context TinyDTLS allocates per session
+#ifdef WITH_CONTIKI
+    #define TINYDTLS_SESSION_MEMORY (sizeof(dtls_peer_t))
+#else
+    #define TINYDTLS_SESSION_MEMORY (sizeof(dtls_peer_t) + sizeof(dtls_context_t))
 #endif
 
 const char * DTLS_LibraryName = "TinyDTLS";
 
-static DTLS_Session sessions[MAX_DTLS_SESSIONS];
+static DTLS_SessionTable sessions;
 
 static uint8_t * certificate = NULL;
 static int certificateLength = 0;
@@ -82,14 +86,18 @@ static const char * pskIdentity = NULL;
 static const uint8_t * pskKey = NULL;
 static int pskKeyLength = 0;
 
+// Keys of the identities clients present to the server, if not pskKey for all
+static DTLS_KeyStore * keyStore = NULL;
+
 static DTLS_NetworkSendCallback NetworkSend = NULL;
 
 
 static DTLS_Session * AllocateSession(NetworkAddress * address, bool client, void * context);
 static int DummySendCallBack(struct dtls_context_t *context, session_t *session, uint8 * sendBuffer, size_t sendBufferLength);
 static DTLS_Session * GetSession(NetworkAddress * address);
-static void SetupNewSession(int index, NetworkAddress * networkAddress, bool client);
+static DTLS_Session * SetupNewSession(NetworkAddress * networkAddress, bool client);
 static void FreeSession(DTLS_Session * session);
+static void FreeSessionEntry(DTLS_SessionEntry * entry);
 #ifdef DTLS_ECC
 static int CertificateVerify(struct dtls_context_t *ctx, const session_t *session, const unsigned char *other_pub_x, const unsigned char *other_pub_y, size_t key_size);
 #endif
@@ -107,7 +115,7 @@ static dtls_context_t * dtlsContext;
 
 void DTLS_Init(void)
 {
-    memset(sessions,0,sizeof(DTLS_Session) * MAX_DTLS_SESSIONS);
+    DTLS_SessionTable_Init(&sessions, sizeof(DTLS_Session), TINYDTLS_SESSION_MEMORY, FreeSessionEntry);
     dtls_init();
 #ifdef WITH_CONTIKI
     dtlsContext  = dtls_new_context(NULL);
@@ -116,14 +124,7 @@ void DTLS_Init(void)
 
 void DTLS_Shutdown(void)
 {
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
-    {
-        if (sessions[index].Context)
-        {
-            FreeSession(&sessions[index]);
-        }
-    }
+    DTLS_SessionTable_Destroy(&sessions);
 #ifdef WITH_CONTIKI
     dtls_free_context(dtlsContext);
 #endif
@@ -163,6 +164,52 @@ void DTLS_SetPSK(const char * identity, const uint8_t * key, int keyLength)
     }
 }
 
+void DTLS_SetKeyStore(DTLS_KeyStore * store)
+{
+    keyStore = store;
+}
+
+void DTLS_SetSessionLimits(uint32_t maxSessions, size_t maxMemory, uint32_t idleTimeout)
+{
+    DTLS_SessionTable_SetLimits(&sessions, maxSessions, maxMemory, idleTimeout);
+}
+
+void DTLS_GetSessionStatistics(DTLS_SessionTableStatistics * statistics)
+{
+    DTLS_SessionTable_GetStatistics(&sessions, statistics);
+}
+
+// Sessions are not resumed with TinyDTLS
+void DTLS_SetResumptionLimits(uint32_t maxEntries, uint32_t lifetime)
+{
+    (void)maxEntries;
+    (void)lifetime;
+}
+
+void DTLS_GetResumptionStatistics(DTLS_ResumptionCacheStatistics * statistics)
+{
+    DTLS_ResumptionCache_GetStatistics(NULL, statistics);
+}
+
+void DTLS_GetCookieStatistics(DTLS_CookieStatistics * statistics)
+{
+    DTLS_CookieVerifier_GetStatistics(NULL, statistics);
+}
+
+int DTLS_SetHandshakeWorkers(unsigned int workers)
+{
+    return (workers == 0) ? 0 : -1;
+}
+
+void DTLS_GetHandshakeStatistics(DTLS_HandshakePoolStatistics * statistics)
+{
+    memset(statistics, 0, sizeof(DTLS_HandshakePoolStatistics));
+}
+
+bool DTLS_IsHandshakeWorker(void)
+{
+    return false;
+}
 
 bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encryptedLength, uint8_t * decryptBuffer, int decryptBufferLength, int * decryptedLength, void *context)
 {
@@ -186,6 +233,10 @@ bool DTLS_Decrypt(NetworkAddress * sourceAddress, uint8_t * encrypted, int encry
             if (session->SessionEstablished)
             {
                 result = (*decryptedLength > 0);
+                if (result)
+                {
+                    DTLS_SessionTable_AddDecrypted(&session->Entry, *decryptedLength);
+                }
             }
             else
             {
@@ -225,10 +276,16 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
             session->BufferLength = encryptedBufferLength;
             dtls_set_app_data(session->Context, session);
             int written = dtls_write(session->Context, &session->Session, plainText, plainTextLength);
+            // anything TinyDTLS sends outside a write, such as alerts, goes to the peer rather than this buffer
+            session->Callbacks.write = SSLSendCallBack;
             if (written >= 0)
             {
                 *encryptedLength = encryptedBufferLength - session->BufferLength;
                 result = (*encryptedLength > 0);
+                if (result)
+                {
+                    DTLS_SessionTable_AddEncrypted(&session->Entry, plainTextLength);
+                }
             }
         }
         else
@@ -254,7 +311,7 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
                 FreeSession(session);
                 session = AllocateSession(destAddress, true, context);
             }
-            if (!peer)
+            if (session && !peer)
             {
                 dtls_set_app_data(session->Context, session);
                 dtls_connect(session->Context, &session->Session);
@@ -266,18 +323,11 @@ bool DTLS_Encrypt(NetworkAddress * destAddress, uint8_t * plainText, int plainTe
 
 static DTLS_Session * AllocateSession(NetworkAddress * address, bool client, void * context)
 {
-    DTLS_Session * result = NULL;
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+    DTLS_Session * result = SetupNewSession(address, client);
+    if (result)
     {
-        if (!sessions[index].Context)
-        {
-            SetupNewSession(index, address, client);
-            sessions[index].UserContext = context;
-            sessions[index].Callbacks.write = SSLSendCallBack;
-            result = &sessions[index];
-            break;
-        }
+        result->UserContext = context;
+        result->Callbacks.write = SSLSendCallBack;
     }
     return result;
 }
@@ -285,21 +335,22 @@ static DTLS_Session * AllocateSession(NetworkAddress * address, bool client, voi
 static DTLS_Session * GetSession(NetworkAddress * address)
 {
     DTLS_Session * result = NULL;
-    int index;
-    for (index = 0;index < MAX_DTLS_SESSIONS; index++)
+    DTLS_SessionEntry * entry = DTLS_SessionTable_Get(&sessions, address, Lwm2mCore_GetTickCountMs());
+    if (entry)
     {
-        if (NetworkAddress_Compare(sessions[index].NetworkAddress,address) == 0)
-        {
-            result = &sessions[index];
-            break;
-        }
+        result = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
     }
     return result;
 }
 
-static void SetupNewSession(int index, NetworkAddress * networkAddress, bool client)
+static DTLS_Session * SetupNewSession(NetworkAddress * networkAddress, bool client)
 {
-    DTLS_Session * session = &sessions[index];
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&sessions, networkAddress, Lwm2mCore_GetTickCountMs());
+    if (!entry)
+    {
+        return NULL;
+    }
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
     if (!client)
         session->Callbacks.event = EventCallBack;
     session->Callbacks.read = DecryptCallBack;
@@ -311,7 +362,6 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
     session->Callbacks.get_ecdsa_key = GetCertificate;
     session->Callbacks.verify_ecdsa_key = CertificateVerify;
 #endif
-    session->NetworkAddress = networkAddress;
 #ifdef WITH_CONTIKI
     session->Context = dtlsContext;
 #else
@@ -326,10 +376,22 @@ static void SetupNewSession(int index, NetworkAddress * networkAddress, bool cli
 //            dtls_new_peer(&session->Session);
 //        }
     }
+    else
+    {
+        FreeSession(session);
+        session = NULL;
+    }
+    return session;
 }
 
 static void FreeSession(DTLS_Session * session)
 {
+    DTLS_SessionTable_Free(&sessions, &session->Entry);
+}
+
+static void FreeSessionEntry(DTLS_SessionEntry * entry)
+{
+    DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
     if (session->Context)
     {
         session->Callbacks.write = DummySendCallBack;
@@ -342,7 +404,6 @@ static void FreeSession(DTLS_Session * session)
         dtls_free_context(session->Context);
 #endif
     }
-    memset(session,0, sizeof(DTLS_Session));
 }
 
 #if GNUTLS_VERSION_MAJOR >= 3
@@ -367,7 +428,8 @@ static int DecryptCallBack(struct dtls_context_t *context, session_t *session, u
         {
             result =  dtlsSession->BufferLength;
         }
-        memcpy(dtlsSession->Buffer, recieveBuffer, result);
+        // the record is decrypted within the received datagram, which may be the buffer
+        memmove(dtlsSession->Buffer, recieveBuffer, result);
         dtlsSession->BufferLength = dtlsSession->BufferLength - result;
         dtlsSession->Buffer += result;
     }
@@ -440,6 +502,11 @@ static int PSKCallBack(struct dtls_context_t *ctx, const session_t *session, dtl
         {
             Lwm2m_Debug("got psk_identity_hint: '%.*s'\n", (int)id_len, id);
         }
+        if (!pskIdentity && keyStore && (type == DTLS_PSK_HINT))
+        {
+            // a server with a key per client has no single identity to hint
+            return 0;
+        }
         if (!pskIdentity)
         {
             Lwm2m_Error("psk identity is not set\n");
@@ -455,6 +522,21 @@ static int PSKCallBack(struct dtls_context_t *ctx, const session_t *session, dtl
         memcpy(result, pskIdentity, pskIdentityLength);
         return pskIdentityLength;
     case DTLS_PSK_KEY:
+        if (keyStore)
+        {
+            int keyLength = DTLS_KeyStore_Lookup(keyStore, (const char *)id, id_len, result, result_length);
+            if (keyLength < 0)
+            {
+                Lwm2m_Debug("PSK for unknown id '%.*s' requested\n", (int)id_len, id);
+                return dtls_alert_fatal_create(DTLS_ALERT_ILLEGAL_PARAMETER);
+            }
+            return keyLength;
+        }
+        if (!pskIdentity)
+        {
+            Lwm2m_Error("psk identity is not set\n");
+            return dtls_alert_fatal_create(DTLS_ALERT_INTERNAL_ERROR);
+        }
         pskIdentityLength = strlen(pskIdentity);
         if (id_len != (size_t)pskIdentityLength || memcmp(pskIdentity, id, id_len) != 0)
         {
@@ -484,7 +566,7 @@ static int SSLSendCallBack(struct dtls_context_t *context, session_t *session, u
     DTLS_Session * dtlsSession = (DTLS_Session *)dtls_get_app_data(context);
     if (dtlsSession && NetworkSend)
     {
-        NetworkTransmissionError error = NetworkSend(dtlsSession->NetworkAddress, sendBuffer, sendBufferLength, dtlsSession->UserContext);
+        NetworkTransmissionError error = NetworkSend(dtlsSession->Entry.NetworkAddress, sendBuffer, sendBufferLength, dtlsSession->UserContext);
         if (error == NetworkTransmissionError_None)
             result = sendBufferLength;
         else
@@ -0,0 +1,295 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <string.h>
+
+#include "lwm2m_debug.h"
+#include "hmac.h"
+#include "dtls_cookie.h"
+
+#define RECORD_HEADER_LENGTH        (13)
+#define HANDSHAKE_HEADER_LENGTH     (12)
+
+#define CONTENT_TYPE_HANDSHAKE      (22)
+#define HANDSHAKE_CLIENT_HELLO      (1)
+#define HANDSHAKE_HELLO_VERIFY      (3)
+
+static uint32_t ReadUint16(const uint8_t * buffer)
+{
+    return ((uint32_t)buffer[0] << 8) | buffer[1];
+}
+
+static uint32_t ReadUint24(const uint8_t * buffer)
+{
+    return ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | buffer[2];
+}
+
+static void WriteUint16(uint8_t * buffer, uint32_t value)
+{
+    buffer[0] = (value >> 8) & 0xFF;
+    buffer[1] = value & 0xFF;
+}
+
+static void WriteUint24(uint8_t * buffer, uint32_t value)
+{
+    buffer[0] = (value >> 16) & 0xFF;
+    WriteUint16(&buffer[1], value);
+}
+
+// Replace the secret when it is older than its lifetime, keeping the previous one for cookies already sent
+static bool RotateSecret(DTLS_CookieVerifier * verifier, uint64_t now)
+{
+    if (verifier->HasSecret && ((verifier->SecretLifetime == 0) || (now - verifier->SecretCreated < verifier->SecretLifetime)))
+    {
+        return true;
+    }
+
+    uint8_t secret[DTLS_COOKIE_SECRET_LENGTH];
+    if ((verifier->Random == NULL) || (verifier->Random(secret, sizeof(secret)) != 0))
+    {
+        Lwm2m_Error("Failed to generate DTLS cookie secret\n");
+        return verifier->HasSecret;
+    }
+    if (verifier->HasSecret)
+    {
+        // cookies made with a secret that expired a lifetime ago are too old to accept
+        memcpy(verifier->PreviousSecret, verifier->Secret, sizeof(verifier->Secret));
+        verifier->HasPreviousSecret = (now - verifier->SecretCreated < 2 * (uint64_t)verifier->SecretLifetime);
+        verifier->Statistics.Rotations++;
+    }
+    memcpy(verifier->Secret, secret, sizeof(secret));
+    memset(secret, 0, sizeof(secret));
+    verifier->HasSecret = true;
+    verifier->SecretCreated = now;
+    return true;
+}
+
+static void ComputeCookie(const uint8_t secret[DTLS_COOKIE_SECRET_LENGTH], const uint8_t * clientId, size_t clientIdLength, uint8_t cookie[DTLS_COOKIE_LENGTH])
+{
+    uint8_t hash[SHA256_HASH_LENGTH];
+    HmacSha256_ComputeHash(hash, clientId, clientIdLength, secret, DTLS_COOKIE_SECRET_LENGTH);
+    memcpy(cookie, hash, DTLS_COOKIE_LENGTH);
+}
+
+// Compare in constant time, so that the time taken does not reveal how much of a forged cookie is right
+static bool CookiesMatch(const uint8_t * x, const uint8_t * y)
+{
+    uint8_t difference = 0;
+    int i;
+    for (i = 0; i < DTLS_COOKIE_LENGTH; i++)
+    {
+        difference |= x[i] ^ y[i];
+    }
+    return difference == 0;
+}
+
+static size_t WriteHelloVerifyRequest(const uint8_t * clientHelloRecord, const uint8_t cookie[DTLS_COOKIE_LENGTH], uint8_t * response)
+{
+    uint8_t * handshake = response + RECORD_HEADER_LENGTH;
+    uint8_t * body = handshake + HANDSHAKE_HEADER_LENGTH;
+    size_t bodyLength = 2 + 1 + DTLS_COOKIE_LENGTH;
+
+    // DTLS 1.0 for any version (RFC 6347 section 4.2.1), with the record sequence number of the ClientHello
+    response[0] = CONTENT_TYPE_HANDSHAKE;
+    response[1] = 254;
+    response[2] = 255;
+    memcpy(&response[3], &clientHelloRecord[3], 8);
+    WriteUint16(&response[11], HANDSHAKE_HEADER_LENGTH + bodyLength);
+
+    handshake[0] = HANDSHAKE_HELLO_VERIFY;
+    WriteUint24(&handshake[1], bodyLength);
+    WriteUint16(&handshake[4], 0);
+    WriteUint24(&handshake[6], 0);
+    WriteUint24(&handshake[9], bodyLength);
+
+    body[0] = 254;
+    body[1] = 255;
+    body[2] = DTLS_COOKIE_LENGTH;
+    memcpy(&body[3], cookie, DTLS_COOKIE_LENGTH);
+    return RECORD_HEADER_LENGTH + HANDSHAKE_HEADER_LENGTH + bodyLength;
+}
+
+int DTLS_CookieVerifier_Init(DTLS_CookieVerifier * verifier, DTLS_CookieRandomCallback random)
+{
+    if (verifier == NULL)
+    {
+        return -1;
+    }
+    memset(verifier, 0, sizeof(*verifier));
+    verifier->Random = random;
+    verifier->SecretLifetime = DTLS_COOKIE_SECRET_LIFETIME;
+    return 0;
+}
+
+void DTLS_CookieVerifier_Destroy(DTLS_CookieVerifier * verifier)
+{
+    if (verifier != NULL)
+    {
+        memset(verifier->Secret, 0, sizeof(verifier->Secret));
+        memset(verifier->PreviousSecret, 0, sizeof(verifier->PreviousSecret));
+        verifier->HasSecret = false;
+        verifier->HasPreviousSecret = false;
+    }
+}
+
+void DTLS_CookieVerifier_SetSecretLifetime(DTLS_CookieVerifier * verifier, uint32_t lifetime)
+{
+    if (verifier != NULL)
+    {
+        verifier->SecretLifetime = lifetime;
+    }
+}
+
+int DTLS_CookieVerifier_WriteCookie(DTLS_CookieVerifier * verifier, const uint8_t * clientId, size_t clientIdLength,
+        uint8_t cookie[DTLS_COOKIE_LENGTH], uint64_t now)
+{
+    if ((verifier == NULL) || (clientId == NULL) || (cookie == NULL) || !RotateSecret(verifier, now))
+    {
+        return -1;
+    }
+    ComputeCookie(verifier->Secret, clientId, clientIdLength, cookie);
+    return 0;
+}
+
+bool DTLS_CookieVerifier_CheckCookie(DTLS_CookieVerifier * verifier, const uint8_t * clientId, size_t clientIdLength,
+        const uint8_t * cookie, size_t cookieLength, uint64_t now)
+{
+    bool result = false;
+    if ((verifier != NULL) && (clientId != NULL) && (cookie != NULL) && (cookieLength == DTLS_COOKIE_LENGTH) && RotateSecret(verifier, now))
+    {
+        uint8_t expected[DTLS_COOKIE_LENGTH];
+        ComputeCookie(verifier->Secret, clientId, clientIdLength, expected);
+        result = CookiesMatch(cookie, expected);
+        if (!result && verifier->HasPreviousSecret)
+        {
+            ComputeCookie(verifier->PreviousSecret, clientId, clientIdLength, expected);
+            result = CookiesMatch(cookie, expected);
+        }
+    }
+    return result;
+}
+
+DTLS_CookieResult DTLS_CookieVerifier_CheckClientHello(DTLS_CookieVerifier * verifier, NetworkAddress * address,
+        const uint8_t * datagram, size_t datagramLength, DTLS_ClientHello * hello,
+        uint8_t * response, size_t responseSize, size_t * responseLength, uint64_t now)
+{
+    uint8_t clientId[NETWORK_ADDRESS_MAX_SERIALISED_LENGTH];
+    const uint8_t * handshake;
+    const uint8_t * body;
+    size_t recordLength, length, position, cookieLength;
+    int clientIdLength;
+
+    if ((verifier == NULL) || (datagram == NULL))
+    {
+        return DTLS_CookieResult_Drop;
+    }
+
+    // an unfragmented ClientHello in epoch 0
+    if ((datagramLength < RECORD_HEADER_LENGTH + HANDSHAKE_HEADER_LENGTH) || (datagram[0] != CONTENT_TYPE_HANDSHAKE) ||
+        (ReadUint16(&datagram[3]) != 0))
+    {
+        goto drop;
+    }
+    recordLength = ReadUint16(&datagram[11]);
+    handshake = datagram + RECORD_HEADER_LENGTH;
+    length = ReadUint24(&handshake[1]);
+    if ((RECORD_HEADER_LENGTH + recordLength > datagramLength) || (handshake[0] != HANDSHAKE_CLIENT_HELLO) ||
+        (ReadUint24(&handshake[6]) != 0) || (ReadUint24(&handshake[9]) != length) || (HANDSHAKE_HEADER_LENGTH + length > recordLength))
+    {
+        goto drop;
+    }
+
+    // client version and random, then the session ID and cookie, each with a 1 byte length
+    body = handshake + HANDSHAKE_HEADER_LENGTH;
+    position = 2 + 32;
+    if (position + 1 > length)
+    {
+        goto drop;
+    }
+    position += 1 + body[position];
+    if (position + 1 > length)
+    {
+        goto drop;
+    }
+    cookieLength = body[position];
+    position++;
+    if (position + cookieLength > length)
+    {
+        goto drop;
+    }
+
+    clientIdLength = NetworkAddress_Serialise(address, clientId, sizeof(clientId));
+    if (clientIdLength == 0)
+    {
+        goto drop;
+    }
+
+    if (cookieLength > 0)
+    {
+        if (DTLS_CookieVerifier_CheckCookie(verifier, clientId, clientIdLength, &body[position], cookieLength, now))
+        {
+            if (hello)
+            {
+                int i;
+                hello->RecordSequence = 0;
+                for (i = 5; i < 11; i++)
+                {
+                    hello->RecordSequence = (hello->RecordSequence << 8) | datagram[i];
+                }
+                hello->MessageSequence = ReadUint16(&handshake[4]);
+            }
+            verifier->Statistics.Verified++;
+            return DTLS_CookieResult_Verified;
+        }
+        verifier->Statistics.Invalid++;
+    }
+
+    if ((response != NULL) && (responseLength != NULL) && (responseSize >= DTLS_HELLO_VERIFY_REQUEST_LENGTH))
+    {
+        uint8_t cookie[DTLS_COOKIE_LENGTH];
+        if (DTLS_CookieVerifier_WriteCookie(verifier, clientId, clientIdLength, cookie, now) == 0)
+        {
+            *responseLength = WriteHelloVerifyRequest(datagram, cookie, response);
+            verifier->Statistics.HelloVerifySent++;
+            return DTLS_CookieResult_HelloVerify;
+        }
+    }
+
+drop:
+    verifier->Statistics.Dropped++;
+    return DTLS_CookieResult_Drop;
+}
+
+void DTLS_CookieVerifier_GetStatistics(const DTLS_CookieVerifier * verifier, DTLS_CookieStatistics * statistics)
+{
+    if (statistics != NULL)
+    {
+        if (verifier != NULL)
+        {
+            *statistics = verifier->Statistics;
+        }
+        else
+        {
+            memset(statistics, 0, sizeof(*statistics));
+        }
+    }
+}
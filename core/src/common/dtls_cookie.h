@@ -0,0 +1,135 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+#ifndef DTLS_COOKIE_H
+#define DTLS_COOKIE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "network_abstraction.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Stateless DTLS cookie exchange (RFC 6347 section 4.2.1). A server checks a datagram from a peer that
+ *  has no session before creating one:
+ *
+ *     switch (DTLS_CookieVerifier_CheckClientHello(&verifier, address, datagram, length, &hello,
+ *                                                  response, sizeof(response), &responseLength, now))
+ *     {
+ *         case DTLS_CookieResult_Verified:      create a session and hand it the ClientHello
+ *         case DTLS_CookieResult_HelloVerify:   send the HelloVerifyRequest in response to the peer
+ *         case DTLS_CookieResult_Drop:          ignore the datagram
+ *     }
+ *
+ *  A peer only gets a session once it returns a cookie, which proves that it receives datagrams at its
+ *  address, and no state is kept before then. Cookies are an HMAC of the peer address with a secret that
+ *  is replaced every DTLS_COOKIE_SECRET_LIFETIME, and a cookie made with the previous secret is accepted.
+ */
+
+#define DTLS_COOKIE_LENGTH                  (16)
+#define DTLS_COOKIE_SECRET_LENGTH           (32)
+
+// Record and handshake headers, version, and cookie
+#define DTLS_HELLO_VERIFY_REQUEST_LENGTH    (13 + 12 + 2 + 1 + DTLS_COOKIE_LENGTH)
+
+#ifndef DTLS_COOKIE_SECRET_LIFETIME
+    #define DTLS_COOKIE_SECRET_LIFETIME     (60 * 1000)                 // milliseconds
+#endif
+
+// Fill buffer with length cryptographically secure random bytes. Returns 0 on success.
+typedef int (*DTLS_CookieRandomCallback)(uint8_t * buffer, size_t length);
+
+typedef enum
+{
+    DTLS_CookieResult_Verified,         // ClientHello with a valid cookie
+    DTLS_CookieResult_HelloVerify,      // ClientHello without a valid cookie, answer with the response
+    DTLS_CookieResult_Drop,             // Not an initial ClientHello
+
+} DTLS_CookieResult;
+
+typedef struct
+{
+    uint32_t HelloVerifySent;           // ClientHellos answered with a cookie
+    uint32_t Verified;                  // ClientHellos that returned a valid cookie
+    uint32_t Invalid;                   // ClientHellos with a cookie that is wrong or too old
+    uint32_t Dropped;                   // Datagrams that are not an initial ClientHello
+    uint32_t Rotations;                 // Times the secret was replaced
+
+} DTLS_CookieStatistics;
+
+// Sequence numbers of a verified ClientHello, which the server continues from
+typedef struct
+{
+    uint64_t RecordSequence;
+    uint16_t MessageSequence;
+
+} DTLS_ClientHello;
+
+typedef struct
+{
+    DTLS_CookieRandomCallback Random;
+    uint8_t Secret[DTLS_COOKIE_SECRET_LENGTH];
+    uint8_t PreviousSecret[DTLS_COOKIE_SECRET_LENGTH];
+    bool HasSecret;
+    bool HasPreviousSecret;
+    uint64_t SecretCreated;
+    uint32_t SecretLifetime;
+    DTLS_CookieStatistics Statistics;
+
+} DTLS_CookieVerifier;
+
+int DTLS_CookieVerifier_Init(DTLS_CookieVerifier * verifier, DTLS_CookieRandomCallback random);
+
+// Forget the secrets
+void DTLS_CookieVerifier_Destroy(DTLS_CookieVerifier * verifier);
+
+// Replace the secret every lifetime milliseconds
+void DTLS_CookieVerifier_SetSecretLifetime(DTLS_CookieVerifier * verifier, uint32_t lifetime);
+
+/* Check the first record of a datagram from a peer without a session. hello is set to the sequence numbers of a
+ * verified ClientHello, and response to the HelloVerifyRequest to send, which needs
+ * DTLS_HELLO_VERIFY_REQUEST_LENGTH bytes.
+ */
+DTLS_CookieResult DTLS_CookieVerifier_CheckClientHello(DTLS_CookieVerifier * verifier, NetworkAddress * address,
+        const uint8_t * datagram, size_t datagramLength, DTLS_ClientHello * hello,
+        uint8_t * response, size_t responseSize, size_t * responseLength, uint64_t now);
+
+/* Write the cookie of a peer identified by clientId, such as a serialised NetworkAddress. Returns 0 on success.
+ * For DTLS libraries that exchange cookies themselves.
+ */
+int DTLS_CookieVerifier_WriteCookie(DTLS_CookieVerifier * verifier, const uint8_t * clientId, size_t clientIdLength,
+        uint8_t cookie[DTLS_COOKIE_LENGTH], uint64_t now);
+
+bool DTLS_CookieVerifier_CheckCookie(DTLS_CookieVerifier * verifier, const uint8_t * clientId, size_t clientIdLength,
+        const uint8_t * cookie, size_t cookieLength, uint64_t now);
+
+void DTLS_CookieVerifier_GetStatistics(const DTLS_CookieVerifier * verifier, DTLS_CookieStatistics * statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DTLS_COOKIE_H
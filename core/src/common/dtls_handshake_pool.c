@@ -0,0 +1,359 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "lwm2m_debug.h"
+#include "dtls_handshake_pool.h"
+
+typedef struct
+{
+    struct ListHead list;
+    size_t Length;
+    uint8_t Data[];
+
+} QueuedDatagram;
+
+struct _DTLS_HandshakePool
+{
+    pthread_mutex_t Lock;                   // Guards the pool and the queue and state of every job
+    pthread_cond_t Work;                    // Signalled when a job is queued, or the workers must stop
+    pthread_cond_t Finished;                // Signalled when a worker finishes running a job
+    struct ListHead RunQueue;
+    struct ListHead Completed;
+    DTLS_HandshakeStep Step;
+    pthread_t * Threads;
+    unsigned int ThreadCount;
+    bool Stopping;
+    DTLS_HandshakePoolStatistics Statistics;
+
+};
+
+static __thread bool isWorker = false;
+
+static bool ListIsEmpty(const struct ListHead * list)
+{
+    return list->Next == list;
+}
+
+// Move the entries of from to the empty list to
+static void MoveList(struct ListHead * to, struct ListHead * from)
+{
+    ListInit(to);
+    if (!ListIsEmpty(from))
+    {
+        to->Next = from->Next;
+        to->Prev = from->Prev;
+        to->Next->Prev = to;
+        to->Prev->Next = to;
+        ListInit(from);
+    }
+}
+
+static void FreeDatagrams(struct ListHead * datagrams)
+{
+    struct ListHead * i, * n;
+    ListForEachSafe(i, n, datagrams)
+    {
+        QueuedDatagram * datagram = ListEntry(i, QueuedDatagram, list);
+        ListRemove(&datagram->list);
+        free(datagram);
+    }
+}
+
+// Return a job to the idle state, with the pool locked and no worker running it
+static void ResetJob(DTLS_HandshakePool * pool, DTLS_HandshakeJob * job)
+{
+    if (job->State == DTLS_HandshakeJobState_Queued)
+    {
+        pool->Statistics.Pending--;
+    }
+    ListRemove(&job->Queue);
+    FreeDatagrams(&job->Datagrams);
+    job->DatagramCount = 0;
+    job->State = DTLS_HandshakeJobState_Idle;
+}
+
+static void * RunWorker(void * context)
+{
+    DTLS_HandshakePool * pool = (DTLS_HandshakePool *)context;
+    isWorker = true;
+
+    pthread_mutex_lock(&pool->Lock);
+    while (!pool->Stopping)
+    {
+        struct ListHead datagrams;
+        struct ListHead * i, * n;
+        DTLS_HandshakeJob * job;
+        DTLS_HandshakeResult result = DTLS_HandshakeResult_InProgress;
+
+        if (ListIsEmpty(&pool->RunQueue))
+        {
+            pthread_cond_wait(&pool->Work, &pool->Lock);
+            continue;
+        }
+        job = ListEntry(pool->RunQueue.Next, DTLS_HandshakeJob, Queue);
+        ListRemove(&job->Queue);
+        job->State = DTLS_HandshakeJobState_Running;
+
+        // datagrams submitted while the job runs wait for its next run
+        MoveList(&datagrams, &job->Datagrams);
+        job->DatagramCount = 0;
+        pthread_mutex_unlock(&pool->Lock);
+
+        ListForEachSafe(i, n, &datagrams)
+        {
+            QueuedDatagram * datagram = ListEntry(i, QueuedDatagram, list);
+            if (result == DTLS_HandshakeResult_InProgress)
+            {
+                result = pool->Step(job, datagram->Data, datagram->Length);
+            }
+            ListRemove(&datagram->list);
+            free(datagram);
+        }
+
+        pthread_mutex_lock(&pool->Lock);
+        if (result != DTLS_HandshakeResult_InProgress)
+        {
+            FreeDatagrams(&job->Datagrams);
+            job->DatagramCount = 0;
+            job->Result = result;
+            job->State = DTLS_HandshakeJobState_Completed;
+            ListAdd(&job->Queue, &pool->Completed);
+            pool->Statistics.Pending--;
+            if (result == DTLS_HandshakeResult_Established)
+                pool->Statistics.Established++;
+            else
+                pool->Statistics.Failed++;
+        }
+        else if (job->DatagramCount > 0)
+        {
+            // to the back of the queue, so a peer cannot hold a worker with a stream of datagrams
+            job->State = DTLS_HandshakeJobState_Queued;
+            ListAdd(&job->Queue, &pool->RunQueue);
+        }
+        else
+        {
+            job->State = DTLS_HandshakeJobState_Idle;
+            pool->Statistics.Pending--;
+        }
+        pthread_cond_broadcast(&pool->Finished);
+    }
+    pthread_mutex_unlock(&pool->Lock);
+    return NULL;
+}
+
+DTLS_HandshakePool * DTLS_HandshakePool_New(unsigned int workers, DTLS_HandshakeStep step)
+{
+    DTLS_HandshakePool * pool = NULL;
+    if ((workers == 0) || (step == NULL))
+    {
+        goto error;
+    }
+
+    pool = (DTLS_HandshakePool *)malloc(sizeof(DTLS_HandshakePool));
+    if (pool == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for DTLS handshake pool\n");
+        goto error;
+    }
+    memset(pool, 0, sizeof(DTLS_HandshakePool));
+    pthread_mutex_init(&pool->Lock, NULL);
+    pthread_cond_init(&pool->Work, NULL);
+    pthread_cond_init(&pool->Finished, NULL);
+    ListInit(&pool->RunQueue);
+    ListInit(&pool->Completed);
+    pool->Step = step;
+
+    pool->Threads = (pthread_t *)malloc(workers * sizeof(pthread_t));
+    if (pool->Threads == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for DTLS handshake workers\n");
+        goto error;
+    }
+    for (pool->ThreadCount = 0; pool->ThreadCount < workers; pool->ThreadCount++)
+    {
+        if (pthread_create(&pool->Threads[pool->ThreadCount], NULL, RunWorker, pool) != 0)
+        {
+            Lwm2m_Error("Failed to start DTLS handshake worker %u\n", pool->ThreadCount);
+            goto error;
+        }
+    }
+    pool->Statistics.Workers = workers;
+    return pool;
+
+error:
+    DTLS_HandshakePool_Free(&pool);
+    return NULL;
+}
+
+void DTLS_HandshakePool_Free(DTLS_HandshakePool ** pool)
+{
+    if ((pool != NULL) && (*pool != NULL))
+    {
+        struct ListHead * i, * n;
+        unsigned int worker;
+
+        pthread_mutex_lock(&(*pool)->Lock);
+        (*pool)->Stopping = true;
+        pthread_cond_broadcast(&(*pool)->Work);
+        pthread_mutex_unlock(&(*pool)->Lock);
+        for (worker = 0; worker < (*pool)->ThreadCount; worker++)
+        {
+            pthread_join((*pool)->Threads[worker], NULL);
+        }
+
+        ListForEachSafe(i, n, &(*pool)->RunQueue)
+        {
+            DTLS_HandshakeJob * job = ListEntry(i, DTLS_HandshakeJob, Queue);
+            ResetJob(*pool, job);
+        }
+        ListForEachSafe(i, n, &(*pool)->Completed)
+        {
+            DTLS_HandshakeJob * job = ListEntry(i, DTLS_HandshakeJob, Queue);
+            ResetJob(*pool, job);
+        }
+
+        pthread_cond_destroy(&(*pool)->Finished);
+        pthread_cond_destroy(&(*pool)->Work);
+        pthread_mutex_destroy(&(*pool)->Lock);
+        free((*pool)->Threads);
+        free(*pool);
+        *pool = NULL;
+    }
+}
+
+void DTLS_HandshakeJob_Init(DTLS_HandshakeJob * job)
+{
+    memset(job, 0, sizeof(DTLS_HandshakeJob));
+    ListInit(&job->Queue);
+    ListInit(&job->Datagrams);
+    job->State = DTLS_HandshakeJobState_Idle;
+    job->Result = DTLS_HandshakeResult_InProgress;
+}
+
+bool DTLS_HandshakeJob_IsActive(const DTLS_HandshakeJob * job)
+{
+    // only the owning thread moves a job out of the idle state, so an idle job stays idle for it
+    return job->State != DTLS_HandshakeJobState_Idle;
+}
+
+int DTLS_HandshakePool_Submit(DTLS_HandshakePool * pool, DTLS_HandshakeJob * job, const uint8_t * datagram, size_t length)
+{
+    int result = -1;
+    QueuedDatagram * queued;
+
+    if ((pool == NULL) || (job == NULL) || ((datagram == NULL) && (length > 0)))
+    {
+        return -1;
+    }
+
+    queued = (QueuedDatagram *)malloc(sizeof(QueuedDatagram) + length);
+    if (queued == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for DTLS handshake datagram\n");
+        return -1;
+    }
+    queued->Length = length;
+    if (length > 0)
+    {
+        memcpy(queued->Data, datagram, length);
+    }
+
+    pthread_mutex_lock(&pool->Lock);
+    if ((job->State != DTLS_HandshakeJobState_Completed) && (job->DatagramCount < DTLS_HANDSHAKE_MAX_QUEUED_DATAGRAMS))
+    {
+        ListAdd(&queued->list, &job->Datagrams);
+        job->DatagramCount++;
+        pool->Statistics.Submitted++;
+        if (job->State == DTLS_HandshakeJobState_Idle)
+        {
+            job->State = DTLS_HandshakeJobState_Queued;
+            job->Result = DTLS_HandshakeResult_InProgress;
+            ListAdd(&job->Queue, &pool->RunQueue);
+            pool->Statistics.Pending++;
+            pthread_cond_signal(&pool->Work);
+        }
+        queued = NULL;
+        result = 0;
+    }
+    else
+    {
+        pool->Statistics.Dropped++;
+    }
+    pthread_mutex_unlock(&pool->Lock);
+
+    free(queued);
+    return result;
+}
+
+DTLS_HandshakeJob * DTLS_HandshakePool_TakeCompleted(DTLS_HandshakePool * pool)
+{
+    DTLS_HandshakeJob * job = NULL;
+    if (pool != NULL)
+    {
+        pthread_mutex_lock(&pool->Lock);
+        if (!ListIsEmpty(&pool->Completed))
+        {
+            job = ListEntry(pool->Completed.Next, DTLS_HandshakeJob, Queue);
+            ListRemove(&job->Queue);
+            job->State = DTLS_HandshakeJobState_Idle;
+        }
+        pthread_mutex_unlock(&pool->Lock);
+    }
+    return job;
+}
+
+void DTLS_HandshakePool_Cancel(DTLS_HandshakePool * pool, DTLS_HandshakeJob * job)
+{
+    if ((pool != NULL) && (job != NULL))
+    {
+        pthread_mutex_lock(&pool->Lock);
+        while (job->State == DTLS_HandshakeJobState_Running)
+        {
+            pthread_cond_wait(&pool->Finished, &pool->Lock);
+        }
+        ResetJob(pool, job);
+        pthread_mutex_unlock(&pool->Lock);
+    }
+}
+
+bool DTLS_HandshakePool_IsWorker(void)
+{
+    return isWorker;
+}
+
+void DTLS_HandshakePool_GetStatistics(DTLS_HandshakePool * pool, DTLS_HandshakePoolStatistics * statistics)
+{
+    if (statistics != NULL)
+    {
+        memset(statistics, 0, sizeof(DTLS_HandshakePoolStatistics));
+        if (pool != NULL)
+        {
+            pthread_mutex_lock(&pool->Lock);
+            *statistics = pool->Statistics;
+            pthread_mutex_unlock(&pool->Lock);
+        }
+    }
+}
@@ -0,0 +1,143 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+#ifndef DTLS_HANDSHAKE_POOL_H
+#define DTLS_HANDSHAKE_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lwm2m_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Worker threads that run the handshakes of a DTLS backend, so that a burst of full handshakes does not
+ *  hold up the records of established sessions on the thread that reads the socket. Each backend embeds a
+ *  DTLS_HandshakeJob in its session structure, and gives the pool a step function that feeds one datagram
+ *  to the handshake of a session:
+ *
+ *     static DTLS_HandshakeResult HandshakeStep(DTLS_HandshakeJob * job, uint8_t * datagram, size_t length)
+ *     {
+ *         DTLS_Session * session = ... container of job ...;
+ *         ... continue the handshake with the datagram, which is empty to only retransmit ...
+ *     }
+ *
+ *     pool = DTLS_HandshakePool_New(workers, HandshakeStep);
+ *
+ *  Datagrams for a session that is still handshaking are submitted to its job, and a worker steps the job
+ *  through them in order. A job is only run by one worker at a time, so the library state of a session is
+ *  only touched by one thread. Once the handshake ends, the job is queued as completed, and the thread that
+ *  owns the sessions takes the session back:
+ *
+ *     DTLS_HandshakePool_Submit(pool, &session->Handshake, datagram, length);
+ *     ...
+ *     while ((job = DTLS_HandshakePool_TakeCompleted(pool)) != NULL)
+ *         ... use the session if job->Result is DTLS_HandshakeResult_Established, otherwise free it ...
+ *
+ *  Step functions run on the workers, so anything they share with other sessions must be thread-safe. The
+ *  sessions themselves stay on the owning thread, which cancels the job before freeing a session.
+ */
+
+#ifndef DTLS_HANDSHAKE_MAX_QUEUED_DATAGRAMS
+    #define DTLS_HANDSHAKE_MAX_QUEUED_DATAGRAMS     (8)         // per job, further datagrams are dropped
+#endif
+
+typedef enum
+{
+    DTLS_HandshakeResult_InProgress,
+    DTLS_HandshakeResult_Established,
+    DTLS_HandshakeResult_Failed
+
+} DTLS_HandshakeResult;
+
+typedef enum
+{
+    DTLS_HandshakeJobState_Idle,            // Owned by the thread that submits datagrams
+    DTLS_HandshakeJobState_Queued,
+    DTLS_HandshakeJobState_Running,
+    DTLS_HandshakeJobState_Completed        // Waiting to be taken back with DTLS_HandshakePool_TakeCompleted
+
+} DTLS_HandshakeJobState;
+
+typedef struct
+{
+    struct ListHead Queue;                  // Position in the run or completed queue of the pool
+    struct ListHead Datagrams;              // Datagrams submitted and not yet stepped through
+    uint32_t DatagramCount;
+    DTLS_HandshakeJobState State;
+    DTLS_HandshakeResult Result;
+
+} DTLS_HandshakeJob;
+
+typedef struct
+{
+    uint32_t Workers;
+    uint32_t Pending;                       // Jobs queued or running
+    uint32_t Submitted;                     // Datagrams submitted to jobs
+    uint32_t Dropped;                       // Datagrams dropped, as their job had too many queued
+    uint32_t Established;                   // Handshakes completed
+    uint32_t Failed;
+
+} DTLS_HandshakePoolStatistics;
+
+// Continue the handshake of a job with a datagram, which is empty (length 0) to retransmit if it is time to
+typedef DTLS_HandshakeResult (*DTLS_HandshakeStep)(DTLS_HandshakeJob * job, uint8_t * datagram, size_t length);
+
+typedef struct _DTLS_HandshakePool DTLS_HandshakePool;
+
+// Start workers threads that run handshakes with step. Returns NULL if the threads cannot be started.
+DTLS_HandshakePool * DTLS_HandshakePool_New(unsigned int workers, DTLS_HandshakeStep step);
+
+/* Stop the workers, after they finish the step they are running. Jobs still queued or completed are returned to
+ * the idle state, so their sessions can carry on handshaking without the pool.
+ */
+void DTLS_HandshakePool_Free(DTLS_HandshakePool ** pool);
+
+void DTLS_HandshakeJob_Init(DTLS_HandshakeJob * job);
+
+// Whether the job is queued, running or completed, rather than owned by the calling thread
+bool DTLS_HandshakeJob_IsActive(const DTLS_HandshakeJob * job);
+
+/* Copy a datagram to the queue of a job, and queue the job to run if it is idle. An empty datagram asks the job
+ * to retransmit. Returns -1 if the datagram is dropped: the job has completed, or has too many datagrams queued.
+ */
+int DTLS_HandshakePool_Submit(DTLS_HandshakePool * pool, DTLS_HandshakeJob * job, const uint8_t * datagram, size_t length);
+
+// Return the next job whose handshake has ended, now idle, or NULL if there is none
+DTLS_HandshakeJob * DTLS_HandshakePool_TakeCompleted(DTLS_HandshakePool * pool);
+
+// Take a job out of the pool and drop its datagrams, waiting for a worker that is running it
+void DTLS_HandshakePool_Cancel(DTLS_HandshakePool * pool, DTLS_HandshakeJob * job);
+
+// Whether the calling thread is a worker of a pool, for code that must not run there
+bool DTLS_HandshakePool_IsWorker(void);
+
+void DTLS_HandshakePool_GetStatistics(DTLS_HandshakePool * pool, DTLS_HandshakePoolStatistics * statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DTLS_HANDSHAKE_POOL_H
@@ -0,0 +1,600 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef CONTIKI
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "lwm2m_debug.h"
+#include "lwm2m_list.h"
+#include "lwm2m_hash_table.h"
+#include "dtls_keystore.h"
+
+typedef enum
+{
+    KeyStoreType_Custom,
+    KeyStoreType_Memory,
+    KeyStoreType_Mapped,
+
+} KeyStoreType;
+
+typedef struct
+{
+    struct ListHead list;
+    HashTableEntry Entry;
+    uint8_t Key[DTLS_KEYSTORE_MAX_KEY_LENGTH];
+    size_t KeyLength;
+    size_t IdentityLength;
+    char Identity[];
+
+} KeyStoreEntry;
+
+struct _DTLS_KeyStore
+{
+    KeyStoreType Type;
+    DTLS_KeyStoreLookupCallback Lookup;
+    DTLS_KeyStoreFreeCallback Free;
+    void * Context;
+    size_t Count;
+
+    // KeyStoreType_Memory
+    HashTable Keys;
+    struct ListHead Entries;
+
+    // KeyStoreType_Mapped
+    const char * Data;
+    size_t Size;
+
+};
+
+// A key file line, where Identity is NULL for blank lines and comments
+typedef struct
+{
+    const char * Identity;
+    size_t IdentityLength;
+    const char * HexKey;
+    size_t HexKeyLength;
+
+} KeyFileLine;
+
+static bool IsSpace(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+static int HexDigit(char c)
+{
+    if ((c >= '0') && (c <= '9'))
+        return c - '0';
+    if ((c >= 'a') && (c <= 'f'))
+        return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F'))
+        return c - 'A' + 10;
+    return -1;
+}
+
+static int DecodeHex(const char * hex, size_t hexLength, uint8_t * key, size_t keySize)
+{
+    size_t i;
+    if ((hexLength == 0) || (hexLength % 2 != 0) || (hexLength / 2 > keySize))
+    {
+        return -1;
+    }
+    for (i = 0; i < hexLength / 2; i++)
+    {
+        int high = HexDigit(hex[2 * i]);
+        int low = HexDigit(hex[2 * i + 1]);
+        if ((high < 0) || (low < 0))
+        {
+            return -1;
+        }
+        key[i] = (high << 4) | low;
+    }
+    return hexLength / 2;
+}
+
+// Split the line from start up to end (excluding the newline). Returns false if the line is invalid.
+static bool ParseLine(const char * start, const char * end, KeyFileLine * line)
+{
+    const char * position = start;
+    uint8_t key[DTLS_KEYSTORE_MAX_KEY_LENGTH];
+
+    memset(line, 0, sizeof(*line));
+    while ((position < end) && IsSpace(*position))
+        position++;
+    if ((position == end) || (*position == '#'))
+    {
+        return true;
+    }
+
+    line->Identity = position;
+    while ((position < end) && !IsSpace(*position))
+        position++;
+    line->IdentityLength = position - line->Identity;
+
+    while ((position < end) && IsSpace(*position))
+        position++;
+    line->HexKey = position;
+    while ((position < end) && !IsSpace(*position))
+        position++;
+    line->HexKeyLength = position - line->HexKey;
+
+    while ((position < end) && IsSpace(*position))
+        position++;
+
+    return (position == end) && (line->IdentityLength <= DTLS_KEYSTORE_MAX_IDENTITY_LENGTH) &&
+           (DecodeHex(line->HexKey, line->HexKeyLength, key, sizeof(key)) >= 0);
+}
+
+// Order identities as their bytes, which is the order of LC_ALL=C sort for printable identities
+static int CompareIdentities(const char * identity1, size_t length1, const char * identity2, size_t length2)
+{
+    int result = memcmp(identity1, identity2, (length1 < length2) ? length1 : length2);
+    if (result == 0)
+    {
+        result = (length1 < length2) ? -1 : (length1 > length2) ? 1 : 0;
+    }
+    return result;
+}
+
+static const char * LineEnd(const char * data, size_t size, const char * start)
+{
+    const char * end = memchr(start, '\n', data + size - start);
+    return (end != NULL) ? end : data + size;
+}
+
+static int LookupMemory(void * context, const char * identity, size_t identityLength, uint8_t * key, size_t keySize)
+{
+    DTLS_KeyStore * store = context;
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &store->Keys, HashTable_HashBytes(0, identity, identityLength))
+    {
+        KeyStoreEntry * keyEntry = HashTableContainer(entry, KeyStoreEntry, Entry);
+        if ((keyEntry->IdentityLength == identityLength) && (memcmp(keyEntry->Identity, identity, identityLength) == 0))
+        {
+            if (keyEntry->KeyLength > keySize)
+            {
+                return -1;
+            }
+            memcpy(key, keyEntry->Key, keyEntry->KeyLength);
+            return keyEntry->KeyLength;
+        }
+    }
+    return -1;
+}
+
+// Binary search of the lines between offsets low and high, which always start a line
+static int LookupMapped(void * context, const char * identity, size_t identityLength, uint8_t * key, size_t keySize)
+{
+    DTLS_KeyStore * store = context;
+    const char * data = store->Data;
+    size_t low = 0;
+    size_t high = store->Size;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        size_t start = middle;
+        const char * lineStart;
+        const char * lineEnd;
+        KeyFileLine line;
+
+        while ((start > low) && (data[start - 1] != '\n'))
+            start--;
+
+        // skip comments, which are not in identity order
+        lineStart = data + start;
+        for (;;)
+        {
+            lineEnd = LineEnd(data, store->Size, lineStart);
+            ParseLine(lineStart, lineEnd, &line);
+            if ((line.Identity != NULL) || ((size_t)(lineEnd - data) + 1 >= high))
+                break;
+            lineStart = lineEnd + 1;
+        }
+
+        int comparison = (line.Identity != NULL) ? CompareIdentities(identity, identityLength, line.Identity, line.IdentityLength) : -1;
+        if (comparison == 0)
+        {
+            return DecodeHex(line.HexKey, line.HexKeyLength, key, keySize);
+        }
+        else if (comparison < 0)
+        {
+            high = start;
+        }
+        else
+        {
+            low = lineEnd - data + 1;
+        }
+    }
+    return -1;
+}
+
+static DTLS_KeyStore * NewStore(KeyStoreType type)
+{
+    DTLS_KeyStore * store = malloc(sizeof(DTLS_KeyStore));
+    if (store == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for key store\n");
+        return NULL;
+    }
+    memset(store, 0, sizeof(DTLS_KeyStore));
+    store->Type = type;
+    store->Context = store;
+    ListInit(&store->Entries);
+    return store;
+}
+
+DTLS_KeyStore * DTLS_KeyStore_New(DTLS_KeyStoreLookupCallback lookup, DTLS_KeyStoreFreeCallback free, void * context)
+{
+    DTLS_KeyStore * store = NULL;
+    if (lookup != NULL)
+    {
+        store = NewStore(KeyStoreType_Custom);
+        if (store != NULL)
+        {
+            store->Lookup = lookup;
+            store->Free = free;
+            store->Context = context;
+        }
+    }
+    return store;
+}
+
+DTLS_KeyStore * DTLS_KeyStore_NewMemory(void)
+{
+    DTLS_KeyStore * store = NewStore(KeyStoreType_Memory);
+    if (store != NULL)
+    {
+        if (HashTable_Init(&store->Keys, 0) != 0)
+        {
+            free(store);
+            return NULL;
+        }
+        store->Lookup = LookupMemory;
+    }
+    return store;
+}
+
+int DTLS_KeyStore_Add(DTLS_KeyStore * store, const char * identity, size_t identityLength, const uint8_t * key, size_t keyLength)
+{
+    KeyStoreEntry * keyEntry;
+    HashTableEntry * entry;
+    uint32_t hash;
+
+    if ((store == NULL) || (store->Type != KeyStoreType_Memory) || (identity == NULL) || (key == NULL) ||
+        (identityLength > DTLS_KEYSTORE_MAX_IDENTITY_LENGTH) || (keyLength == 0) || (keyLength > DTLS_KEYSTORE_MAX_KEY_LENGTH))
+    {
+        return -1;
+    }
+
+    hash = HashTable_HashBytes(0, identity, identityLength);
+    HashTable_ForEachWithHash(entry, &store->Keys, hash)
+    {
+        keyEntry = HashTableContainer(entry, KeyStoreEntry, Entry);
+        if ((keyEntry->IdentityLength == identityLength) && (memcmp(keyEntry->Identity, identity, identityLength) == 0))
+        {
+            memcpy(keyEntry->Key, key, keyLength);
+            keyEntry->KeyLength = keyLength;
+            return 0;
+        }
+    }
+
+    keyEntry = malloc(sizeof(KeyStoreEntry) + identityLength);
+    if (keyEntry == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for key store entry\n");
+        return -1;
+    }
+    memcpy(keyEntry->Key, key, keyLength);
+    keyEntry->KeyLength = keyLength;
+    memcpy(keyEntry->Identity, identity, identityLength);
+    keyEntry->IdentityLength = identityLength;
+    ListAdd(&keyEntry->list, &store->Entries);
+    HashTable_Add(&store->Keys, &keyEntry->Entry, hash);
+    store->Count++;
+    return 0;
+}
+
+#ifndef CONTIKI
+
+// Map the file at path read-only. An empty file maps to no data.
+static int MapFile(const char * path, const char ** data, size_t * size)
+{
+    int result = -1;
+    struct stat st;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        Lwm2m_Error("Failed to open key file %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    if (fstat(fd, &st) != 0)
+    {
+        Lwm2m_Error("Failed to stat key file %s: %s\n", path, strerror(errno));
+        goto done;
+    }
+
+    *data = NULL;
+    *size = st.st_size;
+    if (*size > 0)
+    {
+        void * map = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            Lwm2m_Error("Failed to map key file %s: %s\n", path, strerror(errno));
+            goto done;
+        }
+        *data = map;
+    }
+    result = 0;
+
+done:
+    close(fd);
+    return result;
+}
+
+DTLS_KeyStore * DTLS_KeyStore_Load(const char * path)
+{
+    const char * data = NULL;
+    const char * lineStart;
+    size_t size = 0;
+    int lineNumber = 0;
+    DTLS_KeyStore * store = NULL;
+
+    if ((path == NULL) || (MapFile(path, &data, &size) != 0))
+    {
+        return NULL;
+    }
+
+    store = DTLS_KeyStore_NewMemory();
+    if (store == NULL)
+    {
+        goto error;
+    }
+
+    for (lineStart = data; lineStart < data + size; )
+    {
+        const char * lineEnd = LineEnd(data, size, lineStart);
+        KeyFileLine line;
+        lineNumber++;
+        if (!ParseLine(lineStart, lineEnd, &line))
+        {
+            Lwm2m_Error("Invalid key on line %d of %s\n", lineNumber, path);
+            goto error;
+        }
+        if (line.Identity != NULL)
+        {
+            uint8_t key[DTLS_KEYSTORE_MAX_KEY_LENGTH];
+            int keyLength = DecodeHex(line.HexKey, line.HexKeyLength, key, sizeof(key));
+            int added = DTLS_KeyStore_Add(store, line.Identity, line.IdentityLength, key, keyLength);
+            memset(key, 0, sizeof(key));
+            if (added != 0)
+            {
+                goto error;
+            }
+        }
+        lineStart = lineEnd + 1;
+    }
+
+    if (data != NULL)
+    {
+        munmap((void *)data, size);
+    }
+    return store;
+
+error:
+    DTLS_KeyStore_Free(&store);
+    if (data != NULL)
+    {
+        munmap((void *)data, size);
+    }
+    return NULL;
+}
+
+// Check every line of a key file. Returns 1 if the keys are in identity order, 0 if not, or -1 if a line is invalid.
+static int ScanKeyFile(const char * path, const char * data, size_t size, size_t * count)
+{
+    const char * lineStart;
+    int lineNumber = 0;
+    int result = 1;
+    KeyFileLine previous;
+
+    *count = 0;
+    memset(&previous, 0, sizeof(previous));
+    for (lineStart = data; lineStart < data + size; )
+    {
+        const char * lineEnd = LineEnd(data, size, lineStart);
+        KeyFileLine line;
+        lineNumber++;
+        if (!ParseLine(lineStart, lineEnd, &line))
+        {
+            Lwm2m_Error("Invalid key on line %d of %s\n", lineNumber, path);
+            return -1;
+        }
+        if (line.Identity != NULL)
+        {
+            if ((previous.Identity != NULL) &&
+                (CompareIdentities(previous.Identity, previous.IdentityLength, line.Identity, line.IdentityLength) >= 0))
+            {
+                result = 0;
+            }
+            previous = line;
+            (*count)++;
+        }
+        lineStart = lineEnd + 1;
+    }
+    return result;
+}
+
+// Take ownership of the mapping of a sorted key file
+static DTLS_KeyStore * NewMappedStore(const char * data, size_t size, size_t count)
+{
+    DTLS_KeyStore * store = NewStore(KeyStoreType_Mapped);
+    if (store != NULL)
+    {
+        store->Lookup = LookupMapped;
+        store->Data = data;
+        store->Size = size;
+        store->Count = count;
+    }
+    else if (data != NULL)
+    {
+        munmap((void *)data, size);
+    }
+    return store;
+}
+
+DTLS_KeyStore * DTLS_KeyStore_Map(const char * path)
+{
+    const char * data = NULL;
+    size_t size = 0;
+    size_t count;
+    int sorted;
+
+    if ((path == NULL) || (MapFile(path, &data, &size) != 0))
+    {
+        return NULL;
+    }
+
+    // lookups rely on the order, and on every line being valid
+    sorted = ScanKeyFile(path, data, size, &count);
+    if (sorted <= 0)
+    {
+        if (sorted == 0)
+        {
+            Lwm2m_Error("Keys in %s are not sorted by identity, or have duplicate identities\n", path);
+        }
+        if (data != NULL)
+        {
+            munmap((void *)data, size);
+        }
+        return NULL;
+    }
+    return NewMappedStore(data, size, count);
+}
+
+DTLS_KeyStore * DTLS_KeyStore_Open(const char * path)
+{
+    const char * data = NULL;
+    size_t size = 0;
+    size_t count;
+    int sorted;
+
+    if ((path == NULL) || (MapFile(path, &data, &size) != 0))
+    {
+        return NULL;
+    }
+
+    sorted = ScanKeyFile(path, data, size, &count);
+    if (sorted > 0)
+    {
+        return NewMappedStore(data, size, count);
+    }
+    if (data != NULL)
+    {
+        munmap((void *)data, size);
+    }
+    return (sorted == 0) ? DTLS_KeyStore_Load(path) : NULL;
+}
+
+#else
+
+DTLS_KeyStore * DTLS_KeyStore_Load(const char * path)
+{
+    (void)path;
+    return NULL;
+}
+
+DTLS_KeyStore * DTLS_KeyStore_Map(const char * path)
+{
+    (void)path;
+    return NULL;
+}
+
+DTLS_KeyStore * DTLS_KeyStore_Open(const char * path)
+{
+    (void)path;
+    return NULL;
+}
+
+#endif
+
+int DTLS_KeyStore_Lookup(const DTLS_KeyStore * store, const char * identity, size_t identityLength, uint8_t * key, size_t keySize)
+{
+    int result = -1;
+    if ((store != NULL) && (identity != NULL) && (key != NULL))
+    {
+        result = store->Lookup(store->Context, identity, identityLength, key, keySize);
+    }
+    return result;
+}
+
+size_t DTLS_KeyStore_Count(const DTLS_KeyStore * store)
+{
+    return (store != NULL) ? store->Count : 0;
+}
+
+void DTLS_KeyStore_Free(DTLS_KeyStore ** store)
+{
+    if ((store != NULL) && (*store != NULL))
+    {
+        struct ListHead * i, * n;
+        switch ((*store)->Type)
+        {
+            case KeyStoreType_Custom:
+                if ((*store)->Free != NULL)
+                {
+                    (*store)->Free((*store)->Context);
+                }
+                break;
+            case KeyStoreType_Memory:
+                ListForEachSafe(i, n, &(*store)->Entries)
+                {
+                    KeyStoreEntry * keyEntry = ListEntry(i, KeyStoreEntry, list);
+                    ListRemove(&keyEntry->list);
+                    memset(keyEntry->Key, 0, sizeof(keyEntry->Key));
+                    free(keyEntry);
+                }
+                HashTable_Destroy(&(*store)->Keys);
+                break;
+            case KeyStoreType_Mapped:
+#ifndef CONTIKI
+                if ((*store)->Data != NULL)
+                {
+                    munmap((void *)(*store)->Data, (*store)->Size);
+                }
+#endif
+                break;
+        }
+        free(*store);
+        *store = NULL;
+    }
+}
@@ -0,0 +1,96 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#ifndef DTLS_KEYSTORE_H
+#define DTLS_KEYSTORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Pre-shared keys by PSK identity, for servers that give every client its own key. The DTLS backends look up
+ *  the key of the identity a client presents in the store set with DTLS_SetKeyStore():
+ *
+ *     DTLS_KeyStore * store = DTLS_KeyStore_Load("keys.txt");
+ *     DTLS_SetKeyStore(store);
+ *
+ *  Key files have a line per client with the identity and the key as a hex string, separated by whitespace.
+ *  Blank lines and lines starting with '#' are ignored:
+ *
+ *     # identity             key
+ *     client1                2646188672F6CCD4AAEA476C645F2565
+ *
+ *  DTLS_KeyStore_Load reads the keys into a hash table. DTLS_KeyStore_Map instead maps a key file sorted by
+ *  identity (e.g. with LC_ALL=C sort) and binary searches it in place, so a server with millions of clients does
+ *  not copy every key into memory, and only the pages of recently used keys stay resident. DTLS_KeyStore_Open
+ *  picks the mode from the order of the file. Other key sources, such as a database, are added with
+ *  DTLS_KeyStore_New.
+ */
+
+#define DTLS_KEYSTORE_MAX_IDENTITY_LENGTH   (128)
+#define DTLS_KEYSTORE_MAX_KEY_LENGTH        (64)
+
+/* Copy the key of identity into key, which holds keySize bytes. Returns the key length, or -1 if the identity is
+ * unknown or its key does not fit. With handshake workers, lookups run on several threads at once.
+ */
+typedef int (*DTLS_KeyStoreLookupCallback)(void * context, const char * identity, size_t identityLength, uint8_t * key, size_t keySize);
+
+// Release the context of a custom key store
+typedef void (*DTLS_KeyStoreFreeCallback)(void * context);
+
+typedef struct _DTLS_KeyStore DTLS_KeyStore;
+
+// Key store that calls lookup, and free (if not NULL) when it is freed
+DTLS_KeyStore * DTLS_KeyStore_New(DTLS_KeyStoreLookupCallback lookup, DTLS_KeyStoreFreeCallback free, void * context);
+
+// Empty key store, filled with DTLS_KeyStore_Add
+DTLS_KeyStore * DTLS_KeyStore_NewMemory(void);
+
+// Add or replace the key of identity in a store created with DTLS_KeyStore_NewMemory or DTLS_KeyStore_Load
+int DTLS_KeyStore_Add(DTLS_KeyStore * store, const char * identity, size_t identityLength, const uint8_t * key, size_t keyLength);
+
+// Read a key file into a hash table. Returns NULL if the file cannot be read or has an invalid line.
+DTLS_KeyStore * DTLS_KeyStore_Load(const char * path);
+
+// Map a key file sorted by identity. Returns NULL if the file cannot be mapped or is not sorted.
+DTLS_KeyStore * DTLS_KeyStore_Map(const char * path);
+
+// Map a key file if it is sorted by identity, and load it otherwise
+DTLS_KeyStore * DTLS_KeyStore_Open(const char * path);
+
+int DTLS_KeyStore_Lookup(const DTLS_KeyStore * store, const char * identity, size_t identityLength, uint8_t * key, size_t keySize);
+
+// Number of keys in a loaded or mapped store, 0 for custom stores
+size_t DTLS_KeyStore_Count(const DTLS_KeyStore * store);
+
+void DTLS_KeyStore_Free(DTLS_KeyStore ** store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DTLS_KEYSTORE_H
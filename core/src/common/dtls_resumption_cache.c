@@ -0,0 +1,311 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lwm2m_debug.h"
+#include "dtls_resumption_cache.h"
+
+typedef struct
+{
+    HashTableEntry KeyEntry;
+    struct ListHead list;
+    NetworkAddress * Address;           // Key of client sessions, NULL if keyed by session ID
+    uint64_t Stored;
+    size_t KeyLength;
+    size_t StateLength;
+    uint8_t Data[];                     // Key followed by state
+
+} ResumptionEntry;
+
+static void RemoveEntry(DTLS_ResumptionCache * cache, ResumptionEntry * entry)
+{
+    HashTable_Remove(&cache->ByKey, &entry->KeyEntry);
+    ListRemove(&entry->list);
+    cache->Statistics.Count--;
+    if (entry->Address)
+    {
+        // this may be a handshake worker, which must not free addresses
+        ListAdd(&entry->list, &cache->Released);
+    }
+    else
+    {
+        free(entry);
+    }
+}
+
+static ResumptionEntry * OldestEntry(DTLS_ResumptionCache * cache)
+{
+    ResumptionEntry * result = NULL;
+    if (cache->Entries.Next != &cache->Entries)
+    {
+        result = ListEntry(cache->Entries.Next, ResumptionEntry, list);
+    }
+    return result;
+}
+
+static void ExpireEntries(DTLS_ResumptionCache * cache, uint64_t now)
+{
+    ResumptionEntry * entry;
+    while (((entry = OldestEntry(cache)) != NULL) && (cache->Lifetime > 0) && (now - entry->Stored >= cache->Lifetime))
+    {
+        cache->Statistics.Expired++;
+        RemoveEntry(cache, entry);
+    }
+}
+
+static ResumptionEntry * FindEntry(DTLS_ResumptionCache * cache, NetworkAddress * address, const uint8_t * key, size_t keyLength)
+{
+    HashTableEntry * i;
+    uint32_t hash = address ? NetworkAddress_Hash(address) : HashTable_HashBytes(0, key, keyLength);
+    HashTable_ForEachWithHash(i, &cache->ByKey, hash)
+    {
+        ResumptionEntry * entry = HashTableContainer(i, ResumptionEntry, KeyEntry);
+        if (address)
+        {
+            if (entry->Address && (NetworkAddress_Compare(entry->Address, address) == 0))
+                return entry;
+        }
+        else if (!entry->Address && (entry->KeyLength == keyLength) && (memcmp(entry->Data, key, keyLength) == 0))
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static int StoreEntry(DTLS_ResumptionCache * cache, NetworkAddress * address, const uint8_t * key, size_t keyLength,
+                      const uint8_t * state, size_t stateLength, uint64_t now)
+{
+    ResumptionEntry * entry;
+    if ((cache == NULL) || (state == NULL) || (stateLength == 0))
+    {
+        return -1;
+    }
+
+    entry = FindEntry(cache, address, key, keyLength);
+    if (entry)
+    {
+        RemoveEntry(cache, entry);
+    }
+    ExpireEntries(cache, now);
+    while ((cache->MaxEntries > 0) && (cache->Statistics.Count >= cache->MaxEntries) && ((entry = OldestEntry(cache)) != NULL))
+    {
+        cache->Statistics.Evicted++;
+        RemoveEntry(cache, entry);
+    }
+
+    entry = (ResumptionEntry *)malloc(sizeof(ResumptionEntry) + keyLength + stateLength);
+    if (entry == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for DTLS resumption state\n");
+        return -1;
+    }
+    memset(entry, 0, sizeof(ResumptionEntry));
+    ListInit(&entry->list);
+    entry->Stored = now;
+    entry->KeyLength = keyLength;
+    entry->StateLength = stateLength;
+    if (keyLength > 0)
+    {
+        memcpy(entry->Data, key, keyLength);
+    }
+    memcpy(entry->Data + keyLength, state, stateLength);
+    if (address)
+    {
+        entry->Address = NetworkAddress_Retain(address);
+        HashTable_Add(&cache->ByKey, &entry->KeyEntry, NetworkAddress_Hash(address));
+    }
+    else
+    {
+        HashTable_Add(&cache->ByKey, &entry->KeyEntry, HashTable_HashBytes(0, key, keyLength));
+    }
+    ListAdd(&entry->list, &cache->Entries);
+    cache->Statistics.Count++;
+    return 0;
+}
+
+static const uint8_t * FetchEntry(DTLS_ResumptionCache * cache, NetworkAddress * address, const uint8_t * key, size_t keyLength,
+                                  size_t * stateLength, uint64_t now)
+{
+    const uint8_t * result = NULL;
+    if (cache != NULL)
+    {
+        ResumptionEntry * entry;
+        ExpireEntries(cache, now);
+        entry = FindEntry(cache, address, key, keyLength);
+        if (entry)
+        {
+            result = entry->Data + entry->KeyLength;
+            if (stateLength)
+            {
+                *stateLength = entry->StateLength;
+            }
+            cache->Statistics.Hits++;
+        }
+        else
+        {
+            cache->Statistics.Misses++;
+        }
+    }
+    return result;
+}
+
+int DTLS_ResumptionCache_Init(DTLS_ResumptionCache * cache)
+{
+    if (cache == NULL)
+    {
+        return -1;
+    }
+    memset(cache, 0, sizeof(*cache));
+    if (HashTable_Init(&cache->ByKey, 0) != 0)
+    {
+        return -1;
+    }
+    ListInit(&cache->Entries);
+    ListInit(&cache->Released);
+    cache->MaxEntries = MAX_DTLS_RESUMPTION_ENTRIES;
+    cache->Lifetime = DTLS_RESUMPTION_LIFETIME;
+    return 0;
+}
+
+void DTLS_ResumptionCache_Destroy(DTLS_ResumptionCache * cache)
+{
+    if (cache != NULL)
+    {
+        ResumptionEntry * entry;
+        while ((entry = OldestEntry(cache)) != NULL)
+        {
+            RemoveEntry(cache, entry);
+        }
+        DTLS_ResumptionCache_Release(cache);
+        HashTable_Destroy(&cache->ByKey);
+    }
+}
+
+void DTLS_ResumptionCache_SetLimits(DTLS_ResumptionCache * cache, uint32_t maxEntries, uint32_t lifetime)
+{
+    if (cache != NULL)
+    {
+        cache->MaxEntries = maxEntries;
+        cache->Lifetime = lifetime;
+    }
+}
+
+int DTLS_ResumptionCache_Store(DTLS_ResumptionCache * cache, const uint8_t * key, size_t keyLength, const uint8_t * state, size_t stateLength, uint64_t now)
+{
+    if ((key == NULL) || (keyLength == 0))
+    {
+        return -1;
+    }
+    return StoreEntry(cache, NULL, key, keyLength, state, stateLength, now);
+}
+
+int DTLS_ResumptionCache_StoreForAddress(DTLS_ResumptionCache * cache, NetworkAddress * address, const uint8_t * state, size_t stateLength, uint64_t now)
+{
+    if (address == NULL)
+    {
+        return -1;
+    }
+    int result = StoreEntry(cache, address, NULL, 0, state, stateLength, now);
+    DTLS_ResumptionCache_Release(cache);
+    return result;
+}
+
+const uint8_t * DTLS_ResumptionCache_Fetch(DTLS_ResumptionCache * cache, const uint8_t * key, size_t keyLength, size_t * stateLength, uint64_t now)
+{
+    const uint8_t * result = NULL;
+    if ((key != NULL) && (keyLength > 0))
+    {
+        result = FetchEntry(cache, NULL, key, keyLength, stateLength, now);
+    }
+    return result;
+}
+
+const uint8_t * DTLS_ResumptionCache_FetchForAddress(DTLS_ResumptionCache * cache, NetworkAddress * address, size_t * stateLength, uint64_t now)
+{
+    const uint8_t * result = NULL;
+    if (address != NULL)
+    {
+        result = FetchEntry(cache, address, NULL, 0, stateLength, now);
+        DTLS_ResumptionCache_Release(cache);
+    }
+    return result;
+}
+
+void DTLS_ResumptionCache_Remove(DTLS_ResumptionCache * cache, const uint8_t * key, size_t keyLength)
+{
+    if ((cache != NULL) && (key != NULL) && (keyLength > 0))
+    {
+        ResumptionEntry * entry = FindEntry(cache, NULL, key, keyLength);
+        if (entry)
+        {
+            RemoveEntry(cache, entry);
+        }
+    }
+}
+
+void DTLS_ResumptionCache_RemoveForAddress(DTLS_ResumptionCache * cache, NetworkAddress * address)
+{
+    if ((cache != NULL) && (address != NULL))
+    {
+        ResumptionEntry * entry = FindEntry(cache, address, NULL, 0);
+        if (entry)
+        {
+            RemoveEntry(cache, entry);
+        }
+        DTLS_ResumptionCache_Release(cache);
+    }
+}
+
+int DTLS_ResumptionCache_Release(DTLS_ResumptionCache * cache)
+{
+    int result = 0;
+    if (cache != NULL)
+    {
+        while (cache->Released.Next != &cache->Released)
+        {
+            ResumptionEntry * entry = ListEntry(cache->Released.Next, ResumptionEntry, list);
+            ListRemove(&entry->list);
+            NetworkAddress_Free(&entry->Address);
+            free(entry);
+            result++;
+        }
+    }
+    return result;
+}
+
+void DTLS_ResumptionCache_GetStatistics(const DTLS_ResumptionCache * cache, DTLS_ResumptionCacheStatistics * statistics)
+{
+    if (statistics != NULL)
+    {
+        if (cache != NULL)
+        {
+            *statistics = cache->Statistics;
+        }
+        else
+        {
+            memset(statistics, 0, sizeof(*statistics));
+        }
+    }
+}
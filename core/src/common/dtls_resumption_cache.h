@@ -0,0 +1,115 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+#ifndef DTLS_RESUMPTION_CACHE_H
+#define DTLS_RESUMPTION_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lwm2m_list.h"
+#include "lwm2m_hash_table.h"
+#include "network_abstraction.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  State of earlier DTLS sessions, kept so that a peer reconnecting within the lifetime resumes its
+ *  session with an abbreviated handshake instead of a full PSK or certificate handshake. A server keys
+ *  the state by session ID, and a client by the address of the server it connected to:
+ *
+ *     DTLS_ResumptionCache_Store(&cache, sessionID, sessionIDLength, state, stateLength, now);
+ *     state = DTLS_ResumptionCache_Fetch(&cache, sessionID, sessionIDLength, &stateLength, now);
+ *
+ *     DTLS_ResumptionCache_StoreForAddress(&cache, address, state, stateLength, now);
+ *     state = DTLS_ResumptionCache_FetchForAddress(&cache, address, &stateLength, now);
+ *
+ *  The state is opaque to the cache, and is serialised by the backend.
+ *
+ *  The session ID functions may be called from handshake workers, with the backend serialising access to the
+ *  cache. An entry keyed by address that they drop keeps its address until DTLS_ResumptionCache_Release(), or
+ *  the next call by address, as network addresses may only be freed by the thread that owns them.
+ */
+
+#ifndef MAX_DTLS_RESUMPTION_ENTRIES
+    #define MAX_DTLS_RESUMPTION_ENTRIES     (10000)                     // 0 for no limit
+#endif
+
+#ifndef DTLS_RESUMPTION_LIFETIME
+    #define DTLS_RESUMPTION_LIFETIME        (24 * 60 * 60 * 1000)       // milliseconds, 0 for no limit
+#endif
+
+typedef struct
+{
+    uint32_t Count;                     // Sessions in the cache
+    uint32_t Hits;                      // Lookups that found a session to resume
+    uint32_t Misses;
+    uint32_t Evicted;                   // Oldest sessions dropped to stay within the entry limit
+    uint32_t Expired;                   // Sessions dropped after the lifetime
+
+} DTLS_ResumptionCacheStatistics;
+
+typedef struct
+{
+    HashTable ByKey;
+    struct ListHead Entries;            // Oldest first
+    struct ListHead Released;           // Dropped entries whose addresses are still to be freed
+    uint32_t MaxEntries;
+    uint32_t Lifetime;
+    DTLS_ResumptionCacheStatistics Statistics;
+
+} DTLS_ResumptionCache;
+
+/* Initialise a cache with the limits MAX_DTLS_RESUMPTION_ENTRIES and DTLS_RESUMPTION_LIFETIME */
+int DTLS_ResumptionCache_Init(DTLS_ResumptionCache * cache);
+
+void DTLS_ResumptionCache_Destroy(DTLS_ResumptionCache * cache);
+
+// Set the number of sessions kept and how long in milliseconds they can be resumed for, where 0 disables a limit
+void DTLS_ResumptionCache_SetLimits(DTLS_ResumptionCache * cache, uint32_t maxEntries, uint32_t lifetime);
+
+// Store the state of a session, replacing any stored with the same key. Returns 0 on success.
+int DTLS_ResumptionCache_Store(DTLS_ResumptionCache * cache, const uint8_t * key, size_t keyLength, const uint8_t * state, size_t stateLength, uint64_t now);
+int DTLS_ResumptionCache_StoreForAddress(DTLS_ResumptionCache * cache, NetworkAddress * address, const uint8_t * state, size_t stateLength, uint64_t now);
+
+/* Return the stored state of a session, or NULL if there is none or it has expired. The state is valid until the
+ * cache is next changed.
+ */
+const uint8_t * DTLS_ResumptionCache_Fetch(DTLS_ResumptionCache * cache, const uint8_t * key, size_t keyLength, size_t * stateLength, uint64_t now);
+const uint8_t * DTLS_ResumptionCache_FetchForAddress(DTLS_ResumptionCache * cache, NetworkAddress * address, size_t * stateLength, uint64_t now);
+
+// Forget a session, such as one that ended with a fatal alert
+void DTLS_ResumptionCache_Remove(DTLS_ResumptionCache * cache, const uint8_t * key, size_t keyLength);
+void DTLS_ResumptionCache_RemoveForAddress(DTLS_ResumptionCache * cache, NetworkAddress * address);
+
+// Free the addresses of entries dropped by the session ID functions, on the thread that owns them. Returns the number freed.
+int DTLS_ResumptionCache_Release(DTLS_ResumptionCache * cache);
+
+void DTLS_ResumptionCache_GetStatistics(const DTLS_ResumptionCache * cache, DTLS_ResumptionCacheStatistics * statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DTLS_RESUMPTION_CACHE_H
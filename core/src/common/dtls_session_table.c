@@ -0,0 +1,346 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "lwm2m_debug.h"
+#include "dtls_session_table.h"
+
+static void RemoveSession(DTLS_SessionTable * table, DTLS_SessionEntry * entry)
+{
+    if (table->FreeSession)
+    {
+        table->FreeSession(entry);
+    }
+    HashTable_Remove(&table->ByAddress, &entry->AddressEntry);
+    HashTable_Remove(&table->ByConnectionId, &entry->ConnectionIdEntry);
+    ListRemove(&entry->UseList);
+    NetworkAddress_Free(&entry->NetworkAddress);
+    table->Statistics.Count--;
+    table->Statistics.Memory -= table->SessionMemory;
+    free(entry);
+}
+
+static DTLS_SessionEntry * LeastRecentlyUsed(DTLS_SessionTable * table)
+{
+    DTLS_SessionEntry * result = NULL;
+    if (table->Sessions.Next != &table->Sessions)
+    {
+        result = ListEntry(table->Sessions.Next, DTLS_SessionEntry, UseList);
+    }
+    return result;
+}
+
+static void UseSession(DTLS_SessionTable * table, DTLS_SessionEntry * entry, uint64_t now)
+{
+    entry->Statistics.LastUsed = now;
+    ListRemove(&entry->UseList);
+    ListAdd(&entry->UseList, &table->Sessions);
+}
+
+static DTLS_SessionEntry * FindByConnectionId(DTLS_SessionTable * table, const uint8_t * connectionId, size_t length)
+{
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &table->ByConnectionId, HashTable_HashBytes(0, connectionId, length))
+    {
+        DTLS_SessionEntry * session = HashTableContainer(entry, DTLS_SessionEntry, ConnectionIdEntry);
+        if ((session->ConnectionIdLength == length) && (memcmp(session->ConnectionId, connectionId, length) == 0))
+        {
+            return session;
+        }
+    }
+    return NULL;
+}
+
+static void ExpireSessions(DTLS_SessionTable * table, uint64_t now)
+{
+    DTLS_SessionEntry * entry;
+    while ((entry = LeastRecentlyUsed(table)) != NULL)
+    {
+        bool idle = (table->IdleTimeout > 0) && (now - entry->Statistics.LastUsed >= table->IdleTimeout);
+        bool overLimit = (table->MaxSessions > 0) && (table->Statistics.Count > table->MaxSessions);
+        if (!idle && !overLimit)
+        {
+            break;
+        }
+        if (idle)
+        {
+            table->Statistics.Expired++;
+        }
+        else
+        {
+            table->Statistics.Evicted++;
+        }
+        RemoveSession(table, entry);
+    }
+}
+
+int DTLS_SessionTable_Init(DTLS_SessionTable * table, size_t sessionSize, size_t libraryMemory, DTLS_SessionFreeCallback freeSession)
+{
+    if ((table == NULL) || (sessionSize < sizeof(DTLS_SessionEntry)))
+    {
+        return -1;
+    }
+    memset(table, 0, sizeof(*table));
+    if (HashTable_Init(&table->ByAddress, 0) != 0)
+    {
+        return -1;
+    }
+    if (HashTable_Init(&table->ByConnectionId, 0) != 0)
+    {
+        HashTable_Destroy(&table->ByAddress);
+        return -1;
+    }
+    ListInit(&table->Sessions);
+    table->SessionSize = sessionSize;
+    table->SessionMemory = sessionSize + libraryMemory;
+    table->FreeSession = freeSession;
+    table->MaxSessions = MAX_DTLS_SESSIONS;
+    table->MaxMemory = MAX_DTLS_SESSION_MEMORY;
+    table->IdleTimeout = DTLS_SESSION_IDLE_TIMEOUT;
+    return 0;
+}
+
+void DTLS_SessionTable_Destroy(DTLS_SessionTable * table)
+{
+    if (table != NULL)
+    {
+        DTLS_SessionEntry * entry;
+        while ((entry = LeastRecentlyUsed(table)) != NULL)
+        {
+            RemoveSession(table, entry);
+        }
+        HashTable_Destroy(&table->ByAddress);
+        HashTable_Destroy(&table->ByConnectionId);
+    }
+}
+
+void DTLS_SessionTable_SetLimits(DTLS_SessionTable * table, uint32_t maxSessions, size_t maxMemory, uint32_t idleTimeout)
+{
+    if (table != NULL)
+    {
+        table->MaxSessions = maxSessions;
+        table->MaxMemory = maxMemory;
+        table->IdleTimeout = idleTimeout;
+    }
+}
+
+DTLS_SessionEntry * DTLS_SessionTable_Get(DTLS_SessionTable * table, NetworkAddress * address, uint64_t now)
+{
+    DTLS_SessionEntry * result = NULL;
+    if ((table != NULL) && (address != NULL))
+    {
+        HashTableEntry * entry;
+        ExpireSessions(table, now);
+        HashTable_ForEachWithHash(entry, &table->ByAddress, NetworkAddress_Hash(address))
+        {
+            DTLS_SessionEntry * session = HashTableContainer(entry, DTLS_SessionEntry, AddressEntry);
+            if (NetworkAddress_Compare(session->NetworkAddress, address) == 0)
+            {
+                result = session;
+                break;
+            }
+        }
+        if (result != NULL)
+        {
+            UseSession(table, result, now);
+            table->Statistics.Hits++;
+        }
+        else
+        {
+            table->Statistics.Misses++;
+        }
+    }
+    return result;
+}
+
+DTLS_SessionEntry * DTLS_SessionTable_New(DTLS_SessionTable * table, NetworkAddress * address, uint64_t now)
+{
+    DTLS_SessionEntry * result = NULL;
+    DTLS_SessionEntry * leastRecentlyUsed;
+    if ((table == NULL) || (address == NULL))
+    {
+        return NULL;
+    }
+
+    ExpireSessions(table, now);
+    if ((table->MaxMemory > 0) && (table->SessionMemory > table->MaxMemory))
+    {
+        Lwm2m_Error("DTLS session exceeds the session memory limit\n");
+        table->Statistics.Rejected++;
+        return NULL;
+    }
+    while ((leastRecentlyUsed = LeastRecentlyUsed(table)) != NULL)
+    {
+        bool full = (table->MaxSessions > 0) && (table->Statistics.Count >= table->MaxSessions);
+        bool outOfMemory = (table->MaxMemory > 0) && (table->Statistics.Memory + table->SessionMemory > table->MaxMemory);
+        if (!full && !outOfMemory)
+        {
+            break;
+        }
+        table->Statistics.Evicted++;
+        RemoveSession(table, leastRecentlyUsed);
+    }
+
+    result = (DTLS_SessionEntry *)malloc(table->SessionSize);
+    if (result == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for DTLS session\n");
+        return NULL;
+    }
+    memset(result, 0, table->SessionSize);
+    ListInit(&result->UseList);
+    result->NetworkAddress = NetworkAddress_Retain(address);
+    result->Statistics.Created = now;
+    result->Statistics.LastUsed = now;
+    HashTable_Add(&table->ByAddress, &result->AddressEntry, NetworkAddress_Hash(address));
+    ListAdd(&result->UseList, &table->Sessions);
+    table->Statistics.Count++;
+    table->Statistics.Memory += table->SessionMemory;
+    table->Statistics.Created++;
+    return result;
+}
+
+void DTLS_SessionTable_Free(DTLS_SessionTable * table, DTLS_SessionEntry * entry)
+{
+    if ((table != NULL) && (entry != NULL))
+    {
+        RemoveSession(table, entry);
+    }
+}
+
+int DTLS_SessionTable_SetConnectionId(DTLS_SessionTable * table, DTLS_SessionEntry * entry, const uint8_t * connectionId, size_t length)
+{
+    DTLS_SessionEntry * existing;
+    if ((table == NULL) || (entry == NULL) || (connectionId == NULL) || (length == 0) || (length > DTLS_MAX_CONNECTION_ID_LENGTH))
+    {
+        return -1;
+    }
+    existing = FindByConnectionId(table, connectionId, length);
+    if (existing != NULL)
+    {
+        return (existing == entry) ? 0 : -1;
+    }
+    HashTable_Remove(&table->ByConnectionId, &entry->ConnectionIdEntry);
+    memcpy(entry->ConnectionId, connectionId, length);
+    entry->ConnectionIdLength = length;
+    HashTable_Add(&table->ByConnectionId, &entry->ConnectionIdEntry, HashTable_HashBytes(0, connectionId, length));
+    return 0;
+}
+
+DTLS_SessionEntry * DTLS_SessionTable_GetByConnectionId(DTLS_SessionTable * table, const uint8_t * connectionId, size_t length, uint64_t now)
+{
+    DTLS_SessionEntry * result = NULL;
+    if ((table != NULL) && (connectionId != NULL) && (length > 0))
+    {
+        ExpireSessions(table, now);
+        result = FindByConnectionId(table, connectionId, length);
+        if (result != NULL)
+        {
+            UseSession(table, result, now);
+        }
+    }
+    return result;
+}
+
+DTLS_SessionEntry * DTLS_SessionTable_GetByRecord(DTLS_SessionTable * table, const uint8_t * record, size_t recordLength, size_t connectionIdLength, uint64_t now)
+{
+    DTLS_SessionEntry * result = NULL;
+    // the connection ID is followed by the 2 byte record length
+    if ((record != NULL) && (connectionIdLength > 0) && (recordLength >= DTLS_CONNECTION_ID_OFFSET + connectionIdLength + 2) &&
+        (record[0] == DTLS_CONNECTION_ID_CONTENT_TYPE))
+    {
+        result = DTLS_SessionTable_GetByConnectionId(table, record + DTLS_CONNECTION_ID_OFFSET, connectionIdLength, now);
+    }
+    return result;
+}
+
+DTLS_SessionEntry * DTLS_SessionTable_MoveByRecord(DTLS_SessionTable * table, NetworkAddress * address, uint8_t * record, size_t recordLength,
+                                                   size_t connectionIdLength, DTLS_SessionAuthenticate authenticate, void * context, uint64_t now)
+{
+    DTLS_SessionEntry * result = DTLS_SessionTable_GetByRecord(table, record, recordLength, connectionIdLength, now);
+    if ((result != NULL) && (authenticate != NULL) && authenticate(result, record, recordLength, context))
+    {
+        DTLS_SessionTable_SetAddress(table, result, address);
+    }
+    else
+    {
+        // anyone can send a record with a connection ID
+        result = NULL;
+    }
+    return result;
+}
+
+void DTLS_SessionTable_SetAddress(DTLS_SessionTable * table, DTLS_SessionEntry * entry, NetworkAddress * address)
+{
+    if ((table != NULL) && (entry != NULL) && (address != NULL) && (NetworkAddress_Compare(entry->NetworkAddress, address) != 0))
+    {
+        HashTableEntry * i;
+        HashTable_ForEachWithHash(i, &table->ByAddress, NetworkAddress_Hash(address))
+        {
+            DTLS_SessionEntry * session = HashTableContainer(i, DTLS_SessionEntry, AddressEntry);
+            if ((session != entry) && (NetworkAddress_Compare(session->NetworkAddress, address) == 0))
+            {
+                RemoveSession(table, session);
+                break;
+            }
+        }
+        HashTable_Remove(&table->ByAddress, &entry->AddressEntry);
+        NetworkAddress_Free(&entry->NetworkAddress);
+        entry->NetworkAddress = NetworkAddress_Retain(address);
+        HashTable_Add(&table->ByAddress, &entry->AddressEntry, NetworkAddress_Hash(address));
+        table->Statistics.Rebound++;
+    }
+}
+
+void DTLS_SessionTable_AddDecrypted(DTLS_SessionEntry * entry, int length)
+{
+    if ((entry != NULL) && (length > 0))
+    {
+        entry->Statistics.RecordsDecrypted++;
+        entry->Statistics.BytesDecrypted += length;
+    }
+}
+
+void DTLS_SessionTable_AddEncrypted(DTLS_SessionEntry * entry, int length)
+{
+    if ((entry != NULL) && (length > 0))
+    {
+        entry->Statistics.RecordsEncrypted++;
+        entry->Statistics.BytesEncrypted += length;
+    }
+}
+
+void DTLS_SessionTable_GetStatistics(const DTLS_SessionTable * table, DTLS_SessionTableStatistics * statistics)
+{
+    if (statistics != NULL)
+    {
+        if (table != NULL)
+        {
+            *statistics = table->Statistics;
+        }
+        else
+        {
+            memset(statistics, 0, sizeof(*statistics));
+        }
+    }
+}
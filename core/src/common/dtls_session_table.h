@@ -0,0 +1,206 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+#ifndef DTLS_SESSION_TABLE_H
+#define DTLS_SESSION_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lwm2m_list.h"
+#include "lwm2m_hash_table.h"
+#include "network_abstraction.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Sessions of a DTLS backend, indexed by peer address. Each backend embeds a DTLS_SessionEntry in
+ *  its own session structure, and the table allocates, finds and frees the sessions:
+ *
+ *     typedef struct {
+ *         DTLS_SessionEntry Entry;
+ *         ... library state ...
+ *     } DTLS_Session;
+ *
+ *     DTLS_SessionTable_Init(&sessions, sizeof(DTLS_Session), LIBRARY_MEMORY, FreeSessionEntry);
+ *
+ *     DTLS_SessionEntry * entry = DTLS_SessionTable_Get(&sessions, address, now);
+ *     if (entry == NULL)
+ *         entry = DTLS_SessionTable_New(&sessions, address, now);
+ *     DTLS_Session * session = DTLS_SessionTableContainer(entry, DTLS_Session, Entry);
+ *
+ *  To stay within the session and memory limits, creating a session frees the least recently used
+ *  sessions first. Sessions that are idle for longer than the idle timeout are freed as sessions are
+ *  looked up.
+ *
+ *  Sessions that negotiated a connection ID (RFC 9146) are also indexed by the connection ID the peer
+ *  puts in its records, so that a record from a peer whose address changed, such as after NAT rebinding,
+ *  still finds its session:
+ *
+ *     entry = DTLS_SessionTable_MoveByRecord(&sessions, address, record, recordLength, CONNECTION_ID_LENGTH,
+ *                                            DecryptRecord, context, now);
+ *
+ *  where DecryptRecord decrypts the record with the session, so that the session only moves to the new
+ *  address once a record from it is authentic.
+ */
+
+#ifndef MAX_DTLS_SESSIONS
+    #define MAX_DTLS_SESSIONS               (10000)
+#endif
+
+#ifndef MAX_DTLS_SESSION_MEMORY
+    #define MAX_DTLS_SESSION_MEMORY         (0)                         // bytes, 0 for no limit
+#endif
+
+// Longest connection ID the table indexes
+#define DTLS_MAX_CONNECTION_ID_LENGTH       (32)
+
+// Content type of records with a connection ID, and the length of their header before the connection ID
+#define DTLS_CONNECTION_ID_CONTENT_TYPE     (25)
+#define DTLS_CONNECTION_ID_OFFSET           (11)
+
+#ifndef DTLS_SESSION_IDLE_TIMEOUT
+    #define DTLS_SESSION_IDLE_TIMEOUT       (24 * 60 * 60 * 1000)       // milliseconds, 0 for no timeout
+#endif
+
+typedef struct
+{
+    uint64_t Created;                   // Time the session was created, in milliseconds
+    uint64_t LastUsed;
+    uint32_t RecordsDecrypted;
+    uint32_t RecordsEncrypted;
+    uint64_t BytesDecrypted;            // Plain text bytes
+    uint64_t BytesEncrypted;
+
+} DTLS_SessionStatistics;
+
+typedef struct
+{
+    HashTableEntry AddressEntry;
+    HashTableEntry ConnectionIdEntry;
+    struct ListHead UseList;            // Position in least recently used order
+    NetworkAddress * NetworkAddress;    // Peer address, referenced by the session
+    uint8_t ConnectionId[DTLS_MAX_CONNECTION_ID_LENGTH];
+    uint8_t ConnectionIdLength;         // 0 if the session is not indexed by connection ID
+    DTLS_SessionStatistics Statistics;
+
+} DTLS_SessionEntry;
+
+typedef struct
+{
+    uint32_t Count;                     // Sessions in the table
+    size_t Memory;                      // Estimated memory used by the sessions, in bytes
+    uint32_t Hits;                      // Lookups that found a session
+    uint32_t Misses;
+    uint32_t Created;
+    uint32_t Evicted;                   // Least recently used sessions freed to stay within the limits
+    uint32_t Expired;                   // Sessions freed after the idle timeout
+    uint32_t Rejected;                  // Sessions not created, as they would not fit within the memory limit
+    uint32_t Rebound;                   // Sessions moved to a new peer address
+
+} DTLS_SessionTableStatistics;
+
+// Release the library state of a session. The table then releases the address and frees the session.
+typedef void (*DTLS_SessionFreeCallback)(DTLS_SessionEntry * entry);
+
+typedef struct
+{
+    HashTable ByAddress;
+    HashTable ByConnectionId;
+    struct ListHead Sessions;           // Least recently used first
+    size_t SessionSize;                 // Bytes allocated per session, including the DTLS_SessionEntry
+    size_t SessionMemory;               // Estimated bytes per session, including the library state
+    DTLS_SessionFreeCallback FreeSession;
+    uint32_t MaxSessions;
+    size_t MaxMemory;
+    uint32_t IdleTimeout;
+    DTLS_SessionTableStatistics Statistics;
+
+} DTLS_SessionTable;
+
+/* locate the structure of type "type" containing the DTLS_SessionEntry named "member" */
+#define DTLS_SessionTableContainer(ptr, type, member) \
+    ((type *)((char *)(ptr) - offsetof(type, member)))
+
+/* Initialise a table of sessions of sessionSize bytes, with libraryMemory the estimated memory the DTLS
+ * library allocates for each session. The limits are initially MAX_DTLS_SESSIONS, MAX_DTLS_SESSION_MEMORY
+ * and DTLS_SESSION_IDLE_TIMEOUT.
+ */
+int DTLS_SessionTable_Init(DTLS_SessionTable * table, size_t sessionSize, size_t libraryMemory, DTLS_SessionFreeCallback freeSession);
+
+// Free all sessions and release the table
+void DTLS_SessionTable_Destroy(DTLS_SessionTable * table);
+
+// Set the limits, where 0 disables a limit. Sessions beyond the new limits are freed when sessions are next created or looked up.
+void DTLS_SessionTable_SetLimits(DTLS_SessionTable * table, uint32_t maxSessions, size_t maxMemory, uint32_t idleTimeout);
+
+// Return the session for a peer address and mark it as most recently used, or NULL if there is none
+DTLS_SessionEntry * DTLS_SessionTable_Get(DTLS_SessionTable * table, NetworkAddress * address, uint64_t now);
+
+/* Create a zero-initialised session for a peer address, which must not have one already. Returns NULL if
+ * the session cannot be allocated.
+ */
+DTLS_SessionEntry * DTLS_SessionTable_New(DTLS_SessionTable * table, NetworkAddress * address, uint64_t now);
+
+void DTLS_SessionTable_Free(DTLS_SessionTable * table, DTLS_SessionEntry * entry);
+
+/* Index a session by the connection ID its peer puts in records. Returns -1 if the connection ID is too long or
+ * another session has it.
+ */
+int DTLS_SessionTable_SetConnectionId(DTLS_SessionTable * table, DTLS_SessionEntry * entry, const uint8_t * connectionId, size_t length);
+
+// Return the session with a connection ID and mark it as most recently used, or NULL if there is none
+DTLS_SessionEntry * DTLS_SessionTable_GetByConnectionId(DTLS_SessionTable * table, const uint8_t * connectionId, size_t length, uint64_t now);
+
+/* Return the session a record belongs to from its connection ID, where the connection IDs of the table are
+ * connectionIdLength bytes long. Returns NULL if the record has no connection ID, or no session has it.
+ */
+DTLS_SessionEntry * DTLS_SessionTable_GetByRecord(DTLS_SessionTable * table, const uint8_t * record, size_t recordLength, size_t connectionIdLength, uint64_t now);
+
+// Decrypt or otherwise authenticate a record with the session it names, returning whether it is authentic
+typedef bool (*DTLS_SessionAuthenticate)(DTLS_SessionEntry * entry, uint8_t * record, size_t recordLength, void * context);
+
+/* Find the session of a record from an address without one by the record's connection ID, as DTLS_SessionTable_GetByRecord,
+ * and move the session to the address if authenticate accepts the record. Returns the session moved, or NULL if
+ * the record names no session or is not authentic, in which case the session stays at its address.
+ */
+DTLS_SessionEntry * DTLS_SessionTable_MoveByRecord(DTLS_SessionTable * table, NetworkAddress * address, uint8_t * record, size_t recordLength,
+                                                   size_t connectionIdLength, DTLS_SessionAuthenticate authenticate, void * context, uint64_t now);
+
+/* Move a session to a new peer address, freeing any other session with that address. Only move a session after
+ * authenticating a record from the new address, as anyone can send a record with a connection ID.
+ */
+void DTLS_SessionTable_SetAddress(DTLS_SessionTable * table, DTLS_SessionEntry * entry, NetworkAddress * address);
+
+// Count a record of length plain text bytes decrypted or encrypted by the session
+void DTLS_SessionTable_AddDecrypted(DTLS_SessionEntry * entry, int length);
+void DTLS_SessionTable_AddEncrypted(DTLS_SessionEntry * entry, int length);
+
+void DTLS_SessionTable_GetStatistics(const DTLS_SessionTable * table, DTLS_SessionTableStatistics * statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DTLS_SESSION_TABLE_H
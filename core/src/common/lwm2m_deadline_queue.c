@@ -0,0 +1,218 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+
+#include <stdlib.h>
+
+#include "lwm2m_deadline_queue.h"
+
+#define DEADLINE_QUEUE_INITIAL_CAPACITY (16)
+
+// Heap positions are 1-based so that a zeroed entry is "not scheduled"
+#define AT(queue, position) ((queue)->Entries[(position) - 1])
+
+static void Place(DeadlineQueue * queue, DeadlineQueueEntry * entry, size_t position)
+{
+    AT(queue, position) = entry;
+    entry->Position = position;
+}
+
+static void SiftUp(DeadlineQueue * queue, size_t position)
+{
+    DeadlineQueueEntry * entry = AT(queue, position);
+    while (position > 1)
+    {
+        size_t parent = position / 2;
+        if (AT(queue, parent)->Deadline <= entry->Deadline)
+        {
+            break;
+        }
+        Place(queue, AT(queue, parent), position);
+        position = parent;
+    }
+    Place(queue, entry, position);
+}
+
+static void SiftDown(DeadlineQueue * queue, size_t position)
+{
+    DeadlineQueueEntry * entry = AT(queue, position);
+    for (;;)
+    {
+        size_t child = position * 2;
+        if (child > queue->Count)
+        {
+            break;
+        }
+        if ((child < queue->Count) && (AT(queue, child + 1)->Deadline < AT(queue, child)->Deadline))
+        {
+            child++;
+        }
+        if (entry->Deadline <= AT(queue, child)->Deadline)
+        {
+            break;
+        }
+        Place(queue, AT(queue, child), position);
+        position = child;
+    }
+    Place(queue, entry, position);
+}
+
+int DeadlineQueue_Init(DeadlineQueue * queue)
+{
+    int result = -1;
+    if (queue != NULL)
+    {
+        queue->Count = 0;
+        queue->Capacity = DEADLINE_QUEUE_INITIAL_CAPACITY;
+        queue->Entries = malloc(queue->Capacity * sizeof(DeadlineQueueEntry *));
+        result = (queue->Entries != NULL) ? 0 : -1;
+    }
+    return result;
+}
+
+void DeadlineQueue_Destroy(DeadlineQueue * queue)
+{
+    if (queue != NULL)
+    {
+        size_t i;
+        for (i = 0; i < queue->Count; i++)
+        {
+            queue->Entries[i]->Position = 0;
+        }
+        free(queue->Entries);
+        queue->Entries = NULL;
+        queue->Count = 0;
+        queue->Capacity = 0;
+    }
+}
+
+int DeadlineQueue_Schedule(DeadlineQueue * queue, DeadlineQueueEntry * entry, uint64_t deadline)
+{
+    int result = -1;
+    if ((queue != NULL) && (entry != NULL))
+    {
+        if (entry->Position != 0)
+        {
+            uint64_t previous = entry->Deadline;
+            entry->Deadline = deadline;
+            if (deadline < previous)
+            {
+                SiftUp(queue, entry->Position);
+            }
+            else
+            {
+                SiftDown(queue, entry->Position);
+            }
+            result = 0;
+        }
+        else
+        {
+            if (queue->Count == queue->Capacity)
+            {
+                size_t capacity = (queue->Capacity > 0) ? queue->Capacity * 2 : DEADLINE_QUEUE_INITIAL_CAPACITY;
+                DeadlineQueueEntry ** entries = realloc(queue->Entries, capacity * sizeof(DeadlineQueueEntry *));
+                if (entries == NULL)
+                {
+                    goto error;
+                }
+                queue->Entries = entries;
+                queue->Capacity = capacity;
+            }
+
+            entry->Deadline = deadline;
+            queue->Count++;
+            Place(queue, entry, queue->Count);
+            SiftUp(queue, queue->Count);
+            result = 0;
+        }
+    }
+error:
+    return result;
+}
+
+void DeadlineQueue_Cancel(DeadlineQueue * queue, DeadlineQueueEntry * entry)
+{
+    if ((queue != NULL) && (entry != NULL) && (entry->Position != 0))
+    {
+        size_t position = entry->Position;
+        DeadlineQueueEntry * last = AT(queue, queue->Count);
+
+        queue->Count--;
+        entry->Position = 0;
+
+        if (last != entry)
+        {
+            // move the last entry into the hole and restore the heap property in whichever direction is required
+            Place(queue, last, position);
+            if ((position > 1) && (last->Deadline < AT(queue, position / 2)->Deadline))
+            {
+                SiftUp(queue, position);
+            }
+            else
+            {
+                SiftDown(queue, position);
+            }
+        }
+    }
+}
+
+bool DeadlineQueue_IsScheduled(const DeadlineQueueEntry * entry)
+{
+    return (entry != NULL) && (entry->Position != 0);
+}
+
+size_t DeadlineQueue_Count(const DeadlineQueue * queue)
+{
+    return (queue != NULL) ? queue->Count : 0;
+}
+
+DeadlineQueueEntry * DeadlineQueue_Peek(const DeadlineQueue * queue)
+{
+    return ((queue != NULL) && (queue->Count > 0)) ? AT(queue, 1) : NULL;
+}
+
+DeadlineQueueEntry * DeadlineQueue_PopExpired(DeadlineQueue * queue, uint64_t now)
+{
+    DeadlineQueueEntry * entry = DeadlineQueue_Peek(queue);
+    if ((entry != NULL) && (entry->Deadline <= now))
+    {
+        DeadlineQueue_Cancel(queue, entry);
+    }
+    else
+    {
+        entry = NULL;
+    }
+    return entry;
+}
+
+int32_t DeadlineQueue_GetTimeout(const DeadlineQueue * queue, uint64_t now)
+{
+    int32_t timeout = -1;
+    DeadlineQueueEntry * entry = DeadlineQueue_Peek(queue);
+    if (entry != NULL)
+    {
+        uint64_t remaining = (entry->Deadline > now) ? entry->Deadline - now : 0;
+        timeout = (remaining > INT32_MAX) ? INT32_MAX : (int32_t)remaining;
+    }
+    return timeout;
+}
@@ -0,0 +1,99 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+
+#ifndef LWM2M_DEADLINE_QUEUE_H
+#define LWM2M_DEADLINE_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Priority queue of deadlines (binary min-heap). Entries are embedded in the scheduled
+ *  structure, so scheduling, rescheduling and cancelling are O(log n) and finding the
+ *  earliest deadline is O(1):
+ *
+ *     DeadlineQueue_Schedule(&queue, &item->TimerEntry, now + timeout);
+ *
+ *     DeadlineQueueEntry * entry;
+ *     while ((entry = DeadlineQueue_PopExpired(&queue, now)) != NULL)
+ *     {
+ *         Item * item = DeadlineQueueContainer(entry, Item, TimerEntry);
+ *         ... handle timeout ...
+ *     }
+ *     nextTimeout = DeadlineQueue_GetTimeout(&queue, now);
+ */
+
+typedef struct
+{
+    uint64_t Deadline;                  // Absolute time, in the same units as "now" (normally milliseconds)
+    size_t Position;                    // 1-based position in the heap, 0 when not scheduled
+
+} DeadlineQueueEntry;
+
+typedef struct
+{
+    DeadlineQueueEntry ** Entries;
+    size_t Count;
+    size_t Capacity;
+
+} DeadlineQueue;
+
+/* locate the structure of type "type" containing the DeadlineQueueEntry named "member" */
+#define DeadlineQueueContainer(ptr, type, member) \
+    ((type *)((char *)(ptr) - offsetof(type, member)))
+
+int DeadlineQueue_Init(DeadlineQueue * queue);
+
+// Release the queue storage. Entries are owned by the caller and are not freed.
+void DeadlineQueue_Destroy(DeadlineQueue * queue);
+
+// Schedule an entry, or move it if it is already scheduled. Entries must be zero-initialised before first use.
+int DeadlineQueue_Schedule(DeadlineQueue * queue, DeadlineQueueEntry * entry, uint64_t deadline);
+
+// Remove an entry from the queue. Cancelling an entry that is not scheduled has no effect.
+void DeadlineQueue_Cancel(DeadlineQueue * queue, DeadlineQueueEntry * entry);
+
+bool DeadlineQueue_IsScheduled(const DeadlineQueueEntry * entry);
+
+size_t DeadlineQueue_Count(const DeadlineQueue * queue);
+
+// Return the entry with the earliest deadline without removing it, or NULL if the queue is empty
+DeadlineQueueEntry * DeadlineQueue_Peek(const DeadlineQueue * queue);
+
+// Remove and return the earliest entry if its deadline is at or before now, otherwise return NULL
+DeadlineQueueEntry * DeadlineQueue_PopExpired(DeadlineQueue * queue, uint64_t now);
+
+// Return the time remaining until the earliest deadline (0 if already passed), or -1 if the queue is empty
+int32_t DeadlineQueue_GetTimeout(const DeadlineQueue * queue, uint64_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LWM2M_DEADLINE_QUEUE_H
@@ -0,0 +1,214 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+
+#include <stdlib.h>
+
+#include "lwm2m_hash_table.h"
+
+#define HASH_TABLE_DEFAULT_BUCKETS (16)
+#define HASH_TABLE_MAX_LOAD        (2)      // grow when the average chain length exceeds this
+
+#define FNV_OFFSET_BASIS (2166136261u)
+#define FNV_PRIME        (16777619u)
+
+static struct ListHead * GetBucket(const HashTable * table, uint32_t hash)
+{
+    return &table->Buckets[hash & (table->BucketCount - 1)];
+}
+
+static struct ListHead * AllocateBuckets(size_t bucketCount)
+{
+    struct ListHead * buckets = malloc(bucketCount * sizeof(struct ListHead));
+    if (buckets != NULL)
+    {
+        size_t i;
+        for (i = 0; i < bucketCount; i++)
+        {
+            ListInit(&buckets[i]);
+        }
+    }
+    return buckets;
+}
+
+static void Resize(HashTable * table, size_t bucketCount)
+{
+    struct ListHead * buckets = AllocateBuckets(bucketCount);
+    if (buckets != NULL)
+    {
+        struct ListHead * oldBuckets = table->Buckets;
+        size_t oldBucketCount = table->BucketCount;
+        size_t i;
+
+        table->Buckets = buckets;
+        table->BucketCount = bucketCount;
+
+        for (i = 0; i < oldBucketCount; i++)
+        {
+            struct ListHead * j, * n;
+            ListForEachSafe(j, n, &oldBuckets[i])
+            {
+                HashTableEntry * entry = HashTableContainer(j, HashTableEntry, list);
+                ListAdd(&entry->list, GetBucket(table, entry->Hash));
+            }
+        }
+        free(oldBuckets);
+    }
+    // On allocation failure keep the existing buckets, chains just get longer
+}
+
+int HashTable_Init(HashTable * table, size_t initialBucketCount)
+{
+    int result = -1;
+    if (table != NULL)
+    {
+        size_t bucketCount = HASH_TABLE_DEFAULT_BUCKETS;
+        while (bucketCount < initialBucketCount)
+        {
+            bucketCount <<= 1;
+        }
+
+        table->Count = 0;
+        table->BucketCount = bucketCount;
+        table->Buckets = AllocateBuckets(bucketCount);
+        result = (table->Buckets != NULL) ? 0 : -1;
+    }
+    return result;
+}
+
+void HashTable_Destroy(HashTable * table)
+{
+    if (table != NULL)
+    {
+        free(table->Buckets);
+        table->Buckets = NULL;
+        table->BucketCount = 0;
+        table->Count = 0;
+    }
+}
+
+void HashTable_Add(HashTable * table, HashTableEntry * entry, uint32_t hash)
+{
+    if ((table != NULL) && (table->Buckets != NULL) && (entry != NULL))
+    {
+        if (table->Count >= table->BucketCount * HASH_TABLE_MAX_LOAD)
+        {
+            Resize(table, table->BucketCount << 1);
+        }
+
+        entry->Hash = hash;
+        ListAdd(&entry->list, GetBucket(table, hash));
+        table->Count++;
+    }
+}
+
+void HashTable_Remove(HashTable * table, HashTableEntry * entry)
+{
+    if ((table != NULL) && (entry != NULL))
+    {
+        if ((entry->list.Next != NULL) && (entry->list.Next != &entry->list))
+        {
+            ListRemove(&entry->list);
+            table->Count--;
+        }
+    }
+}
+
+size_t HashTable_Count(const HashTable * table)
+{
+    return (table != NULL) ? table->Count : 0;
+}
+
+static HashTableEntry * FindFrom(const HashTable * table, struct ListHead * bucket, struct ListHead * from, uint32_t hash)
+{
+    struct ListHead * i;
+    for (i = from; i != bucket; i = i->Next)
+    {
+        HashTableEntry * entry = HashTableContainer(i, HashTableEntry, list);
+        if (entry->Hash == hash)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+HashTableEntry * HashTable_First(const HashTable * table, uint32_t hash)
+{
+    HashTableEntry * result = NULL;
+    if ((table != NULL) && (table->Buckets != NULL))
+    {
+        struct ListHead * bucket = GetBucket(table, hash);
+        result = FindFrom(table, bucket, bucket->Next, hash);
+    }
+    return result;
+}
+
+HashTableEntry * HashTable_Next(const HashTable * table, const HashTableEntry * entry)
+{
+    HashTableEntry * result = NULL;
+    if ((table != NULL) && (table->Buckets != NULL) && (entry != NULL))
+    {
+        result = FindFrom(table, GetBucket(table, entry->Hash), entry->list.Next, entry->Hash);
+    }
+    return result;
+}
+
+// FNV-1a
+uint32_t HashTable_HashBytes(uint32_t seed, const void * data, size_t length)
+{
+    const uint8_t * bytes = (const uint8_t *)data;
+    uint32_t hash = FNV_OFFSET_BASIS ^ seed;
+    size_t i;
+    for (i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint32_t HashTable_HashString(const char * string)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    if (string != NULL)
+    {
+        while (*string != '\0')
+        {
+            hash ^= (uint8_t)*string++;
+            hash *= FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+// Integer finaliser from MurmurHash3, spreads sequential values across buckets
+uint32_t HashTable_HashInt(uint32_t value)
+{
+    value ^= value >> 16;
+    value *= 0x85ebca6bu;
+    value ^= value >> 13;
+    value *= 0xc2b2ae35u;
+    value ^= value >> 16;
+    return value;
+}
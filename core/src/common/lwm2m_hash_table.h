@@ -0,0 +1,109 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+
+#ifndef LWM2M_HASH_TABLE_H
+#define LWM2M_HASH_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lwm2m_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ *  Intrusive, chained hash table. Entries are embedded in the indexed structure
+ *  and the caller supplies the hash, so an object can be indexed by several keys
+ *  at once by embedding one HashTableEntry per table:
+ *
+ *     typedef struct {
+ *         HashTableEntry NameEntry;
+ *         char * Name;
+ *     } Item;
+ *
+ *     HashTable_Add(&table, &item->NameEntry, HashTable_HashString(item->Name));
+ *
+ *     HashTableEntry * entry;
+ *     HashTable_ForEachWithHash(entry, &table, HashTable_HashString(name))
+ *     {
+ *         Item * item = HashTableContainer(entry, Item, NameEntry);
+ *         if (strcmp(item->Name, name) == 0) ... found
+ *     }
+ *
+ *  Hash collisions are resolved by the caller comparing keys, as above.
+ */
+
+typedef struct
+{
+    struct ListHead list;
+    uint32_t Hash;
+
+} HashTableEntry;
+
+typedef struct
+{
+    struct ListHead * Buckets;
+    size_t BucketCount;                 // Always a power of two
+    size_t Count;
+
+} HashTable;
+
+/* locate the structure of type "type" containing the HashTableEntry named "member" */
+#define HashTableContainer(ptr, type, member) \
+    ((type *)((char *)(ptr) - offsetof(type, member)))
+
+#define HashTable_ForEachWithHash(pos, table, hash) \
+    for (pos = HashTable_First((table), (hash)); pos != NULL; pos = HashTable_Next((table), pos))
+
+// Initialise a table with at least initialBucketCount buckets (0 selects a default size)
+int HashTable_Init(HashTable * table, size_t initialBucketCount);
+
+// Release the bucket array. Entries are owned by the caller and are not freed.
+void HashTable_Destroy(HashTable * table);
+
+// Add an entry with the specified hash. The table grows automatically as entries are added.
+void HashTable_Add(HashTable * table, HashTableEntry * entry, uint32_t hash);
+
+// Remove an entry previously added to the table. Removing a zero-initialised or already removed entry has no effect.
+void HashTable_Remove(HashTable * table, HashTableEntry * entry);
+
+size_t HashTable_Count(const HashTable * table);
+
+// Return the first/next entry with the specified hash, or NULL if there are none
+HashTableEntry * HashTable_First(const HashTable * table, uint32_t hash);
+HashTableEntry * HashTable_Next(const HashTable * table, const HashTableEntry * entry);
+
+// Hash functions for common key types. Use seed 0 or the result of a previous call to combine keys.
+uint32_t HashTable_HashBytes(uint32_t seed, const void * data, size_t length);
+uint32_t HashTable_HashString(const char * string);
+uint32_t HashTable_HashInt(uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LWM2M_HASH_TABLE_H
@@ -41,18 +41,27 @@
 #include "lwm2m_security_object.h"
 #include "lwm2m_server_object.h"
 
+static uint32_t HashOIR(ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    int32_t key[] = { objectID, objectInstanceID, resourceID };
+    return HashTable_HashBytes(0, key, sizeof(key));
+}
+
+static bool ObserverMatchesOIR(Lwm2mObserverType * observer, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+{
+    return (observer->ObjectID == objectID) && (observer->ObjectInstanceID == objectInstanceID) && (observer->ResourceID == resourceID);
+}
+
 static Lwm2mObserverType * LookupObserver(void * ctxt, AddressType * addr, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
 {
     Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
-    struct ListHead * i, *n;
-    ListForEachSafe(i, n, Lwm2mCore_GetObserverList(context))
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, Lwm2mCore_GetObserverIndex(context), HashOIR(objectID, objectInstanceID, resourceID))
     {
-        Lwm2mObserverType * observer = ListEntry(i, Lwm2mObserverType, list);
+        Lwm2mObserverType * observer = HashTableContainer(entry, Lwm2mObserverType, OIREntry);
 
-        if ((observer->ObjectID == objectID) &&
-            (observer->ObjectInstanceID == objectInstanceID) &&
-            (observer->ResourceID == resourceID) &&
-            (memcmp(&observer->Address, addr, sizeof(AddressType)) == 0))
+        if (ObserverMatchesOIR(observer, objectID, objectInstanceID, resourceID) &&
+            ((addr == NULL) || (memcmp(&observer->Address, addr, sizeof(AddressType)) == 0)))
         {
             return observer;
         }
@@ -60,6 +69,48 @@ static Lwm2mObserverType * LookupObserver(void * ctxt, AddressType * addr, Objec
     return NULL;
 }
 
+static void FreeObserver(Lwm2mContextType * context, Lwm2mObserverType * observer)
+{
+    ListRemove(&observer->list);
+    HashTable_Remove(Lwm2mCore_GetObserverIndex(context), &observer->OIREntry);
+    DeadlineQueue_Cancel(Lwm2mCore_GetObserverQueue(context), &observer->NotifyEntry);
+    free(observer->OldValueBuffer);
+    free(observer->ContextData);
+    free(observer);
+}
+
+// Keep a copy of value as the observer's old value, or none if value is NULL
+static void SetOldValue(Lwm2mObserverType * observer, const void * value, size_t valueLength)
+{
+    observer->OldValue = NULL;
+    observer->OldValueLength = 0;
+
+    if (value != NULL)
+    {
+        if (valueLength <= sizeof(observer->OldValueInline))
+        {
+            observer->OldValue = &observer->OldValueInline;
+        }
+        else
+        {
+            if (valueLength > observer->OldValueBufferSize)
+            {
+                void * buffer = realloc(observer->OldValueBuffer, valueLength);
+                if (buffer == NULL)
+                {
+                    Lwm2m_Error("Error allocating memory\n");
+                    return;
+                }
+                observer->OldValueBuffer = buffer;
+                observer->OldValueBufferSize = valueLength;
+            }
+            observer->OldValue = observer->OldValueBuffer;
+        }
+        memcpy(observer->OldValue, value, valueLength);
+        observer->OldValueLength = valueLength;
+    }
+}
+
 static bool NotificationAttributesValid(AttributeTypeEnum attributeType, NotificationAttributes * attributes)
 {
     return (attributes != NULL) && attributes->Valid[attributeType];
@@ -86,140 +137,232 @@ static NotificationAttributes * GetHighestValidAttributesForType(AttributeTypeEn
     }
 }
 
-void Lwm2m_MarkObserversChanged(void * ctxt, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID,
-                                ResourceIDType resourceID, const void * newValue, size_t newValueLength)
+// Resolve the attributes in effect for /objectID/objectInstanceID/resourceID: each is taken from the most specific level it is set at
+static void ResolveAttributes(Lwm2mContextType * context, int shortServerID, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID,
+                              ResourceIDType resourceID, ObserverAttributes * attributes)
 {
-    Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
-    struct ListHead * observerItem;
-    ListForEach(observerItem, Lwm2mCore_GetObserverList(context))
+    NotificationAttributes * resourceAttributes = resourceID == -1? NULL : AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, objectInstanceID, resourceID);
+    NotificationAttributes * objectInstanceAttributes = objectInstanceID == -1? NULL : AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, objectInstanceID, -1);
+    NotificationAttributes * objectAttributes = AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, -1, -1);
+
+    NotificationAttributes * minimumPeriodAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_MinimumPeriod, resourceAttributes, objectInstanceAttributes, objectAttributes);
+    NotificationAttributes * maximumPeriodAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_MaximumPeriod, resourceAttributes, objectInstanceAttributes, objectAttributes);
+    NotificationAttributes * greaterThanAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_GreaterThan, resourceAttributes, objectInstanceAttributes, objectAttributes);
+    NotificationAttributes * lessThanAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_LessThan, resourceAttributes, objectInstanceAttributes, objectAttributes);
+    NotificationAttributes * stepAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_Step, resourceAttributes, objectInstanceAttributes, objectAttributes);
+
+    memset(attributes, 0, sizeof(*attributes));
+    attributes->ShortServerID = shortServerID;
+    attributes->MinimumPeriod = minimumPeriodAttributes != NULL? minimumPeriodAttributes->MinimumPeriod : Lwm2mServerObject_GetDefaultMinimumPeriod(context, shortServerID);
+    attributes->MaximumPeriod = maximumPeriodAttributes != NULL? maximumPeriodAttributes->MaximumPeriod : Lwm2mServerObject_GetDefaultMaximumPeriod(context, shortServerID);
+    if (greaterThanAttributes != NULL)
     {
-        Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
+        attributes->Valid[AttributeTypeEnum_GreaterThan] = true;
+        attributes->GreaterThan = greaterThanAttributes->GreaterThan;
+    }
+    if (lessThanAttributes != NULL)
+    {
+        attributes->Valid[AttributeTypeEnum_LessThan] = true;
+        attributes->LessThan = lessThanAttributes->LessThan;
+    }
+    if (stepAttributes != NULL)
+    {
+        attributes->Valid[AttributeTypeEnum_Step] = true;
+        attributes->Step = stepAttributes->Step;
+    }
+    attributes->Resolved = true;
+}
 
-        if ((observer->ObjectID == objectID) &&
-            ((observer->ObjectInstanceID == objectInstanceID) || (observer->ObjectInstanceID == -1)) &&
-            ((observer->ResourceID == resourceID) || (observer->ResourceID == -1)))
-        {
+// The observer's own attributes, resolved on first use after it is created or the attributes or security objects change
+static ObserverAttributes * GetObserverAttributes(Lwm2mContextType * context, Lwm2mObserverType * observer)
+{
+    if (!observer->Attributes.Resolved)
+    {
+        ResolveAttributes(context, Lwm2mSecurity_GetShortServerID(context, &observer->Address),
+                          observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID, &observer->Attributes);
+    }
+    return &observer->Attributes;
+}
 
-            int shortServerID = Lwm2mSecurity_GetShortServerID(context, &observer->Address);
+// Schedule an observer for when it must next be notified: pmin after its last notification if it has changed, and pmax after it regardless
+static void ScheduleObserver(Lwm2mContextType * context, Lwm2mObserverType * observer)
+{
+    ObserverAttributes * attributes = GetObserverAttributes(context, observer);
+    int minimumPeriod = attributes->MinimumPeriod;
+    int maximumPeriod = attributes->MaximumPeriod;
+    uint32_t coalescePeriod = Lwm2mCore_GetNotificationCoalescePeriod(context);
+
+    // a notification is sent once more than the period has elapsed
+    uint64_t deadline = UINT64_MAX;
+    if (observer->Changed)
+    {
+        deadline = observer->LastUpdate + (uint32_t)minimumPeriod * 1000 + 1;
 
-            NotificationAttributes * resourceAttributes = (resourceID == -1) ? NULL :
-                    AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, objectInstanceID, resourceID);
-            NotificationAttributes * objectInstanceAttributes = (objectInstanceID == -1) ? NULL :
-                    AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, objectInstanceID, -1);
-            NotificationAttributes * objectAttributes = AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, objectID, -1, -1);
+        if (coalescePeriod > 0)
+        {
+            // round up to the next multiple of the coalescing period, so every observer that changes within it is due at the same time
+            uint64_t now = Lwm2mCore_GetTickCountMs();
+            if (deadline < now)
+            {
+                deadline = now;
+            }
+            deadline = ((deadline + coalescePeriod - 1) / coalescePeriod) * coalescePeriod;
+        }
+    }
+    if ((maximumPeriod != -1) && (observer->LastUpdate + (uint32_t)maximumPeriod * 1000 + 1 < deadline))
+    {
+        deadline = observer->LastUpdate + (uint32_t)maximumPeriod * 1000 + 1;
+    }
 
-            ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
+    if (deadline != UINT64_MAX)
+    {
+        DeadlineQueue_Schedule(Lwm2mCore_GetObserverQueue(context), &observer->NotifyEntry, deadline);
+    }
+    else
+    {
+        DeadlineQueue_Cancel(Lwm2mCore_GetObserverQueue(context), &observer->NotifyEntry);
+    }
+}
+
+// Set the changed bit of an observer matching a change to /objectID/objectInstanceID/resourceID, if the change passes its notification attributes
+static void MarkObserverChanged(Lwm2mContextType * context, Lwm2mObserverType * observer, ResourceDefinition * definition, ObjectIDType objectID,
+                                ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, const void * newValue, size_t newValueLength)
+{
+    int shortServerID = GetObserverAttributes(context, observer)->ShortServerID;
 
-            bool passedAttributeChecks = false;
-            if ((definition != NULL) && (!IS_MULTIPLE_INSTANCE(definition)) && (observer->OldValue != NULL) && (newValue != NULL))
+    bool passedAttributeChecks = false;
+    if ((definition != NULL) && (!IS_MULTIPLE_INSTANCE(definition)) && (observer->OldValue != NULL) && (newValue != NULL))
+    {
+        switch (definition->Type)
+        {
+            case AwaResourceType_Integer: // no-break
+            case AwaResourceType_Float:   // no-break
+            case AwaResourceType_Time:
             {
+                ObserverAttributes * attributes = GetObserverAttributes(context, observer);
+                ObserverAttributes changeAttributes;
+                if ((observer->ObjectInstanceID != objectInstanceID) || (observer->ResourceID != resourceID))
+                {
+                    // an observer of the object or object instance checks the attributes of the resource that changed
+                    ResolveAttributes(context, shortServerID, objectID, objectInstanceID, resourceID, &changeAttributes);
+                    attributes = &changeAttributes;
+                }
+
                 switch (definition->Type)
                 {
+                    // FIXME: Remove duplication if possible
                     case AwaResourceType_Integer: // no-break
-                    case AwaResourceType_Float:   // no-break
                     case AwaResourceType_Time:
                     {
-                        NotificationAttributes * greaterThanAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_GreaterThan, resourceAttributes,
-                                                                                                          objectInstanceAttributes, objectAttributes);
-                        NotificationAttributes * lessThanAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_LessThan, resourceAttributes,
-                                                                                                       objectInstanceAttributes, objectAttributes);
-                        NotificationAttributes * stepAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_Step, resourceAttributes,
-                                                                                                   objectInstanceAttributes, objectAttributes);
-
-                        switch (definition->Type)
+                        AwaInteger oldValueAsInteger = observer->OldValueLength == sizeof(AwaInteger) ? *((AwaInteger *)observer->OldValue) : 0;
+                        AwaInteger newValueAsInteger = newValueLength == sizeof(AwaInteger) ? *((AwaInteger *)newValue) : 0;
+
+                        if (attributes->Valid[AttributeTypeEnum_GreaterThan] &&
+                                ((oldValueAsInteger > attributes->GreaterThan) == (newValueAsInteger > attributes->GreaterThan)))
                         {
-                            // FIXME: Remove duplication if possible
-                            case AwaResourceType_Integer: // no-break
-                            case AwaResourceType_Time:
-                            {
-                                AwaInteger oldValueAsInteger = observer->OldValueLength == sizeof(AwaInteger) ? *((AwaInteger *)observer->OldValue) : 0;
-                                AwaInteger newValueAsInteger = newValueLength == sizeof(AwaInteger) ? *((AwaInteger *)newValue) : 0;
-
-                                if ((greaterThanAttributes != NULL) &&
-                                        ((oldValueAsInteger > greaterThanAttributes->GreaterThan) == (newValueAsInteger > greaterThanAttributes->GreaterThan)))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold high value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
-                                }
-                                else if ((lessThanAttributes != NULL) &&
-                                        ((oldValueAsInteger > lessThanAttributes->LessThan) == (newValueAsInteger > lessThanAttributes->LessThan)))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold low value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
-                                }
-                                else if ((stepAttributes != NULL) && stepAttributes->Step > labs(oldValueAsInteger - newValueAsInteger))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but not by the step amount (Old value = %" PRId64 ", new value = %" PRId64 "); not notifying observer for server %d", objectID, objectInstanceID, resourceID, oldValueAsInteger, newValueAsInteger, shortServerID);
-                                }
-                                else
-                                {
-                                    passedAttributeChecks = true;
-                                }
-                                break;
-                            }
-                            case AwaResourceType_Float:
-                            {
-                                AwaFloat oldValueAsFloat = observer->OldValueLength == sizeof(AwaInteger) ? *((AwaFloat *)observer->OldValue) : 0;
-                                AwaFloat newValueAsFloat = newValueLength == sizeof(AwaInteger) ? *((AwaFloat *)newValue) : 0;
-
-                                if ((greaterThanAttributes != NULL) &&
-                                        ((oldValueAsFloat > greaterThanAttributes->GreaterThan) == (newValueAsFloat > greaterThanAttributes->GreaterThan)))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold high value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
-                                }
-                                else if ((lessThanAttributes != NULL) &&
-                                        ((oldValueAsFloat > lessThanAttributes->LessThan) == (newValueAsFloat > lessThanAttributes->LessThan)))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold low value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
-                                }
-                                else if ((stepAttributes != NULL) && stepAttributes->Step > labs(oldValueAsFloat - newValueAsFloat))
-                                {
-                                    Lwm2m_Error("/%d/%d/%d changed but not by the step amount (Old value = %f, new value = %f); not notifying observer for server %d", objectID, objectInstanceID, resourceID, oldValueAsFloat, newValueAsFloat, shortServerID);
-                                }
-                                else
-                                {
-                                    passedAttributeChecks = true;
-                                }
-                                break;
-                            }
-                            default:
-                                Lwm2m_Error("Unsupported resource type for checking gt/lt/stp attributes: %d\n", definition->Type);
-                                break;
+                            Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold high value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
+                        }
+                        else if (attributes->Valid[AttributeTypeEnum_LessThan] &&
+                                ((oldValueAsInteger > attributes->LessThan) == (newValueAsInteger > attributes->LessThan)))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold low value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
+                        }
+                        else if (attributes->Valid[AttributeTypeEnum_Step] && attributes->Step > labs(oldValueAsInteger - newValueAsInteger))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but not by the step amount (Old value = %" PRId64 ", new value = %" PRId64 "); not notifying observer for server %d", objectID, objectInstanceID, resourceID, oldValueAsInteger, newValueAsInteger, shortServerID);
+                        }
+                        else
+                        {
+                            passedAttributeChecks = true;
                         }
                         break;
                     }
-                    default:
-                        // Other resource types do not support stp/gt/lt attributes
-                        passedAttributeChecks = true;
+                    case AwaResourceType_Float:
+                    {
+                        AwaFloat oldValueAsFloat = observer->OldValueLength == sizeof(AwaInteger) ? *((AwaFloat *)observer->OldValue) : 0;
+                        AwaFloat newValueAsFloat = newValueLength == sizeof(AwaInteger) ? *((AwaFloat *)newValue) : 0;
+
+                        if (attributes->Valid[AttributeTypeEnum_GreaterThan] &&
+                                ((oldValueAsFloat > attributes->GreaterThan) == (newValueAsFloat > attributes->GreaterThan)))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold high value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
+                        }
+                        else if (attributes->Valid[AttributeTypeEnum_LessThan] &&
+                                ((oldValueAsFloat > attributes->LessThan) == (newValueAsFloat > attributes->LessThan)))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but did not cross over threshold low value; not notifying observer for server %d", objectID, objectInstanceID, resourceID, shortServerID);
+                        }
+                        else if (attributes->Valid[AttributeTypeEnum_Step] && attributes->Step > labs(oldValueAsFloat - newValueAsFloat))
+                        {
+                            Lwm2m_Error("/%d/%d/%d changed but not by the step amount (Old value = %f, new value = %f); not notifying observer for server %d", objectID, objectInstanceID, resourceID, oldValueAsFloat, newValueAsFloat, shortServerID);
+                        }
+                        else
+                        {
+                            passedAttributeChecks = true;
+                        }
                         break;
                     }
-            }
-            else
-            {
-                if (observer->OldValue != NULL && resourceID != -1)
-                {
-                    Lwm2m_Error("No resource definition for /%d/%d/%d\n", objectID, objectInstanceID, resourceID);
-                }
-                else
-                {
-                    passedAttributeChecks = true;
+                    default:
+                        Lwm2m_Error("Unsupported resource type for checking gt/lt/stp attributes: %d\n", definition->Type);
+                        break;
                 }
+                break;
             }
+            default:
+                // Other resource types do not support stp/gt/lt attributes
+                passedAttributeChecks = true;
+                break;
+            }
+    }
+    else
+    {
+        if (observer->OldValue != NULL && resourceID != -1)
+        {
+            Lwm2m_Error("No resource definition for /%d/%d/%d\n", objectID, objectInstanceID, resourceID);
+        }
+        else
+        {
+            passedAttributeChecks = true;
+        }
+    }
 
-            if (passedAttributeChecks)
-            {
-                Lwm2m_Debug("All attributes checked out for server %d, Will notify change to /%d/%d/%d when possible.\n", shortServerID, objectID, objectInstanceID, resourceID);
-                observer->Changed = true;
+    if (passedAttributeChecks)
+    {
+        Lwm2m_Debug("All attributes checked out for server %d, Will notify change to /%d/%d/%d when possible.\n", shortServerID, objectID, objectInstanceID, resourceID);
+        if (!observer->Changed)
+        {
+            observer->Changed = true;
+            ScheduleObserver(context, observer);
+        }
 
-                if (observer->OldValue != NULL)
-                {
-                    free(observer->OldValue);
-                    observer->OldValue = NULL;
-                }
+        SetOldValue(observer, newValue, newValueLength);
+    }
+}
+
+void Lwm2m_MarkObserversChanged(void * ctxt, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID,
+                                ResourceIDType resourceID, const void * newValue, size_t newValueLength)
+{
+    Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
+    ResourceDefinition * definition = Definition_LookupResourceDefinition(Lwm2mCore_GetDefinitions(context), objectID, resourceID);
 
-                if (newValue != NULL)
+    // An observer of the object, object instance or resource matches a change; only probe the keys it could be indexed by
+    ObjectInstanceIDType objectInstanceIDs[] = { objectInstanceID, -1 };
+    ResourceIDType resourceIDs[] = { resourceID, -1 };
+    int numObjectInstanceIDs = (objectInstanceID == -1) ? 1 : 2;
+    int numResourceIDs = (resourceID == -1) ? 1 : 2;
+    int i, j;
+
+    for (i = 0; i < numObjectInstanceIDs; i++)
+    {
+        for (j = 0; j < numResourceIDs; j++)
+        {
+            HashTableEntry * entry;
+            HashTable_ForEachWithHash(entry, Lwm2mCore_GetObserverIndex(context), HashOIR(objectID, objectInstanceIDs[i], resourceIDs[j]))
+            {
+                Lwm2mObserverType * observer = HashTableContainer(entry, Lwm2mObserverType, OIREntry);
+                if (ObserverMatchesOIR(observer, objectID, objectInstanceIDs[i], resourceIDs[j]))
                 {
-                    observer->OldValue = malloc(newValueLength);
-                    observer->OldValueLength = newValueLength;
-                    memcpy(observer->OldValue, newValue, newValueLength);
+                    MarkObserverChanged(context, observer, definition, objectID, objectInstanceID, resourceID, newValue, newValueLength);
                 }
             }
         }
@@ -229,25 +372,16 @@ void Lwm2m_MarkObserversChanged(void * ctxt, ObjectIDType objectID, ObjectInstan
 int Lwm2m_RemoveAllObserversForOIR(void * ctxt, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
 {
     Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
-    struct ListHead * observerItem, *next;
-    ListForEachSafe(observerItem, next, Lwm2mCore_GetObserverList(context))
-    {
-        Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
-
-        if (observer->ObjectID == objectID &&
-            observer->ObjectInstanceID == objectInstanceID &&
-            observer->ResourceID == resourceID)
-        {
-
-           ListRemove(&observer->list);
+    Lwm2mObserverType * observer;
+    int result = -1;
 
-           free(observer->OldValue);
-           free(observer->ContextData);
-           free(observer);
-           return 0;
-        }
+    // any server may observe the entity, so look up again after each removal
+    while ((observer = LookupObserver(context, NULL, objectID, objectInstanceID, resourceID)) != NULL)
+    {
+        FreeObserver(context, observer);
+        result = 0;
     }
-    return -1;
+    return result;
 }
 
 void Lwm2m_FreeObservers(void * ctxt)
@@ -257,11 +391,7 @@ void Lwm2m_FreeObservers(void * ctxt)
     ListForEachSafe(observerItem, n, Lwm2mCore_GetObserverList(context))
     {
         Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
-
-        ListRemove(observerItem);
-        free(observer->OldValue);
-        free(observer->ContextData);
-        free(observer);
+        FreeObserver(context, observer);
     }
 }
 
@@ -288,15 +418,14 @@ int Lwm2m_Observe(void * ctxt, AddressType * addr, const char * token, int token
 
         memset(observer, 0, sizeof(*observer));
         ListAdd(&observer->list, Lwm2mCore_GetObserverList(context));
+        HashTable_Add(Lwm2mCore_GetObserverIndex(context), &observer->OIREntry, HashOIR(objectID, objectInstanceID, resourceID));
     }
     else
     {
-        free(observer->OldValue);
         free(observer->ContextData);
     }
 
-    observer->OldValue = NULL;
-    observer->OldValueLength = 0;
+    SetOldValue(observer, NULL, 0);
     observer->ObjectID = objectID;
     observer->ObjectInstanceID = objectInstanceID;
     observer->ResourceID = resourceID;
@@ -309,6 +438,7 @@ int Lwm2m_Observe(void * ctxt, AddressType * addr, const char * token, int token
     observer->Sequence = 1;
     memcpy(&observer->Token, token, tokenLength);
     memcpy(&observer->Address, addr, sizeof(AddressType));
+    ScheduleObserver(context, observer);
 
     // The old value buffer must be created when the observation begins,
     // otherwise attributes can't be checked on the first modification of a resource value.
@@ -325,9 +455,7 @@ int Lwm2m_Observe(void * ctxt, AddressType * addr, const char * token, int token
 
             if ((oldValueLength > 0) && (oldValue != NULL))
             {
-                observer->OldValueLength = oldValueLength;
-                observer->OldValue = malloc(observer->OldValueLength);
-                memcpy(observer->OldValue, oldValue, observer->OldValueLength);
+                SetOldValue(observer, oldValue, oldValueLength);
             }
         }
     }
@@ -342,49 +470,43 @@ int Lwm2m_CancelObserve(void * ctxt, AddressType * addr, ObjectIDType objectID,
     Lwm2mObserverType * observer = LookupObserver(context, addr, objectID, objectInstanceID, resourceID);
     if (observer != NULL)
     {
-        ListRemove(&observer->list);
-        free(observer->OldValue);
-        free(observer->ContextData);
-        free(observer);
+        FreeObserver(context, observer);
         return 0;
     }
     return -1;
 }
 
-void Lwm2m_UpdateObservers(void * ctxt)
+int32_t Lwm2m_UpdateObservers(void * ctxt)
 {
     Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
-    uint32_t now = Lwm2mCore_GetTickCountMs();
+    DeadlineQueue * queue = Lwm2mCore_GetObserverQueue(context);
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+    DeadlineQueueEntry * entry;
 
-    struct ListHead * observerItem, *n;
-    ListForEachSafe(observerItem, n, Lwm2mCore_GetObserverList(context))
+    while ((entry = DeadlineQueue_PopExpired(queue, now)) != NULL)
     {
-        Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
-
-        int shortServerID = Lwm2mSecurity_GetShortServerID(context, &observer->Address);
-
-        NotificationAttributes * resourceAttributes = observer->ResourceID == -1? NULL : AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID);
-        NotificationAttributes * objectInstanceAttributes = observer->ObjectInstanceID == -1? NULL : AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, observer->ObjectID, observer->ObjectInstanceID, -1);
-        NotificationAttributes * objectAttributes = AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context), shortServerID, observer->ObjectID, -1, -1);
-
-        NotificationAttributes * minimumPeriodAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_MinimumPeriod, resourceAttributes, objectInstanceAttributes, objectAttributes);
-        int minimumPeriod = minimumPeriodAttributes != NULL? minimumPeriodAttributes->MinimumPeriod : Lwm2mServerObject_GetDefaultMinimumPeriod(context, shortServerID);
-
-        NotificationAttributes * maximumPeriodAttributes = GetHighestValidAttributesForType(AttributeTypeEnum_MaximumPeriod, resourceAttributes, objectInstanceAttributes, objectAttributes);
-        int maximumPeriod = maximumPeriodAttributes != NULL? maximumPeriodAttributes->MaximumPeriod : Lwm2mServerObject_GetDefaultMaximumPeriod(context, shortServerID);
-
-        uint32_t elapsed = now - observer->LastUpdate;
+        Lwm2mObserverType * observer = DeadlineQueueContainer(entry, Lwm2mObserverType, NotifyEntry);
+
+        observer->Sequence ++;
+        observer->Callback(context, &observer->Address, observer->Sequence,
+                           (const char *)&observer->Token,
+                           observer->TokenLength,
+                           observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID, observer->ContentType, observer->ContextData);
+        observer->Changed = false;
+        observer->LastUpdate = now;
+        ScheduleObserver(context, observer);
+    }
+    return DeadlineQueue_GetTimeout(queue, now);
+}
 
-        if ((observer->Changed && (elapsed > ((uint32_t)minimumPeriod * 1000))) ||
-            ((maximumPeriod != -1) && (elapsed > ((uint32_t)maximumPeriod * 1000))))
-        {
-            observer->Sequence ++;
-            observer->Callback(context, &observer->Address, observer->Sequence,
-                               (const char *)&observer->Token,
-                               observer->TokenLength,
-                               observer->ObjectID, observer->ObjectInstanceID, observer->ResourceID, observer->ContentType, observer->ContextData);
-            observer->Changed = false;
-            observer->LastUpdate = now;
-        }
+void Lwm2m_RescheduleObservers(void * ctxt)
+{
+    Lwm2mContextType * context = (Lwm2mContextType *) ctxt;
+    struct ListHead * observerItem;
+    ListForEach(observerItem, Lwm2mCore_GetObserverList(context))
+    {
+        Lwm2mObserverType * observer = ListEntry(observerItem, Lwm2mObserverType, list);
+        observer->Attributes.Resolved = false;
+        ScheduleObserver(context, observer);
     }
 }
@@ -31,18 +31,39 @@ extern "C" {
 #include "lwm2m_types.h"
 #include "lwm2m_attributes.h"
 #include "lwm2m_list.h"
+#include "lwm2m_hash_table.h"
+#include "lwm2m_deadline_queue.h"
+
+#define OBSERVER_INLINE_VALUE_SIZE (16)
 
 typedef int (*Lwm2mNotificationCallback)(void * context, AddressType *, int, const char *, int, ObjectIDType, ObjectInstanceIDType, ResourceIDType, AwaContentType, void * ContextData);
 
+// Notification attributes in effect for an observer, each taken from the resource, object instance or object level
+typedef struct
+{
+    bool Resolved;                         // Cleared when the attributes or security objects change
+    int ShortServerID;
+    int MinimumPeriod;                     // Server's default if not set
+    int MaximumPeriod;                     // Server's default if not set, -1 for none
+    bool Valid[AttributeTypeEnum_LAST];    // Whether GreaterThan, LessThan and Step are set
+    float GreaterThan;
+    float LessThan;
+    float Step;
+
+} ObserverAttributes;
+
 typedef struct
 {
     struct ListHead list;
-    uint32_t LastUpdate;
+    HashTableEntry OIREntry;               // Indexed by object, object instance and resource ID, -1 for the whole object or instance
+    DeadlineQueueEntry NotifyEntry;        // Scheduled for the next notification, if one is due (pmax) or pending (changed, after pmin)
+    uint64_t LastUpdate;
     ObjectIDType ObjectID;
     ObjectInstanceIDType ObjectInstanceID;
     ResourceIDType ResourceID;
     AwaContentType ContentType;
     AddressType Address;
+    ObserverAttributes Attributes;
     Lwm2mNotificationCallback Callback;
     void * ContextData;
     bool Changed;
@@ -51,10 +72,23 @@ typedef struct
     int Sequence;
     void * OldValue;                       // For Integer and Float datatypes only, used for notification attributes.
     size_t OldValueLength;
+    union
+    {
+        AwaInteger Integer;
+        AwaFloat Float;
+        uint8_t Bytes[OBSERVER_INLINE_VALUE_SIZE];
+    } OldValueInline;                      // Holds OldValue if it fits, so most changes do not allocate
+    void * OldValueBuffer;                 // Holds larger values, grown as needed and reused between changes
+    size_t OldValueBufferSize;
 } Lwm2mObserverType;
 
 // Send out pending notifications to any observers of objects, object instances and resources.
-void Lwm2m_UpdateObservers(void * ctxt);
+// Return the time in milliseconds until the next notification is due, or -1 if none is.
+int32_t Lwm2m_UpdateObservers(void * ctxt);
+
+// Resolve each observer's attributes and server again and recompute when it is next due, after notification attributes,
+// a server's default periods or the security objects have changed.
+void Lwm2m_RescheduleObservers(void * ctxt);
 
 void Lwm2m_FreeObservers(void * ctxt);
 
@@ -70,6 +70,8 @@ const char * Lwm2mCore_DebugPrintAddress(AddressType * addr);
 bool Lwm2mCore_ResolveAddressByName(unsigned char * address, int addressLength, AddressType * addr);
 int Lwm2mCore_CompareAddresses(AddressType * addr1, AddressType * addr2);
 int Lwm2mCore_ComparePorts(AddressType * addr1, AddressType * addr2);
+// Hash consistent with Lwm2mCore_CompareAddresses, i.e. addresses that compare equal have the same hash
+uint32_t Lwm2mCore_HashAddress(AddressType * addr);
 int Lwm2mCore_GetIPAddressFromInterface(const char * interface, int addressFamily, char * destAddress, size_t destAddressLength);
 
 QueryPair * Lwm2mCore_SplitQuery(const char * query, int * numPairs);
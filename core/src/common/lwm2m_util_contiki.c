@@ -34,6 +34,7 @@
 #include "lwm2m_util.h"
 #include "lwm2m_list.h"
 #include "lwm2m_debug.h"
+#include "lwm2m_hash_table.h"
 
 
 uint64_t Lwm2mCore_GetTickCountMs(void)
@@ -104,6 +105,12 @@ int Lwm2mCore_ComparePorts(AddressType * addr1, AddressType * addr2)
     return 0;
 }
 
+uint32_t Lwm2mCore_HashAddress(AddressType * addr)
+{
+    uint32_t hash = HashTable_HashBytes(0, &addr->Addr.u16, sizeof(addr->Addr.u16));
+    return HashTable_HashBytes(hash, &addr->Port, sizeof(addr->Port));
+}
+
 int Lwm2mCore_GetIPAddressFromInterface(const char * interface, int addressFamily, char * destAddress, size_t destAddressLength)
 {
     /* Note: only used by servers */
@@ -41,6 +41,7 @@
 #endif
 #include "lwm2m_debug.h"
 #include "lwm2m_util.h"
+#include "lwm2m_hash_table.h"
 
 
 #include "lwm2m_list.h"
@@ -104,6 +105,10 @@ const char * Lwm2mCore_DebugPrintSockAddr(const struct sockaddr * sa)
             port =  ntohs(((struct sockaddr_in6 *)sa)->sin6_port);
             sprintf(out, "[%s]:%d", ip, port);
             break;
+        case AF_UNSPEC:
+            // unnamed local socket, such as a shard's link to its router
+            sprintf(out, "local");
+            break;
         default:
             Lwm2m_Error("Unsupported address family: %d\n", sa->sa_family);
             break;
@@ -167,6 +172,25 @@ int Lwm2mCore_ComparePorts(AddressType * addr1, AddressType * addr2)
 }
 
 
+uint32_t Lwm2mCore_HashAddress(AddressType * addr)
+{
+    uint32_t hash = 0;
+    switch (addr->Addr.Sa.sa_family)
+    {
+        case AF_INET:
+            hash = HashTable_HashBytes(hash, &addr->Addr.Sin.sin_addr, sizeof(addr->Addr.Sin.sin_addr));
+            hash = HashTable_HashBytes(hash, &addr->Addr.Sin.sin_port, sizeof(addr->Addr.Sin.sin_port));
+            break;
+        case AF_INET6:
+            hash = HashTable_HashBytes(hash, &addr->Addr.Sin6.sin6_addr, sizeof(addr->Addr.Sin6.sin6_addr));
+            hash = HashTable_HashBytes(hash, &addr->Addr.Sin6.sin6_port, sizeof(addr->Addr.Sin6.sin6_port));
+            break;
+        default:
+            break;
+    }
+    return hash;
+}
+
 int Lwm2mCore_GetIPAddressFromInterface(const char * interface, int addressFamily, char * destAddress, size_t destAddressLength)
 {
 #ifdef RIOT /* N/A to RIOT since it does not store interface name */
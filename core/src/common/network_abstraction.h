@@ -31,6 +31,7 @@ extern "C" {
 #include <stdint.h>
 
 #include "lwm2m_types.h"
+#include "dtls_keystore.h"
 
 
 typedef enum
@@ -48,7 +49,8 @@ typedef enum
     NetworkSocketType_NotSet = 0,
     NetworkSocketType_UDP = 1,
     NetworkSocketType_TCP = 2,
-    NetworkSocketType_Secure = 4
+    NetworkSocketType_Secure = 4,
+    NetworkSocketType_Shared = 8        // Bind with SO_REUSEPORT, so that several processes can listen on the port
 } NetworkSocketType;
 
 
@@ -56,16 +58,44 @@ typedef struct _NetworkAddress NetworkAddress;
 
 typedef struct _NetworkSocket NetworkSocket;
 
+typedef struct
+{
+    uint32_t Hits;                      // Lookups answered by a cached address
+    uint32_t Misses;                    // Lookups that resolved or allocated a new address
+    uint32_t Evictions;                 // Unused addresses freed by the cache
+    uint32_t Count;                     // Addresses currently cached
+
+} NetworkAddressCacheStatistics;
+
 NetworkAddress * NetworkAddress_New(const char * uri, int uriLength);
 
+// Address of a peer already resolved into addressType, without formatting and parsing a URI. Free with NetworkAddress_Free.
+NetworkAddress * NetworkAddress_FromAddressType(AddressType * addressType);
+
+// Take another reference to address, released with NetworkAddress_Free
+NetworkAddress * NetworkAddress_Retain(NetworkAddress * address);
+
 int NetworkAddress_Compare(NetworkAddress * addressX, NetworkAddress * addressY);
 
+// Hash of the address and port, consistent with NetworkAddress_Compare
+uint32_t NetworkAddress_Hash(NetworkAddress * address);
+
+// Longest serialised address: family, IPv6 address and port
+#define NETWORK_ADDRESS_MAX_SERIALISED_LENGTH (1 + 16 + 2)
+
+/* Write the family, address and port of an address to buffer, as a key that identifies the peer, such as for DTLS
+ * cookies. Returns the number of bytes written, or 0 if the buffer is too small.
+ */
+int NetworkAddress_Serialise(NetworkAddress * address, uint8_t * buffer, int bufferLength);
+
 void NetworkAddress_SetAddressType(NetworkAddress * address, AddressType * addressType);
 
 void NetworkAddress_Free(NetworkAddress ** address);
 
 bool NetworkAddress_IsSecure(const NetworkAddress * address);
 
+void NetworkAddress_GetCacheStatistics(NetworkAddressCacheStatistics * statistics);
+
 NetworkSocket * NetworkSocket_New(const char * ipAddress, NetworkSocketType socketType, uint16_t port);
 
 NetworkSocketError NetworkSocket_GetError(NetworkSocket * networkSocket);
@@ -75,6 +105,8 @@ int NetworkSocket_GetFileDescriptor(NetworkSocket * networkSocket);
 void NetworkSocket_SetCertificate(NetworkSocket * networkSocket, const uint8_t * cert, int certLength, AwaCertificateFormat format);
 
 void NetworkSocket_SetPSK(NetworkSocket * networkSocket, const char * identity, const uint8_t * key, int keyLength);
+void NetworkSocket_SetKeyStore(NetworkSocket * networkSocket, DTLS_KeyStore * keyStore);
+bool NetworkSocket_SetHandshakeWorkers(NetworkSocket * networkSocket, int workers);
 
 bool NetworkSocket_StartListening(NetworkSocket * networkSocket);
 
@@ -84,6 +116,19 @@ bool NetworkSocket_Read(NetworkSocket * networkSocket, uint8_t * buffer, int buf
 
 bool NetworkSocket_Send(NetworkSocket * networkSocket, NetworkAddress * destAddress, uint8_t * buffer, int bufferLength);
 
+/* Receive and send up to batchSize datagrams per system call. Once set above 1, NetworkSocket_Read returns
+ * datagrams from the last batch received until it is empty, and NetworkSocket_Send queues datagrams until the
+ * batch is full or NetworkSocket_Flush is called. Set it after the socket is listening, as batching may change
+ * the descriptor NetworkSocket_GetFileDescriptor returns. Returns false if batching is not supported.
+ */
+bool NetworkSocket_SetBatchSize(NetworkSocket * networkSocket, int batchSize);
+
+// Number of received datagrams NetworkSocket_Read will return without reading from the socket again
+int NetworkSocket_GetPendingReads(NetworkSocket * networkSocket);
+
+// Send the datagrams queued by NetworkSocket_Send
+bool NetworkSocket_Flush(NetworkSocket * networkSocket);
+
 void NetworkSocket_Free(NetworkSocket ** networkSocket);
 
 #ifdef __cplusplus
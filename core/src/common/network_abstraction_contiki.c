@@ -34,6 +34,7 @@
 
 #include "lwm2m_debug.h"
 #include "lwm2m_util.h"
+#include "lwm2m_hash_table.h"
 #include "network_abstraction.h"
 #include "dtls_abstraction.h"
 
@@ -87,7 +88,7 @@ static NetworkAddress * getCachedAddress(const uip_ipaddr_t * addr, uint16_t por
 #define ENCRYPT_BUFFER_LENGTH 1024
 #endif
 
-uint8_t encryptBuffer[ENCRYPT_BUFFER_LENGTH];
+static uint8_t encryptBuffer[ENCRYPT_BUFFER_LENGTH];
 
 static NetworkTransmissionError SendDTLS(NetworkAddress * destAddress, const uint8_t * buffer, int bufferLength, void *context);
 
@@ -273,6 +274,30 @@ int NetworkAddress_Compare(NetworkAddress * address1, NetworkAddress * address2)
     return result;
 }
 
+uint32_t NetworkAddress_Hash(NetworkAddress * address)
+{
+    uint32_t result = 0;
+    if (address)
+    {
+        result = HashTable_HashBytes(0, &address->Address, sizeof(uip_ipaddr_t));
+        result = HashTable_HashBytes(result, &address->Port, sizeof(address->Port));
+    }
+    return result;
+}
+
+int NetworkAddress_Serialise(NetworkAddress * address, uint8_t * buffer, int bufferLength)
+{
+    int result = 0;
+    if (address && buffer && (bufferLength >= 1 + (int)sizeof(uip_ipaddr_t) + (int)sizeof(address->Port)))
+    {
+        buffer[0] = 6;
+        memcpy(&buffer[1], &address->Address, sizeof(uip_ipaddr_t));
+        memcpy(&buffer[1 + sizeof(uip_ipaddr_t)], &address->Port, sizeof(address->Port));
+        result = 1 + sizeof(uip_ipaddr_t) + sizeof(address->Port);
+    }
+    return result;
+}
+
 void NetworkAddress_SetAddressType(NetworkAddress * address, AddressType * addressType)
 {
     if (address && addressType)
@@ -307,6 +332,49 @@ void NetworkAddress_Free(NetworkAddress ** address)
     }
 }
 
+NetworkAddress * NetworkAddress_FromAddressType(AddressType * addressType)
+{
+    NetworkAddress * result = NULL;
+    if (addressType)
+    {
+        result = getCachedAddress(&addressType->Addr, addressType->Port);
+        if (!result)
+        {
+            result = addCachedAddress(&addressType->Addr, addressType->Port, addressType->Secure);
+        }
+        if (result)
+        {
+            result->useCount++;
+        }
+    }
+    return result;
+}
+
+NetworkAddress * NetworkAddress_Retain(NetworkAddress * address)
+{
+    if (address)
+    {
+        address->useCount++;
+    }
+    return address;
+}
+
+void NetworkAddress_GetCacheStatistics(NetworkAddressCacheStatistics * statistics)
+{
+    if (statistics)
+    {
+        int index;
+        memset(statistics, 0, sizeof(*statistics));
+        for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
+        {
+            if (networkAddressCache[index].InUse)
+            {
+                statistics->Count++;
+            }
+        }
+    }
+}
+
 bool NetworkAddress_IsSecure(const NetworkAddress * address)
 {
     bool result = false;
@@ -404,6 +472,16 @@ void NetworkSocket_SetPSK(NetworkSocket * networkSocket, const char * identity,
     DTLS_SetPSK(identity, key, keyLength);
 }
 
+void NetworkSocket_SetKeyStore(NetworkSocket * networkSocket, DTLS_KeyStore * keyStore)
+{
+    DTLS_SetKeyStore(keyStore);
+}
+
+bool NetworkSocket_SetHandshakeWorkers(NetworkSocket * networkSocket, int workers)
+{
+    return (workers >= 0) && (DTLS_SetHandshakeWorkers(workers) == 0);
+}
+
 
 bool NetworkSocket_StartListening(NetworkSocket * networkSocket)
 {
@@ -481,12 +559,9 @@ bool NetworkSocket_Read(NetworkSocket * networkSocket, uint8_t * buffer, int buf
                    }
                    if ((*readLength > 0) && *sourceAddress && (*sourceAddress)->Secure)
                    {
-                       if (DTLS_Decrypt(*sourceAddress, buffer, *readLength, encryptBuffer, ENCRYPT_BUFFER_LENGTH, readLength, networkSocket))
+                       if (!DTLS_Decrypt(*sourceAddress, buffer, *readLength, buffer, bufferLength, readLength, networkSocket))
                        {
-                           if (*readLength > 0)
-                           {
-                               memcpy(buffer, encryptBuffer, *readLength);
-                           }
+                           *readLength = 0;
                        }
                    }
                 }
@@ -554,6 +629,22 @@ bool NetworkSocket_Send(NetworkSocket * networkSocket, NetworkAddress * destAddr
     return result;
 }
 
+bool NetworkSocket_SetBatchSize(NetworkSocket * networkSocket, int batchSize)
+{
+    // uIP hands over one datagram at a time
+    return batchSize == 1;
+}
+
+int NetworkSocket_GetPendingReads(NetworkSocket * networkSocket)
+{
+    return 0;
+}
+
+bool NetworkSocket_Flush(NetworkSocket * networkSocket)
+{
+    return true;
+}
+
 void NetworkSocket_Free(NetworkSocket ** networkSocket)
 {
     if (networkSocket && *networkSocket)
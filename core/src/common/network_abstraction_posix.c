@@ -34,8 +34,21 @@
 
 #include "lwm2m_debug.h"
 #include "lwm2m_util.h"
-#include "network_abstraction.h"
+#include "lwm2m_list.h"
+#include "lwm2m_hash_table.h"
+#include "network_abstraction_posix.h"
 #include "dtls_abstraction.h"
+#ifdef WITH_IO_URING
+#include "network_io_uring.h"
+#endif
+
+#if defined(__linux__) && !defined(RIOT)
+    #define BATCHED_IO_SUPPORTED
+#endif
+
+#ifndef MAX_BATCH_DATAGRAM_LENGTH
+    #define MAX_BATCH_DATAGRAM_LENGTH  (2048)
+#endif
 
 struct _NetworkAddress
 {
@@ -47,7 +60,13 @@ struct _NetworkAddress
         struct sockaddr_in6 Sin6;
     } Address;
     bool Secure;
-    int useCount;
+    int useCount;                           // References, including the cache's own while Cached
+    bool Cached;
+    HashTableEntry AddressEntry;            // Cache index by socket address
+    HashTableEntry UriEntry;                // Cache index by URI host and port, if resolved from a URI
+    char * Uri;
+    struct ListHead IdleList;               // Position in the eviction order while only the cache references it
+    uint64_t LastUsed;
 };
 
 struct _NetworkSocket
@@ -58,13 +77,29 @@ struct _NetworkSocket
     NetworkSocketType SocketType;
     uint16_t Port;
     NetworkSocketError LastError;
+    struct _DatagramBatch * ReadBatch;      // NULL unless batching is enabled
+    struct _DatagramBatch * SendBatch;
+    uint8_t * EncryptBuffer;                // Records encrypted for sending, grown to the largest sent
+    int EncryptBufferLength;
+#ifdef WITH_IO_URING
+    NetworkRing * Ring;                     // Used for batching instead, if the kernel supports it
+#endif
 };
 
-typedef struct
+#ifdef BATCHED_IO_SUPPORTED
+typedef struct _DatagramBatch
 {
-    char * uri;
-    NetworkAddress * address;
-} NetworkAddressCache;
+    int Size;                               // Maximum datagrams in the batch
+    int Count;                              // Datagrams received, or queued to send
+    int Next;                               // Next received datagram to return
+    int Socket;                             // Socket the queued datagrams are sent on
+    bool IPv6First;                         // Receive from the IPv6 socket first, alternated so neither starves
+    struct mmsghdr * Messages;
+    struct iovec * Vectors;
+    struct sockaddr_storage * Addresses;
+    uint8_t * Buffers;                      // Size buffers of MAX_BATCH_DATAGRAM_LENGTH bytes
+} DatagramBatch;
+#endif
 
 typedef enum
 {
@@ -75,57 +110,135 @@ typedef enum
 
 #define MAX_URI_LENGTH  (256)
 
-#ifndef MAX_NETWORK_ADDRESS_CACHE
-    #define MAX_NETWORK_ADDRESS_CACHE  (5)
-#endif
+typedef struct
+{
+    bool Initialised;
+    HashTable ByAddress;
+    HashTable ByUri;
+    struct ListHead Idle;                   // Addresses only referenced by the cache, least recently used first
+    uint32_t IdleCount;
+    NetworkAddressCacheStatistics Statistics;
 
-static NetworkAddressCache networkAddressCache[MAX_NETWORK_ADDRESS_CACHE] = {{0}};
+} NetworkAddressCache;
 
-#ifndef ENCRYPT_BUFFER_LENGTH
-#define ENCRYPT_BUFFER_LENGTH 1024
-#endif
+static NetworkAddressCache networkAddressCache;
 
-static uint8_t encryptBuffer[ENCRYPT_BUFFER_LENGTH];
+static bool initCache(void)
+{
+    if (!networkAddressCache.Initialised)
+    {
+        if (HashTable_Init(&networkAddressCache.ByAddress, 0) != 0)
+            return false;
+        if (HashTable_Init(&networkAddressCache.ByUri, 0) != 0)
+        {
+            HashTable_Destroy(&networkAddressCache.ByAddress);
+            return false;
+        }
+        ListInit(&networkAddressCache.Idle);
+        networkAddressCache.Initialised = true;
+    }
+    return true;
+}
+
+static uint32_t hashAddress(const NetworkAddress * address)
+{
+    uint32_t hash = HashTable_HashInt(address->Address.Sa.sa_family);
+    if (address->Address.Sa.sa_family == AF_INET)
+    {
+        hash = HashTable_HashBytes(hash, &address->Address.Sin.sin_addr, sizeof(address->Address.Sin.sin_addr));
+        hash = HashTable_HashBytes(hash, &address->Address.Sin.sin_port, sizeof(address->Address.Sin.sin_port));
+    }
+    else if (address->Address.Sa.sa_family == AF_INET6)
+    {
+        hash = HashTable_HashBytes(hash, &address->Address.Sin6.sin6_addr, sizeof(address->Address.Sin6.sin6_addr));
+        hash = HashTable_HashBytes(hash, &address->Address.Sin6.sin6_port, sizeof(address->Address.Sin6.sin6_port));
+    }
+    return hash;
+}
+
+static void freeCachedAddress(NetworkAddress * address)
+{
+    HashTable_Remove(&networkAddressCache.ByAddress, &address->AddressEntry);
+    HashTable_Remove(&networkAddressCache.ByUri, &address->UriEntry);
+    ListRemove(&address->IdleList);
+    if (address->Uri)
+    {
+        Lwm2m_Debug("Address free: %s\n", address->Uri);
+        free(address->Uri);
+    }
+    else
+    {
+        Lwm2m_Debug("Address free\n");
+    }
+    free(address);
+}
+
+// Free the least recently used addresses that only the cache references, while there are too many or they have expired
+static void evictCachedAddresses(uint64_t now)
+{
+    while (networkAddressCache.IdleCount > 0)
+    {
+        NetworkAddress * address = ListEntry(networkAddressCache.Idle.Next, NetworkAddress, IdleList);
+        if ((networkAddressCache.IdleCount <= NETWORK_ADDRESS_CACHE_IDLE_LIMIT) && (now - address->LastUsed < NETWORK_ADDRESS_CACHE_IDLE_TIMEOUT))
+            break;
+        networkAddressCache.IdleCount--;
+        networkAddressCache.Statistics.Evictions++;
+        freeCachedAddress(address);
+    }
+}
+
+static void retainAddress(NetworkAddress * address)
+{
+    if (address->Cached && (address->useCount == 1))
+    {
+        ListRemove(&address->IdleList);
+        networkAddressCache.IdleCount--;
+    }
+    address->useCount++;
+}
+
+static void useCachedAddress(NetworkAddress * address, uint64_t now)
+{
+    address->LastUsed = now;
+    if (address->useCount == 1)
+    {
+        // move to the most recently used end
+        ListRemove(&address->IdleList);
+        ListAdd(&address->IdleList, &networkAddressCache.Idle);
+    }
+    networkAddressCache.Statistics.Hits++;
+}
 
 static NetworkAddress * getCachedAddressByUri(const char * uri, int uriLength)
 {
     NetworkAddress * result = NULL;
-    int index;
-    for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
+    if (networkAddressCache.Initialised)
     {
-        if (networkAddressCache[index].uri && (memcmp(networkAddressCache[index].uri, uri, uriLength) == 0))
+        HashTableEntry * entry;
+        HashTable_ForEachWithHash(entry, &networkAddressCache.ByUri, HashTable_HashBytes(0, uri, uriLength))
         {
-            //Lwm2m_Debug("Address uri matched: %s\n", networkAddressCache[index].uri);
-            result = networkAddressCache[index].address;
-            break;
+            NetworkAddress * address = HashTableContainer(entry, NetworkAddress, UriEntry);
+            if ((strncmp(address->Uri, uri, uriLength) == 0) && (address->Uri[uriLength] == '\0'))
+            {
+                result = address;
+                break;
+            }
         }
     }
     return result;
 }
 
-static NetworkAddress * getCachedAddress(NetworkAddress * matchAddress, const char * uri, int uriLength)
+static NetworkAddress * getCachedAddress(NetworkAddress * matchAddress)
 {
     NetworkAddress * result = NULL;
-    int index;
-    for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
+    if (networkAddressCache.Initialised)
     {
-        NetworkAddress * address = networkAddressCache[index].address;
-        if (address)
+        HashTableEntry * entry;
+        HashTable_ForEachWithHash(entry, &networkAddressCache.ByAddress, hashAddress(matchAddress))
         {
+            NetworkAddress * address = HashTableContainer(entry, NetworkAddress, AddressEntry);
             if (NetworkAddress_Compare(matchAddress, address) == 0)
             {
-                if (uri && uriLength > 0 && networkAddressCache[index].uri == NULL)
-                {
-                    // Add info to cached address
-                    address->Secure = matchAddress->Secure;
-                    networkAddressCache[index].uri = (char *)malloc(uriLength + 1);
-                    if (networkAddressCache[index].uri)
-                    {
-                        memcpy(networkAddressCache[index].uri, uri, uriLength);
-                        networkAddressCache[index].uri[uriLength] = 0;
-                        Lwm2m_Debug("Address add uri: %s\n", networkAddressCache[index].uri);
-                    }
-                }
                 result = address;
                 break;
             }
@@ -134,38 +247,56 @@ static NetworkAddress * getCachedAddress(NetworkAddress * matchAddress, const ch
     return result;
 }
 
-static void addCachedAddress(NetworkAddress * address, const char * uri, int uriLength)
+static void setCachedAddressUri(NetworkAddress * address, const char * uri, int uriLength)
 {
-    if (address)
+    if (uri && (uriLength > 0) && (address->Uri == NULL))
     {
-        int index;
-        for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
+        address->Uri = (char *)malloc(uriLength + 1);
+        if (address->Uri)
         {
-            if (networkAddressCache[index].address == NULL)
-            {
-                if (uri && uriLength > 0)
-                {
-                    networkAddressCache[index].uri = (char *)malloc(uriLength + 1);
-                    if (networkAddressCache[index].uri)
-                    {
-                        memcpy(networkAddressCache[index].uri, uri, uriLength);
-                        networkAddressCache[index].uri[uriLength] = 0;
-                        networkAddressCache[index].address = address;
-                        Lwm2m_Debug("Address add: %s\n", networkAddressCache[index].uri);
-                    }
-                }
-                else
-                {
-                    networkAddressCache[index].address = address;
-                    networkAddressCache[index].uri = NULL;
-                    Lwm2m_Debug("Address add (received)\n");    // TODO - print remote address
-                }
-                break;
-            }
+            memcpy(address->Uri, uri, uriLength);
+            address->Uri[uriLength] = 0;
+            HashTable_Add(&networkAddressCache.ByUri, &address->UriEntry, HashTable_HashBytes(0, uri, uriLength));
+            Lwm2m_Debug("Address add uri: %s\n", address->Uri);
         }
     }
 }
 
+// Add an address to the cache, which takes its own reference to it
+static void addCachedAddress(NetworkAddress * address, const char * uri, int uriLength, uint64_t now)
+{
+    if (initCache())
+    {
+        evictCachedAddresses(now);
+        HashTable_Add(&networkAddressCache.ByAddress, &address->AddressEntry, hashAddress(address));
+        setCachedAddressUri(address, uri, uriLength);
+        address->Cached = true;
+        address->LastUsed = now;
+        address->useCount++;
+        if (address->useCount == 1)
+        {
+            ListAdd(&address->IdleList, &networkAddressCache.Idle);
+            networkAddressCache.IdleCount++;
+        }
+        if (address->Uri == NULL)
+        {
+            Lwm2m_Debug("Address add (received)\n");    // TODO - print remote address
+        }
+    }
+}
+
+static NetworkAddress * newAddress(void)
+{
+    size_t size = sizeof(struct _NetworkAddress);
+    NetworkAddress * result = (NetworkAddress *)malloc(size);
+    if (result)
+    {
+        memset(result, 0, size);
+        ListInit(&result->IdleList);
+    }
+    return result;
+}
+
 static int getUriHostLength(const char * uri, int uriLength)
 {
     // Search for end of host + optional port
@@ -224,6 +355,10 @@ static NetworkTransmissionError SendDTLS(NetworkAddress * destAddress, const uin
     NetworkSocket * networkSocket = (NetworkSocket *)context;
     if (networkSocket)
     {
+        // keep handshake records in order with any application data queued before them. Handshake workers send
+        // directly, as only the thread that reads the socket uses its queue, and their peers have no data queued.
+        if (!DTLS_IsHandshakeWorker())
+            NetworkSocket_Flush(networkSocket);
         if (!sendUDP(networkSocket, destAddress, buffer, bufferLength))
         {
             result = NetworkTransmissionError_TransmitBufferFull;
@@ -232,12 +367,176 @@ static NetworkTransmissionError SendDTLS(NetworkAddress * destAddress, const uin
     return result;
 }
 
+#ifdef BATCHED_IO_SUPPORTED
+static bool isBatched(NetworkSocket * networkSocket)
+{
+#ifdef WITH_IO_URING
+    if (networkSocket->Ring)
+        return true;
+#endif
+    return networkSocket->SendBatch != NULL;
+}
+
+static void freeBatch(DatagramBatch ** batch)
+{
+    if (batch && *batch)
+    {
+        free((*batch)->Messages);
+        free((*batch)->Vectors);
+        free((*batch)->Addresses);
+        free((*batch)->Buffers);
+        free(*batch);
+        *batch = NULL;
+    }
+}
+
+static DatagramBatch * newBatch(int size)
+{
+    DatagramBatch * batch = (DatagramBatch *)malloc(sizeof(DatagramBatch));
+    if (batch)
+    {
+        memset(batch, 0, sizeof(DatagramBatch));
+        batch->Size = size;
+        batch->Socket = SOCKET_ERROR;
+        batch->Messages = (struct mmsghdr *)calloc(size, sizeof(struct mmsghdr));
+        batch->Vectors = (struct iovec *)calloc(size, sizeof(struct iovec));
+        batch->Addresses = (struct sockaddr_storage *)calloc(size, sizeof(struct sockaddr_storage));
+        batch->Buffers = (uint8_t *)malloc(size * MAX_BATCH_DATAGRAM_LENGTH);
+        if (batch->Messages && batch->Vectors && batch->Addresses && batch->Buffers)
+        {
+            int index;
+            for (index = 0; index < size; index++)
+            {
+                batch->Vectors[index].iov_base = &batch->Buffers[index * MAX_BATCH_DATAGRAM_LENGTH];
+                batch->Messages[index].msg_hdr.msg_iov = &batch->Vectors[index];
+                batch->Messages[index].msg_hdr.msg_iovlen = 1;
+                batch->Messages[index].msg_hdr.msg_name = &batch->Addresses[index];
+            }
+        }
+        else
+        {
+            freeBatch(&batch);
+        }
+    }
+    return batch;
+}
+
+// Receive as many datagrams as are waiting on the socket, up to the batch size
+static bool receiveBatch(NetworkSocket * networkSocket, int socketHandle)
+{
+    bool result = true;
+    DatagramBatch * batch = networkSocket->ReadBatch;
+    int index;
+    for (index = 0; index < batch->Size; index++)
+    {
+        batch->Vectors[index].iov_len = MAX_BATCH_DATAGRAM_LENGTH;
+        batch->Messages[index].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+    }
+    batch->Next = 0;
+    batch->Count = recvmmsg(socketHandle, batch->Messages, batch->Size, MSG_DONTWAIT, NULL);
+    if (batch->Count == SOCKET_ERROR)
+    {
+        batch->Count = 0;
+        if ((errno != EWOULDBLOCK) && (errno != EAGAIN) && (errno != EINTR))
+        {
+            networkSocket->LastError = NetworkSocketError_ReadError;
+            result = false;
+        }
+    }
+    return result;
+}
+
+static bool sendBatch(NetworkSocket * networkSocket)
+{
+    bool result = true;
+    DatagramBatch * batch = networkSocket->SendBatch;
+    int sent = 0;
+#ifdef WITH_IO_URING
+    if (networkSocket->Ring)
+    {
+        result = NetworkRing_Flush(networkSocket->Ring);
+        if (!result)
+            networkSocket->LastError = NetworkSocketError_SendError;
+        return result;
+    }
+#endif
+    while (sent < batch->Count)
+    {
+        int sentMessages = sendmmsg(batch->Socket, &batch->Messages[sent], batch->Count - sent, 0);
+        if (sentMessages == SOCKET_ERROR)
+        {
+            if ((errno == EWOULDBLOCK) || (errno == EINTR))
+            {
+                continue;
+            }
+            // drop the datagram that could not be sent, so that the rest are not held up behind it
+            networkSocket->LastError = NetworkSocketError_SendError;
+            result = false;
+            sentMessages = 1;
+        }
+        sent += sentMessages;
+    }
+    batch->Count = 0;
+    return result;
+}
+
+static bool queueUDP(NetworkSocket * networkSocket, NetworkAddress * destAddress, const uint8_t * buffer, int bufferLength)
+{
+    bool result = true;
+    DatagramBatch * batch = networkSocket->SendBatch;
+    int socketHandle = networkSocket->Socket;
+    if (destAddress->Address.Sa.sa_family == AF_INET6)
+        socketHandle = networkSocket->SocketIPv6;
+
+#ifdef WITH_IO_URING
+    if (networkSocket->Ring)
+    {
+        if (bufferLength > MAX_BATCH_DATAGRAM_LENGTH)
+        {
+            result = sendBatch(networkSocket) && sendUDP(networkSocket, destAddress, buffer, bufferLength);
+        }
+        else if (!NetworkRing_Send(networkSocket->Ring, socketHandle, &destAddress->Address.St, buffer, bufferLength))
+        {
+            networkSocket->LastError = NetworkSocketError_SendError;
+            result = false;
+        }
+        return result;
+    }
+#endif
+
+    // a batch is sent on one socket
+    if ((batch->Count > 0) && (batch->Socket != socketHandle))
+    {
+        result = sendBatch(networkSocket);
+    }
+
+    if (bufferLength > MAX_BATCH_DATAGRAM_LENGTH)
+    {
+        result = sendBatch(networkSocket) && sendUDP(networkSocket, destAddress, buffer, bufferLength);
+    }
+    else
+    {
+        int index = batch->Count++;
+        batch->Socket = socketHandle;
+        memcpy(batch->Vectors[index].iov_base, buffer, bufferLength);
+        batch->Vectors[index].iov_len = bufferLength;
+        memcpy(&batch->Addresses[index], &destAddress->Address, sizeof(struct sockaddr_storage));
+        batch->Messages[index].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        if (batch->Count == batch->Size)
+        {
+            result = sendBatch(networkSocket);
+        }
+    }
+    return result;
+}
+#endif
+
 NetworkAddress * NetworkAddress_FromIPAddress(const char * ipAddress, uint16_t port)
 {
-    NetworkAddress * result;
-    size_t size = sizeof(struct _NetworkAddress);
-    result = (NetworkAddress *)malloc(size);
-    memset(result, 0, size);
+    NetworkAddress * result = newAddress();
+    if (result == NULL)
+        return NULL;
+    result->useCount = 1;
     if (inet_pton(AF_INET, ipAddress, &result->Address.Sin.sin_addr) == 1)
     {
         result->Address.Sin.sin_family = AF_INET;
@@ -315,6 +614,34 @@ int NetworkAddress_Compare(NetworkAddress * address1, NetworkAddress * address2)
     return result;
 }
 
+uint32_t NetworkAddress_Hash(NetworkAddress * address)
+{
+    return address ? hashAddress(address) : 0;
+}
+
+int NetworkAddress_Serialise(NetworkAddress * address, uint8_t * buffer, int bufferLength)
+{
+    int result = 0;
+    if (address && buffer)
+    {
+        if ((address->Address.Sa.sa_family == AF_INET) && (bufferLength >= 1 + (int)sizeof(struct in_addr) + 2))
+        {
+            buffer[0] = 4;
+            memcpy(&buffer[1], &address->Address.Sin.sin_addr, sizeof(struct in_addr));
+            memcpy(&buffer[1 + sizeof(struct in_addr)], &address->Address.Sin.sin_port, 2);
+            result = 1 + sizeof(struct in_addr) + 2;
+        }
+        else if ((address->Address.Sa.sa_family == AF_INET6) && (bufferLength >= 1 + (int)sizeof(struct in6_addr) + 2))
+        {
+            buffer[0] = 6;
+            memcpy(&buffer[1], &address->Address.Sin6.sin6_addr, sizeof(struct in6_addr));
+            memcpy(&buffer[1 + sizeof(struct in6_addr)], &address->Address.Sin6.sin6_port, 2);
+            result = 1 + sizeof(struct in6_addr) + 2;
+        }
+    }
+    return result;
+}
+
 bool NetworkAddress_IsSecure(const NetworkAddress * address)
 {
     bool result = false;
@@ -343,6 +670,11 @@ int NetworkSocket_GetFileDescriptor(NetworkSocket * networkSocket)
         result = networkSocket->Socket;
         if (result == SOCKET_ERROR)
             result = networkSocket->SocketIPv6;
+#ifdef WITH_IO_URING
+        // the ring takes the datagrams from the sockets, so they never become readable
+        if (networkSocket->Ring)
+            result = NetworkRing_GetFileDescriptor(networkSocket->Ring);
+#endif
     }
     return result;
 }
@@ -351,17 +683,36 @@ void NetworkSocket_Free(NetworkSocket ** networkSocket)
 {
     if (networkSocket && *networkSocket)
     {
+        NetworkSocket_SetBatchSize(*networkSocket, 1);
         if ((*networkSocket)->Socket != SOCKET_ERROR)
             close((*networkSocket)->Socket);
         if ((*networkSocket)->SocketIPv6 != SOCKET_ERROR)
             close((*networkSocket)->SocketIPv6);
         if ((*networkSocket)->BindAddress)
             NetworkAddress_Free(&(*networkSocket)->BindAddress);
+        free((*networkSocket)->EncryptBuffer);
         free(*networkSocket);
         *networkSocket = NULL;
     }
 }
 
+static uint8_t * getEncryptBuffer(NetworkSocket * networkSocket, int plainTextLength)
+{
+    int length = plainTextLength + DTLS_MAX_RECORD_OVERHEAD;
+    if (length > networkSocket->EncryptBufferLength)
+    {
+        uint8_t * encryptBuffer = realloc(networkSocket->EncryptBuffer, length);
+        if (!encryptBuffer)
+        {
+            Lwm2m_Error("Failed to allocate memory for DTLS record\n");
+            return NULL;
+        }
+        networkSocket->EncryptBuffer = encryptBuffer;
+        networkSocket->EncryptBufferLength = length;
+    }
+    return networkSocket->EncryptBuffer;
+}
+
 bool NetworkSocket_Send(NetworkSocket * networkSocket, NetworkAddress * destAddress, uint8_t * buffer, int bufferLength)
 {
     bool result = false;
@@ -377,7 +728,8 @@ bool NetworkSocket_Send(NetworkSocket * networkSocket, NetworkAddress * destAddr
                     if (destAddress->Secure)
                     {
                         int encryptedBytes;
-                        if (DTLS_Encrypt(destAddress, buffer, bufferLength, encryptBuffer, ENCRYPT_BUFFER_LENGTH, &encryptedBytes, networkSocket))
+                        uint8_t * encryptBuffer = getEncryptBuffer(networkSocket, bufferLength);
+                        if (encryptBuffer && DTLS_Encrypt(destAddress, buffer, bufferLength, encryptBuffer, networkSocket->EncryptBufferLength, &encryptedBytes, networkSocket))
                         {
                             buffer = encryptBuffer;
                             bufferLength = encryptedBytes;
@@ -389,7 +741,12 @@ bool NetworkSocket_Send(NetworkSocket * networkSocket, NetworkAddress * destAddr
                     }
                     if (bufferLength > 0)
                     {
-                        result = sendUDP(networkSocket, destAddress, buffer, bufferLength);
+#ifdef BATCHED_IO_SUPPORTED
+                        if (isBatched(networkSocket))
+                            result = queueUDP(networkSocket, destAddress, buffer, bufferLength);
+                        else
+#endif
+                            result = sendUDP(networkSocket, destAddress, buffer, bufferLength);
                     }
                 }
                 else
@@ -418,6 +775,18 @@ void NetworkSocket_SetPSK(NetworkSocket * networkSocket, const char * identity,
     DTLS_SetPSK(identity, key, keyLength);
 }
 
+void NetworkSocket_SetKeyStore(NetworkSocket * networkSocket, DTLS_KeyStore * keyStore)
+{
+    (void)networkSocket;
+    DTLS_SetKeyStore(keyStore);
+}
+
+bool NetworkSocket_SetHandshakeWorkers(NetworkSocket * networkSocket, int workers)
+{
+    (void)networkSocket;
+    return (workers >= 0) && (DTLS_SetHandshakeWorkers(workers) == 0);
+}
+
 void NetworkAddress_SetAddressType(NetworkAddress * address, AddressType * addressType)
 {
     if (address && addressType)
@@ -434,6 +803,40 @@ void NetworkAddress_SetAddressType(NetworkAddress * address, AddressType * addre
     }
 }
 
+static NetworkAddress * getSourceAddress(NetworkSocket * networkSocket, const struct sockaddr_storage * sourceSocket, socklen_t sourceSocketLength)
+{
+    NetworkAddress * networkAddress = NULL;
+    NetworkAddress matchAddress;
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+    memset(&matchAddress, 0, sizeof(matchAddress));
+    memcpy(&matchAddress.Address.Sa, sourceSocket, sourceSocketLength);
+    networkAddress = getCachedAddress(&matchAddress);
+
+    if (networkAddress)
+    {
+        useCachedAddress(networkAddress, now);
+    }
+    else
+    {
+        networkAddress = newAddress();
+        if (networkAddress)
+        {
+            // Add new address to cache (note: uri is unknown). Only the cache references it, so it is freed once
+            // unused unless the receiver retains it.
+            memcpy(&networkAddress->Address, &matchAddress.Address, sizeof(networkAddress->Address));
+            networkAddress->Secure = (networkSocket->SocketType & NetworkSocketType_Secure) == NetworkSocketType_Secure;
+            addCachedAddress(networkAddress, NULL, 0, now);
+            networkAddressCache.Statistics.Misses++;
+            if (!networkAddress->Cached)
+            {
+                free(networkAddress);
+                networkAddress = NULL;
+            }
+        }
+    }
+    return networkAddress;
+}
+
 static bool readUDP(NetworkSocket * networkSocket, int socketHandle, uint8_t * buffer, int bufferLength, NetworkAddress ** sourceAddress, int *readLength)
 {
     bool result = false;
@@ -458,33 +861,93 @@ static bool readUDP(NetworkSocket * networkSocket, int socketHandle, uint8_t * b
     }
     else
     {
-        NetworkAddress * networkAddress = NULL;
-        NetworkAddress matchAddress;
-        size_t size = sizeof(struct _NetworkAddress);
-        memset(&matchAddress, 0, size);
-        memcpy(&matchAddress.Address.Sa, &sourceSocket, sourceSocketLength);
-        matchAddress.Secure = (networkSocket->SocketType & NetworkSocketType_Secure) == NetworkSocketType_Secure;
-        networkAddress = getCachedAddress(&matchAddress, NULL, 0);
+        NetworkAddress * networkAddress = getSourceAddress(networkSocket, &sourceSocket, sourceSocketLength);
+        if (networkAddress)
+        {
+            *sourceAddress = networkAddress;
+            result = true;
+        }
+    }
+    return result;
+}
 
-        if (networkAddress == NULL)
+#ifdef BATCHED_IO_SUPPORTED
+// Return the next datagram of the batch, receiving a new batch when the last one has been returned
+static bool readBatch(NetworkSocket * networkSocket, uint8_t * buffer, int bufferLength, NetworkAddress ** sourceAddress, int *readLength)
+{
+    bool result = true;
+    DatagramBatch * batch = networkSocket->ReadBatch;
+#ifdef WITH_IO_URING
+    if (networkSocket->Ring)
+    {
+        struct sockaddr_storage sourceSocket;
+        socklen_t sourceSocketLength = 0;
+        int length = NetworkRing_Receive(networkSocket->Ring, buffer, bufferLength, &sourceSocket, &sourceSocketLength);
+        if (length < 0)
+        {
+            networkSocket->LastError = NetworkSocketError_ReadError;
+            result = false;
+        }
+        else if (length > 0)
         {
-            networkAddress = (NetworkAddress *)malloc(size);
+            NetworkAddress * networkAddress = getSourceAddress(networkSocket, &sourceSocket, sourceSocketLength);
             if (networkAddress)
             {
-                // Add new address to cache (note: uri and secure is unknown)
-                memcpy(networkAddress, &matchAddress, size);
-                addCachedAddress(networkAddress, NULL, 0);
-                networkAddress->useCount++;         // TODO - ensure addresses are freed? (after t/o or transaction or DTLS session closed)
+                *readLength = length;
+                *sourceAddress = networkAddress;
             }
         }
-        if (networkAddress)
+        return result;
+    }
+#endif
+    if (batch->Next == batch->Count)
+    {
+        int sockets[2] = { networkSocket->Socket, networkSocket->SocketIPv6 };
+        int first = batch->IPv6First ? 1 : 0;
+        int index;
+
+        batch->Next = batch->Count = 0;
+        for (index = 0; (index < 2) && (batch->Count == 0); index++)
         {
-            *sourceAddress = networkAddress;
-            result = true;
+            int socketIndex = (first + index) % 2;
+            if (sockets[socketIndex] != SOCKET_ERROR)
+            {
+                // report a failure of either socket, but still receive from the other
+                if (!receiveBatch(networkSocket, sockets[socketIndex]))
+                {
+                    result = false;
+                }
+                if (batch->Count > 0)
+                {
+                    batch->IPv6First = (socketIndex == 0);
+                }
+            }
         }
     }
+
+    while ((batch->Next < batch->Count) && (*readLength == 0))
+    {
+        struct mmsghdr * message = &batch->Messages[batch->Next];
+        if (message->msg_hdr.msg_flags & MSG_TRUNC)
+        {
+            // a datagram truncated to the batch buffer cannot be decoded, drop it as if it had been lost
+            Lwm2m_Warning("Dropping datagram larger than %d bytes\n", MAX_BATCH_DATAGRAM_LENGTH);
+        }
+        else
+        {
+            NetworkAddress * networkAddress = getSourceAddress(networkSocket, &batch->Addresses[batch->Next], message->msg_hdr.msg_namelen);
+            if (networkAddress)
+            {
+                *readLength = ((int)message->msg_len < bufferLength) ? (int)message->msg_len : bufferLength;
+                memcpy(buffer, message->msg_hdr.msg_iov->iov_base, *readLength);
+                *sourceAddress = networkAddress;
+            }
+        }
+        batch->Next++;
+    }
     return result;
 }
+#endif
 
 NetworkAddress * NetworkAddress_New(const char * uri, int uriLength)
 {
@@ -492,10 +955,15 @@ NetworkAddress * NetworkAddress_New(const char * uri, int uriLength)
     if (!uri || uriLength <= 0)
         return result;
 
+    uint64_t now = Lwm2mCore_GetTickCountMs();
     int uriHostLength = getUriHostLength(uri, uriLength);
     if (uriHostLength > 0)
         result = getCachedAddressByUri(uri, uriHostLength);
-    if (!result)
+    if (result)
+    {
+        useCachedAddress(result, now);
+    }
+    else
     {
         bool ip6Address = false;
         bool secure = false;
@@ -594,11 +1062,9 @@ NetworkAddress * NetworkAddress_New(const char * uri, int uriLength)
                 AddressType resolvedAddress;
                 if (Lwm2mCore_ResolveAddressByName((unsigned char*)hostname, strlen(hostname), &resolvedAddress))
                 {
-                    size_t size = sizeof(struct _NetworkAddress);
-                    networkAddress = (NetworkAddress *) malloc(size);
+                    networkAddress = newAddress();
                     if (networkAddress)
                     {
-                        memset(networkAddress, 0, size);
                         if (resolvedAddress.Addr.Sa.sa_family == AF_INET)
                         {
                             networkAddress->Address.Sin.sin_family = AF_INET;
@@ -622,16 +1088,25 @@ NetworkAddress * NetworkAddress_New(const char * uri, int uriLength)
             if (networkAddress)
             {
                 networkAddress->Secure = secure;
-                result = getCachedAddress(networkAddress, uri, uriHostLength);
+                result = getCachedAddress(networkAddress);
                 if (result)
                 {
-                    // Matched existing address
+                    // Matched existing address, add info if it was received before its uri was known
+                    if (result->Uri == NULL)
+                    {
+                        result->Secure = secure;
+                        setCachedAddressUri(result, uri, uriHostLength);
+                    }
+                    result->LastUsed = now;
                     free(networkAddress);
                 }
                 else
                 {
+                    networkAddress->useCount = 0;
+                    addCachedAddress(networkAddress, uri, uriHostLength, now);
                     result = networkAddress;
                 }
+                networkAddressCache.Statistics.Misses++;
             }
 
         }
@@ -639,49 +1114,125 @@ NetworkAddress * NetworkAddress_New(const char * uri, int uriLength)
 
     if (result)
     {
-        if (result->useCount == 0)
+        retainAddress(result);
+    }
+
+    return result;
+}
+
+NetworkAddress * NetworkAddress_FromAddressType(AddressType * addressType)
+{
+    NetworkAddress * result = NULL;
+    NetworkAddress matchAddress;
+    uint64_t now;
+
+    if (addressType == NULL)
+        return NULL;
+
+    memset(&matchAddress, 0, sizeof(matchAddress));
+    switch (addressType->Addr.Sa.sa_family)
+    {
+        case AF_INET:
+            memcpy(&matchAddress.Address.Sin, &addressType->Addr.Sin, sizeof(matchAddress.Address.Sin));
+#ifdef RIOT
+            matchAddress.Address.Sin.sin_port = htons(addressType->Addr.Sin.sin_port);
+#endif
+            break;
+        case AF_INET6:
+            memcpy(&matchAddress.Address.Sin6, &addressType->Addr.Sin6, sizeof(matchAddress.Address.Sin6));
+#ifdef RIOT
+            matchAddress.Address.Sin6.sin6_port = htons(addressType->Addr.Sin6.sin6_port);
+#endif
+            break;
+        default:
+            Lwm2m_Error("Unsupported address family: %d\n", addressType->Addr.Sa.sa_family);
+            return NULL;
+    }
+
+    now = Lwm2mCore_GetTickCountMs();
+    result = getCachedAddress(&matchAddress);
+    if (result)
+    {
+        useCachedAddress(result, now);
+    }
+    else
+    {
+        result = newAddress();
+        if (result)
         {
-            addCachedAddress(result, uri, uriHostLength);
+            memcpy(&result->Address, &matchAddress.Address, sizeof(result->Address));
+            result->Secure = addressType->Secure;
+            addCachedAddress(result, NULL, 0, now);
+            networkAddressCache.Statistics.Misses++;
         }
-        result->useCount++;
     }
 
+    if (result)
+    {
+        retainAddress(result);
+    }
     return result;
 }
 
+NetworkAddress * NetworkAddress_Retain(NetworkAddress * address)
+{
+    if (address)
+    {
+        retainAddress(address);
+    }
+    return address;
+}
+
 void NetworkAddress_Free(NetworkAddress ** address)
 {
-    // TODO - review when addresses are freed (e.g. after client bootstrap, or connection lost ?)
     if (address && *address)
     {
         (*address)->useCount--;
         if ((*address)->useCount == 0)
         {
-            int index;
-            for (index = 0; index < MAX_NETWORK_ADDRESS_CACHE; index++)
-            {
-                if (networkAddressCache[index].address == *address)
-                {
-                    if (networkAddressCache[index].uri)
-                    {
-                        Lwm2m_Debug("Address free: %s\n", networkAddressCache[index].uri);
-                        free(networkAddressCache[index].uri);
-                        networkAddressCache[index].uri = NULL;
-                    }
-                    else
-                    {
-                        Lwm2m_Debug("Address free\n");
-                    }
-                    networkAddressCache[index].address = NULL;
-                    break;
-                }
-            }
+            // not cached
+            free((*address)->Uri);
             free(*address);
         }
+        else if ((*address)->Cached && ((*address)->useCount == 1))
+        {
+            // only the cache references it now
+            uint64_t now = Lwm2mCore_GetTickCountMs();
+            (*address)->LastUsed = now;
+            ListAdd(&(*address)->IdleList, &networkAddressCache.Idle);
+            networkAddressCache.IdleCount++;
+            evictCachedAddresses(now);
+        }
         *address = NULL;
     }
 }
 
+void NetworkAddress_GetCacheStatistics(NetworkAddressCacheStatistics * statistics)
+{
+    if (statistics)
+    {
+        *statistics = networkAddressCache.Statistics;
+        statistics->Count = networkAddressCache.Initialised ? HashTable_Count(&networkAddressCache.ByAddress) : 0;
+    }
+}
+
+// Let other sockets bind the same port, so the kernel spreads incoming datagrams over them by source address
+static void SetShared(NetworkSocket * networkSocket, int socket)
+{
+    if ((networkSocket->SocketType & NetworkSocketType_Shared) == NetworkSocketType_Shared)
+    {
+#ifdef SO_REUSEPORT
+        int yes = 1;
+        if (setsockopt(socket, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes)) == SOCKET_ERROR)
+        {
+            Lwm2m_Error("Failed to set SO_REUSEPORT: %s\n", strerror(errno));
+        }
+#else
+        Lwm2m_Error("Shared sockets are not supported on this platform\n");
+#endif
+    }
+}
+
 bool NetworkSocket_StartListening(NetworkSocket * networkSocket)
 {
     bool result = false;
@@ -737,6 +1288,7 @@ bool NetworkSocket_StartListening(NetworkSocket * networkSocket)
         addressLength = sizeof(struct sockaddr_in);
         address = (struct sockaddr *)ip4Address;
 
+        SetShared(networkSocket, networkSocket->Socket);
 #ifndef RIOT
         int flag = fcntl(networkSocket->Socket, F_GETFL);
         flag = flag | O_NONBLOCK;
@@ -786,12 +1338,13 @@ bool NetworkSocket_StartListening(NetworkSocket * networkSocket)
         }
 #else
         int yes = 1;
-        if (setsockopt(networkSocket->SocketIPv6, IPPROTO_IPV6, IPV6_V6ONLY, &yes, sizeof(yes) != SOCKET_ERROR))
+        if (setsockopt(networkSocket->SocketIPv6, IPPROTO_IPV6, IPV6_V6ONLY, &yes, sizeof(yes)) != SOCKET_ERROR)
         {
             struct sockaddr *address = NULL;
             socklen_t addressLength = 0;
             addressLength = sizeof(struct sockaddr_in6);
             address = (struct sockaddr *)ip6Address;
+            SetShared(networkSocket, networkSocket->SocketIPv6);
             int flag = fcntl(networkSocket->SocketIPv6, F_GETFL);
             flag = flag | O_NONBLOCK;
             if (fcntl(networkSocket->SocketIPv6, F_SETFL, flag) < 0)
@@ -826,6 +1379,13 @@ bool NetworkSocket_Read(NetworkSocket * networkSocket, uint8_t * buffer, int buf
             {
                 if (sourceAddress)
                 {
+#ifdef BATCHED_IO_SUPPORTED
+                   if (isBatched(networkSocket))
+                   {
+                       result = readBatch(networkSocket, buffer, bufferLength, sourceAddress, readLength);
+                   }
+                   else
+#endif
                    if ((networkSocket->Socket != SOCKET_ERROR) && readUDP(networkSocket, networkSocket->Socket, buffer, bufferLength, sourceAddress, readLength))
                    {
                        result = true;
@@ -840,12 +1400,10 @@ bool NetworkSocket_Read(NetworkSocket * networkSocket, uint8_t * buffer, int buf
                    }
                    if ((*readLength > 0) && *sourceAddress && (*sourceAddress)->Secure)
                    {
-                       if (DTLS_Decrypt(*sourceAddress, buffer, *readLength, encryptBuffer, ENCRYPT_BUFFER_LENGTH, readLength, networkSocket))
+                       // decrypt in place, as records are never longer than the datagram they arrive in
+                       if (!DTLS_Decrypt(*sourceAddress, buffer, *readLength, buffer, bufferLength, readLength, networkSocket))
                        {
-                           if (*readLength > 0)
-                           {
-                               memcpy(buffer, encryptBuffer, *readLength);
-                           }
+                           *readLength = 0;
                        }
                    }
                 }
@@ -883,3 +1441,92 @@ bool NetworkSocket_Read(NetworkSocket * networkSocket, uint8_t * buffer, int buf
     return result;
 }
 
+
+bool NetworkSocket_SetBatchSize(NetworkSocket * networkSocket, int batchSize)
+{
+    bool result = false;
+    if (networkSocket && batchSize > 0)
+    {
+#ifdef BATCHED_IO_SUPPORTED
+#ifdef WITH_IO_URING
+        // the ring stops receiving before it sends what is queued, so that nothing sent to this socket is lost
+        NetworkRing_Free(&networkSocket->Ring);
+#endif
+        if (isBatched(networkSocket))
+        {
+            sendBatch(networkSocket);
+        }
+        freeBatch(&networkSocket->ReadBatch);
+        freeBatch(&networkSocket->SendBatch);
+#ifdef WITH_IO_URING
+        if (batchSize > 1)
+        {
+            networkSocket->Ring = NetworkRing_New(batchSize, MAX_BATCH_DATAGRAM_LENGTH);
+            if ((networkSocket->Ring == NULL) ||
+                ((networkSocket->Socket != SOCKET_ERROR) && !NetworkRing_AddSocket(networkSocket->Ring, networkSocket->Socket)) ||
+                ((networkSocket->SocketIPv6 != SOCKET_ERROR) && !NetworkRing_AddSocket(networkSocket->Ring, networkSocket->SocketIPv6)))
+            {
+                Lwm2m_Warning("io_uring is not available, batching with recvmmsg and sendmmsg instead\n");
+                NetworkRing_Free(&networkSocket->Ring);
+            }
+            else
+            {
+                result = true;
+            }
+        }
+#endif
+        if ((batchSize > 1) && !result)
+        {
+            networkSocket->ReadBatch = newBatch(batchSize);
+            networkSocket->SendBatch = newBatch(batchSize);
+            if ((networkSocket->ReadBatch == NULL) || (networkSocket->SendBatch == NULL))
+            {
+                Lwm2m_Error("Failed to allocate memory for %d datagram batch\n", batchSize);
+                freeBatch(&networkSocket->ReadBatch);
+                freeBatch(&networkSocket->SendBatch);
+            }
+            else
+            {
+                result = true;
+            }
+        }
+        else if (batchSize == 1)
+        {
+            result = true;
+        }
+#else
+        result = (batchSize == 1);
+#endif
+    }
+    return result;
+}
+
+int NetworkSocket_GetPendingReads(NetworkSocket * networkSocket)
+{
+    int result = 0;
+#ifdef BATCHED_IO_SUPPORTED
+#ifdef WITH_IO_URING
+    if (networkSocket && networkSocket->Ring)
+    {
+        result = NetworkRing_GetPendingReceives(networkSocket->Ring);
+    }
+#endif
+    if (networkSocket && networkSocket->ReadBatch)
+    {
+        result = networkSocket->ReadBatch->Count - networkSocket->ReadBatch->Next;
+    }
+#endif
+    return result;
+}
+
+bool NetworkSocket_Flush(NetworkSocket * networkSocket)
+{
+    bool result = true;
+#ifdef BATCHED_IO_SUPPORTED
+    if (networkSocket && isBatched(networkSocket))
+    {
+        result = sendBatch(networkSocket);
+    }
+#endif
+    return result;
+}
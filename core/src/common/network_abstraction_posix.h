@@ -29,6 +29,18 @@ extern "C" {
 
 #include "network_abstraction.h"
 
+/* Addresses are cached by socket address and by URI, and freed once only the cache references them and either
+ * more than NETWORK_ADDRESS_CACHE_IDLE_LIMIT such addresses are cached, or they have not been used for
+ * NETWORK_ADDRESS_CACHE_IDLE_TIMEOUT milliseconds. The least recently used are freed first.
+ */
+#ifndef NETWORK_ADDRESS_CACHE_IDLE_LIMIT
+    #define NETWORK_ADDRESS_CACHE_IDLE_LIMIT    (1024)
+#endif
+
+#ifndef NETWORK_ADDRESS_CACHE_IDLE_TIMEOUT
+    #define NETWORK_ADDRESS_CACHE_IDLE_TIMEOUT  (10 * 60 * 1000)
+#endif
+
 NetworkAddress * NetworkAddress_FromIPAddress(const char * ipAddress, uint16_t port);
 NetworkSocket * NetworkSocket_New(const char * ipAddress, NetworkSocketType socketType, uint16_t port);
 bool NetworkSocket_Send(NetworkSocket * networkSocket, NetworkAddress * destAddress, uint8_t * buffer, int bufferLength);
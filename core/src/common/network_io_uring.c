@@ -0,0 +1,634 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <linux/io_uring.h>
+
+#include "lwm2m_debug.h"
+#include "network_io_uring.h"
+
+#define RECEIVE_BUFFER_GROUP    (0)
+#define MAX_RING_SOCKETS        (2)     // IPv4 and IPv6
+#define MIN_RECEIVE_BUFFERS     (8)
+#define CANCEL_USER_DATA        (~(uint64_t)0)
+
+typedef struct
+{
+    int Fd;
+    unsigned int Entries;
+    unsigned int * SqHead;
+    unsigned int * SqTail;
+    unsigned int * SqMask;
+    unsigned int * SqArray;
+    struct io_uring_sqe * Sqes;
+    unsigned int * CqHead;
+    unsigned int * CqTail;
+    unsigned int * CqMask;
+    struct io_uring_cqe * Cqes;
+    void * SqRing;
+    size_t SqRingSize;
+    void * CqRing;                      // Same mapping as SqRing if the kernel supports it
+    size_t CqRingSize;
+    size_t SqesSize;
+    unsigned int Unsubmitted;           // Entries queued since the last submission
+} Ring;
+
+struct _NetworkRing
+{
+    Ring Receive;
+    Ring Send;
+    int EventFd;                        // Signalled by the kernel for each receive completion
+    int Sockets[MAX_RING_SOCKETS];
+    bool Receiving[MAX_RING_SOCKETS];  // Whether the socket's receive is armed
+    int NumSockets;
+
+    struct msghdr ReceiveTemplate;      // Tells the kernel how much of each buffer to set aside for the source address
+    struct io_uring_buf_ring * BufferRing;
+    size_t BufferRingSize;
+    unsigned int NumBuffers;            // A power of two, as the kernel requires
+    int BufferLength;
+    uint8_t * Buffers;
+
+    int DatagramLength;
+    int SendSize;
+    int SendCount;                      // Datagrams queued
+    struct msghdr * SendMessages;
+    struct iovec * SendVectors;
+    struct sockaddr_storage * SendAddresses;
+    uint8_t * SendBuffers;
+};
+
+static int ringEnter(Ring * ring, unsigned int toSubmit, unsigned int minComplete, unsigned int flags)
+{
+    return syscall(__NR_io_uring_enter, ring->Fd, toSubmit, minComplete, flags, NULL, 0);
+}
+
+static int ringRegister(Ring * ring, unsigned int opcode, void * arg, unsigned int numArgs)
+{
+    return syscall(__NR_io_uring_register, ring->Fd, opcode, arg, numArgs);
+}
+
+static void * ringMap(Ring * ring, size_t size, off_t offset)
+{
+    void * map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->Fd, offset);
+    return (map == MAP_FAILED) ? NULL : map;
+}
+
+static void ringFree(Ring * ring)
+{
+    if (ring->Sqes != NULL)
+    {
+        munmap(ring->Sqes, ring->SqesSize);
+    }
+    if ((ring->CqRing != NULL) && (ring->CqRing != ring->SqRing))
+    {
+        munmap(ring->CqRing, ring->CqRingSize);
+    }
+    if (ring->SqRing != NULL)
+    {
+        munmap(ring->SqRing, ring->SqRingSize);
+    }
+    if (ring->Fd >= 0)
+    {
+        close(ring->Fd);
+    }
+    memset(ring, 0, sizeof(Ring));
+    ring->Fd = -1;
+}
+
+static bool ringInit(Ring * ring, unsigned int entries, unsigned int completionEntries)
+{
+    struct io_uring_params params;
+    memset(ring, 0, sizeof(Ring));
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = completionEntries;
+
+    ring->Fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->Fd < 0)
+    {
+        Lwm2m_Error("Failed to create io_uring: %s\n", strerror(errno));
+        goto error;
+    }
+
+    ring->Entries = params.sq_entries;
+    ring->SqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ring->CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->SqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (ring->CqRingSize > ring->SqRingSize)
+        {
+            ring->SqRingSize = ring->CqRingSize;
+        }
+        ring->CqRingSize = ring->SqRingSize;
+    }
+
+    ring->SqRing = ringMap(ring, ring->SqRingSize, IORING_OFF_SQ_RING);
+    ring->CqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? ring->SqRing : ringMap(ring, ring->CqRingSize, IORING_OFF_CQ_RING);
+    ring->Sqes = ringMap(ring, ring->SqesSize, IORING_OFF_SQES);
+    if ((ring->SqRing == NULL) || (ring->CqRing == NULL) || (ring->Sqes == NULL))
+    {
+        Lwm2m_Error("Failed to map io_uring: %s\n", strerror(errno));
+        goto error;
+    }
+
+    ring->SqHead = (unsigned int *)((uint8_t *)ring->SqRing + params.sq_off.head);
+    ring->SqTail = (unsigned int *)((uint8_t *)ring->SqRing + params.sq_off.tail);
+    ring->SqMask = (unsigned int *)((uint8_t *)ring->SqRing + params.sq_off.ring_mask);
+    ring->SqArray = (unsigned int *)((uint8_t *)ring->SqRing + params.sq_off.array);
+    ring->CqHead = (unsigned int *)((uint8_t *)ring->CqRing + params.cq_off.head);
+    ring->CqTail = (unsigned int *)((uint8_t *)ring->CqRing + params.cq_off.tail);
+    ring->CqMask = (unsigned int *)((uint8_t *)ring->CqRing + params.cq_off.ring_mask);
+    ring->Cqes = (struct io_uring_cqe *)((uint8_t *)ring->CqRing + params.cq_off.cqes);
+    return true;
+
+error:
+    ringFree(ring);
+    return false;
+}
+
+static struct io_uring_sqe * ringGetSqe(Ring * ring)
+{
+    struct io_uring_sqe * sqe = NULL;
+    unsigned int head = __atomic_load_n(ring->SqHead, __ATOMIC_ACQUIRE);
+    unsigned int tail = *ring->SqTail;
+    if (tail - head < ring->Entries)
+    {
+        unsigned int index = tail & *ring->SqMask;
+        ring->SqArray[index] = index;
+        sqe = &ring->Sqes[index];
+        memset(sqe, 0, sizeof(struct io_uring_sqe));
+    }
+    return sqe;
+}
+
+// Hand the entry from ringGetSqe() to the kernel; it is read on the next submission
+static void ringQueueSqe(Ring * ring)
+{
+    __atomic_store_n(ring->SqTail, *ring->SqTail + 1, __ATOMIC_RELEASE);
+    ring->Unsubmitted++;
+}
+
+static unsigned int ringReady(Ring * ring)
+{
+    return __atomic_load_n(ring->CqTail, __ATOMIC_ACQUIRE) - *ring->CqHead;
+}
+
+static struct io_uring_cqe * ringPeekCqe(Ring * ring)
+{
+    return (ringReady(ring) > 0) ? &ring->Cqes[*ring->CqHead & *ring->CqMask] : NULL;
+}
+
+static void ringAdvanceCqe(Ring * ring)
+{
+    __atomic_store_n(ring->CqHead, *ring->CqHead + 1, __ATOMIC_RELEASE);
+}
+
+// Submit the queued entries, then wait until at least minReady completions are waiting
+static bool ringSubmit(Ring * ring, unsigned int minReady)
+{
+    bool result = true;
+    for (;;)
+    {
+        unsigned int flags = (ringReady(ring) < minReady) ? IORING_ENTER_GETEVENTS : 0;
+        if ((ring->Unsubmitted == 0) && (flags == 0))
+        {
+            break;
+        }
+
+        int submitted = ringEnter(ring, ring->Unsubmitted, (flags != 0) ? minReady : 0, flags);
+        if (submitted < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            Lwm2m_Error("Failed to submit to io_uring: %s\n", strerror(errno));
+            result = false;
+            break;
+        }
+        if ((submitted == 0) && (flags == 0))
+        {
+            Lwm2m_Error("io_uring accepted none of %u entries\n", ring->Unsubmitted);
+            result = false;
+            break;
+        }
+        ring->Unsubmitted -= submitted;
+    }
+    return result;
+}
+
+static void recycleBuffer(NetworkRing * ring, unsigned short bufferID)
+{
+    unsigned short tail = ring->BufferRing->tail;
+    struct io_uring_buf * buffer = &ring->BufferRing->bufs[tail & (ring->NumBuffers - 1)];
+    buffer->addr = (uintptr_t)&ring->Buffers[bufferID * ring->BufferLength];
+    buffer->len = ring->BufferLength;
+    buffer->bid = bufferID;
+    __atomic_store_n(&ring->BufferRing->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+// Receive datagrams from the socket until the receive is cancelled or runs out of buffers
+static bool armReceive(NetworkRing * ring, int socketIndex)
+{
+    struct io_uring_sqe * sqe = ringGetSqe(&ring->Receive);
+    if (sqe == NULL)
+    {
+        Lwm2m_Error("No io_uring entry free to receive on socket %d\n", ring->Sockets[socketIndex]);
+        return false;
+    }
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = ring->Sockets[socketIndex];
+    sqe->addr = (uintptr_t)&ring->ReceiveTemplate;
+    sqe->len = 1;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = RECEIVE_BUFFER_GROUP;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->user_data = socketIndex;
+    ringQueueSqe(&ring->Receive);
+    ring->Receiving[socketIndex] = ringSubmit(&ring->Receive, 0);
+    return ring->Receiving[socketIndex];
+}
+
+// Cancel the receives and wait until they have stopped, as the kernel writes into the buffers until then
+static void cancelReceives(NetworkRing * ring)
+{
+    int cancels = 0;
+    int index;
+    for (index = 0; index < ring->NumSockets; index++)
+    {
+        struct io_uring_sqe * sqe = ringGetSqe(&ring->Receive);
+        if (sqe != NULL)
+        {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = ring->Sockets[index];
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+            sqe->user_data = CANCEL_USER_DATA;
+            ringQueueSqe(&ring->Receive);
+            cancels++;
+        }
+    }
+
+    for (;;)
+    {
+        bool receiving = false;
+        struct io_uring_cqe * cqe;
+        for (index = 0; index < ring->NumSockets; index++)
+        {
+            receiving = receiving || ring->Receiving[index];
+        }
+        if ((cancels == 0) && !receiving)
+        {
+            break;
+        }
+        if (!ringSubmit(&ring->Receive, 1))
+        {
+            break;
+        }
+        while ((cqe = ringPeekCqe(&ring->Receive)) != NULL)
+        {
+            if (cqe->user_data == CANCEL_USER_DATA)
+            {
+                cancels--;
+            }
+            else if (!(cqe->flags & IORING_CQE_F_MORE) && (cqe->user_data < (uint64_t)ring->NumSockets))
+            {
+                ring->Receiving[cqe->user_data] = false;
+            }
+            ringAdvanceCqe(&ring->Receive);
+        }
+    }
+}
+
+static bool initReceive(NetworkRing * ring, int batchSize)
+{
+    struct io_uring_buf_reg bufferRegistration;
+    unsigned int index;
+
+    ring->NumBuffers = MIN_RECEIVE_BUFFERS;
+    while (ring->NumBuffers < (unsigned int)batchSize * 2)
+    {
+        ring->NumBuffers <<= 1;
+    }
+    if (!ringInit(&ring->Receive, MAX_RING_SOCKETS * 2, ring->NumBuffers * 2))
+    {
+        return false;
+    }
+
+    ring->ReceiveTemplate.msg_namelen = sizeof(struct sockaddr_storage);
+    ring->BufferLength = sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_storage) + ring->DatagramLength;
+    ring->Buffers = (uint8_t *)malloc(ring->NumBuffers * ring->BufferLength);
+
+    // the kernel requires the buffer ring to be page aligned
+    ring->BufferRingSize = ring->NumBuffers * sizeof(struct io_uring_buf);
+    ring->BufferRing = mmap(NULL, ring->BufferRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring->BufferRing == MAP_FAILED)
+    {
+        ring->BufferRing = NULL;
+    }
+    if ((ring->Buffers == NULL) || (ring->BufferRing == NULL))
+    {
+        Lwm2m_Error("Failed to allocate memory for io_uring receive buffers\n");
+        return false;
+    }
+
+    memset(&bufferRegistration, 0, sizeof(bufferRegistration));
+    bufferRegistration.ring_addr = (uintptr_t)ring->BufferRing;
+    bufferRegistration.ring_entries = ring->NumBuffers;
+    bufferRegistration.bgid = RECEIVE_BUFFER_GROUP;
+    if (ringRegister(&ring->Receive, IORING_REGISTER_PBUF_RING, &bufferRegistration, 1) != 0)
+    {
+        Lwm2m_Error("Failed to register io_uring receive buffers: %s\n", strerror(errno));
+        return false;
+    }
+    for (index = 0; index < ring->NumBuffers; index++)
+    {
+        recycleBuffer(ring, index);
+    }
+
+    ring->EventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((ring->EventFd < 0) || (ringRegister(&ring->Receive, IORING_REGISTER_EVENTFD, &ring->EventFd, 1) != 0))
+    {
+        Lwm2m_Error("Failed to register io_uring eventfd: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+static bool initSend(NetworkRing * ring, int batchSize)
+{
+    int index;
+    if (!ringInit(&ring->Send, batchSize, batchSize * 2))
+    {
+        return false;
+    }
+
+    ring->SendSize = batchSize;
+    ring->SendMessages = (struct msghdr *)calloc(batchSize, sizeof(struct msghdr));
+    ring->SendVectors = (struct iovec *)calloc(batchSize, sizeof(struct iovec));
+    ring->SendAddresses = (struct sockaddr_storage *)calloc(batchSize, sizeof(struct sockaddr_storage));
+    ring->SendBuffers = (uint8_t *)malloc(batchSize * ring->DatagramLength);
+    if ((ring->SendMessages == NULL) || (ring->SendVectors == NULL) || (ring->SendAddresses == NULL) || (ring->SendBuffers == NULL))
+    {
+        Lwm2m_Error("Failed to allocate memory for io_uring send buffers\n");
+        return false;
+    }
+    for (index = 0; index < batchSize; index++)
+    {
+        ring->SendVectors[index].iov_base = &ring->SendBuffers[index * ring->DatagramLength];
+        ring->SendMessages[index].msg_name = &ring->SendAddresses[index];
+        ring->SendMessages[index].msg_namelen = sizeof(struct sockaddr_storage);
+        ring->SendMessages[index].msg_iov = &ring->SendVectors[index];
+        ring->SendMessages[index].msg_iovlen = 1;
+    }
+    return true;
+}
+
+NetworkRing * NetworkRing_New(int batchSize, int datagramLength)
+{
+    NetworkRing * ring = NULL;
+    if ((batchSize <= 0) || (datagramLength <= 0))
+    {
+        goto error;
+    }
+
+    ring = (NetworkRing *)malloc(sizeof(NetworkRing));
+    if (ring == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for io_uring\n");
+        goto error;
+    }
+    memset(ring, 0, sizeof(NetworkRing));
+    ring->Receive.Fd = -1;
+    ring->Send.Fd = -1;
+    ring->EventFd = -1;
+    ring->DatagramLength = datagramLength;
+
+    if (!initReceive(ring, batchSize) || !initSend(ring, batchSize))
+    {
+        goto error;
+    }
+    return ring;
+
+error:
+    NetworkRing_Free(&ring);
+    return NULL;
+}
+
+void NetworkRing_Free(NetworkRing ** ring)
+{
+    if ((ring != NULL) && (*ring != NULL))
+    {
+        NetworkRing * networkRing = *ring;
+
+        // closing the ring does not wait for the receives to stop. Stop them before sending what is queued, so that
+        // datagrams sent to the socket's own address are left on the socket for whoever reads it next.
+        if (networkRing->Receive.Fd >= 0)
+        {
+            cancelReceives(networkRing);
+        }
+        if (networkRing->Send.Fd >= 0)
+        {
+            NetworkRing_Flush(networkRing);
+        }
+
+        ringFree(&networkRing->Receive);
+        ringFree(&networkRing->Send);
+        if (networkRing->EventFd >= 0)
+        {
+            close(networkRing->EventFd);
+        }
+        if (networkRing->BufferRing != NULL)
+        {
+            munmap(networkRing->BufferRing, networkRing->BufferRingSize);
+        }
+        free(networkRing->Buffers);
+        free(networkRing->SendMessages);
+        free(networkRing->SendVectors);
+        free(networkRing->SendAddresses);
+        free(networkRing->SendBuffers);
+        free(networkRing);
+        *ring = NULL;
+    }
+}
+
+int NetworkRing_GetFileDescriptor(NetworkRing * ring)
+{
+    return (ring != NULL) ? ring->EventFd : -1;
+}
+
+bool NetworkRing_AddSocket(NetworkRing * ring, int socket)
+{
+    bool result = false;
+    if ((ring != NULL) && (socket >= 0) && (ring->NumSockets < MAX_RING_SOCKETS))
+    {
+        ring->Sockets[ring->NumSockets] = socket;
+        result = armReceive(ring, ring->NumSockets);
+        if (result)
+        {
+            ring->NumSockets++;
+        }
+    }
+    return result;
+}
+
+int NetworkRing_Receive(NetworkRing * ring, uint8_t * buffer, int bufferLength, struct sockaddr_storage * sourceAddress, socklen_t * sourceAddressLength)
+{
+    int result = 0;
+    if ((ring == NULL) || (buffer == NULL) || (sourceAddress == NULL) || (sourceAddressLength == NULL))
+    {
+        return -1;
+    }
+
+    while (result == 0)
+    {
+        struct io_uring_cqe * cqe;
+        int socketIndex;
+        int received;
+        unsigned int flags;
+
+        if (ringReady(&ring->Receive) == 0)
+        {
+            // reset the eventfd before looking again, so that a completion posted in between signals it again
+            uint64_t count;
+            if (read(ring->EventFd, &count, sizeof(count)) < 0)
+            {
+                // already reset
+            }
+        }
+        cqe = ringPeekCqe(&ring->Receive);
+        if (cqe == NULL)
+        {
+            break;
+        }
+        socketIndex = (int)cqe->user_data;
+        received = cqe->res;
+        flags = cqe->flags;
+        ringAdvanceCqe(&ring->Receive);
+
+        if (flags & IORING_CQE_F_BUFFER)
+        {
+            unsigned short bufferID = flags >> IORING_CQE_BUFFER_SHIFT;
+            if (received > 0)
+            {
+                uint8_t * data = &ring->Buffers[bufferID * ring->BufferLength];
+                struct io_uring_recvmsg_out * out = (struct io_uring_recvmsg_out *)data;
+                uint8_t * name = data + sizeof(struct io_uring_recvmsg_out);
+                uint8_t * payload = name + ring->ReceiveTemplate.msg_namelen + ring->ReceiveTemplate.msg_controllen;
+                int length = received - (payload - data);
+
+                // a datagram too large for the buffer would otherwise be handed up as a partial message
+                if (out->flags & MSG_TRUNC)
+                {
+                    Lwm2m_Warning("Dropping datagram larger than %d bytes\n", ring->DatagramLength);
+                    length = 0;
+                }
+                if (length > bufferLength)
+                {
+                    length = bufferLength;
+                }
+                if (length > 0)
+                {
+                    memcpy(buffer, payload, length);
+                    *sourceAddressLength = (out->namelen < sizeof(struct sockaddr_storage)) ? out->namelen : sizeof(struct sockaddr_storage);
+                    memcpy(sourceAddress, name, *sourceAddressLength);
+                    result = length;
+                }
+            }
+            recycleBuffer(ring, bufferID);
+        }
+        else if ((received < 0) && (received != -ENOBUFS) && (received != -ECANCELED))
+        {
+            Lwm2m_Error("io_uring receive failed: %s\n", strerror(-received));
+        }
+
+        // the receive stops when it runs out of buffers or fails, so start it again
+        if (!(flags & IORING_CQE_F_MORE) && (socketIndex >= 0) && (socketIndex < ring->NumSockets))
+        {
+            ring->Receiving[socketIndex] = false;
+            if (!armReceive(ring, socketIndex))
+            {
+                result = -1;
+            }
+        }
+    }
+    return result;
+}
+
+int NetworkRing_GetPendingReceives(NetworkRing * ring)
+{
+    return (ring != NULL) ? (int)ringReady(&ring->Receive) : 0;
+}
+
+bool NetworkRing_Send(NetworkRing * ring, int socket, const struct sockaddr_storage * destAddress, const uint8_t * buffer, int bufferLength)
+{
+    bool result = false;
+    if ((ring != NULL) && (destAddress != NULL) && (buffer != NULL) && (bufferLength > 0) && (bufferLength <= ring->DatagramLength))
+    {
+        struct io_uring_sqe * sqe = ringGetSqe(&ring->Send);
+        if (sqe != NULL)
+        {
+            int index = ring->SendCount++;
+            memcpy(ring->SendVectors[index].iov_base, buffer, bufferLength);
+            ring->SendVectors[index].iov_len = bufferLength;
+            memcpy(&ring->SendAddresses[index], destAddress, sizeof(struct sockaddr_storage));
+
+            sqe->opcode = IORING_OP_SENDMSG;
+            sqe->fd = socket;
+            sqe->addr = (uintptr_t)&ring->SendMessages[index];
+            sqe->len = 1;
+            sqe->user_data = index;
+            ringQueueSqe(&ring->Send);
+
+            result = (ring->SendCount < ring->SendSize) ? true : NetworkRing_Flush(ring);
+        }
+    }
+    return result;
+}
+
+bool NetworkRing_Flush(NetworkRing * ring)
+{
+    bool result = true;
+    if ((ring != NULL) && (ring->SendCount > 0))
+    {
+        struct io_uring_cqe * cqe;
+        result = ringSubmit(&ring->Send, ring->SendCount);
+        while ((cqe = ringPeekCqe(&ring->Send)) != NULL)
+        {
+            if (cqe->res < 0)
+            {
+                Lwm2m_Debug("io_uring send failed: %s\n", strerror(-cqe->res));
+                result = false;
+            }
+            ringAdvanceCqe(&ring->Send);
+        }
+        ring->SendCount = 0;
+    }
+    return result;
+}
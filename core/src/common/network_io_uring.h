@@ -0,0 +1,72 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#ifndef NETWORK_IO_URING_H_
+#define NETWORK_IO_URING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/socket.h>
+
+/* Datagram I/O through io_uring, used by the POSIX network abstraction when built with WITH_IO_URING.
+ *
+ * Each socket has a multishot receive armed that the kernel completes into a ring of buffers registered with it,
+ * so no system call is made per datagram received. Sends are queued and submitted together. An eventfd becomes
+ * readable when received datagrams are waiting, as the sockets themselves no longer are.
+ */
+typedef struct _NetworkRing NetworkRing;
+
+// Create a ring that receives and sends batches of up to batchSize datagrams of up to datagramLength bytes
+NetworkRing * NetworkRing_New(int batchSize, int datagramLength);
+
+// Cancel the receives, send any queued datagrams and free the ring
+void NetworkRing_Free(NetworkRing ** ring);
+
+int NetworkRing_GetFileDescriptor(NetworkRing * ring);
+
+// Start receiving the datagrams of a bound socket
+bool NetworkRing_AddSocket(NetworkRing * ring, int socket);
+
+/* Copy the next received datagram into buffer, truncated to bufferLength, and its source into sourceAddress.
+ * Datagrams longer than the ring's datagramLength are dropped.
+ * Returns the length copied, 0 if no datagram is waiting, or -1 on error.
+ */
+int NetworkRing_Receive(NetworkRing * ring, uint8_t * buffer, int bufferLength, struct sockaddr_storage * sourceAddress, socklen_t * sourceAddressLength);
+
+// Number of receive completions waiting
+int NetworkRing_GetPendingReceives(NetworkRing * ring);
+
+// Queue a datagram, submitting the queue when it is full. Returns false if a send failed.
+bool NetworkRing_Send(NetworkRing * ring, int socket, const struct sockaddr_storage * destAddress, const uint8_t * buffer, int bufferLength);
+
+// Submit the queued datagrams and wait for them to be sent. Returns false if a send failed.
+bool NetworkRing_Flush(NetworkRing * ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETWORK_IO_URING_H_ */
@@ -72,7 +72,7 @@ coap_transaction_t * coap_new_transaction(NetworkSocket * networkSocket, uint16_
         t->mid = mid;
         t->retrans_counter = 0;
         t->networkSocket = networkSocket;
-        t->remoteAddress = remoteAddress;
+        t->remoteAddress = NetworkAddress_Retain(remoteAddress);
 
         ListAdd(&t->list, &transactions_list); /* list itself makes sure same element is not added twice */
     }
@@ -156,6 +156,7 @@ void coap_clear_transaction(coap_transaction_t **t)
 
         //etimer_stop(&t->retrans_timer);
         ListRemove(&(*t)->list);
+        NetworkAddress_Free(&(*t)->remoteAddress);
         free(*t);
         *t = NULL;
     }
@@ -177,10 +178,11 @@ coap_transaction_t * coap_get_transaction_by_mid(uint16_t mid)
     return NULL;
 }
 /*---------------------------------------------------------------------------*/
-void coap_check_transactions(void)
+int coap_check_transactions(void)
 {
     struct ListHead * current = NULL;
     struct ListHead * next = NULL;
+    int pending = 0;
 
     ListForEachSafe(current ,next, &transactions_list)
     {
@@ -196,5 +198,15 @@ void coap_check_transactions(void)
         }
     }
 
+    /* coap_send_transaction() frees completed transactions, so count the ones left over separately */
+    ListForEach(current, &transactions_list)
+    {
+        coap_transaction_t *t = ListEntry(current, struct coap_transaction, list);
+        if (!t->sent)
+        {
+            pending++;
+        }
+    }
+    return pending;
 }
 /*---------------------------------------------------------------------------*/
@@ -81,6 +81,7 @@ void coap_send_transaction(coap_transaction_t *t);
 void coap_clear_transaction(coap_transaction_t **t);
 coap_transaction_t *coap_get_transaction_by_mid(uint16_t mid);
 
-void coap_check_transactions(void);
+/* returns the number of transactions still waiting to be sent */
+int coap_check_transactions(void);
 
 #endif /* COAP_TRANSACTIONS_H_ */
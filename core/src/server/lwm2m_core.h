@@ -39,14 +39,32 @@
 #include "lwm2m_endpoints.h"
 #include "lwm2m_request_origin.h"
 #include "lwm2m_observers.h"
+#include "lwm2m_hash_table.h"
+#include "lwm2m_deadline_queue.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Indexes over the registered client list, maintained by the registration module
+typedef struct
+{
+    HashTable ByName;                         // Keyed by endpoint name
+    HashTable ByLocation;                     // Keyed by /rd/<location>
+    HashTable ByAddress;                      // Keyed by source address and port
+    DeadlineQueue ByExpiry;                   // Ordered by registration lifetime expiry
+    HashTable ObjectLists;                    // Interned object lists, keyed by content
+    HashTable ByObject;                       // Sets of clients keyed by supported object ID
+
+} ClientIndex;
+
+typedef struct _RegistrationJournal RegistrationJournal;
+
 Lwm2mContextType * Lwm2mCore_Init(CoapInfo * coap, AwaContentType contentType);
 
-// Update the LWM2M state machine, process any message timeouts, registration attempts etc.
+/* Update the LWM2M state machine, expire registrations etc. Returns the time in milliseconds until
+ * the next registration expires, or -1 if there are no registered clients.
+ */
 int Lwm2mCore_Process(Lwm2mContextType * context);
 
 int Lwm2mCore_GetEndPointClientName(Lwm2mContextType * context, char * buffer, int len);
@@ -91,9 +109,11 @@ int Lwm2mCore_RemoveResourceEndPoint(Lwm2mContextType * context, const char * pa
 DefinitionRegistry * Lwm2mCore_GetDefinitions(Lwm2mContextType * context);
 
 struct ListHead * Lwm2mCore_GetClientList(Lwm2mContextType * context);
+ClientIndex * Lwm2mCore_GetClientIndex(Lwm2mContextType * context);
 AwaContentType Lwm2mCore_GetContentType(Lwm2mContextType * context);
 int Lwm2mCore_GetLastLocation(Lwm2mContextType * context);
 struct ListHead * Lwm2mCore_GetEventRecordList(Lwm2mContextType * context);
+RegistrationJournal * Lwm2mCore_GetRegistrationJournal(Lwm2mContextType * context);
 void Lwm2mCore_SetLastLocation(Lwm2mContextType * context, int location);
 
 #ifdef __cplusplus
@@ -25,6 +25,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include "lwm2m_core.h"
 #include "lwm2m_result.h"
@@ -52,8 +53,6 @@ typedef struct
 
 } EventRecord;
 
-static void DestroyObjectList(struct ListHead * objectList);
-
 static int RegistrationEndpointHandler(int type, void * ctxt, AddressType * addr, const char * path, const char * query, const char * token,
                                        int tokenLength, AwaContentType contentType, const char * requestContent, size_t requestContentLen,
                                        AwaContentType * responseContentType, char * responseContent, size_t * responseContentLen, int * responseCode);
@@ -105,40 +104,251 @@ static void Lwm2m_SplitUpQuery(const char * query, RegistrationQueryString * res
     free(str);
 }
 
+static int CompareObjectListEntry(const ObjectListEntry * entry, ObjectIDType objectID, ObjectInstanceIDType instanceID)
+{
+    if (entry->ObjectID != objectID)
+    {
+        return (entry->ObjectID < objectID) ? -1 : 1;
+    }
+    if (entry->InstanceID != instanceID)
+    {
+        return (entry->InstanceID < instanceID) ? -1 : 1;
+    }
+    return 0;
+}
+
+static int SortObjectListEntries(const void * a, const void * b)
+{
+    const ObjectListEntry * entryB = (const ObjectListEntry *)b;
+    return CompareObjectListEntry((const ObjectListEntry *)a, entryB->ObjectID, entryB->InstanceID);
+}
+
 bool Lwm2m_ClientSupportsObject(Lwm2mClientType * client, ObjectIDType objectID, ObjectInstanceIDType instanceID)
 {
     bool clientSupportsObject = false;
-    struct ListHead * i;
-    ListForEach(i, &client->ObjectList)
+    const ClientObjectList * objectList = client->ObjectList;
+    if (objectList != NULL)
     {
-        ObjectListEntry * entry = ListEntry(i, ObjectListEntry, list);
-        if ((entry->ObjectID == objectID) &&
-            ((entry->InstanceID == instanceID) || (instanceID == -1)))
+        // binary search for the first entry at or after objectID/instanceID, any instance matches -1
+        ObjectInstanceIDType searchInstanceID = (instanceID == -1) ? INT_MIN : instanceID;
+        size_t low = 0;
+        size_t high = objectList->Count;
+        while (low < high)
         {
-            clientSupportsObject = true;
-            break;
+            size_t middle = low + (high - low) / 2;
+            if (CompareObjectListEntry(&objectList->Entries[middle], objectID, searchInstanceID) < 0)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        if (low < objectList->Count)
+        {
+            const ObjectListEntry * entry = &objectList->Entries[low];
+            clientSupportsObject = (entry->ObjectID == objectID) && ((entry->InstanceID == instanceID) || (instanceID == -1));
         }
     }
     return clientSupportsObject;
 }
 
-// parse object list in "CoRE" format
-static void Lwm2m_ParseObjectList(Lwm2mClientType * client, const char * objectList, int objectListLength)
+// Return a shared object list with the specified (sorted) entries, creating it if no client has registered it yet
+static ClientObjectList * InternObjectList(Lwm2mContextType * context, const ObjectListEntry * entries, size_t count)
 {
-    // clear all entries out of object list
-    struct ListHead * i, * n;
-    ListForEachSafe(i, n, &client->ObjectList)
+    HashTable * objectLists = &Lwm2mCore_GetClientIndex(context)->ObjectLists;
+    uint32_t hash = HashTable_HashBytes(0, entries, count * sizeof(ObjectListEntry));
+    ClientObjectList * objectList = NULL;
+
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, objectLists, hash)
     {
-        ObjectListEntry * entry = ListEntry(i, ObjectListEntry, list);
-        ListRemove(i);
-        free(entry);
+        ClientObjectList * existing = HashTableContainer(entry, ClientObjectList, InternEntry);
+        if ((existing->Count == count) && ((count == 0) || (memcmp(existing->Entries, entries, count * sizeof(ObjectListEntry)) == 0)))
+        {
+            existing->RefCount++;
+            return existing;
+        }
     }
 
-    if ((objectListLength > 0) && (objectList != NULL))
+    objectList = malloc(sizeof(ClientObjectList) + count * sizeof(ObjectListEntry));
+    if (objectList != NULL)
+    {
+        memset(objectList, 0, sizeof(ClientObjectList));
+        objectList->RefCount = 1;
+        objectList->Count = count;
+        objectList->Entries = (ObjectListEntry *)(objectList + 1);
+        if (count > 0)
+        {
+            memcpy(objectList->Entries, entries, count * sizeof(ObjectListEntry));
+        }
+        HashTable_Add(objectLists, &objectList->InternEntry, hash);
+    }
+    else
+    {
+        Lwm2m_Error("Failed to allocate memory for object list\n");
+    }
+    return objectList;
+}
+
+static void ReleaseObjectList(Lwm2mContextType * context, ClientObjectList * objectList)
+{
+    if ((objectList != NULL) && (--objectList->RefCount == 0))
+    {
+        HashTable_Remove(&Lwm2mCore_GetClientIndex(context)->ObjectLists, &objectList->InternEntry);
+        free(objectList);
+    }
+}
+
+static ObjectClientSet * LookupObjectClientSet(Lwm2mContextType * context, ObjectIDType objectID)
+{
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &Lwm2mCore_GetClientIndex(context)->ByObject, HashTable_HashInt(objectID))
+    {
+        ObjectClientSet * set = HashTableContainer(entry, ObjectClientSet, IndexEntry);
+        if (set->ObjectID == objectID)
+        {
+            return set;
+        }
+    }
+    return NULL;
+}
+
+const struct ListHead * Lwm2m_GetClientsWithObject(Lwm2mContextType * context, ObjectIDType objectID)
+{
+    ObjectClientSet * set = LookupObjectClientSet(context, objectID);
+    return (set != NULL) ? &set->Clients : NULL;
+}
+
+static void UnlinkClientObjects(Lwm2mContextType * context, Lwm2mClientType * client)
+{
+    size_t i;
+    for (i = 0; i < client->NumObjectLinks; i++)
     {
-        char altPath[128];
-        strcpy(altPath, "/"); // Assume root path is "/" until proven otherwise
+        ObjectClientSet * set = client->ObjectLinks[i].Set;
+        ListRemove(&client->ObjectLinks[i].list);
+        if (set->Clients.Next == &set->Clients)
+        {
+            HashTable_Remove(&Lwm2mCore_GetClientIndex(context)->ByObject, &set->IndexEntry);
+            free(set);
+        }
+    }
+    free(client->ObjectLinks);
+    client->ObjectLinks = NULL;
+    client->NumObjectLinks = 0;
+}
+
+// Add the client to the set of clients for each object in its object list
+static void LinkClientObjects(Lwm2mContextType * context, Lwm2mClientType * client)
+{
+    const ClientObjectList * objectList = client->ObjectList;
+    size_t numObjects = 0;
+    size_t i;
+
+    // the list is sorted, so each object's instances are adjacent
+    for (i = 0; i < objectList->Count; i++)
+    {
+        if ((i == 0) || (objectList->Entries[i].ObjectID != objectList->Entries[i - 1].ObjectID))
+        {
+            numObjects++;
+        }
+    }
 
+    if (numObjects > 0)
+    {
+        client->ObjectLinks = malloc(numObjects * sizeof(ObjectClientLink));
+        if (client->ObjectLinks == NULL)
+        {
+            Lwm2m_Error("Failed to allocate memory for object index\n");
+            return;
+        }
+
+        for (i = 0; i < objectList->Count; i++)
+        {
+            ObjectIDType objectID = objectList->Entries[i].ObjectID;
+            if ((i > 0) && (objectID == objectList->Entries[i - 1].ObjectID))
+            {
+                continue;
+            }
+
+            ObjectClientSet * set = LookupObjectClientSet(context, objectID);
+            if (set == NULL)
+            {
+                set = malloc(sizeof(ObjectClientSet));
+                if (set == NULL)
+                {
+                    Lwm2m_Error("Failed to allocate memory for object index\n");
+                    break;
+                }
+                memset(set, 0, sizeof(ObjectClientSet));
+                set->ObjectID = objectID;
+                ListInit(&set->Clients);
+                HashTable_Add(&Lwm2mCore_GetClientIndex(context)->ByObject, &set->IndexEntry, HashTable_HashInt(objectID));
+            }
+
+            ObjectClientLink * link = &client->ObjectLinks[client->NumObjectLinks++];
+            link->Client = client;
+            link->Set = set;
+            ListAdd(&link->list, &set->Clients);
+        }
+    }
+}
+
+// Sort and drop duplicates, so that identical registrations produce identical lists. Returns the new count.
+static size_t NormaliseObjectListEntries(ObjectListEntry * entries, size_t count)
+{
+    if (count > 1)
+    {
+        size_t i, unique = 1;
+        qsort(entries, count, sizeof(ObjectListEntry), SortObjectListEntries);
+        for (i = 1; i < count; i++)
+        {
+            if (SortObjectListEntries(&entries[unique - 1], &entries[i]) != 0)
+            {
+                entries[unique++] = entries[i];
+            }
+        }
+        count = unique;
+    }
+    return count;
+}
+
+// Replace the client's object list with the (normalised) entries
+static void SetClientObjectList(Lwm2mContextType * context, Lwm2mClientType * client, const ObjectListEntry * entries, size_t count)
+{
+    // Intern the new list before releasing the old one, so an unchanged list is reused rather than reallocated
+    ClientObjectList * newObjectList = InternObjectList(context, entries, count);
+    if (newObjectList != NULL)
+    {
+        if (newObjectList != client->ObjectList)
+        {
+            UnlinkClientObjects(context, client);
+            ReleaseObjectList(context, client->ObjectList);
+            client->ObjectList = newObjectList;
+            LinkClientObjects(context, client);
+        }
+        else
+        {
+            // unchanged, drop the extra reference
+            ReleaseObjectList(context, newObjectList);
+        }
+    }
+}
+
+// parse object list in "CoRE" format
+static void Lwm2m_ParseObjectList(Lwm2mContextType * context, Lwm2mClientType * client, const char * objectList, int objectListLength)
+{
+    ObjectListEntry * entries = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    char altPath[128];
+
+    strcpy(altPath, "/"); // Assume root path is "/" until proven otherwise
+
+    if ((objectListLength > 0) && (objectList != NULL))
+    {
         char * str = strndup(objectList, objectListLength);
         const char delim[] = ", ";
         char * savePointer;
@@ -192,17 +402,21 @@ static void Lwm2m_ParseObjectList(Lwm2mClientType * client, const char * objectL
                     continue;
                 }
 
-                // Create new entry, perhaps check for duplicates?
-                ObjectListEntry * entry = malloc(sizeof(ObjectListEntry));
-                if (entry == NULL)
+                if (count == capacity)
                 {
-                    break;
+                    size_t newCapacity = (capacity > 0) ? capacity * 2 : 16;
+                    ObjectListEntry * newEntries = realloc(entries, newCapacity * sizeof(ObjectListEntry));
+                    if (newEntries == NULL)
+                    {
+                        break;
+                    }
+                    entries = newEntries;
+                    capacity = newCapacity;
                 }
 
-                entry->ObjectID = object;
-                entry->InstanceID = instance;
-
-                ListAdd(&entry->list, &client->ObjectList);
+                entries[count].ObjectID = object;
+                entries[count].InstanceID = instance;
+                count++;
             }
 
         skip:
@@ -210,21 +424,26 @@ static void Lwm2m_ParseObjectList(Lwm2mClientType * client, const char * objectL
         }
 
         free(str);
+    }
+
+    count = NormaliseObjectListEntries(entries, count);
 
-        // Debug, printout list
-        ListForEach(i, &client->ObjectList)
+    // Debug, printout list
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        if (entries[i].InstanceID != -1)
         {
-            ObjectListEntry * entry = ListEntry(i, ObjectListEntry, list);
-            if (entry->InstanceID != -1)
-            {
-                Lwm2m_Info("Path %s Object %d, Instance %d\n", altPath, entry->ObjectID, entry->InstanceID);
-            }
-            else
-            {
-                Lwm2m_Info("Path %s Object %d\n", altPath, entry->ObjectID);
-            }
+            Lwm2m_Info("Path %s Object %d, Instance %d\n", altPath, entries[i].ObjectID, entries[i].InstanceID);
+        }
+        else
+        {
+            Lwm2m_Info("Path %s Object %d\n", altPath, entries[i].ObjectID);
         }
     }
+
+    SetClientObjectList(context, client, entries, count);
+    free(entries);
 }
 
 static void Lwm2m_ReleaseQueryString(RegistrationQueryString * queryString)
@@ -238,10 +457,10 @@ static void Lwm2m_ReleaseQueryString(RegistrationQueryString * queryString)
 Lwm2mClientType * Lwm2m_LookupClientByName(Lwm2mContextType * context, const char * endPointName)
 {
     Lwm2mClientType * client = NULL;
-    struct ListHead * i;
-    ListForEach(i, Lwm2mCore_GetClientList(context))
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &Lwm2mCore_GetClientIndex(context)->ByName, HashTable_HashString(endPointName))
     {
-        Lwm2mClientType * c = ListEntry(i, Lwm2mClientType, list);
+        Lwm2mClientType * c = HashTableContainer(entry, Lwm2mClientType, NameEntry);
         if (strcmp(c->EndPointName, endPointName) == 0)
         {
             client = c;
@@ -251,13 +470,13 @@ Lwm2mClientType * Lwm2m_LookupClientByName(Lwm2mContextType * context, const cha
     return client;
 }
 
-static Lwm2mClientType * Lwm2m_LookupClientByLocation(Lwm2mContextType * context, int location)
+Lwm2mClientType * Lwm2m_LookupClientByLocation(Lwm2mContextType * context, int location)
 {
     Lwm2mClientType * client = NULL;
-    struct ListHead * i;
-    ListForEach(i, Lwm2mCore_GetClientList(context))
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &Lwm2mCore_GetClientIndex(context)->ByLocation, HashTable_HashInt(location))
     {
-        Lwm2mClientType * c = ListEntry(i, Lwm2mClientType, list);
+        Lwm2mClientType * c = HashTableContainer(entry, Lwm2mClientType, LocationEntry);
         if (c->Location == location)
         {
             client = c;
@@ -270,12 +489,11 @@ static Lwm2mClientType * Lwm2m_LookupClientByLocation(Lwm2mContextType * context
 Lwm2mClientType * Lwm2m_LookupClientByAddress(Lwm2mContextType * context, AddressType * address)
 {
     Lwm2mClientType * client = NULL;
-    struct ListHead * i;
-    ListForEach(i, Lwm2mCore_GetClientList(context))
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &Lwm2mCore_GetClientIndex(context)->ByAddress, Lwm2mCore_HashAddress(address))
     {
-        Lwm2mClientType * c = ListEntry(i, Lwm2mClientType, list);
-
-        if (memcmp(c->Address.Addr.Sa.sa_data, address->Addr.Sa.sa_data, sizeof(c->Address.Addr.Sa.sa_data)) == 0)
+        Lwm2mClientType * c = HashTableContainer(entry, Lwm2mClientType, AddressEntry);
+        if (Lwm2mCore_CompareAddresses(&c->Address, address) == 0)
         {
             client = c;
             break;
@@ -284,8 +502,47 @@ Lwm2mClientType * Lwm2m_LookupClientByAddress(Lwm2mContextType * context, Addres
     return client;
 }
 
+static void AddClientToIndex(Lwm2mContextType * context, Lwm2mClientType * client)
+{
+    ClientIndex * index = Lwm2mCore_GetClientIndex(context);
+    HashTable_Add(&index->ByName, &client->NameEntry, HashTable_HashString(client->EndPointName));
+    HashTable_Add(&index->ByLocation, &client->LocationEntry, HashTable_HashInt(client->Location));
+    HashTable_Add(&index->ByAddress, &client->AddressEntry, Lwm2mCore_HashAddress(&client->Address));
+}
+
+static void RemoveClientFromIndex(Lwm2mContextType * context, Lwm2mClientType * client)
+{
+    ClientIndex * index = Lwm2mCore_GetClientIndex(context);
+    HashTable_Remove(&index->ByName, &client->NameEntry);
+    HashTable_Remove(&index->ByLocation, &client->LocationEntry);
+    HashTable_Remove(&index->ByAddress, &client->AddressEntry);
+    DeadlineQueue_Cancel(&index->ByExpiry, &client->ExpiryEntry);
+}
+
+// The client may send an update from a new address/port (e.g. after NAT rebinding), keep the address index in step
+static void UpdateClientAddress(Lwm2mContextType * context, Lwm2mClientType * client, AddressType * addr)
+{
+    if (Lwm2mCore_CompareAddresses(&client->Address, addr) != 0)
+    {
+        ClientIndex * index = Lwm2mCore_GetClientIndex(context);
+        HashTable_Remove(&index->ByAddress, &client->AddressEntry);
+        memcpy(&client->Address, addr, sizeof(AddressType));
+        HashTable_Add(&index->ByAddress, &client->AddressEntry, Lwm2mCore_HashAddress(&client->Address));
+    }
+    else
+    {
+        memcpy(&client->Address, addr, sizeof(AddressType));
+    }
+}
+
 static void DispatchRegistrationEventCallbacks(Lwm2mContextType * lwm2mContext, RegistrationEventType eventType, void * parameter)
 {
+    RegistrationJournal * journal = Lwm2mCore_GetRegistrationJournal(lwm2mContext);
+    if (journal->Callback != NULL)
+    {
+        journal->Callback(eventType, journal->Context, parameter);
+    }
+
     struct ListHead * eventRecordList = Lwm2mCore_GetEventRecordList(lwm2mContext);
     if (eventRecordList != NULL)
     {
@@ -313,7 +570,7 @@ static int Lwm2m_UpdateClient(Lwm2mContextType * context, int location, int life
     Lwm2mClientType * client = Lwm2m_LookupClientByLocation(context, location);
     if (client)
     {
-        uint32_t now = Lwm2mCore_GetTickCountMs();
+        uint64_t now = Lwm2mCore_GetTickCountMs();
 
         if (lifeTime > 0)
         {
@@ -324,14 +581,15 @@ static int Lwm2m_UpdateClient(Lwm2mContextType * context, int location, int life
             client->LifeTime = LIFETIME_DEFAULT;
         }
 
-        memcpy(&client->Address, addr, sizeof(AddressType));
+        UpdateClientAddress(context, client, addr);
 
         if (contentType == AwaContentType_ApplicationLinkFormat)
         {
-            Lwm2m_ParseObjectList(client, objectList, objectListLength);
+            Lwm2m_ParseObjectList(context, client, objectList, objectListLength);
         }
 
         client->LastUpdateTime = now;
+        DeadlineQueue_Schedule(&Lwm2mCore_GetClientIndex(context)->ByExpiry, &client->ExpiryEntry, now + (uint64_t)client->LifeTime * 1000);
 
         DispatchRegistrationEventCallbacks(context, registrationEventType, client);
 
@@ -356,16 +614,17 @@ static int Lwm2m_RegisterClient(Lwm2mContextType * context, const char * endPoin
         {
             char RegisterLocation[128] = {0};
 
+            memset(client, 0, sizeof(Lwm2mClientType));
             client->EndPointName = strdup(endPointName);
             client->BindingMode = bindingMode;
             client->SupportsJson = false;
+            memcpy(&client->Address, addr, sizeof(AddressType));
 
             client->Location = Lwm2mCore_GetLastLocation(context) + 1;
             Lwm2mCore_SetLastLocation(context, client->Location);
 
-            ListInit(&client->ObjectList);
-
             ListAdd(&client->list, Lwm2mCore_GetClientList(context));
+            AddClientToIndex(context, client);
 
             sprintf(RegisterLocation, "/rd/%d", client->Location);
             Lwm2mCore_AddResourceEndPoint(context, RegisterLocation, UpdateEndpointHandler);
@@ -386,22 +645,129 @@ static int Lwm2m_RegisterClient(Lwm2mContextType * context, const char * endPoin
     return result;
 }
 
-static void Lwm2m_DeregisterClient(Lwm2mContextType * context, Lwm2mClientType * client)
+// Remove a client from the client list, its indexes and its /rd/<location> endpoint
+static void UnlistClient(Lwm2mContextType * context, Lwm2mClientType * client)
 {
     char RegisterLocation[128] = {0};
 
     ListRemove(&client->list);
-    DestroyObjectList(&client->ObjectList);
+    RemoveClientFromIndex(context, client);
 
     sprintf(RegisterLocation, "/rd/%d", client->Location);
     Lwm2mCore_RemoveResourceEndPoint(context, RegisterLocation);
+}
+
+static void FreeClient(Lwm2mContextType * context, Lwm2mClientType * client)
+{
+    UnlinkClientObjects(context, client);
+    ReleaseObjectList(context, client->ObjectList);
+    free(client->EndPointName);
+    free(client);
+}
+
+static void Lwm2m_DeregisterClient(Lwm2mContextType * context, Lwm2mClientType * client)
+{
+    UnlistClient(context, client);
 
     Lwm2m_Info("Client deregistered: \'%s\'\n", client->EndPointName);
 
     DispatchRegistrationEventCallbacks(context, RegistrationEventType_Deregister, client);
 
-    free(client->EndPointName);
-    free(client);
+    FreeClient(context, client);
+}
+
+void Lwm2m_RemoveClient(Lwm2mContextType * context, Lwm2mClientType * client)
+{
+    Lwm2m_DeregisterClient(context, client);
+}
+
+Lwm2mClientType * Lwm2m_RestoreClient(Lwm2mContextType * context, const char * endPointName, int location, int lifeTime,
+                                      BindingMode bindingMode, bool supportsJson, AddressType * address,
+                                      const ObjectListEntry * entries, size_t count, uint32_t remainingLifeTimeMs)
+{
+    Lwm2mClientType * client = NULL;
+    ObjectListEntry * sortedEntries = NULL;
+    char registerLocation[128] = {0};
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+
+    if ((endPointName == NULL) || (address == NULL) || (location <= 0) || ((count > 0) && (entries == NULL)))
+    {
+        Lwm2m_Error("Invalid registration to restore\n");
+        goto error;
+    }
+
+    if (count > 0)
+    {
+        sortedEntries = malloc(count * sizeof(ObjectListEntry));
+        if (sortedEntries == NULL)
+        {
+            Lwm2m_Error("Failed to allocate memory for object list\n");
+            goto error;
+        }
+        memcpy(sortedEntries, entries, count * sizeof(ObjectListEntry));
+        count = NormaliseObjectListEntries(sortedEntries, count);
+    }
+
+    // the newest record for an endpoint or location wins, and replacing a registration is not a deregistration
+    if ((client = Lwm2m_LookupClientByName(context, endPointName)) != NULL)
+    {
+        UnlistClient(context, client);
+        FreeClient(context, client);
+    }
+    if ((client = Lwm2m_LookupClientByLocation(context, location)) != NULL)
+    {
+        UnlistClient(context, client);
+        FreeClient(context, client);
+    }
+
+    client = malloc(sizeof(Lwm2mClientType));
+    if (client == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for Client entry\n");
+        goto error;
+    }
+
+    memset(client, 0, sizeof(Lwm2mClientType));
+    client->EndPointName = strdup(endPointName);
+    client->BindingMode = bindingMode;
+    client->SupportsJson = supportsJson;
+    client->LifeTime = (lifeTime > 0) ? lifeTime : LIFETIME_DEFAULT;
+    client->Location = location;
+    memcpy(&client->Address, address, sizeof(AddressType));
+
+    // keep the original update time, so that restoring a registration does not extend its lifetime
+    uint64_t lifeTimeMs = (uint64_t)client->LifeTime * 1000;
+    if (remainingLifeTimeMs > lifeTimeMs)
+    {
+        remainingLifeTimeMs = lifeTimeMs;
+    }
+    client->LastUpdateTime = now + remainingLifeTimeMs - lifeTimeMs;
+
+    if (location > Lwm2mCore_GetLastLocation(context))
+    {
+        Lwm2mCore_SetLastLocation(context, location);
+    }
+
+    ListAdd(&client->list, Lwm2mCore_GetClientList(context));
+    AddClientToIndex(context, client);
+    SetClientObjectList(context, client, sortedEntries, count);
+    DeadlineQueue_Schedule(&Lwm2mCore_GetClientIndex(context)->ByExpiry, &client->ExpiryEntry, now + remainingLifeTimeMs);
+
+    sprintf(registerLocation, "/rd/%d", client->Location);
+    Lwm2mCore_AddResourceEndPoint(context, registerLocation, UpdateEndpointHandler);
+
+    Lwm2m_Debug("Client restored: \'%s\' at %s\n", endPointName, registerLocation);
+
+error:
+    free(sortedEntries);
+    return client;
+}
+
+void Lwm2m_SetRegistrationJournal(Lwm2mContextType * context, RegistrationEventCallback callback, void * callbackContext)
+{
+    RegistrationJournal * journal = Lwm2mCore_GetRegistrationJournal(context);
+    journal->Callback = callback;
+    journal->Context = callbackContext;
 }
 
 // handler called when a client posts to /rd
@@ -441,7 +807,7 @@ static int Lwm2m_RegisterPost(void * ctxt, AddressType * addr, const char * path
     if ((client = Lwm2m_LookupClientByName(context, q.EndPointName)) != NULL)
     {
         // Check to see if this is a re-register from the same address, otherwise treat as a duplicate.
-        if ((addr->Size == client->Address.Size) && (memcmp(addr, &client->Address, addr->Size) == 0))
+        if (Lwm2mCore_CompareAddresses(addr, &client->Address) == 0)
         {
             Lwm2m_Info("Client \'%s\' already registered, deleting\n", q.EndPointName);
             Lwm2m_DeregisterClient(context, client);
@@ -591,50 +957,47 @@ static int RegistrationEndpointHandler(int type, void * ctxt, AddressType * addr
 
 int32_t Lwm2m_AgeRegistrations(Lwm2mContextType * context)
 {
-    uint32_t now = Lwm2mCore_GetTickCountMs();
-    struct ListHead * i, *n;
+    DeadlineQueue * expiryQueue = &Lwm2mCore_GetClientIndex(context)->ByExpiry;
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+    DeadlineQueueEntry * entry;
 
-    ListForEachSafe(i, n, Lwm2mCore_GetClientList(context))
+    while ((entry = DeadlineQueue_PopExpired(expiryQueue, now)) != NULL)
     {
-        Lwm2mClientType * client = ListEntry(i, Lwm2mClientType, list);
+        Lwm2mClientType * client = DeadlineQueueContainer(entry, Lwm2mClientType, ExpiryEntry);
 
-        if ((now - client->LastUpdateTime) > (client->LifeTime * 1000))
-        {
-            Lwm2m_Error("Client \'%s\' Lifetime Expired\n", client->EndPointName);
+        Lwm2m_Error("Client \'%s\' Lifetime Expired\n", client->EndPointName);
 
-            Lwm2m_DeregisterClient(context, client);
-        }
+        Lwm2m_DeregisterClient(context, client);
     }
-    return 0;
+    return DeadlineQueue_GetTimeout(expiryQueue, now);
 }
 
 int Lwm2m_RegistrationInit(Lwm2mContextType * context)
 {
     // Initialise client list
+    ClientIndex * index = Lwm2mCore_GetClientIndex(context);
     ListInit(Lwm2mCore_GetClientList(context));
+    if ((HashTable_Init(&index->ByName, 0) != 0) ||
+        (HashTable_Init(&index->ByLocation, 0) != 0) ||
+        (HashTable_Init(&index->ByAddress, 0) != 0) ||
+        (DeadlineQueue_Init(&index->ByExpiry) != 0) ||
+        (HashTable_Init(&index->ObjectLists, 0) != 0) ||
+        (HashTable_Init(&index->ByObject, 0) != 0))
+    {
+        Lwm2m_Error("Failed to allocate client index\n");
+        return -1;
+    }
     Lwm2mCore_SetLastLocation(context, 0);
 
     Lwm2mCore_AddResourceEndPoint(context, "/rd", RegistrationEndpointHandler);
 
     ListInit(Lwm2mCore_GetEventRecordList(context));
+    Lwm2m_SetRegistrationJournal(context, NULL, NULL);
 
     return 0;
 }
 
-static void DestroyObjectList(struct ListHead * objectList)
-{
-    if (objectList != NULL)
-    {
-        struct ListHead * i, * n;
-        ListForEachSafe(i, n, objectList)
-        {
-            ObjectListEntry * object = ListEntry(i, ObjectListEntry, list);
-            free(object);
-        }
-    }
-}
-
-static void DestroyClientList(struct ListHead * clientList)
+static void DestroyClientList(Lwm2mContextType * context, struct ListHead * clientList)
 {
     if (clientList != NULL)
     {
@@ -644,7 +1007,8 @@ static void DestroyClientList(struct ListHead * clientList)
             Lwm2mClientType * client = ListEntry(i, Lwm2mClientType, list);
             if (client != NULL)
             {
-                DestroyObjectList(&client->ObjectList);
+                UnlinkClientObjects(context, client);
+                ReleaseObjectList(context, client->ObjectList);
                 free(client->EndPointName);
                 free(client);
             }
@@ -673,7 +1037,14 @@ static void DestroyEventList(struct ListHead * eventRecordList)
 
 void Lwm2m_RegistrationDestroy(Lwm2mContextType * context)
 {
-    DestroyClientList(Lwm2mCore_GetClientList(context));
+    ClientIndex * index = Lwm2mCore_GetClientIndex(context);
+    DestroyClientList(context, Lwm2mCore_GetClientList(context));
+    HashTable_Destroy(&index->ByName);
+    HashTable_Destroy(&index->ByLocation);
+    HashTable_Destroy(&index->ByAddress);
+    DeadlineQueue_Destroy(&index->ByExpiry);
+    HashTable_Destroy(&index->ObjectLists);
+    HashTable_Destroy(&index->ByObject);
     DestroyEventList(Lwm2mCore_GetEventRecordList(context));
 }
 
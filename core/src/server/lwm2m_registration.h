@@ -63,45 +63,114 @@ typedef enum
 
 typedef struct
 {
-    struct ListHead list;
     ObjectIDType ObjectID;
-    ObjectInstanceIDType InstanceID;
+    ObjectInstanceIDType InstanceID;   // -1 if the client registered the object without instances
 
 } ObjectListEntry;
 
-// Information about Registered Clients
+/* Supported objects and object instances, sorted by object ID then instance ID. Lists are interned
+ * by content and shared between clients registering the same objects, so they must not be modified;
+ * a registration update replaces the client's list instead.
+ */
+typedef struct
+{
+    HashTableEntry InternEntry;
+    size_t RefCount;
+    size_t Count;
+    ObjectListEntry * Entries;         // Allocated together with the list
+
+} ClientObjectList;
+
+typedef struct _Lwm2mClientType Lwm2mClientType;
+
+// Set of registered clients supporting an object, see Lwm2m_GetClientsWithObject()
+typedef struct
+{
+    HashTableEntry IndexEntry;
+    ObjectIDType ObjectID;
+    struct ListHead Clients;           // List of ObjectClientLink
+
+} ObjectClientSet;
+
 typedef struct
+{
+    struct ListHead list;
+    Lwm2mClientType * Client;
+    ObjectClientSet * Set;
+
+} ObjectClientLink;
+
+// Information about Registered Clients
+struct _Lwm2mClientType
 {
     struct ListHead list;
     char * EndPointName;               // Clients "unique" end point name
     AddressType Address;               // Clients address information
     int LifeTime;                      // Lifetime in seconds, 86400 is the default.
     BindingMode BindingMode;           // Binding mode, currently only "U" is supported.
-    uint32_t LastUpdateTime;           // Time the client last sent an update or registration request to the server
-    struct ListHead ObjectList;        // List of supported objects, object instances
+    uint64_t LastUpdateTime;           // Time the client last sent an update or registration request to the server
+    ClientObjectList * ObjectList;     // Supported objects, object instances (shared, read-only)
     char * ResourceType;               // RFC6690 Resource Type parameter
     bool SupportsJson;                 // The Client supports JSON for all objects
     int Location;                      // /rd/location, this should probably be a string
+    HashTableEntry NameEntry;          // Entries in the ClientIndex tables
+    HashTableEntry LocationEntry;
+    HashTableEntry AddressEntry;
+    DeadlineQueueEntry ExpiryEntry;    // Scheduled at LastUpdateTime + LifeTime
+    ObjectClientLink * ObjectLinks;    // One per distinct object ID in ObjectList, links the client into ClientIndex.ByObject
+    size_t NumObjectLinks;
 
-} Lwm2mClientType;
+};
 
 int Lwm2m_RegistrationInit(Lwm2mContextType * context);
 void Lwm2m_RegistrationDestroy(Lwm2mContextType * context);
 
 /* Age the client registrations. The registration will be removed by the server if a registration or update
- * has not been received with the client lifetime.
+ * has not been received with the client lifetime. Only expired registrations are visited. Returns the time in
+ * milliseconds until the next registration expires, or -1 if there are no registered clients.
  */
 int32_t Lwm2m_AgeRegistrations(Lwm2mContextType * context);
 
 Lwm2mClientType * Lwm2m_LookupClientByName(Lwm2mContextType * context, const char * endPointName);
+Lwm2mClientType * Lwm2m_LookupClientByLocation(Lwm2mContextType * context, int location);
 Lwm2mClientType * Lwm2m_LookupClientByAddress(Lwm2mContextType * context, AddressType * address);
 
 bool Lwm2m_ClientSupportsObject(Lwm2mClientType * client, ObjectIDType objectID, ObjectInstanceIDType instanceID);
 
+/* Return the list of clients that have registered the specified object, as ObjectClientLink entries,
+ * or NULL if no registered client supports the object. The list must not be modified.
+ */
+const struct ListHead * Lwm2m_GetClientsWithObject(Lwm2mContextType * context, ObjectIDType objectID);
+
 // Functions to support Server Events
 
 typedef void (*RegistrationEventCallback)(RegistrationEventType eventType, void * context, void * parameter);
 
+/* Recreate a registration saved by a previous server instance, so that a restarted server can serve its clients
+ * without waiting for them to register again. The client keeps its /rd/<location> and any existing registration
+ * with the same endpoint name or location is replaced. Registration event callbacks are not called, neither for the
+ * restored registration nor for the ones it replaces. The restored registration expires after remainingLifeTimeMs.
+ * Returns the restored client, or NULL on failure.
+ */
+Lwm2mClientType * Lwm2m_RestoreClient(Lwm2mContextType * context, const char * endPointName, int location, int lifeTime,
+                                      BindingMode bindingMode, bool supportsJson, AddressType * address,
+                                      const ObjectListEntry * entries, size_t count, uint32_t remainingLifeTimeMs);
+
+// Remove a registration, as if the client had deregistered
+void Lwm2m_RemoveClient(Lwm2mContextType * context, Lwm2mClientType * client);
+
+// Persistent store notified of every registration, update and deregistration, see Lwm2m_SetRegistrationJournal()
+struct _RegistrationJournal
+{
+    RegistrationEventCallback Callback;
+    void * Context;
+};
+
+/* Set the journal callback, called after each registration change is applied and before the other registration
+ * event callbacks. Pass a NULL callback to stop journalling. The callback context is not owned by the server.
+ */
+void Lwm2m_SetRegistrationJournal(Lwm2mContextType * context, RegistrationEventCallback callback, void * callbackContext);
+
 void * Lwm2m_GetEventContext(Lwm2mContextType * lwm2mContext, IPCSessionID sessionID);
 int Lwm2m_AddRegistrationEventCallback(Lwm2mContextType * lwm2mContext, IPCSessionID sessionID, RegistrationEventCallback callback, void * callbackContext);
 int Lwm2m_DeleteRegistrationEventCallback(Lwm2mContextType * lwm2mContext, IPCSessionID sessionID);
@@ -44,9 +44,11 @@ struct _Lwm2mContextType
     ResourceEndPointList EndPointList;        // CoAP endpoints
     CoapInfo * Coap;                          // CoAP library context information
     struct ListHead ClientList;               // List of registered clients
+    ClientIndex ClientIndex;                  // Lookup tables for registered clients
     int LastLocation;                         // Used for registration, creates /rd/0, /rd/1 etc
     AwaContentType ContentType;                  // Used to set CoAP content type
     struct ListHead EventRecordList;          // Used to dispatch event callbacks
+    RegistrationJournal RegistrationJournal;  // Persistent store for registrations, if any
 };
 
 static Lwm2mContextType Lwm2mContext;
@@ -138,6 +140,11 @@ struct ListHead * Lwm2mCore_GetClientList(Lwm2mContextType * context)
     return &context->ClientList;
 }
 
+ClientIndex * Lwm2mCore_GetClientIndex(Lwm2mContextType * context)
+{
+    return &context->ClientIndex;
+}
+
 AwaContentType Lwm2mCore_GetContentType(Lwm2mContextType * context)
 {
     return context->ContentType;
@@ -153,6 +160,11 @@ struct ListHead * Lwm2mCore_GetEventRecordList(Lwm2mContextType * context)
     return &context->EventRecordList;
 }
 
+RegistrationJournal * Lwm2mCore_GetRegistrationJournal(Lwm2mContextType * context)
+{
+    return &context->RegistrationJournal;
+}
+
 void Lwm2mCore_SetLastLocation(Lwm2mContextType * context, int location)
 {
     context->LastLocation = location;
@@ -190,7 +202,5 @@ bool qClientRegisterEvent = false;
 
 int Lwm2mCore_Process(Lwm2mContextType * context)
 {
-    int nextTick = 1000;
-    Lwm2m_AgeRegistrations(context);
-    return nextTick;
+    return Lwm2m_AgeRegistrations(context);
 }
@@ -0,0 +1,165 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "coap_exchange_index.h"
+
+class CoapExchangeIndexTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(0, CoapExchangeIndex_Init(&index_));
+        for (int i = 0; i < NUM_ADDRESSES; i++)
+        {
+            memset(&addresses_[i], 0, sizeof(addresses_[i]));
+            addresses_[i].Size = sizeof(addresses_[i].Addr.Sin);
+            addresses_[i].Addr.Sin.sin_family = AF_INET;
+            addresses_[i].Addr.Sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addresses_[i].Addr.Sin.sin_port = htons(15700 + i);
+        }
+    }
+    void TearDown()
+    {
+        CoapExchangeIndex_Destroy(&index_);
+    }
+
+    static const int NUM_ADDRESSES = 3;
+    CoapExchangeIndex index_;
+    AddressType addresses_[NUM_ADDRESSES];
+};
+
+TEST_F(CoapExchangeIndexTestSuite, test_get_transaction_by_id)
+{
+    CoapTransactionEntry transactions[100];
+    for (int i = 0; i < 100; i++)
+    {
+        memset(&transactions[i], 0, sizeof(transactions[i]));
+        ASSERT_EQ(0, CoapExchangeIndex_AddTransaction(&index_, &transactions[i], 1000 + i));
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(&transactions[i], CoapExchangeIndex_GetTransaction(&index_, 1000 + i));
+    }
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetTransaction(&index_, 999));
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetTransaction(&index_, 1100));
+}
+
+TEST_F(CoapExchangeIndexTestSuite, test_transaction_id_is_unique)
+{
+    CoapTransactionEntry first;
+    CoapTransactionEntry second;
+    memset(&first, 0, sizeof(first));
+    memset(&second, 0, sizeof(second));
+    ASSERT_EQ(0, CoapExchangeIndex_AddTransaction(&index_, &first, 42));
+    EXPECT_EQ(-1, CoapExchangeIndex_AddTransaction(&index_, &second, 42));
+    EXPECT_EQ(&first, CoapExchangeIndex_GetTransaction(&index_, 42));
+}
+
+TEST_F(CoapExchangeIndexTestSuite, test_remove_transaction)
+{
+    CoapTransactionEntry first;
+    CoapTransactionEntry second;
+    memset(&first, 0, sizeof(first));
+    memset(&second, 0, sizeof(second));
+    ASSERT_EQ(0, CoapExchangeIndex_AddTransaction(&index_, &first, 1));
+    ASSERT_EQ(0, CoapExchangeIndex_AddTransaction(&index_, &second, 2));
+
+    CoapExchangeIndex_RemoveTransaction(&index_, &first);
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetTransaction(&index_, 1));
+    EXPECT_EQ(&second, CoapExchangeIndex_GetTransaction(&index_, 2));
+
+    // removing twice has no effect, and the ID can be used again
+    CoapExchangeIndex_RemoveTransaction(&index_, &first);
+    EXPECT_EQ(0, CoapExchangeIndex_AddTransaction(&index_, &first, 1));
+    EXPECT_EQ(&first, CoapExchangeIndex_GetTransaction(&index_, 1));
+}
+
+TEST_F(CoapExchangeIndexTestSuite, test_retransmission_changes_transaction_id)
+{
+    CoapTransactionEntry transaction;
+    memset(&transaction, 0, sizeof(transaction));
+    ASSERT_EQ(0, CoapExchangeIndex_AddTransaction(&index_, &transaction, 7));
+
+    CoapExchangeIndex_SetTransactionID(&index_, &transaction, 8);
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetTransaction(&index_, 7));
+    EXPECT_EQ(&transaction, CoapExchangeIndex_GetTransaction(&index_, 8));
+    EXPECT_EQ(8, transaction.TransactionID);
+}
+
+TEST_F(CoapExchangeIndexTestSuite, test_get_observation_by_peer_and_token)
+{
+    const uint8_t token[] = { 0x01, 0x02, 0x03, 0x04 };
+    const uint8_t otherToken[] = { 0x01, 0x02, 0x03, 0x05 };
+    CoapObservationEntry observation;
+    memset(&observation, 0, sizeof(observation));
+    ASSERT_EQ(0, CoapExchangeIndex_AddObservation(&index_, &observation, &addresses_[0], token, sizeof(token)));
+
+    EXPECT_EQ(&observation, CoapExchangeIndex_GetObservation(&index_, &addresses_[0], token, sizeof(token)));
+    EXPECT_EQ(0, memcmp(&addresses_[0], &observation.Address, sizeof(observation.Address)));
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetObservation(&index_, &addresses_[0], otherToken, sizeof(otherToken)));
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetObservation(&index_, &addresses_[0], token, sizeof(token) - 1));
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetObservation(&index_, &addresses_[1], token, sizeof(token)));
+}
+
+TEST_F(CoapExchangeIndexTestSuite, test_same_token_from_different_peers)
+{
+    const uint8_t token[] = { 0xaa, 0xbb };
+    CoapObservationEntry observations[NUM_ADDRESSES];
+    for (int i = 0; i < NUM_ADDRESSES; i++)
+    {
+        memset(&observations[i], 0, sizeof(observations[i]));
+        ASSERT_EQ(0, CoapExchangeIndex_AddObservation(&index_, &observations[i], &addresses_[i], token, sizeof(token)));
+    }
+    for (int i = 0; i < NUM_ADDRESSES; i++)
+    {
+        EXPECT_EQ(&observations[i], CoapExchangeIndex_GetObservation(&index_, &addresses_[i], token, sizeof(token)));
+    }
+
+    // a peer cannot have two observations with the same token
+    CoapObservationEntry duplicate;
+    memset(&duplicate, 0, sizeof(duplicate));
+    EXPECT_EQ(-1, CoapExchangeIndex_AddObservation(&index_, &duplicate, &addresses_[1], token, sizeof(token)));
+
+    // removing the observation of one peer leaves the others
+    CoapExchangeIndex_RemoveObservation(&index_, &observations[1]);
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetObservation(&index_, &addresses_[1], token, sizeof(token)));
+    EXPECT_EQ(&observations[0], CoapExchangeIndex_GetObservation(&index_, &addresses_[0], token, sizeof(token)));
+    EXPECT_EQ(&observations[2], CoapExchangeIndex_GetObservation(&index_, &addresses_[2], token, sizeof(token)));
+}
+
+TEST_F(CoapExchangeIndexTestSuite, test_empty_and_long_tokens)
+{
+    const uint8_t token[COAP_EXCHANGE_MAX_TOKEN_LENGTH + 1] = { 0 };
+    CoapObservationEntry empty;
+    CoapObservationEntry tooLong;
+    memset(&empty, 0, sizeof(empty));
+    memset(&tooLong, 0, sizeof(tooLong));
+
+    ASSERT_EQ(0, CoapExchangeIndex_AddObservation(&index_, &empty, &addresses_[0], token, 0));
+    EXPECT_EQ(&empty, CoapExchangeIndex_GetObservation(&index_, &addresses_[0], token, 0));
+
+    EXPECT_EQ(-1, CoapExchangeIndex_AddObservation(&index_, &tooLong, &addresses_[0], token, sizeof(token)));
+    EXPECT_TRUE(NULL == CoapExchangeIndex_GetObservation(&index_, &addresses_[0], token, sizeof(token)));
+}
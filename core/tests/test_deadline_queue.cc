@@ -0,0 +1,121 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwm2m_deadline_queue.h"
+
+class DeadlineQueueTestSuite : public testing::Test
+{
+protected:
+    void SetUp() { ASSERT_EQ(0, DeadlineQueue_Init(&queue_)); }
+    void TearDown() { DeadlineQueue_Destroy(&queue_); }
+
+    DeadlineQueue queue_;
+};
+
+TEST_F(DeadlineQueueTestSuite, test_empty_queue)
+{
+    EXPECT_EQ(0u, DeadlineQueue_Count(&queue_));
+    EXPECT_TRUE(NULL == DeadlineQueue_Peek(&queue_));
+    EXPECT_TRUE(NULL == DeadlineQueue_PopExpired(&queue_, 1000));
+    EXPECT_EQ(-1, DeadlineQueue_GetTimeout(&queue_, 0));
+}
+
+TEST_F(DeadlineQueueTestSuite, test_pop_in_deadline_order)
+{
+    DeadlineQueueEntry entries[5];
+    memset(entries, 0, sizeof(entries));
+    const uint64_t deadlines[5] = { 50, 10, 40, 20, 30 };
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(0, DeadlineQueue_Schedule(&queue_, &entries[i], deadlines[i]));
+    }
+    EXPECT_EQ(5u, DeadlineQueue_Count(&queue_));
+    EXPECT_EQ(5, DeadlineQueue_GetTimeout(&queue_, 5));
+    EXPECT_TRUE(NULL == DeadlineQueue_PopExpired(&queue_, 9));
+
+    EXPECT_EQ(&entries[1], DeadlineQueue_PopExpired(&queue_, 25));
+    EXPECT_EQ(&entries[3], DeadlineQueue_PopExpired(&queue_, 25));
+    EXPECT_TRUE(NULL == DeadlineQueue_PopExpired(&queue_, 25));
+    EXPECT_FALSE(DeadlineQueue_IsScheduled(&entries[1]));
+    EXPECT_TRUE(DeadlineQueue_IsScheduled(&entries[4]));
+    EXPECT_EQ(0, DeadlineQueue_GetTimeout(&queue_, 35));
+}
+
+TEST_F(DeadlineQueueTestSuite, test_reschedule_and_cancel)
+{
+    DeadlineQueueEntry a, b, c;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    memset(&c, 0, sizeof(c));
+    DeadlineQueue_Schedule(&queue_, &a, 10);
+    DeadlineQueue_Schedule(&queue_, &b, 20);
+    DeadlineQueue_Schedule(&queue_, &c, 30);
+
+    // push the earliest entry to the back
+    DeadlineQueue_Schedule(&queue_, &a, 40);
+    EXPECT_EQ(3u, DeadlineQueue_Count(&queue_));
+    EXPECT_EQ(&b, DeadlineQueue_Peek(&queue_));
+
+    // bring the latest entry to the front
+    DeadlineQueue_Schedule(&queue_, &a, 5);
+    EXPECT_EQ(&a, DeadlineQueue_Peek(&queue_));
+
+    DeadlineQueue_Cancel(&queue_, &a);
+    DeadlineQueue_Cancel(&queue_, &a);
+    EXPECT_EQ(2u, DeadlineQueue_Count(&queue_));
+    EXPECT_EQ(&b, DeadlineQueue_Peek(&queue_));
+}
+
+TEST_F(DeadlineQueueTestSuite, test_random_operations_keep_order)
+{
+    const int count = 1000;
+    DeadlineQueueEntry * entries = new DeadlineQueueEntry[count];
+    memset(entries, 0, sizeof(DeadlineQueueEntry) * count);
+    srand(1);
+    for (int i = 0; i < count; i++)
+    {
+        DeadlineQueue_Schedule(&queue_, &entries[i], rand() % 10000);
+    }
+    for (int i = 0; i < count; i += 3)
+    {
+        DeadlineQueue_Cancel(&queue_, &entries[i]);
+    }
+    for (int i = 1; i < count; i += 3)
+    {
+        DeadlineQueue_Schedule(&queue_, &entries[i], rand() % 10000);
+    }
+
+    uint64_t previous = 0;
+    size_t popped = 0;
+    DeadlineQueueEntry * entry;
+    while ((entry = DeadlineQueue_PopExpired(&queue_, UINT64_MAX)) != NULL)
+    {
+        EXPECT_LE(previous, entry->Deadline);
+        previous = entry->Deadline;
+        popped++;
+    }
+    EXPECT_EQ(static_cast<size_t>(count - (count + 2) / 3), popped);
+    delete[] entries;
+}
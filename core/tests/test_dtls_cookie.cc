@@ -0,0 +1,218 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include "dtls_cookie.h"
+
+// Each call returns a different secret
+static int TestRandom(uint8_t * buffer, size_t length)
+{
+    static uint8_t next = 0;
+    next++;
+    memset(buffer, next, length);
+    return 0;
+}
+
+class DtlsCookieTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(0, DTLS_CookieVerifier_Init(&verifier_, TestRandom));
+        const char * uri = "coaps://127.0.0.1:15683";
+        address_ = NetworkAddress_New(uri, strlen(uri));
+        ASSERT_TRUE(NULL != address_);
+        uri = "coaps://127.0.0.1:15684";
+        otherAddress_ = NetworkAddress_New(uri, strlen(uri));
+        ASSERT_TRUE(NULL != otherAddress_);
+    }
+    void TearDown()
+    {
+        DTLS_CookieVerifier_Destroy(&verifier_);
+        NetworkAddress_Free(&address_);
+        NetworkAddress_Free(&otherAddress_);
+    }
+
+    // Build a ClientHello with record sequence number 1 and message sequence number messageSequence
+    size_t WriteClientHello(uint8_t * datagram, uint16_t messageSequence, const uint8_t * cookie, size_t cookieLength)
+    {
+        const uint8_t tail[] = { 0, 2, 0xC0, 0xA8, 1, 0 };      // one cipher suite, no compression
+        size_t bodyLength = 2 + 32 + 1 + 1 + cookieLength + sizeof(tail);
+        uint8_t * handshake = datagram + 13;
+        uint8_t * body = handshake + 12;
+
+        const uint8_t record[] = { 22, 254, 253, 0, 0, 0, 0, 0, 0, 0, 1 };
+        memcpy(datagram, record, sizeof(record));
+        datagram[11] = (12 + bodyLength) >> 8;
+        datagram[12] = (12 + bodyLength) & 0xFF;
+
+        handshake[0] = 1;
+        handshake[1] = 0;
+        handshake[2] = bodyLength >> 8;
+        handshake[3] = bodyLength & 0xFF;
+        handshake[4] = messageSequence >> 8;
+        handshake[5] = messageSequence & 0xFF;
+        memset(&handshake[6], 0, 3);
+        memcpy(&handshake[9], &handshake[1], 3);
+
+        body[0] = 254;
+        body[1] = 253;
+        memset(&body[2], 0xAB, 32);
+        body[34] = 0;
+        body[35] = cookieLength;
+        memcpy(&body[36], cookie, cookieLength);
+        memcpy(&body[36 + cookieLength], tail, sizeof(tail));
+        return 13 + 12 + bodyLength;
+    }
+
+    DTLS_CookieResult Check(NetworkAddress * address, const uint8_t * cookie, size_t cookieLength, uint64_t now)
+    {
+        uint8_t datagram[256];
+        size_t length = WriteClientHello(datagram, cookieLength > 0 ? 1 : 0, cookie, cookieLength);
+        responseLength_ = 0;
+        return DTLS_CookieVerifier_CheckClientHello(&verifier_, address, datagram, length, &hello_,
+                response_, sizeof(response_), &responseLength_, now);
+    }
+
+    // The cookie in the last HelloVerifyRequest
+    const uint8_t * Cookie() { return &response_[13 + 12 + 3]; }
+
+    DTLS_CookieVerifier verifier_;
+    NetworkAddress * address_;
+    NetworkAddress * otherAddress_;
+    DTLS_ClientHello hello_;
+    uint8_t response_[DTLS_HELLO_VERIFY_REQUEST_LENGTH];
+    size_t responseLength_;
+};
+
+TEST_F(DtlsCookieTestSuite, test_client_hello_without_cookie_gets_hello_verify_request)
+{
+    ASSERT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, NULL, 0, 0));
+    ASSERT_EQ((size_t)DTLS_HELLO_VERIFY_REQUEST_LENGTH, responseLength_);
+
+    // handshake record with the sequence number of the ClientHello, then a hello_verify_request with the cookie
+    EXPECT_EQ(22, response_[0]);
+    EXPECT_EQ(1, response_[10]);
+    EXPECT_EQ(3, response_[13]);
+    EXPECT_EQ(DTLS_COOKIE_LENGTH, response_[13 + 12 + 2]);
+
+    DTLS_CookieStatistics statistics;
+    DTLS_CookieVerifier_GetStatistics(&verifier_, &statistics);
+    EXPECT_EQ(1u, statistics.HelloVerifySent);
+    EXPECT_EQ(0u, statistics.Verified);
+}
+
+TEST_F(DtlsCookieTestSuite, test_returned_cookie_is_verified)
+{
+    uint8_t cookie[DTLS_COOKIE_LENGTH];
+    ASSERT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, NULL, 0, 0));
+    memcpy(cookie, Cookie(), sizeof(cookie));
+
+    ASSERT_EQ(DTLS_CookieResult_Verified, Check(address_, cookie, sizeof(cookie), 100));
+    EXPECT_EQ(0u, responseLength_);
+    EXPECT_EQ(1u, hello_.RecordSequence);
+    EXPECT_EQ(1u, hello_.MessageSequence);
+
+    DTLS_CookieStatistics statistics;
+    DTLS_CookieVerifier_GetStatistics(&verifier_, &statistics);
+    EXPECT_EQ(1u, statistics.Verified);
+}
+
+TEST_F(DtlsCookieTestSuite, test_wrong_cookie_or_address_is_rejected)
+{
+    uint8_t cookie[DTLS_COOKIE_LENGTH];
+    ASSERT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, NULL, 0, 0));
+    memcpy(cookie, Cookie(), sizeof(cookie));
+
+    // a cookie is only valid from the address it was sent to
+    EXPECT_EQ(DTLS_CookieResult_HelloVerify, Check(otherAddress_, cookie, sizeof(cookie), 0));
+
+    cookie[0] ^= 1;
+    EXPECT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, cookie, sizeof(cookie), 0));
+    EXPECT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, cookie, sizeof(cookie) - 1, 0));
+
+    DTLS_CookieStatistics statistics;
+    DTLS_CookieVerifier_GetStatistics(&verifier_, &statistics);
+    EXPECT_EQ(3u, statistics.Invalid);
+    EXPECT_EQ(4u, statistics.HelloVerifySent);
+    EXPECT_EQ(0u, statistics.Verified);
+}
+
+TEST_F(DtlsCookieTestSuite, test_cookie_is_valid_for_one_secret_rotation)
+{
+    uint8_t cookie[DTLS_COOKIE_LENGTH];
+    DTLS_CookieVerifier_SetSecretLifetime(&verifier_, 1000);
+    ASSERT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, NULL, 0, 0));
+    memcpy(cookie, Cookie(), sizeof(cookie));
+
+    // made with the previous secret
+    EXPECT_EQ(DTLS_CookieResult_Verified, Check(address_, cookie, sizeof(cookie), 1500));
+
+    // the secret it was made with has been replaced twice
+    EXPECT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, cookie, sizeof(cookie), 2500));
+
+    DTLS_CookieStatistics statistics;
+    DTLS_CookieVerifier_GetStatistics(&verifier_, &statistics);
+    EXPECT_EQ(2u, statistics.Rotations);
+}
+
+TEST_F(DtlsCookieTestSuite, test_previous_secret_expires_when_idle)
+{
+    uint8_t cookie[DTLS_COOKIE_LENGTH];
+    DTLS_CookieVerifier_SetSecretLifetime(&verifier_, 1000);
+    ASSERT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, NULL, 0, 0));
+    memcpy(cookie, Cookie(), sizeof(cookie));
+
+    // rotated only once, but the cookie is older than two lifetimes
+    EXPECT_EQ(DTLS_CookieResult_HelloVerify, Check(address_, cookie, sizeof(cookie), 2500));
+}
+
+TEST_F(DtlsCookieTestSuite, test_datagrams_other_than_client_hello_are_dropped)
+{
+    uint8_t datagram[256];
+    size_t length = WriteClientHello(datagram, 0, NULL, 0);
+
+    // application data
+    datagram[0] = 23;
+    EXPECT_EQ(DTLS_CookieResult_Drop, DTLS_CookieVerifier_CheckClientHello(&verifier_, address_, datagram, length, &hello_,
+            response_, sizeof(response_), &responseLength_, 0));
+
+    // a later epoch
+    datagram[0] = 22;
+    datagram[4] = 1;
+    EXPECT_EQ(DTLS_CookieResult_Drop, DTLS_CookieVerifier_CheckClientHello(&verifier_, address_, datagram, length, &hello_,
+            response_, sizeof(response_), &responseLength_, 0));
+
+    // truncated
+    datagram[4] = 0;
+    EXPECT_EQ(DTLS_CookieResult_Drop, DTLS_CookieVerifier_CheckClientHello(&verifier_, address_, datagram, 40, &hello_,
+            response_, sizeof(response_), &responseLength_, 0));
+
+    EXPECT_EQ(DTLS_CookieResult_HelloVerify, DTLS_CookieVerifier_CheckClientHello(&verifier_, address_, datagram, length, &hello_,
+            response_, sizeof(response_), &responseLength_, 0));
+
+    DTLS_CookieStatistics statistics;
+    DTLS_CookieVerifier_GetStatistics(&verifier_, &statistics);
+    EXPECT_EQ(3u, statistics.Dropped);
+}
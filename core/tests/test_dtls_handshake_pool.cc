@@ -0,0 +1,433 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <vector>
+#include <string>
+#include "dtls_handshake_pool.h"
+#include "dtls_abstraction.h"
+
+// Job that records the datagrams it is stepped through, and completes on "done" or fails on "fail"
+struct TestJob
+{
+    DTLS_HandshakeJob Job;
+    std::vector<std::string> Steps;
+    bool OnWorker;
+    bool Block;
+};
+
+static pthread_mutex_t blockLock = PTHREAD_MUTEX_INITIALIZER;
+
+static DTLS_HandshakeResult TestStep(DTLS_HandshakeJob * job, uint8_t * datagram, size_t length)
+{
+    TestJob * testJob = (TestJob *)((char *)job - offsetof(TestJob, Job));
+    std::string step((const char *)datagram, length);
+    testJob->OnWorker = DTLS_HandshakePool_IsWorker();
+    if (testJob->Block)
+    {
+        // held by the test, to submit datagrams while the job runs
+        pthread_mutex_lock(&blockLock);
+        pthread_mutex_unlock(&blockLock);
+    }
+    testJob->Steps.push_back(step);
+    if (step == "done")
+        return DTLS_HandshakeResult_Established;
+    if (step == "fail")
+        return DTLS_HandshakeResult_Failed;
+    return DTLS_HandshakeResult_InProgress;
+}
+
+class DtlsHandshakePoolTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        pool_ = DTLS_HandshakePool_New(2, TestStep);
+        ASSERT_TRUE(NULL != pool_);
+    }
+    void TearDown()
+    {
+        DTLS_HandshakePool_Free(&pool_);
+    }
+
+    void InitJob(TestJob * job)
+    {
+        DTLS_HandshakeJob_Init(&job->Job);
+        job->OnWorker = false;
+        job->Block = false;
+    }
+
+    int Submit(TestJob * job, const char * datagram)
+    {
+        return DTLS_HandshakePool_Submit(pool_, &job->Job, (const uint8_t *)datagram, strlen(datagram));
+    }
+
+    // Wait for the next completed job
+    DTLS_HandshakeJob * WaitCompleted()
+    {
+        DTLS_HandshakeJob * job = NULL;
+        int attempts;
+        for (attempts = 0; (job == NULL) && (attempts < 5000); attempts++)
+        {
+            job = DTLS_HandshakePool_TakeCompleted(pool_);
+            if (job == NULL)
+                usleep(1000);
+        }
+        return job;
+    }
+
+    DTLS_HandshakePool * pool_;
+};
+
+TEST_F(DtlsHandshakePoolTestSuite, test_new_requires_workers_and_step)
+{
+    EXPECT_TRUE(NULL == DTLS_HandshakePool_New(0, TestStep));
+    EXPECT_TRUE(NULL == DTLS_HandshakePool_New(1, NULL));
+    EXPECT_TRUE(NULL == DTLS_HandshakePool_TakeCompleted(pool_));
+    EXPECT_FALSE(DTLS_HandshakePool_IsWorker());
+}
+
+TEST_F(DtlsHandshakePoolTestSuite, test_job_steps_through_datagrams_in_order_on_a_worker)
+{
+    TestJob job;
+    InitJob(&job);
+    EXPECT_FALSE(DTLS_HandshakeJob_IsActive(&job.Job));
+
+    ASSERT_EQ(0, Submit(&job, "hello"));
+    ASSERT_EQ(0, Submit(&job, "key"));
+    ASSERT_EQ(0, DTLS_HandshakePool_Submit(pool_, &job.Job, NULL, 0));
+    ASSERT_EQ(0, Submit(&job, "done"));
+    EXPECT_TRUE(DTLS_HandshakeJob_IsActive(&job.Job));
+
+    ASSERT_EQ(&job.Job, WaitCompleted());
+    EXPECT_FALSE(DTLS_HandshakeJob_IsActive(&job.Job));
+    EXPECT_EQ(DTLS_HandshakeResult_Established, job.Job.Result);
+    EXPECT_TRUE(job.OnWorker);
+    ASSERT_EQ(4u, job.Steps.size());
+    EXPECT_EQ("hello", job.Steps[0]);
+    EXPECT_EQ("key", job.Steps[1]);
+    EXPECT_EQ("", job.Steps[2]);
+    EXPECT_EQ("done", job.Steps[3]);
+
+    DTLS_HandshakePoolStatistics statistics;
+    DTLS_HandshakePool_GetStatistics(pool_, &statistics);
+    EXPECT_EQ(2u, statistics.Workers);
+    EXPECT_EQ(0u, statistics.Pending);
+    EXPECT_EQ(4u, statistics.Submitted);
+    EXPECT_EQ(1u, statistics.Established);
+    EXPECT_EQ(0u, statistics.Failed);
+}
+
+TEST_F(DtlsHandshakePoolTestSuite, test_failed_job_drops_later_datagrams)
+{
+    TestJob job;
+    InitJob(&job);
+    ASSERT_EQ(0, Submit(&job, "fail"));
+    ASSERT_EQ(&job.Job, WaitCompleted());
+    EXPECT_EQ(DTLS_HandshakeResult_Failed, job.Job.Result);
+
+    DTLS_HandshakePoolStatistics statistics;
+    DTLS_HandshakePool_GetStatistics(pool_, &statistics);
+    EXPECT_EQ(1u, statistics.Failed);
+}
+
+TEST_F(DtlsHandshakePoolTestSuite, test_datagrams_submitted_while_running_run_next)
+{
+    TestJob job;
+    InitJob(&job);
+    job.Block = true;
+
+    pthread_mutex_lock(&blockLock);
+    ASSERT_EQ(0, Submit(&job, "hello"));
+    while (job.Job.State != DTLS_HandshakeJobState_Running)
+        usleep(1000);
+
+    // too many queued datagrams are dropped
+    int i;
+    for (i = 0; i < DTLS_HANDSHAKE_MAX_QUEUED_DATAGRAMS - 1; i++)
+    {
+        ASSERT_EQ(0, Submit(&job, "retransmission"));
+    }
+    ASSERT_EQ(0, Submit(&job, "done"));
+    EXPECT_EQ(-1, Submit(&job, "dropped"));
+    pthread_mutex_unlock(&blockLock);
+
+    ASSERT_EQ(&job.Job, WaitCompleted());
+    EXPECT_EQ(DTLS_HandshakeResult_Established, job.Job.Result);
+    ASSERT_EQ(1u + DTLS_HANDSHAKE_MAX_QUEUED_DATAGRAMS, job.Steps.size());
+    EXPECT_EQ("done", job.Steps.back());
+
+    DTLS_HandshakePoolStatistics statistics;
+    DTLS_HandshakePool_GetStatistics(pool_, &statistics);
+    EXPECT_EQ(1u, statistics.Dropped);
+}
+
+TEST_F(DtlsHandshakePoolTestSuite, test_completed_job_takes_no_datagrams_until_taken)
+{
+    TestJob job;
+    InitJob(&job);
+    ASSERT_EQ(0, Submit(&job, "done"));
+    while (job.Job.State != DTLS_HandshakeJobState_Completed)
+        usleep(1000);
+    EXPECT_EQ(-1, Submit(&job, "late"));
+    ASSERT_EQ(&job.Job, WaitCompleted());
+
+    // once taken back, the job can run again
+    ASSERT_EQ(0, Submit(&job, "done"));
+    ASSERT_EQ(&job.Job, WaitCompleted());
+    EXPECT_EQ(2u, job.Steps.size());
+}
+
+TEST_F(DtlsHandshakePoolTestSuite, test_cancel_waits_for_running_job)
+{
+    TestJob job;
+    InitJob(&job);
+    job.Block = true;
+
+    pthread_mutex_lock(&blockLock);
+    ASSERT_EQ(0, Submit(&job, "hello"));
+    while (job.Job.State != DTLS_HandshakeJobState_Running)
+        usleep(1000);
+    ASSERT_EQ(0, Submit(&job, "done"));
+    pthread_mutex_unlock(&blockLock);
+
+    // the job may have run again before it is cancelled, but is never left completed
+    DTLS_HandshakePool_Cancel(pool_, &job.Job);
+    EXPECT_EQ(DTLS_HandshakeJobState_Idle, job.Job.State);
+    EXPECT_LE(1u, job.Steps.size());
+    EXPECT_TRUE(NULL == DTLS_HandshakePool_TakeCompleted(pool_));
+
+    // cancelling completed and idle jobs
+    ASSERT_EQ(0, Submit(&job, "done"));
+    while (job.Job.State != DTLS_HandshakeJobState_Completed)
+        usleep(1000);
+    DTLS_HandshakePool_Cancel(pool_, &job.Job);
+    DTLS_HandshakePool_Cancel(pool_, &job.Job);
+    EXPECT_TRUE(NULL == DTLS_HandshakePool_TakeCompleted(pool_));
+}
+
+TEST_F(DtlsHandshakePoolTestSuite, test_free_returns_jobs_to_idle)
+{
+    TestJob running, queued, completed;
+    InitJob(&running);
+    InitJob(&queued);
+    InitJob(&completed);
+
+    ASSERT_EQ(0, Submit(&completed, "done"));
+    while (completed.Job.State != DTLS_HandshakeJobState_Completed)
+        usleep(1000);
+
+    // hold both workers, so the third job stays queued
+    TestJob blocker;
+    InitJob(&blocker);
+    blocker.Block = true;
+    running.Block = true;
+    pthread_mutex_lock(&blockLock);
+    ASSERT_EQ(0, Submit(&running, "hello"));
+    ASSERT_EQ(0, Submit(&blocker, "hello"));
+    while ((running.Job.State != DTLS_HandshakeJobState_Running) || (blocker.Job.State != DTLS_HandshakeJobState_Running))
+        usleep(1000);
+    ASSERT_EQ(0, Submit(&queued, "hello"));
+    pthread_mutex_unlock(&blockLock);
+
+    DTLS_HandshakePool_Free(&pool_);
+    EXPECT_TRUE(NULL == pool_);
+    EXPECT_FALSE(DTLS_HandshakeJob_IsActive(&running.Job));
+    EXPECT_FALSE(DTLS_HandshakeJob_IsActive(&queued.Job));
+    EXPECT_FALSE(DTLS_HandshakeJob_IsActive(&completed.Job));
+    EXPECT_FALSE(DTLS_HandshakeJob_IsActive(&blocker.Job));
+}
+
+// Handshakes through the DTLS library the tree is built with, with the server end on handshake workers
+#define BACKEND_PAIRS           (4)
+#define BACKEND_CLIENT_PORT     (21000)
+#define BACKEND_SERVER_PORT     (41000)
+#define BACKEND_MAX_TRIES       (8)
+
+struct BackendDatagram
+{
+    NetworkAddress * Destination;
+    std::string Data;
+};
+
+static pthread_mutex_t backendLock = PTHREAD_MUTEX_INITIALIZER;
+static std::vector<BackendDatagram> backendQueue;
+static NetworkAddress * backendClients[BACKEND_PAIRS];
+static NetworkAddress * backendServers[BACKEND_PAIRS];
+
+static NetworkTransmissionError BackendSend(NetworkAddress * destAddress, const uint8_t * buffer, int bufferLength, void * context)
+{
+    // the server end sends from the workers
+    pthread_mutex_lock(&backendLock);
+    backendQueue.push_back({ destAddress, std::string((const char *)buffer, bufferLength) });
+    pthread_mutex_unlock(&backendLock);
+    return NetworkTransmissionError_None;
+}
+
+// Deliver datagrams between the ends until neither has anything to send and the workers are idle
+static void BackendPump(void)
+{
+    for (;;)
+    {
+        std::vector<BackendDatagram> datagrams;
+        DTLS_HandshakePoolStatistics statistics;
+        pthread_mutex_lock(&backendLock);
+        datagrams.swap(backendQueue);
+        pthread_mutex_unlock(&backendLock);
+        DTLS_GetHandshakeStatistics(&statistics);
+        if (datagrams.empty() && (statistics.Pending == 0))
+            break;
+        if (datagrams.empty())
+            usleep(1000);
+
+        for (size_t i = 0; i < datagrams.size(); i++)
+        {
+            uint8_t plainText[1500];
+            int plainTextLength = 0;
+            for (int pair = 0; pair < BACKEND_PAIRS; pair++)
+            {
+                NetworkAddress * source = NULL;
+                if (NetworkAddress_Compare(datagrams[i].Destination, backendServers[pair]) == 0)
+                    source = backendClients[pair];
+                else if (NetworkAddress_Compare(datagrams[i].Destination, backendClients[pair]) == 0)
+                    source = backendServers[pair];
+                if (source)
+                {
+                    DTLS_Decrypt(source, (uint8_t *)&datagrams[i].Data[0], datagrams[i].Data.size(), plainText, sizeof(plainText), &plainTextLength, NULL);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Send each server a record from its client until all have been received, returning the number that were
+static int BackendHandshakeAll(void)
+{
+    bool established[BACKEND_PAIRS] = { false };
+    int result = 0;
+    for (int tries = 0; (tries < BACKEND_MAX_TRIES) && (result < BACKEND_PAIRS); tries++)
+    {
+        for (int pair = 0; pair < BACKEND_PAIRS; pair++)
+        {
+            uint8_t plainText[16] = "ping";
+            uint8_t record[sizeof(plainText) + DTLS_MAX_RECORD_OVERHEAD];
+            int recordLength = 0;
+            int plainTextLength = 0;
+            if (!established[pair] && DTLS_Encrypt(backendServers[pair], plainText, 4, record, sizeof(record), &recordLength, NULL) &&
+                DTLS_Decrypt(backendClients[pair], record, recordLength, plainText, sizeof(plainText), &plainTextLength, NULL) &&
+                (plainTextLength == 4) && (memcmp(plainText, "ping", 4) == 0))
+            {
+                established[pair] = true;
+                result++;
+            }
+        }
+        BackendPump();
+    }
+    return result;
+}
+
+// Exit codes for the child process the handshakes run in, as the library credentials cannot be unset
+enum
+{
+    BackendResult_Passed,
+    BackendResult_FullHandshakesFailed,
+    BackendResult_NotOnWorkers,
+    BackendResult_ResumedHandshakesFailed,
+};
+
+static int RunBackendHandshakes(void)
+{
+    const uint8_t key[] = { 0x74, 0x65, 0x73, 0x74, 0x2d, 0x6b, 0x65, 0x79 };
+    DTLS_HandshakePoolStatistics statistics;
+    char uri[64];
+    int result = BackendResult_Passed;
+
+    for (int pair = 0; pair < BACKEND_PAIRS; pair++)
+    {
+        snprintf(uri, sizeof(uri), "coaps://127.0.0.1:%d", BACKEND_CLIENT_PORT + pair);
+        backendClients[pair] = NetworkAddress_New(uri, strlen(uri));
+        snprintf(uri, sizeof(uri), "coaps://127.0.0.1:%d", BACKEND_SERVER_PORT + pair);
+        backendServers[pair] = NetworkAddress_New(uri, strlen(uri));
+    }
+
+    DTLS_Init();
+    DTLS_SetNetworkSendCallback(BackendSend);
+    DTLS_SetPSK("test-identity", key, sizeof(key));
+    // one entry, so server sessions stored on the workers push out client sessions
+    DTLS_SetResumptionLimits(1, 0);
+    if (DTLS_SetHandshakeWorkers(2) != 0)
+    {
+        printf("%s does not support handshake workers, skipping\n", DTLS_LibraryName);
+    }
+    else if (BackendHandshakeAll() != BACKEND_PAIRS)
+    {
+        result = BackendResult_FullHandshakesFailed;
+    }
+    else
+    {
+        DTLS_GetHandshakeStatistics(&statistics);
+        if (statistics.Established != BACKEND_PAIRS)
+        {
+            result = BackendResult_NotOnWorkers;
+        }
+        else
+        {
+            for (int pair = 0; pair < BACKEND_PAIRS; pair++)
+            {
+                DTLS_Reset(backendServers[pair]);
+                DTLS_Reset(backendClients[pair]);
+            }
+            if (BackendHandshakeAll() != BACKEND_PAIRS)
+            {
+                result = BackendResult_ResumedHandshakesFailed;
+            }
+        }
+    }
+
+    for (int pair = 0; pair < BACKEND_PAIRS; pair++)
+    {
+        DTLS_Reset(backendServers[pair]);
+        DTLS_Reset(backendClients[pair]);
+    }
+    DTLS_Shutdown();
+    for (int pair = 0; pair < BACKEND_PAIRS; pair++)
+    {
+        NetworkAddress_Free(&backendClients[pair]);
+        NetworkAddress_Free(&backendServers[pair]);
+    }
+    return result;
+}
+
+TEST(DtlsHandshakeWorkersTestSuite, test_backend_handshakes_on_workers)
+{
+    if (strcmp(DTLS_LibraryName, "None") == 0)
+    {
+        printf("Built without a DTLS library, skipping\n");
+        return;
+    }
+    EXPECT_EXIT(exit(RunBackendHandshakes()), ::testing::ExitedWithCode(BackendResult_Passed), "");
+}
+
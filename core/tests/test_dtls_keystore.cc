@@ -0,0 +1,235 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "dtls_keystore.h"
+
+class DtlsKeyStoreTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        strcpy(path_, "/tmp/test_dtls_keystore_XXXXXX");
+        int fd = mkstemp(path_);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        store_ = NULL;
+    }
+    void TearDown()
+    {
+        DTLS_KeyStore_Free(&store_);
+        unlink(path_);
+    }
+
+    void WriteKeyFile(const char * contents)
+    {
+        FILE * file = fopen(path_, "w");
+        ASSERT_TRUE(NULL != file);
+        fputs(contents, file);
+        fclose(file);
+    }
+
+    // Length of the key of identity, or -1, with the key in key_
+    int Lookup(const char * identity)
+    {
+        memset(key_, 0, sizeof(key_));
+        return DTLS_KeyStore_Lookup(store_, identity, strlen(identity), key_, sizeof(key_));
+    }
+
+    char path_[64];
+    DTLS_KeyStore * store_;
+    uint8_t key_[DTLS_KEYSTORE_MAX_KEY_LENGTH];
+};
+
+static const char * sortedKeys =
+    "# identity  key\n"
+    "client1     0102\n"
+    "client10    0A0B0C\n"
+    "\n"
+    "client2     ff\n"
+    "# last\n"
+    "client3\tDEADBEEF";
+
+TEST_F(DtlsKeyStoreTestSuite, test_memory_store_add_and_lookup)
+{
+    const uint8_t key[] = { 1, 2, 3 };
+    const uint8_t newKey[] = { 4, 5 };
+    store_ = DTLS_KeyStore_NewMemory();
+    ASSERT_TRUE(NULL != store_);
+
+    EXPECT_EQ(-1, Lookup("client1"));
+    ASSERT_EQ(0, DTLS_KeyStore_Add(store_, "client1", 7, key, sizeof(key)));
+    ASSERT_EQ(3, Lookup("client1"));
+    EXPECT_EQ(0, memcmp(key_, key, sizeof(key)));
+    EXPECT_EQ(-1, Lookup("client"));
+    EXPECT_EQ(-1, Lookup("client12"));
+
+    // adding again replaces the key
+    ASSERT_EQ(0, DTLS_KeyStore_Add(store_, "client1", 7, newKey, sizeof(newKey)));
+    ASSERT_EQ(2, Lookup("client1"));
+    EXPECT_EQ(0, memcmp(key_, newKey, sizeof(newKey)));
+    EXPECT_EQ(1u, DTLS_KeyStore_Count(store_));
+
+    // the key must fit the caller's buffer
+    uint8_t small[1];
+    EXPECT_EQ(-1, DTLS_KeyStore_Lookup(store_, "client1", 7, small, sizeof(small)));
+}
+
+TEST_F(DtlsKeyStoreTestSuite, test_load_key_file)
+{
+    WriteKeyFile("client2 ff\n"
+                 "client1 0102\n"
+                 "  # comment\n"
+                 "client3\tDEADBEEF\r\n");
+    store_ = DTLS_KeyStore_Load(path_);
+    ASSERT_TRUE(NULL != store_);
+    EXPECT_EQ(3u, DTLS_KeyStore_Count(store_));
+
+    ASSERT_EQ(2, Lookup("client1"));
+    EXPECT_EQ(0x02, key_[1]);
+    ASSERT_EQ(1, Lookup("client2"));
+    EXPECT_EQ(0xFF, key_[0]);
+    ASSERT_EQ(4, Lookup("client3"));
+    EXPECT_EQ(0xEF, key_[3]);
+    EXPECT_EQ(-1, Lookup("client4"));
+}
+
+TEST_F(DtlsKeyStoreTestSuite, test_map_sorted_key_file)
+{
+    WriteKeyFile(sortedKeys);
+    store_ = DTLS_KeyStore_Map(path_);
+    ASSERT_TRUE(NULL != store_);
+    EXPECT_EQ(4u, DTLS_KeyStore_Count(store_));
+
+    ASSERT_EQ(2, Lookup("client1"));
+    EXPECT_EQ(0x01, key_[0]);
+    ASSERT_EQ(3, Lookup("client10"));
+    EXPECT_EQ(0x0C, key_[2]);
+    ASSERT_EQ(1, Lookup("client2"));
+    EXPECT_EQ(0xFF, key_[0]);
+    ASSERT_EQ(4, Lookup("client3"));
+    EXPECT_EQ(0xDE, key_[0]);
+
+    EXPECT_EQ(-1, Lookup("client"));
+    EXPECT_EQ(-1, Lookup("client0"));
+    EXPECT_EQ(-1, Lookup("client11"));
+    EXPECT_EQ(-1, Lookup("client4"));
+    EXPECT_EQ(-1, Lookup("#"));
+}
+
+TEST_F(DtlsKeyStoreTestSuite, test_map_many_keys)
+{
+    FILE * file = fopen(path_, "w");
+    ASSERT_TRUE(NULL != file);
+    int i;
+    for (i = 0; i < 1000; i++)
+    {
+        fprintf(file, "device%04d %04X\n", i * 2, i);
+    }
+    fclose(file);
+
+    store_ = DTLS_KeyStore_Map(path_);
+    ASSERT_TRUE(NULL != store_);
+    for (i = 0; i < 1000; i++)
+    {
+        char identity[32];
+        sprintf(identity, "device%04d", i * 2);
+        ASSERT_EQ(2, Lookup(identity)) << identity;
+        EXPECT_EQ(i, (key_[0] << 8) | key_[1]);
+        sprintf(identity, "device%04d", i * 2 + 1);
+        EXPECT_EQ(-1, Lookup(identity)) << identity;
+    }
+}
+
+TEST_F(DtlsKeyStoreTestSuite, test_open_maps_sorted_and_loads_unsorted_files)
+{
+    WriteKeyFile("client2 ff\nclient1 0102\n");
+    EXPECT_TRUE(NULL == DTLS_KeyStore_Map(path_));
+
+    store_ = DTLS_KeyStore_Open(path_);
+    ASSERT_TRUE(NULL != store_);
+    EXPECT_EQ(2, Lookup("client1"));
+    EXPECT_EQ(1, Lookup("client2"));
+    DTLS_KeyStore_Free(&store_);
+
+    // duplicates are only allowed when loading, where the last key wins
+    WriteKeyFile("client1 0102\nclient1 03\n");
+    EXPECT_TRUE(NULL == DTLS_KeyStore_Map(path_));
+    store_ = DTLS_KeyStore_Open(path_);
+    ASSERT_TRUE(NULL != store_);
+    EXPECT_EQ(1, Lookup("client1"));
+    EXPECT_EQ(0x03, key_[0]);
+}
+
+TEST_F(DtlsKeyStoreTestSuite, test_invalid_key_files_are_rejected)
+{
+    const char * invalid[] = {
+        "client1\n",                    // no key
+        "client1 012\n",                // odd number of digits
+        "client1 01XY\n",               // not hex
+        "client1 0102 extra\n",         // trailing field
+    };
+    size_t i;
+    for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        WriteKeyFile(invalid[i]);
+        EXPECT_TRUE(NULL == DTLS_KeyStore_Load(path_)) << invalid[i];
+        EXPECT_TRUE(NULL == DTLS_KeyStore_Map(path_)) << invalid[i];
+        EXPECT_TRUE(NULL == DTLS_KeyStore_Open(path_)) << invalid[i];
+    }
+    EXPECT_TRUE(NULL == DTLS_KeyStore_Load("/nonexistent/keys"));
+}
+
+static int LookupFixedKey(void * context, const char * identity, size_t identityLength, uint8_t * key, size_t keySize)
+{
+    (void)keySize;
+    if ((identityLength != 6) || (memcmp(identity, "custom", 6) != 0))
+    {
+        return -1;
+    }
+    key[0] = *(uint8_t *)context;
+    return 1;
+}
+
+static void FreeFixedKey(void * context)
+{
+    *(uint8_t *)context = 0;
+}
+
+TEST_F(DtlsKeyStoreTestSuite, test_custom_store)
+{
+    uint8_t fixedKey = 0x42;
+    store_ = DTLS_KeyStore_New(LookupFixedKey, FreeFixedKey, &fixedKey);
+    ASSERT_TRUE(NULL != store_);
+    ASSERT_EQ(1, Lookup("custom"));
+    EXPECT_EQ(0x42, key_[0]);
+    EXPECT_EQ(-1, Lookup("other"));
+    EXPECT_EQ(-1, DTLS_KeyStore_Add(store_, "other", 5, &fixedKey, 1));
+
+    DTLS_KeyStore_Free(&store_);
+    EXPECT_EQ(0, fixedKey);
+}
@@ -0,0 +1,148 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include "dtls_resumption_cache.h"
+
+class DtlsResumptionCacheTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(0, DTLS_ResumptionCache_Init(&cache_));
+        const char * uri = "coaps://127.0.0.1:15683";
+        address_ = NetworkAddress_New(uri, strlen(uri));
+        ASSERT_TRUE(NULL != address_);
+    }
+    void TearDown()
+    {
+        DTLS_ResumptionCache_Destroy(&cache_);
+        NetworkAddress_Free(&address_);
+    }
+
+    DTLS_ResumptionCache cache_;
+    NetworkAddress * address_;
+};
+
+TEST_F(DtlsResumptionCacheTestSuite, test_store_and_fetch_by_session_id)
+{
+    DTLS_ResumptionCacheStatistics statistics;
+    size_t stateLength = 0;
+    const uint8_t id[] = { 1, 2, 3, 4 };
+    const uint8_t otherId[] = { 1, 2, 3, 5 };
+
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_Fetch(&cache_, id, sizeof(id), &stateLength, 0));
+    ASSERT_EQ(0, DTLS_ResumptionCache_Store(&cache_, id, sizeof(id), (const uint8_t *)"state", 5, 0));
+
+    const uint8_t * state = DTLS_ResumptionCache_Fetch(&cache_, id, sizeof(id), &stateLength, 10);
+    ASSERT_TRUE(NULL != state);
+    ASSERT_EQ(5u, stateLength);
+    EXPECT_EQ(0, memcmp(state, "state", 5));
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_Fetch(&cache_, otherId, sizeof(otherId), &stateLength, 10));
+
+    // storing again replaces the state
+    ASSERT_EQ(0, DTLS_ResumptionCache_Store(&cache_, id, sizeof(id), (const uint8_t *)"newer", 5, 20));
+    state = DTLS_ResumptionCache_Fetch(&cache_, id, sizeof(id), &stateLength, 30);
+    ASSERT_TRUE(NULL != state);
+    EXPECT_EQ(0, memcmp(state, "newer", 5));
+
+    DTLS_ResumptionCache_Remove(&cache_, id, sizeof(id));
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_Fetch(&cache_, id, sizeof(id), &stateLength, 40));
+
+    DTLS_ResumptionCache_GetStatistics(&cache_, &statistics);
+    EXPECT_EQ(0u, statistics.Count);
+    EXPECT_EQ(2u, statistics.Hits);
+    EXPECT_EQ(3u, statistics.Misses);
+}
+
+TEST_F(DtlsResumptionCacheTestSuite, test_store_and_fetch_by_address)
+{
+    size_t stateLength = 0;
+    const char * uri = "coaps://127.0.0.1:15683";
+    NetworkAddress * sameAddress = NetworkAddress_New(uri, strlen(uri));
+    ASSERT_TRUE(NULL != sameAddress);
+
+    ASSERT_EQ(0, DTLS_ResumptionCache_StoreForAddress(&cache_, address_, (const uint8_t *)"client", 6, 0));
+    const uint8_t * state = DTLS_ResumptionCache_FetchForAddress(&cache_, sameAddress, &stateLength, 10);
+    ASSERT_TRUE(NULL != state);
+    ASSERT_EQ(6u, stateLength);
+    EXPECT_EQ(0, memcmp(state, "client", 6));
+
+    DTLS_ResumptionCache_RemoveForAddress(&cache_, address_);
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_FetchForAddress(&cache_, sameAddress, &stateLength, 20));
+    NetworkAddress_Free(&sameAddress);
+}
+
+TEST_F(DtlsResumptionCacheTestSuite, test_oldest_session_is_evicted)
+{
+    DTLS_ResumptionCacheStatistics statistics;
+    const uint8_t ids[3][2] = { { 0, 1 }, { 0, 2 }, { 0, 3 } };
+    DTLS_ResumptionCache_SetLimits(&cache_, 2, 0);
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(0, DTLS_ResumptionCache_Store(&cache_, ids[i], 2, (const uint8_t *)"s", 1, i));
+    }
+
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_Fetch(&cache_, ids[0], 2, NULL, 3));
+    EXPECT_TRUE(NULL != DTLS_ResumptionCache_Fetch(&cache_, ids[1], 2, NULL, 3));
+    EXPECT_TRUE(NULL != DTLS_ResumptionCache_Fetch(&cache_, ids[2], 2, NULL, 3));
+    DTLS_ResumptionCache_GetStatistics(&cache_, &statistics);
+    EXPECT_EQ(2u, statistics.Count);
+    EXPECT_EQ(1u, statistics.Evicted);
+}
+
+TEST_F(DtlsResumptionCacheTestSuite, test_sessions_expire_after_lifetime)
+{
+    DTLS_ResumptionCacheStatistics statistics;
+    const uint8_t id[] = { 9 };
+    DTLS_ResumptionCache_SetLimits(&cache_, 0, 100);
+    ASSERT_EQ(0, DTLS_ResumptionCache_Store(&cache_, id, sizeof(id), (const uint8_t *)"s", 1, 0));
+    ASSERT_EQ(0, DTLS_ResumptionCache_StoreForAddress(&cache_, address_, (const uint8_t *)"c", 1, 50));
+
+    EXPECT_TRUE(NULL != DTLS_ResumptionCache_Fetch(&cache_, id, sizeof(id), NULL, 99));
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_Fetch(&cache_, id, sizeof(id), NULL, 100));
+    EXPECT_TRUE(NULL != DTLS_ResumptionCache_FetchForAddress(&cache_, address_, NULL, 100));
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_FetchForAddress(&cache_, address_, NULL, 150));
+
+    DTLS_ResumptionCache_GetStatistics(&cache_, &statistics);
+    EXPECT_EQ(0u, statistics.Count);
+    EXPECT_EQ(2u, statistics.Expired);
+}
+
+TEST_F(DtlsResumptionCacheTestSuite, test_addresses_of_dropped_sessions_are_released_later)
+{
+    const uint8_t id[] = { 7 };
+    DTLS_ResumptionCache_SetLimits(&cache_, 1, 0);
+    ASSERT_EQ(0, DTLS_ResumptionCache_StoreForAddress(&cache_, address_, (const uint8_t *)"c", 1, 0));
+
+    // as a handshake worker would, evict the client session by storing a server session
+    ASSERT_EQ(0, DTLS_ResumptionCache_Store(&cache_, id, sizeof(id), (const uint8_t *)"s", 1, 10));
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_FetchForAddress(&cache_, address_, NULL, 20));
+    EXPECT_EQ(0, DTLS_ResumptionCache_Release(&cache_));
+
+    ASSERT_EQ(0, DTLS_ResumptionCache_StoreForAddress(&cache_, address_, (const uint8_t *)"c", 1, 30));
+    EXPECT_TRUE(NULL == DTLS_ResumptionCache_Fetch(&cache_, id, sizeof(id), NULL, 40));
+    ASSERT_EQ(0, DTLS_ResumptionCache_Store(&cache_, id, sizeof(id), (const uint8_t *)"s", 1, 50));
+    EXPECT_EQ(1, DTLS_ResumptionCache_Release(&cache_));
+    EXPECT_EQ(0, DTLS_ResumptionCache_Release(&cache_));
+}
@@ -0,0 +1,292 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include "dtls_session_table.h"
+
+typedef struct
+{
+    DTLS_SessionEntry Entry;
+    int Value;
+
+} TestSession;
+
+static int freedSessions;
+
+static void FreeTestSession(DTLS_SessionEntry * entry)
+{
+    (void)entry;
+    freedSessions++;
+}
+
+class DtlsSessionTableTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        freedSessions = 0;
+        ASSERT_EQ(0, DTLS_SessionTable_Init(&table_, sizeof(TestSession), 1000, FreeTestSession));
+        for (int i = 0; i < NUM_ADDRESSES; i++)
+        {
+            char uri[64];
+            sprintf(uri, "coaps://127.0.0.1:%d", 15000 + i);
+            addresses_[i] = NetworkAddress_New(uri, strlen(uri));
+            ASSERT_TRUE(NULL != addresses_[i]);
+        }
+    }
+    void TearDown()
+    {
+        DTLS_SessionTable_Destroy(&table_);
+        for (int i = 0; i < NUM_ADDRESSES; i++)
+        {
+            NetworkAddress_Free(&addresses_[i]);
+        }
+    }
+
+    static const int NUM_ADDRESSES = 4;
+    DTLS_SessionTable table_;
+    NetworkAddress * addresses_[NUM_ADDRESSES];
+};
+
+TEST_F(DtlsSessionTableTestSuite, test_new_and_get)
+{
+    DTLS_SessionTableStatistics statistics;
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[0], 0));
+
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&table_, addresses_[0], 0);
+    ASSERT_TRUE(NULL != entry);
+    TestSession * session = DTLS_SessionTableContainer(entry, TestSession, Entry);
+    EXPECT_EQ(0, session->Value);
+    EXPECT_EQ(0, NetworkAddress_Compare(addresses_[0], entry->NetworkAddress));
+
+    EXPECT_EQ(entry, DTLS_SessionTable_Get(&table_, addresses_[0], 10));
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[1], 10));
+
+    DTLS_SessionTable_GetStatistics(&table_, &statistics);
+    EXPECT_EQ(1u, statistics.Count);
+    EXPECT_EQ(sizeof(TestSession) + 1000, statistics.Memory);
+    EXPECT_EQ(1u, statistics.Hits);
+    EXPECT_EQ(2u, statistics.Misses);
+    EXPECT_EQ(1u, statistics.Created);
+
+    DTLS_SessionTable_Free(&table_, entry);
+    EXPECT_EQ(1, freedSessions);
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[0], 20));
+    DTLS_SessionTable_GetStatistics(&table_, &statistics);
+    EXPECT_EQ(0u, statistics.Count);
+    EXPECT_EQ(0u, statistics.Memory);
+}
+
+TEST_F(DtlsSessionTableTestSuite, test_least_recently_used_session_is_evicted)
+{
+    DTLS_SessionTableStatistics statistics;
+    DTLS_SessionTable_SetLimits(&table_, 2, 0, 0);
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[0], 0));
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[1], 1));
+
+    // using the first session makes the second the least recently used
+    ASSERT_TRUE(NULL != DTLS_SessionTable_Get(&table_, addresses_[0], 2));
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[2], 3));
+
+    EXPECT_EQ(1, freedSessions);
+    EXPECT_TRUE(NULL != DTLS_SessionTable_Get(&table_, addresses_[0], 4));
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[1], 4));
+    EXPECT_TRUE(NULL != DTLS_SessionTable_Get(&table_, addresses_[2], 4));
+    DTLS_SessionTable_GetStatistics(&table_, &statistics);
+    EXPECT_EQ(2u, statistics.Count);
+    EXPECT_EQ(1u, statistics.Evicted);
+}
+
+TEST_F(DtlsSessionTableTestSuite, test_idle_sessions_expire)
+{
+    DTLS_SessionTableStatistics statistics;
+    DTLS_SessionTable_SetLimits(&table_, 0, 0, 100);
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[0], 0));
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[1], 50));
+
+    EXPECT_TRUE(NULL != DTLS_SessionTable_Get(&table_, addresses_[0], 99));
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[1], 150));
+    EXPECT_TRUE(NULL != DTLS_SessionTable_Get(&table_, addresses_[0], 150));
+
+    DTLS_SessionTable_GetStatistics(&table_, &statistics);
+    EXPECT_EQ(1u, statistics.Count);
+    EXPECT_EQ(1u, statistics.Expired);
+    EXPECT_EQ(1, freedSessions);
+}
+
+TEST_F(DtlsSessionTableTestSuite, test_memory_limit)
+{
+    DTLS_SessionTableStatistics statistics;
+    size_t sessionMemory = sizeof(TestSession) + 1000;
+
+    // a session that can never fit is rejected
+    DTLS_SessionTable_SetLimits(&table_, 0, sessionMemory - 1, 0);
+    EXPECT_TRUE(NULL == DTLS_SessionTable_New(&table_, addresses_[0], 0));
+
+    DTLS_SessionTable_SetLimits(&table_, 0, 2 * sessionMemory, 0);
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[0], 1));
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[1], 2));
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[2], 3));
+
+    DTLS_SessionTable_GetStatistics(&table_, &statistics);
+    EXPECT_EQ(2u, statistics.Count);
+    EXPECT_EQ(2 * sessionMemory, statistics.Memory);
+    EXPECT_EQ(1u, statistics.Rejected);
+    EXPECT_EQ(1u, statistics.Evicted);
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[0], 4));
+}
+
+TEST_F(DtlsSessionTableTestSuite, test_session_statistics)
+{
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&table_, addresses_[0], 5);
+    ASSERT_TRUE(NULL != entry);
+    DTLS_SessionTable_AddDecrypted(entry, 10);
+    DTLS_SessionTable_AddDecrypted(entry, 0);
+    DTLS_SessionTable_AddEncrypted(entry, 20);
+    DTLS_SessionTable_AddEncrypted(entry, 30);
+    DTLS_SessionTable_Get(&table_, addresses_[0], 8);
+
+    EXPECT_EQ(5u, entry->Statistics.Created);
+    EXPECT_EQ(8u, entry->Statistics.LastUsed);
+    EXPECT_EQ(1u, entry->Statistics.RecordsDecrypted);
+    EXPECT_EQ(10u, entry->Statistics.BytesDecrypted);
+    EXPECT_EQ(2u, entry->Statistics.RecordsEncrypted);
+    EXPECT_EQ(50u, entry->Statistics.BytesEncrypted);
+}
+
+TEST_F(DtlsSessionTableTestSuite, test_destroy_frees_sessions)
+{
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[0], 0));
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[1], 0));
+    DTLS_SessionTable_Destroy(&table_);
+    EXPECT_EQ(2, freedSessions);
+
+    // the fixture destroys the table again
+    ASSERT_EQ(0, DTLS_SessionTable_Init(&table_, sizeof(TestSession), 1000, FreeTestSession));
+}
+
+TEST_F(DtlsSessionTableTestSuite, test_get_by_connection_id)
+{
+    const uint8_t connectionId[4] = { 0xca, 0xfe, 0x00, 0x01 };
+    const uint8_t otherConnectionId[4] = { 0xca, 0xfe, 0x00, 0x02 };
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&table_, addresses_[0], 0);
+    DTLS_SessionEntry * other = DTLS_SessionTable_New(&table_, addresses_[1], 0);
+    ASSERT_TRUE(NULL != entry);
+    ASSERT_TRUE(NULL != other);
+
+    EXPECT_TRUE(NULL == DTLS_SessionTable_GetByConnectionId(&table_, connectionId, sizeof(connectionId), 1));
+    ASSERT_EQ(0, DTLS_SessionTable_SetConnectionId(&table_, entry, connectionId, sizeof(connectionId)));
+    EXPECT_EQ(-1, DTLS_SessionTable_SetConnectionId(&table_, other, connectionId, sizeof(connectionId)));
+    EXPECT_EQ(entry, DTLS_SessionTable_GetByConnectionId(&table_, connectionId, sizeof(connectionId), 1));
+    EXPECT_TRUE(NULL == DTLS_SessionTable_GetByConnectionId(&table_, otherConnectionId, sizeof(otherConnectionId), 1));
+
+    // content type, version, epoch and sequence number, then the connection ID and length
+    uint8_t record[32];
+    memset(record, 0, sizeof(record));
+    record[0] = DTLS_CONNECTION_ID_CONTENT_TYPE;
+    memcpy(record + DTLS_CONNECTION_ID_OFFSET, connectionId, sizeof(connectionId));
+    EXPECT_EQ(entry, DTLS_SessionTable_GetByRecord(&table_, record, sizeof(record), sizeof(connectionId), 2));
+    EXPECT_TRUE(NULL == DTLS_SessionTable_GetByRecord(&table_, record, DTLS_CONNECTION_ID_OFFSET + sizeof(connectionId), sizeof(connectionId), 2));
+    record[0] = 23;
+    EXPECT_TRUE(NULL == DTLS_SessionTable_GetByRecord(&table_, record, sizeof(record), sizeof(connectionId), 2));
+
+    DTLS_SessionTable_Free(&table_, entry);
+    EXPECT_TRUE(NULL == DTLS_SessionTable_GetByConnectionId(&table_, connectionId, sizeof(connectionId), 3));
+}
+
+TEST_F(DtlsSessionTableTestSuite, test_session_moves_to_new_address)
+{
+    DTLS_SessionTableStatistics statistics;
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&table_, addresses_[0], 0);
+    ASSERT_TRUE(NULL != entry);
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[1], 0));
+
+    // the session at the new address is replaced by the moved session
+    DTLS_SessionTable_SetAddress(&table_, entry, addresses_[1]);
+    EXPECT_EQ(1, freedSessions);
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[0], 1));
+    EXPECT_EQ(entry, DTLS_SessionTable_Get(&table_, addresses_[1], 1));
+    EXPECT_EQ(0, NetworkAddress_Compare(addresses_[1], entry->NetworkAddress));
+
+    DTLS_SessionTable_GetStatistics(&table_, &statistics);
+    EXPECT_EQ(1u, statistics.Count);
+    EXPECT_EQ(1u, statistics.Rebound);
+}
+
+struct TestAuthentication
+{
+    bool Authentic;
+    DTLS_SessionEntry * Entry;          // Session the record was authenticated with
+};
+
+static bool AuthenticateTestRecord(DTLS_SessionEntry * entry, uint8_t * record, size_t recordLength, void * context)
+{
+    TestAuthentication * authentication = (TestAuthentication *)context;
+    authentication->Entry = entry;
+    return authentication->Authentic;
+}
+
+TEST_F(DtlsSessionTableTestSuite, test_authentic_record_with_connection_id_moves_session)
+{
+    const uint8_t connectionId[4] = { 0xbe, 0xef, 0x00, 0x01 };
+    DTLS_SessionTableStatistics statistics;
+    TestAuthentication authentication = { false, NULL };
+    DTLS_SessionEntry * entry = DTLS_SessionTable_New(&table_, addresses_[0], 0);
+    ASSERT_TRUE(NULL != entry);
+    ASSERT_TRUE(NULL != DTLS_SessionTable_New(&table_, addresses_[1], 0));
+    ASSERT_EQ(0, DTLS_SessionTable_SetConnectionId(&table_, entry, connectionId, sizeof(connectionId)));
+
+    uint8_t record[32];
+    memset(record, 0, sizeof(record));
+    record[0] = DTLS_CONNECTION_ID_CONTENT_TYPE;
+    memcpy(record + DTLS_CONNECTION_ID_OFFSET, connectionId, sizeof(connectionId));
+
+    // a record that is not authentic leaves the session where it is
+    EXPECT_TRUE(NULL == DTLS_SessionTable_MoveByRecord(&table_, addresses_[2], record, sizeof(record), sizeof(connectionId), AuthenticateTestRecord, &authentication, 1));
+    EXPECT_EQ(entry, authentication.Entry);
+    EXPECT_EQ(entry, DTLS_SessionTable_Get(&table_, addresses_[0], 1));
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[2], 1));
+
+    authentication.Authentic = true;
+    EXPECT_EQ(entry, DTLS_SessionTable_MoveByRecord(&table_, addresses_[2], record, sizeof(record), sizeof(connectionId), AuthenticateTestRecord, &authentication, 2));
+    EXPECT_TRUE(NULL == DTLS_SessionTable_Get(&table_, addresses_[0], 2));
+    EXPECT_EQ(entry, DTLS_SessionTable_Get(&table_, addresses_[2], 2));
+    EXPECT_EQ(entry, DTLS_SessionTable_GetByConnectionId(&table_, connectionId, sizeof(connectionId), 2));
+
+    // moving to the address of another session replaces it
+    EXPECT_EQ(entry, DTLS_SessionTable_MoveByRecord(&table_, addresses_[1], record, sizeof(record), sizeof(connectionId), AuthenticateTestRecord, &authentication, 3));
+    EXPECT_EQ(1, freedSessions);
+    EXPECT_EQ(entry, DTLS_SessionTable_Get(&table_, addresses_[1], 3));
+
+    // a record without a connection ID is not authenticated at all
+    authentication.Entry = NULL;
+    record[0] = 23;
+    EXPECT_TRUE(NULL == DTLS_SessionTable_MoveByRecord(&table_, addresses_[3], record, sizeof(record), sizeof(connectionId), AuthenticateTestRecord, &authentication, 4));
+    EXPECT_TRUE(NULL == authentication.Entry);
+
+    DTLS_SessionTable_GetStatistics(&table_, &statistics);
+    EXPECT_EQ(1u, statistics.Count);
+    EXPECT_EQ(2u, statistics.Rebound);
+}
+
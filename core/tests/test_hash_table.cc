@@ -0,0 +1,142 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include "lwm2m_hash_table.h"
+
+typedef struct
+{
+    HashTableEntry Entry;
+    int Key;
+} TestItem;
+
+class HashTableTestSuite : public testing::Test
+{
+protected:
+    void SetUp() { ASSERT_EQ(0, HashTable_Init(&table_, 0)); }
+    void TearDown() { HashTable_Destroy(&table_); }
+
+    TestItem * Find(int key)
+    {
+        HashTableEntry * entry;
+        HashTable_ForEachWithHash(entry, &table_, HashTable_HashInt(key))
+        {
+            TestItem * item = HashTableContainer(entry, TestItem, Entry);
+            if (item->Key == key)
+            {
+                return item;
+            }
+        }
+        return NULL;
+    }
+
+    HashTable table_;
+};
+
+TEST_F(HashTableTestSuite, test_empty_table)
+{
+    EXPECT_EQ(0u, HashTable_Count(&table_));
+    EXPECT_TRUE(NULL == HashTable_First(&table_, HashTable_HashInt(1)));
+}
+
+TEST_F(HashTableTestSuite, test_add_find_remove)
+{
+    TestItem a, b;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    a.Key = 1;
+    b.Key = 2;
+
+    HashTable_Add(&table_, &a.Entry, HashTable_HashInt(a.Key));
+    HashTable_Add(&table_, &b.Entry, HashTable_HashInt(b.Key));
+    EXPECT_EQ(2u, HashTable_Count(&table_));
+    EXPECT_EQ(&a, Find(1));
+    EXPECT_EQ(&b, Find(2));
+    EXPECT_TRUE(NULL == Find(3));
+
+    HashTable_Remove(&table_, &a.Entry);
+    EXPECT_EQ(1u, HashTable_Count(&table_));
+    EXPECT_TRUE(NULL == Find(1));
+    EXPECT_EQ(&b, Find(2));
+
+    // removing twice has no effect
+    HashTable_Remove(&table_, &a.Entry);
+    EXPECT_EQ(1u, HashTable_Count(&table_));
+}
+
+TEST_F(HashTableTestSuite, test_entries_with_same_hash_are_chained)
+{
+    TestItem items[3];
+    memset(items, 0, sizeof(items));
+    for (int i = 0; i < 3; i++)
+    {
+        items[i].Key = i;
+        HashTable_Add(&table_, &items[i].Entry, 42);
+    }
+
+    int found = 0;
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &table_, 42)
+    {
+        EXPECT_EQ(&items[found], HashTableContainer(entry, TestItem, Entry));
+        found++;
+    }
+    EXPECT_EQ(3, found);
+}
+
+TEST_F(HashTableTestSuite, test_grows_and_keeps_entries)
+{
+    const int count = 10000;
+    TestItem * items = new TestItem[count];
+    memset(items, 0, sizeof(TestItem) * count);
+    for (int i = 0; i < count; i++)
+    {
+        items[i].Key = i;
+        HashTable_Add(&table_, &items[i].Entry, HashTable_HashInt(i));
+    }
+    EXPECT_EQ(static_cast<size_t>(count), HashTable_Count(&table_));
+    EXPECT_LE(static_cast<size_t>(count / 2), table_.BucketCount);
+
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(&items[i], Find(i));
+    }
+    for (int i = 0; i < count; i += 2)
+    {
+        HashTable_Remove(&table_, &items[i].Entry);
+    }
+    EXPECT_EQ(static_cast<size_t>(count / 2), HashTable_Count(&table_));
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ((i % 2) ? &items[i] : NULL, Find(i));
+    }
+    delete[] items;
+}
+
+TEST_F(HashTableTestSuite, test_hash_functions)
+{
+    EXPECT_EQ(HashTable_HashString("abc"), HashTable_HashBytes(0, "abc", 3));
+    EXPECT_NE(HashTable_HashString("abc"), HashTable_HashString("abd"));
+    EXPECT_NE(HashTable_HashInt(1), HashTable_HashInt(2));
+    EXPECT_NE(HashTable_HashBytes(0, "c", 1), HashTable_HashBytes(HashTable_HashBytes(0, "ab", 2), "c", 1));
+}
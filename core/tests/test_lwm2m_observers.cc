@@ -0,0 +1,284 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include "lwm2m_core.h"
+#include "lwm2m_observers.h"
+#include "lwm2m_security_object.h"
+
+class ObserversTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        notifications = 0;
+        context = Lwm2mCore_Init(NULL, (char *)"observers");
+        memset(&server1, 0, sizeof(server1));
+        server1.Size = sizeof(server1.Addr.Sin);
+        server1.Addr.Sin.sin_family = AF_INET;
+        server1.Addr.Sin.sin_port = htons(5683);
+        server1.Addr.Sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        server2 = server1;
+        server2.Addr.Sin.sin_port = htons(5684);
+    }
+    void TearDown() { Lwm2mCore_Destroy(context); }
+
+    int Observe(AddressType * server, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+    {
+        return Lwm2m_Observe(context, server, "token", 5, objectID, objectInstanceID, resourceID, AwaContentType_ApplicationPlainText, Notify, NULL);
+    }
+
+    Lwm2mObserverType * Find(AddressType * server, ObjectIDType objectID, ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID)
+    {
+        struct ListHead * i;
+        ListForEach(i, Lwm2mCore_GetObserverList(context))
+        {
+            Lwm2mObserverType * observer = ListEntry(i, Lwm2mObserverType, list);
+            if ((observer->ObjectID == objectID) && (observer->ObjectInstanceID == objectInstanceID) && (observer->ResourceID == resourceID) &&
+                (memcmp(&observer->Address, server, sizeof(AddressType)) == 0))
+            {
+                return observer;
+            }
+        }
+        return NULL;
+    }
+
+    static int Notify(void * context, AddressType * addr, int sequence, const char * token, int tokenLength, ObjectIDType objectID,
+                      ObjectInstanceIDType objectInstanceID, ResourceIDType resourceID, AwaContentType contentType, void * contextData)
+    {
+        notifications++;
+        return 0;
+    }
+
+    void SetPeriod(AttributeTypeEnum type, int period)
+    {
+        NotificationAttributes * attributes = AttributeStore_LookupNotificationAttributes(Lwm2mCore_GetAttributes(context),
+                Lwm2mSecurity_GetShortServerID(context, &server1), 1000, 0, 1);
+        if (type == AttributeTypeEnum_MinimumPeriod)
+            attributes->MinimumPeriod = period;
+        else
+            attributes->MaximumPeriod = period;
+        attributes->Valid[type] = true;
+    }
+
+    static int notifications;
+    Lwm2mContextType * context;
+    AddressType server1;
+    AddressType server2;
+};
+
+int ObserversTestSuite::notifications;
+
+TEST_F(ObserversTestSuite, test_resource_change_marks_resource_instance_and_object_observers)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, -1));
+    ASSERT_EQ(0, Observe(&server1, 1000, -1, -1));
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 2));
+    ASSERT_EQ(0, Observe(&server1, 1000, 1, 1));
+    ASSERT_EQ(0, Observe(&server1, 1001, 0, 1));
+
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 1, NULL, 0);
+
+    EXPECT_TRUE(Find(&server1, 1000, 0, 1)->Changed);
+    EXPECT_TRUE(Find(&server1, 1000, 0, -1)->Changed);
+    EXPECT_TRUE(Find(&server1, 1000, -1, -1)->Changed);
+    EXPECT_FALSE(Find(&server1, 1000, 0, 2)->Changed);
+    EXPECT_FALSE(Find(&server1, 1000, 1, 1)->Changed);
+    EXPECT_FALSE(Find(&server1, 1001, 0, 1)->Changed);
+}
+
+TEST_F(ObserversTestSuite, test_instance_change_does_not_mark_resource_observers)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, -1));
+    ASSERT_EQ(0, Observe(&server1, 1000, -1, -1));
+
+    Lwm2m_MarkObserversChanged(context, 1000, 0, -1, NULL, 0);
+
+    EXPECT_FALSE(Find(&server1, 1000, 0, 1)->Changed);
+    EXPECT_TRUE(Find(&server1, 1000, 0, -1)->Changed);
+    EXPECT_TRUE(Find(&server1, 1000, -1, -1)->Changed);
+}
+
+TEST_F(ObserversTestSuite, test_observe_again_replaces_observer)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    ASSERT_EQ(0, Observe(&server2, 1000, 0, 1));
+
+    EXPECT_EQ(2u, HashTable_Count(Lwm2mCore_GetObserverIndex(context)));
+}
+
+TEST_F(ObserversTestSuite, test_cancel_observe_removes_only_that_server)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    ASSERT_EQ(0, Observe(&server2, 1000, 0, 1));
+
+    EXPECT_EQ(0, Lwm2m_CancelObserve(context, &server1, 1000, 0, 1));
+    EXPECT_EQ(-1, Lwm2m_CancelObserve(context, &server1, 1000, 0, 1));
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 1, NULL, 0);
+
+    EXPECT_TRUE(Find(&server1, 1000, 0, 1) == NULL);
+    EXPECT_TRUE(Find(&server2, 1000, 0, 1)->Changed);
+}
+
+TEST_F(ObserversTestSuite, test_remove_all_observers_for_oir_removes_every_server)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    ASSERT_EQ(0, Observe(&server2, 1000, 0, 1));
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, -1));
+
+    EXPECT_EQ(0, Lwm2m_RemoveAllObserversForOIR(context, 1000, 0, 1));
+    EXPECT_EQ(-1, Lwm2m_RemoveAllObserversForOIR(context, 1000, 0, 1));
+
+    EXPECT_TRUE(Find(&server1, 1000, 0, 1) == NULL);
+    EXPECT_TRUE(Find(&server2, 1000, 0, 1) == NULL);
+    EXPECT_TRUE(Find(&server1, 1000, 0, -1) != NULL);
+    EXPECT_EQ(1u, HashTable_Count(Lwm2mCore_GetObserverIndex(context)));
+}
+
+TEST_F(ObserversTestSuite, test_unchanged_observer_without_maximum_period_is_not_scheduled)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+
+    EXPECT_EQ(-1, Lwm2m_UpdateObservers(context));
+    EXPECT_EQ(0, notifications);
+}
+
+TEST_F(ObserversTestSuite, test_changed_observer_is_notified_once)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 1, NULL, 0);
+
+    EXPECT_EQ(-1, Lwm2m_UpdateObservers(context));
+    EXPECT_EQ(1, notifications);
+    EXPECT_FALSE(Find(&server1, 1000, 0, 1)->Changed);
+
+    EXPECT_EQ(-1, Lwm2m_UpdateObservers(context));
+    EXPECT_EQ(1, notifications);
+}
+
+TEST_F(ObserversTestSuite, test_maximum_period_is_next_timeout)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    SetPeriod(AttributeTypeEnum_MaximumPeriod, 60);
+    Lwm2m_RescheduleObservers(context);
+
+    // never notified, so already due
+    int32_t timeout = Lwm2m_UpdateObservers(context);
+    EXPECT_EQ(1, notifications);
+    EXPECT_GT(timeout, 59000);
+    EXPECT_LE(timeout, 60001);
+
+    Lwm2m_UpdateObservers(context);
+    EXPECT_EQ(1, notifications);
+}
+
+TEST_F(ObserversTestSuite, test_minimum_period_delays_change_notification)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    SetPeriod(AttributeTypeEnum_MinimumPeriod, 60);
+    Lwm2m_RescheduleObservers(context);
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 1, NULL, 0);
+    EXPECT_EQ(-1, Lwm2m_UpdateObservers(context));
+    EXPECT_EQ(1, notifications);
+
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 1, NULL, 0);
+    int32_t timeout = Lwm2m_UpdateObservers(context);
+    EXPECT_EQ(1, notifications);
+    EXPECT_GT(timeout, 59000);
+    EXPECT_LE(timeout, 60001);
+
+    Lwm2m_CancelObserve(context, &server1, 1000, 0, 1);
+    EXPECT_EQ(-1, Lwm2m_UpdateObservers(context));
+}
+
+TEST_F(ObserversTestSuite, test_attributes_are_cached_until_rescheduled)
+{
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    EXPECT_EQ(-1, Lwm2m_UpdateObservers(context));
+
+    SetPeriod(AttributeTypeEnum_MaximumPeriod, 60);
+    EXPECT_EQ(-1, Lwm2m_UpdateObservers(context));
+    EXPECT_EQ(0, notifications);
+
+    Lwm2m_RescheduleObservers(context);
+    EXPECT_GT(Lwm2m_UpdateObservers(context), 59000);
+    EXPECT_EQ(1, notifications);
+}
+
+TEST_F(ObserversTestSuite, test_old_value_is_kept_inline_or_in_reused_buffer)
+{
+    Lwm2mCore_RegisterObjectType(context, "Test", 1001, MultipleInstancesEnum_Multiple, MandatoryEnum_Optional, &defaultObjectOperationHandlers);
+    Lwm2mCore_RegisterResourceType(context, "Opaque", 1001, 0, AwaResourceType_Opaque, MultipleInstancesEnum_Single, MandatoryEnum_Optional,
+                                   AwaResourceOperations_ReadWrite, &defaultResourceOperationHandlers);
+    ASSERT_EQ(0, Observe(&server1, 1001, 0, 0));
+    Lwm2mObserverType * observer = Find(&server1, 1001, 0, 0);
+
+    AwaInteger integer = 42;
+    Lwm2m_MarkObserversChanged(context, 1001, 0, 0, &integer, sizeof(integer));
+    EXPECT_EQ((void *)&observer->OldValueInline, observer->OldValue);
+    EXPECT_EQ(sizeof(integer), observer->OldValueLength);
+    EXPECT_EQ(42, observer->OldValueInline.Integer);
+
+    char large[OBSERVER_INLINE_VALUE_SIZE * 4];
+    memset(large, 'a', sizeof(large));
+    Lwm2m_MarkObserversChanged(context, 1001, 0, 0, large, sizeof(large));
+    void * buffer = observer->OldValue;
+    EXPECT_EQ(observer->OldValueBuffer, buffer);
+    EXPECT_EQ(0, memcmp(large, observer->OldValue, sizeof(large)));
+
+    memset(large, 'b', sizeof(large));
+    Lwm2m_MarkObserversChanged(context, 1001, 0, 0, large, sizeof(large) / 2);
+    EXPECT_EQ(buffer, observer->OldValue);
+    EXPECT_EQ(sizeof(large) / 2, observer->OldValueLength);
+    EXPECT_EQ(0, memcmp(large, observer->OldValue, sizeof(large) / 2));
+}
+
+TEST_F(ObserversTestSuite, test_coalesced_changes_are_notified_together)
+{
+    Lwm2mCore_SetNotificationCoalescePeriod(context, 100);
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 1));
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, 2));
+    ASSERT_EQ(0, Observe(&server1, 1000, 0, -1));
+
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 1, NULL, 0);
+    Lwm2m_MarkObserversChanged(context, 1000, 0, 2, NULL, 0);
+    uint64_t deadline = Find(&server1, 1000, 0, 1)->NotifyEntry.Deadline;
+    EXPECT_EQ(0u, deadline % 100);
+    EXPECT_EQ(deadline, Find(&server1, 1000, 0, 2)->NotifyEntry.Deadline);
+    EXPECT_EQ(deadline, Find(&server1, 1000, 0, -1)->NotifyEntry.Deadline);
+
+    int32_t timeout;
+    while ((timeout = Lwm2m_UpdateObservers(context)) > 0)
+    {
+        EXPECT_EQ(0, notifications);
+        usleep(timeout * 1000);
+    }
+    EXPECT_EQ(-1, timeout);
+    EXPECT_EQ(3, notifications);
+}
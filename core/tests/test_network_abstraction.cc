@@ -0,0 +1,378 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <stdio.h>
+#include "network_abstraction_posix.h"
+#include "dtls_abstraction.h"
+
+#define TEST_PORT (56830)
+
+class NetworkAbstractionTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        socket_ = NetworkSocket_New("127.0.0.1", NetworkSocketType_UDP, TEST_PORT);
+        ASSERT_TRUE(socket_ != NULL);
+        ASSERT_TRUE(NetworkSocket_StartListening(socket_));
+
+        const char * uri = "coap://127.0.0.1:56830";
+        self_ = NetworkAddress_New(uri, strlen(uri));
+        ASSERT_TRUE(self_ != NULL);
+    }
+
+    void TearDown()
+    {
+        NetworkAddress_Free(&self_);
+        NetworkSocket_Free(&socket_);
+    }
+
+    int Read(uint8_t * buffer, int bufferLength)
+    {
+        NetworkAddress * source = NULL;
+        int readLength = 0;
+        EXPECT_TRUE(NetworkSocket_Read(socket_, buffer, bufferLength, &source, &readLength));
+        if (readLength > 0)
+        {
+            EXPECT_EQ(0, NetworkAddress_Compare(self_, source));
+        }
+        return readLength;
+    }
+
+    NetworkSocket * socket_;
+    NetworkAddress * self_;
+};
+
+TEST_F(NetworkAbstractionTestSuite, test_unbatched_send_and_read)
+{
+    uint8_t buffer[16];
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"one", 3));
+
+    ASSERT_EQ(3, Read(buffer, sizeof(buffer)));
+    EXPECT_EQ(0, memcmp(buffer, "one", 3));
+    EXPECT_EQ(0, NetworkSocket_GetPendingReads(socket_));
+    EXPECT_EQ(0, Read(buffer, sizeof(buffer)));
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_batched_send_is_queued_until_flush)
+{
+    uint8_t buffer[16];
+    ASSERT_TRUE(NetworkSocket_SetBatchSize(socket_, 4));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"one", 3));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"two", 3));
+    EXPECT_EQ(0, Read(buffer, sizeof(buffer)));
+
+    ASSERT_TRUE(NetworkSocket_Flush(socket_));
+    ASSERT_EQ(3, Read(buffer, sizeof(buffer)));
+    EXPECT_EQ(0, memcmp(buffer, "one", 3));
+    EXPECT_EQ(1, NetworkSocket_GetPendingReads(socket_));
+    ASSERT_EQ(3, Read(buffer, sizeof(buffer)));
+    EXPECT_EQ(0, memcmp(buffer, "two", 3));
+    EXPECT_EQ(0, NetworkSocket_GetPendingReads(socket_));
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_full_batch_is_sent)
+{
+    uint8_t buffer[16];
+    int i;
+    ASSERT_TRUE(NetworkSocket_SetBatchSize(socket_, 2));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"1", 1));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"2", 1));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"3", 1));
+
+    // the first two filled the batch, the third is still queued
+    for (i = 0; i < 2; i++)
+    {
+        ASSERT_EQ(1, Read(buffer, sizeof(buffer)));
+        EXPECT_EQ('1' + i, buffer[0]);
+    }
+    EXPECT_EQ(0, Read(buffer, sizeof(buffer)));
+
+    // reverting to unbatched sends what was queued
+    ASSERT_TRUE(NetworkSocket_SetBatchSize(socket_, 1));
+    ASSERT_EQ(1, Read(buffer, sizeof(buffer)));
+    EXPECT_EQ('3', buffer[0]);
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_flush_sends_rest_of_batch)
+{
+    uint8_t buffer[16];
+    int i;
+    ASSERT_TRUE(NetworkSocket_SetBatchSize(socket_, 2));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"1", 1));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"2", 1));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"3", 1));
+
+    ASSERT_TRUE(NetworkSocket_Flush(socket_));
+    for (i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(1, Read(buffer, sizeof(buffer)));
+        EXPECT_EQ('1' + i, buffer[0]);
+    }
+    EXPECT_EQ(0, Read(buffer, sizeof(buffer)));
+
+    // nothing is left to send
+    ASSERT_TRUE(NetworkSocket_Flush(socket_));
+    EXPECT_EQ(0, Read(buffer, sizeof(buffer)));
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_batched_read_truncates_to_buffer)
+{
+    uint8_t buffer[4];
+    ASSERT_TRUE(NetworkSocket_SetBatchSize(socket_, 4));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"truncated", 9));
+    ASSERT_TRUE(NetworkSocket_Flush(socket_));
+
+    ASSERT_EQ(4, Read(buffer, sizeof(buffer)));
+    EXPECT_EQ(0, memcmp(buffer, "trun", 4));
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_batched_read_drops_truncated_datagram)
+{
+    uint8_t large[4096] = { 0 };
+    uint8_t buffer[16];
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, large, sizeof(large)));
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"next", 4));
+
+    // the large datagram does not fit a batch buffer, so it is dropped rather than returned truncated
+    ASSERT_TRUE(NetworkSocket_SetBatchSize(socket_, 4));
+    ASSERT_EQ(4, Read(buffer, sizeof(buffer)));
+    EXPECT_EQ(0, memcmp(buffer, "next", 4));
+    EXPECT_EQ(0, Read(buffer, sizeof(buffer)));
+}
+
+#ifndef WITH_IO_URING
+// io_uring completes the datagrams of both sockets in the order they arrive instead
+TEST_F(NetworkAbstractionTestSuite, test_batched_read_alternates_address_families)
+{
+    NetworkSocket * dualSocket = NetworkSocket_New(NULL, NetworkSocketType_UDP, TEST_PORT + 2);
+    ASSERT_TRUE(dualSocket != NULL);
+    ASSERT_TRUE(NetworkSocket_StartListening(dualSocket));
+    const char * uri4 = "coap://127.0.0.1:56832";
+    const char * uri6 = "coap://[::1]:56832";
+    NetworkAddress * address4 = NetworkAddress_New(uri4, strlen(uri4));
+    NetworkAddress * address6 = NetworkAddress_New(uri6, strlen(uri6));
+    ASSERT_TRUE((address4 != NULL) && (address6 != NULL));
+
+    int i;
+    for (i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(NetworkSocket_Send(dualSocket, address4, (uint8_t *)"4", 1));
+        if (!NetworkSocket_Send(dualSocket, address6, (uint8_t *)"6", 1))
+        {
+            printf("IPv6 is not available, skipping\n");
+            break;
+        }
+    }
+
+    if (i == 4)
+    {
+        // each batch is read from the other family while it has datagrams waiting
+        const char * expected = "44664466";
+        ASSERT_TRUE(NetworkSocket_SetBatchSize(dualSocket, 2));
+        for (i = 0; i < 8; i++)
+        {
+            uint8_t buffer[16];
+            NetworkAddress * source = NULL;
+            int readLength = 0;
+            ASSERT_TRUE(NetworkSocket_Read(dualSocket, buffer, sizeof(buffer), &source, &readLength));
+            ASSERT_EQ(1, readLength);
+            EXPECT_EQ(expected[i], buffer[0]) << "datagram " << i;
+        }
+    }
+
+    NetworkAddress_Free(&address4);
+    NetworkAddress_Free(&address6);
+    NetworkSocket_Free(&dualSocket);
+}
+#endif
+
+TEST_F(NetworkAbstractionTestSuite, test_set_batch_size_handles_invalid_arguments)
+{
+    EXPECT_FALSE(NetworkSocket_SetBatchSize(NULL, 4));
+    EXPECT_FALSE(NetworkSocket_SetBatchSize(socket_, 0));
+    EXPECT_EQ(0, NetworkSocket_GetPendingReads(NULL));
+    EXPECT_TRUE(NetworkSocket_Flush(NULL));
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_received_address_is_the_cached_uri_address)
+{
+    uint8_t buffer[16];
+    NetworkAddress * source = NULL;
+    int readLength = 0;
+    ASSERT_TRUE(NetworkSocket_Send(socket_, self_, (uint8_t *)"one", 3));
+    ASSERT_TRUE(NetworkSocket_Read(socket_, buffer, sizeof(buffer), &source, &readLength));
+    ASSERT_EQ(3, readLength);
+    EXPECT_EQ(self_, source);
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_address_cache_counts_hits_and_misses)
+{
+    NetworkAddressCacheStatistics before, after;
+    const char * uri = "coap://127.0.0.1:56831/3/0";
+    NetworkAddress_GetCacheStatistics(&before);
+
+    NetworkAddress * address1 = NetworkAddress_New(uri, strlen(uri));
+    NetworkAddress * address2 = NetworkAddress_New(uri, strlen(uri));
+    ASSERT_TRUE(address1 != NULL);
+    EXPECT_EQ(address1, address2);
+
+    NetworkAddress_GetCacheStatistics(&after);
+    EXPECT_EQ(before.Misses + 1, after.Misses);
+    EXPECT_EQ(before.Hits + 1, after.Hits);
+    EXPECT_EQ(before.Count + 1, after.Count);
+
+    NetworkAddress_Free(&address1);
+    NetworkAddress_Free(&address2);
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_address_cache_uri_match_is_exact)
+{
+    const char * uri1 = "coap://127.0.0.1:5683";
+    const char * uri2 = "coap://127.0.0.1:56832";
+    NetworkAddress * address1 = NetworkAddress_New(uri1, strlen(uri1));
+    NetworkAddress * address2 = NetworkAddress_New(uri2, strlen(uri2));
+    ASSERT_TRUE(address1 != NULL);
+    ASSERT_TRUE(address2 != NULL);
+    EXPECT_NE(0, NetworkAddress_Compare(address1, address2));
+    NetworkAddress_Free(&address1);
+    NetworkAddress_Free(&address2);
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_address_from_address_type_is_the_cached_uri_address)
+{
+    AddressType addressType;
+    NetworkAddressCacheStatistics before, after;
+    NetworkAddress_SetAddressType(self_, &addressType);
+    NetworkAddress_GetCacheStatistics(&before);
+
+    NetworkAddress * address = NetworkAddress_FromAddressType(&addressType);
+    EXPECT_EQ(self_, address);
+
+    NetworkAddress_GetCacheStatistics(&after);
+    EXPECT_EQ(before.Hits + 1, after.Hits);
+    EXPECT_EQ(before.Misses, after.Misses);
+    NetworkAddress_Free(&address);
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_address_from_new_address_type_is_cached)
+{
+    const char * uri = "coap://127.0.0.1:56833";
+    AddressType addressType;
+    NetworkAddressCacheStatistics before, after;
+    memset(&addressType, 0, sizeof(addressType));
+    addressType.Addr.Sin.sin_family = AF_INET;
+    addressType.Addr.Sin.sin_port = htons(56833);
+    addressType.Addr.Sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    NetworkAddress_GetCacheStatistics(&before);
+
+    NetworkAddress * address1 = NetworkAddress_FromAddressType(&addressType);
+    NetworkAddress * address2 = NetworkAddress_FromAddressType(&addressType);
+    ASSERT_TRUE(address1 != NULL);
+    EXPECT_EQ(address1, address2);
+
+    NetworkAddress_GetCacheStatistics(&after);
+    EXPECT_EQ(before.Misses + 1, after.Misses);
+    EXPECT_EQ(before.Hits + 1, after.Hits);
+    EXPECT_EQ(before.Count + 1, after.Count);
+
+    // the URI resolves to the same address
+    NetworkAddress * address3 = NetworkAddress_New(uri, strlen(uri));
+    EXPECT_EQ(address1, address3);
+
+    NetworkAddress_Free(&address1);
+    NetworkAddress_Free(&address2);
+    NetworkAddress_Free(&address3);
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_address_cache_evicts_least_recently_used_unreferenced_addresses)
+{
+    NetworkAddressCacheStatistics before, after;
+    char uri[64];
+    int i;
+    NetworkAddress_GetCacheStatistics(&before);
+
+    // a referenced address is never evicted
+    const char * retainedUri = "coap://127.0.0.2:1000";
+    NetworkAddress * retained = NetworkAddress_New(retainedUri, strlen(retainedUri));
+    ASSERT_TRUE(retained != NULL);
+
+    for (i = 0; i < NETWORK_ADDRESS_CACHE_IDLE_LIMIT + 10; i++)
+    {
+        sprintf(uri, "coap://127.0.0.2:%d", 2000 + i);
+        NetworkAddress * address = NetworkAddress_New(uri, strlen(uri));
+        ASSERT_TRUE(address != NULL);
+        NetworkAddress_Free(&address);
+    }
+
+    NetworkAddress_GetCacheStatistics(&after);
+    EXPECT_LE(before.Evictions + 10, after.Evictions);
+    EXPECT_GE((uint32_t)NETWORK_ADDRESS_CACHE_IDLE_LIMIT + 3, after.Count);
+
+    // the most recently used are still cached, the first ones were evicted
+    sprintf(uri, "coap://127.0.0.2:%d", 2000 + NETWORK_ADDRESS_CACHE_IDLE_LIMIT + 9);
+    NetworkAddress * recent = NetworkAddress_New(uri, strlen(uri));
+    sprintf(uri, "coap://127.0.0.2:%d", 2000);
+    NetworkAddress * evicted = NetworkAddress_New(uri, strlen(uri));
+    NetworkAddress * again = NetworkAddress_New(retainedUri, strlen(retainedUri));
+    NetworkAddressCacheStatistics last;
+    NetworkAddress_GetCacheStatistics(&last);
+    EXPECT_EQ(after.Hits + 2, last.Hits);
+    EXPECT_EQ(after.Misses + 1, last.Misses);
+    EXPECT_EQ(retained, again);
+
+    NetworkAddress_Free(&recent);
+    NetworkAddress_Free(&evicted);
+    NetworkAddress_Free(&again);
+    NetworkAddress_Free(&retained);
+}
+
+TEST_F(NetworkAbstractionTestSuite, test_secure_datagram_larger_than_1024_bytes)
+{
+    // the dummy backend passes records through unchanged, so a socket can send records to itself
+    if (strcmp(DTLS_LibraryName, "None") != 0)
+    {
+        return;
+    }
+
+    const char * uri = "coaps://127.0.0.1:56830";
+    NetworkAddress * secure = NetworkAddress_New(uri, strlen(uri));
+    ASSERT_TRUE(secure != NULL);
+
+    uint8_t message[1500];
+    uint8_t buffer[2048];
+    for (size_t i = 0; i < sizeof(message); i++)
+    {
+        message[i] = (uint8_t)i;
+    }
+    ASSERT_TRUE(NetworkSocket_Send(socket_, secure, message, sizeof(message)));
+
+    NetworkAddress * source = NULL;
+    int readLength = 0;
+    ASSERT_TRUE(NetworkSocket_Read(socket_, buffer, sizeof(buffer), &source, &readLength));
+    ASSERT_EQ((int)sizeof(message), readLength);
+    EXPECT_EQ(0, memcmp(buffer, message, sizeof(message)));
+    EXPECT_EQ(0, NetworkAddress_Compare(secure, source));
+    NetworkAddress_Free(&secure);
+}
@@ -0,0 +1,217 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include "network_io_uring.h"
+#include "network_abstraction_posix.h"
+
+#define TEST_PORT (56840)
+#define TEST_BATCH_SIZE (2)
+#define TEST_DATAGRAM_LENGTH (64)
+
+class NetworkRingTestSuite : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        memset(&address_, 0, sizeof(address_));
+        address_.sin_family = AF_INET;
+        address_.sin_port = htons(TEST_PORT);
+        address_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_TRUE(socket_ >= 0);
+        ASSERT_EQ(0, bind(socket_, (struct sockaddr *)&address_, sizeof(address_)));
+        sender_ = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_TRUE(sender_ >= 0);
+
+        ring_ = NetworkRing_New(TEST_BATCH_SIZE, TEST_DATAGRAM_LENGTH);
+    }
+
+    void TearDown()
+    {
+        NetworkRing_Free(&ring_);
+        close(sender_);
+        close(socket_);
+    }
+
+    void Send(const void * buffer, size_t length)
+    {
+        ASSERT_EQ((ssize_t)length, sendto(sender_, buffer, length, 0, (struct sockaddr *)&address_, sizeof(address_)));
+    }
+
+    // Completions are posted by the kernel asynchronously, so wait a while for one
+    int Receive(uint8_t * buffer, int bufferLength)
+    {
+        struct sockaddr_storage source;
+        socklen_t sourceLength = sizeof(source);
+        int length = 0;
+        int attempt;
+        for (attempt = 0; (attempt < 100) && (length == 0); attempt++)
+        {
+            length = NetworkRing_Receive(ring_, buffer, bufferLength, &source, &sourceLength);
+            if (length == 0)
+            {
+                struct pollfd eventFd = { NetworkRing_GetFileDescriptor(ring_), POLLIN, 0 };
+                poll(&eventFd, 1, 10);
+            }
+        }
+        if (length > 0)
+        {
+            EXPECT_EQ(AF_INET, source.ss_family);
+        }
+        return length;
+    }
+
+    struct sockaddr_in address_;
+    int socket_;
+    int sender_;
+    NetworkRing * ring_;
+};
+
+#define SKIP_IF_NO_RING() \
+    if (ring_ == NULL) \
+    { \
+        printf("io_uring is not available, skipping\n"); \
+        return; \
+    }
+
+TEST_F(NetworkRingTestSuite, test_multishot_receive_stays_armed)
+{
+    uint8_t buffer[16];
+    int i;
+    SKIP_IF_NO_RING();
+    ASSERT_TRUE(NetworkRing_AddSocket(ring_, socket_));
+
+    Send("1", 1);
+    Send("2", 1);
+    Send("3", 1);
+    for (i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(1, Receive(buffer, sizeof(buffer)));
+        EXPECT_EQ('1' + i, buffer[0]);
+    }
+
+    // the same receive completes again without being resubmitted
+    Send("4", 1);
+    ASSERT_EQ(1, Receive(buffer, sizeof(buffer)));
+    EXPECT_EQ('4', buffer[0]);
+    EXPECT_EQ(0, NetworkRing_GetPendingReceives(ring_));
+}
+
+TEST_F(NetworkRingTestSuite, test_receive_buffers_are_recycled)
+{
+    // many more datagrams than buffers, so the receive runs out of buffers and must be restarted
+    const int count = 64;
+    uint8_t buffer[16];
+    uint8_t i;
+    SKIP_IF_NO_RING();
+    ASSERT_TRUE(NetworkRing_AddSocket(ring_, socket_));
+
+    for (i = 0; i < count; i++)
+    {
+        Send(&i, 1);
+    }
+    for (i = 0; i < count; i++)
+    {
+        ASSERT_EQ(1, Receive(buffer, sizeof(buffer)));
+        EXPECT_EQ(i, buffer[0]);
+    }
+
+    // what is left is at most the receive stopping for want of buffers
+    struct sockaddr_storage source;
+    socklen_t sourceLength = sizeof(source);
+    EXPECT_EQ(0, NetworkRing_Receive(ring_, buffer, sizeof(buffer), &source, &sourceLength));
+    EXPECT_EQ(0, NetworkRing_GetPendingReceives(ring_));
+}
+
+TEST_F(NetworkRingTestSuite, test_truncated_datagram_is_dropped)
+{
+    uint8_t large[TEST_DATAGRAM_LENGTH * 2] = { 0 };
+    uint8_t buffer[16];
+    SKIP_IF_NO_RING();
+    ASSERT_TRUE(NetworkRing_AddSocket(ring_, socket_));
+
+    Send(large, sizeof(large));
+    Send("next", 4);
+    ASSERT_EQ(4, Receive(buffer, sizeof(buffer)));
+    EXPECT_EQ(0, memcmp(buffer, "next", 4));
+}
+
+// Batch through a socket in a process that is refused io_uring, returning 0 if it fell back to recvmmsg
+static int BatchWithoutRing(void)
+{
+    struct sock_filter filter[] = {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, nr)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_io_uring_setup, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | ENOSYS),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+    };
+    struct sock_fprog program = { sizeof(filter) / sizeof(filter[0]), filter };
+    const char * uri = "coap://127.0.0.1:56841";
+    NetworkSocket * networkSocket;
+    NetworkAddress * self;
+    NetworkAddress * source = NULL;
+    uint8_t buffer[16];
+    int readLength = 0;
+    int result = 1;
+
+    if ((prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) != 0) || (prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &program) != 0))
+    {
+        return 2;
+    }
+    networkSocket = NetworkSocket_New("127.0.0.1", NetworkSocketType_UDP, TEST_PORT + 1);
+    self = NetworkAddress_New(uri, strlen(uri));
+    if ((networkSocket != NULL) && (self != NULL) && NetworkSocket_StartListening(networkSocket) &&
+        NetworkSocket_SetBatchSize(networkSocket, 4) &&
+        NetworkSocket_Send(networkSocket, self, (uint8_t *)"one", 3) &&
+        NetworkSocket_Send(networkSocket, self, (uint8_t *)"two", 3) &&
+        NetworkSocket_Flush(networkSocket) &&
+        NetworkSocket_Read(networkSocket, buffer, sizeof(buffer), &source, &readLength) && (readLength == 3) &&
+        (memcmp(buffer, "one", 3) == 0) &&
+        // the second datagram was read in the same recvmmsg batch
+        (NetworkSocket_GetPendingReads(networkSocket) == 1))
+    {
+        result = 0;
+    }
+    NetworkAddress_Free(&self);
+    NetworkSocket_Free(&networkSocket);
+    return result;
+}
+
+TEST(NetworkRingFallbackTestSuite, test_batching_falls_back_without_io_uring)
+{
+    EXPECT_EXIT(exit(BatchWithoutRing()), ::testing::ExitedWithCode(0), "");
+}
@@ -43,6 +43,8 @@ const char *gengetopt_args_info_help[] = {
   "  -d, --daemonize         Detach process from terminal and run in the\n                            background  (default=off)",
   "  -v, --verbose           Generate verbose output  (default=off)",
   "  -l, --logFile=FILE      Log output to FILE",
+  "  -k, --pskFile=FILE      Look up the PSK of each client identity in FILE",
+  "  -w, --handshakeWorkers=N\n                          Run DTLS handshakes on N worker threads\n                            (default=`0')",
   "  -V, --version           Print version and exit  (default=off)",
   "\nExample:\n    awa_bootstrapd --port 15685 --config bootstrap.config\n\n",
     0
@@ -84,6 +86,8 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->daemonize_given = 0 ;
   args_info->verbose_given = 0 ;
   args_info->logFile_given = 0 ;
+  args_info->pskFile_given = 0 ;
+  args_info->handshakeWorkers_given = 0 ;
   args_info->version_given = 0 ;
 }
 
@@ -106,6 +110,10 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->verbose_flag = 0;
   args_info->logFile_arg = NULL;
   args_info->logFile_orig = NULL;
+  args_info->pskFile_arg = NULL;
+  args_info->pskFile_orig = NULL;
+  args_info->handshakeWorkers_arg = 0;
+  args_info->handshakeWorkers_orig = NULL;
   args_info->version_flag = 0;
   
 }
@@ -127,7 +135,9 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->daemonize_help = gengetopt_args_info_help[7] ;
   args_info->verbose_help = gengetopt_args_info_help[8] ;
   args_info->logFile_help = gengetopt_args_info_help[9] ;
-  args_info->version_help = gengetopt_args_info_help[10] ;
+  args_info->pskFile_help = gengetopt_args_info_help[10] ;
+  args_info->handshakeWorkers_help = gengetopt_args_info_help[11] ;
+  args_info->version_help = gengetopt_args_info_help[12] ;
   
 }
 
@@ -268,6 +278,9 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   free_multiple_string_field (args_info->config_given, &(args_info->config_arg), &(args_info->config_orig));
   free_string_field (&(args_info->logFile_arg));
   free_string_field (&(args_info->logFile_orig));
+  free_string_field (&(args_info->pskFile_arg));
+  free_string_field (&(args_info->pskFile_orig));
+  free_string_field (&(args_info->handshakeWorkers_orig));
   
   
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -371,6 +384,10 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "verbose", 0, 0 );
   if (args_info->logFile_given)
     write_into_file(outfile, "logFile", args_info->logFile_orig, 0);
+  if (args_info->pskFile_given)
+    write_into_file(outfile, "pskFile", args_info->pskFile_orig, 0);
+  if (args_info->handshakeWorkers_given)
+    write_into_file(outfile, "handshakeWorkers", args_info->handshakeWorkers_orig, 0);
   if (args_info->version_given)
     write_into_file(outfile, "version", 0, 0 );
   
@@ -1537,6 +1554,8 @@ cmdline_parser_internal (
         { "daemonize",	0, NULL, 'd' },
         { "verbose",	0, NULL, 'v' },
         { "logFile",	1, NULL, 'l' },
+        { "pskFile",	1, NULL, 'k' },
+        { "handshakeWorkers",	1, NULL, 'w' },
         { "version",	0, NULL, 'V' },
         { 0,  0, 0, 0 }
       };
@@ -1546,7 +1565,7 @@ cmdline_parser_internal (
       custom_opterr = opterr;
       custom_optopt = optopt;
 
-      c = custom_getopt_long (argc, argv, "ha:e:f:p:c:sdvl:V", long_options, &option_index);
+      c = custom_getopt_long (argc, argv, "ha:e:f:p:c:sdvl:k:w:V", long_options, &option_index);
 
       optarg = custom_optarg;
       optind = custom_optind;
@@ -1660,6 +1679,30 @@ cmdline_parser_internal (
               additional_error))
             goto failure;
         
+          break;
+        case 'k':	/* Look up the PSK of each client identity in FILE.  */
+
+
+          if (update_arg( (void *)&(args_info->pskFile_arg),
+                         &(args_info->pskFile_orig), &(args_info->pskFile_given),
+                         &(local_args_info.pskFile_given), optarg, 0, 0, ARG_STRING,
+                         check_ambiguity, override, 0, 0,
+                         "pskFile", 'k',
+                         additional_error))
+            goto failure;
+
+          break;
+        case 'w':	/* Run DTLS handshakes on N worker threads.  */
+
+
+          if (update_arg( (void *)&(args_info->handshakeWorkers_arg),
+                         &(args_info->handshakeWorkers_orig), &(args_info->handshakeWorkers_given),
+                         &(local_args_info.handshakeWorkers_given), optarg, 0, "0", ARG_INT,
+                         check_ambiguity, override, 0, 0,
+                         "handshakeWorkers", 'w',
+                         additional_error))
+            goto failure;
+
           break;
         case 'V':	/* Print version and exit.  */
         
@@ -21,7 +21,6 @@
 ************************************************************************************************************************/
 
 
-#include <poll.h>
 #include <stdio.h>
 #include <getopt.h>
 #include <string.h>
@@ -49,6 +48,7 @@
 #include "bootstrap/lwm2m_bootstrap.h"
 #include "bootstrap/lwm2m_bootstrap_cert.h"
 #include "bootstrap/lwm2m_bootstrap_psk.h"
+#include "lwm2m_event_loop.h"
 
 #define DEFAULT_IP_ADDRESS          "0.0.0.0"
 #define MAX_BOOTSTRAP_CONFIG_FILES  (4)
@@ -65,6 +65,8 @@ typedef struct
     bool Daemonise;
     bool Verbose;
     char * LogFile;
+    char * PskFile;
+    int HandshakeWorkers;
     bool Version;
 } Options;
 
@@ -79,6 +81,11 @@ static void CtrlCSignalHandler(int dummy)
     quit = 1;
 }
 
+static void HandleCoapMessage(int fd, void * context)
+{
+    coap_HandleMessage();
+}
+
 // Fork off a daemon process, the parent will exit at this point
 static void Daemonise(bool verbose)
 {
@@ -118,6 +125,8 @@ static void Daemonise(bool verbose)
 static int Bootstrap_Start(Options * options)
 {
     int result = 0;
+    EventLoop * loop = NULL;
+    DTLS_KeyStore * keyStore = NULL;
 
     if (options->Daemonise)
     {
@@ -166,6 +175,14 @@ static int Bootstrap_Start(Options * options)
     Lwm2m_Info("  CoAP library   : %s\n", coap_LibraryName);
     Lwm2m_Info("  CoAP port      : %d\n", options->CoapPort);
     Lwm2m_Info("  CoAP Security  : %s\n", options->Secure ? "DTLS": "None");
+    if (options->PskFile != NULL)
+    {
+        Lwm2m_Info("  PSK file       : %s\n", options->PskFile);
+    }
+    if (options->HandshakeWorkers > 0)
+    {
+        Lwm2m_Info("  DTLS workers   : %d\n", options->HandshakeWorkers);
+    }
 
     if (options->InterfaceName != NULL)
     {
@@ -202,10 +219,33 @@ static int Bootstrap_Start(Options * options)
         goto error_close_log;
     }
 
+    if (!coap_SetBatchSize(COAP_BATCH_SIZE))
+    {
+        Lwm2m_Warning("CoAP datagrams will not be batched\n");
+    }
+
     if (options->Secure)
     {
         coap_SetCertificate(bootsrapCert, sizeof(bootsrapCert), AwaCertificateFormat_PEM);
         coap_SetPSK(pskIdentity, pskKey, sizeof(pskKey));
+
+        if (options->PskFile != NULL)
+        {
+            keyStore = DTLS_KeyStore_Open(options->PskFile);
+            if (keyStore == NULL)
+            {
+                coap_Destroy();
+                result = 1;
+                goto error_close_log;
+            }
+            Lwm2m_Debug("Looking up %zu client PSKs in %s\n", DTLS_KeyStore_Count(keyStore), options->PskFile);
+            coap_SetKeyStore(keyStore);
+        }
+
+        if ((options->HandshakeWorkers > 0) && !coap_SetHandshakeWorkers(options->HandshakeWorkers))
+        {
+            Lwm2m_Warning("DTLS handshakes will run on the main thread\n");
+        }
     }
 
     Lwm2mContextType * context = Lwm2mCore_Init(coap);
@@ -220,46 +260,37 @@ static int Bootstrap_Start(Options * options)
         goto error_destroy;
     }
 
-    // wait for messages on both the IPC and CoAP interfaces
-    while (!quit)
+    // wait for messages on the CoAP interface
+    loop = EventLoop_New();
+    if ((loop == NULL) ||
+        (EventLoop_AddSignal(loop, SIGINT) != 0) ||
+        (EventLoop_AddSignal(loop, SIGTERM) != 0) ||
+        (EventLoop_AddReader(loop, coap->fd, HandleCoapMessage, NULL) != 0))
     {
-        int loop_result;
-        struct pollfd fds[1];
-        int nfds = 1;
-        int timeout;
-
-        fds[0].fd = coap->fd;
-        fds[0].events = POLLIN;
-
-        timeout = Lwm2mCore_Process(context);
+        result = 1;
+        goto error_destroy;
+    }
 
-        loop_result = poll(fds, nfds, timeout);
+    while (!quit)
+    {
+        // coap_Process() last, to send the datagrams queued by the core
+        int timeout = Lwm2mCore_Process(context);
+        timeout = EventLoop_EarliestTimeout(timeout, coap_Process());
 
-        if (loop_result < 0)
+        if (EventLoop_Wait(loop, timeout) < 0)
         {
-            if (errno == EINTR)
-            {
-                continue;
-            }
-
-            perror("poll:");
             break;
         }
-        else if (loop_result > 0)
-        {
-            if (fds[0].revents == POLLIN)
-            {
-                coap_HandleMessage();
-            }
-        }
-        coap_Process();
     }
     Lwm2m_Debug("Exit triggered\n");
 
 error_destroy:
+    EventLoop_Free(&loop);
     Lwm2mBootstrap_Destroy();
     Lwm2mCore_Destroy(context);
     coap_Destroy();
+    coap_SetKeyStore(NULL);
+    DTLS_KeyStore_Free(&keyStore);
 
 error_close_log:
     Lwm2m_Info("Bootstrap Server exiting\n");
@@ -287,6 +318,8 @@ static void PrintOptions(const Options * options)
     printf("  Daemonize      (--daemonize)      : %d\n", options->Daemonise);
     printf("  Verbose        (--verbose)        : %d\n", options->Verbose);
     printf("  LogFile        (--logFile)        : %s\n", options->LogFile ? options->LogFile : "");
+    printf("  PskFile        (--pskFile)        : %s\n", options->PskFile ? options->PskFile : "");
+    printf("  HandshakeWorkers (--handshakeWorkers) : %d\n", options->HandshakeWorkers);
     printf("  Version        (--version)        : %d\n", options->Version);
 }
 
@@ -309,6 +342,8 @@ static int ParseOptions(int argc, char ** argv, struct gengetopt_args_info * ai,
         options->Daemonise = ai->daemonize_flag;
         options->Verbose = ai->verbose_flag;
         options->LogFile = ai->logFile_arg;
+        options->PskFile = ai->pskFile_arg;
+        options->HandshakeWorkers = ai->handshakeWorkers_arg;
         options->Version = ai->version_flag;
 
         if (options->Secure && strcmp(DTLS_LibraryName, "None") == 0)
@@ -316,6 +351,24 @@ static int ParseOptions(int argc, char ** argv, struct gengetopt_args_info * ai,
             printf("Error: not built with DTLS support\n\n");
             result = EXIT_FAILURE;
         }
+
+        if ((options->PskFile != NULL) && !options->Secure)
+        {
+            printf("Error: a PSK file requires --secure\n\n");
+            result = EXIT_FAILURE;
+        }
+
+        if ((options->HandshakeWorkers > 0) && !options->Secure)
+        {
+            printf("Error: handshake workers require --secure\n\n");
+            result = EXIT_FAILURE;
+        }
+
+        if (options->HandshakeWorkers < 0)
+        {
+            printf("Error: handshake workers must not be negative\n\n");
+            result = EXIT_FAILURE;
+        }
     }
     else
     {
@@ -340,6 +393,8 @@ int main(int argc, char ** argv)
         .Daemonise = false,
         .Verbose = false,
         .LogFile = NULL,
+        .PskFile = NULL,
+        .HandshakeWorkers = 0,
         .Version = false,
     };
 
@@ -70,6 +70,9 @@ struct gengetopt_args_info
   int defaultContentType_arg;	/**< @brief Default content type to use when a request doesn't specify one (TLV=1542, JSON=50) (default='0').  */
   char * defaultContentType_orig;	/**< @brief Default content type to use when a request doesn't specify one (TLV=1542, JSON=50) original value given at command line.  */
   const char *defaultContentType_help; /**< @brief Default content type to use when a request doesn't specify one (TLV=1542, JSON=50) help description.  */
+  int notificationCoalescePeriod_arg;	/**< @brief Hold notifications for up to MS milliseconds so changes within the same period are notified together (default='0').  */
+  char * notificationCoalescePeriod_orig;	/**< @brief Hold notifications for up to MS milliseconds so changes within the same period are notified together original value given at command line.  */
+  const char *notificationCoalescePeriod_help; /**< @brief Hold notifications for up to MS milliseconds so changes within the same period are notified together help description.  */
   char ** objDefs_arg;	/**< @brief Load object and resource definitions from FILE.  */
   char ** objDefs_orig;	/**< @brief Load object and resource definitions from FILE original value given at command line.  */
   unsigned int objDefs_min; /**< @brief Load object and resource definitions from FILE's minimum occurreces */
@@ -97,6 +100,7 @@ struct gengetopt_args_info
   unsigned int pskKey_given ;	/**< @brief Whether pskKey was given.  */
   unsigned int certificate_given ;	/**< @brief Whether certificate was given.  */
   unsigned int defaultContentType_given ;	/**< @brief Whether defaultContentType was given.  */
+  unsigned int notificationCoalescePeriod_given ;	/**< @brief Whether notificationCoalescePeriod was given.  */
   unsigned int objDefs_given ;	/**< @brief Whether objDefs was given.  */
   unsigned int daemonize_given ;	/**< @brief Whether daemonize was given.  */
   unsigned int verbose_given ;	/**< @brief Whether verbose was given.  */
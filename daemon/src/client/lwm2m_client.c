@@ -20,7 +20,6 @@
  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ************************************************************************************************************************/
 
-#include <poll.h>
 #include <stdio.h>
 #include <getopt.h>
 #include <string.h>
@@ -52,6 +51,7 @@
 #include "lwm2m_server_object.h"
 #include "lwm2m_acl_object.h"
 #include "lwm2m_client_xml_handlers.h"
+#include "lwm2m_event_loop.h"
 #include "lwm2m_xml_interface.h"
 #include "lwm2m_object_defs.h"
 #include "lwm2m_client_cert.h"
@@ -72,6 +72,7 @@ typedef struct
     const char * FactoryBootstrapFile;
     const char * ObjDefsFiles[MAX_OBJDEFS_FILES];
     AwaContentType DefaultContentType;
+    int NotificationCoalescePeriod;
     size_t NumObjDefsFiles;
     bool Daemonise;
     bool Verbose;
@@ -90,6 +91,16 @@ static void Lwm2m_CtrlCSignalHandler(int dummy)
     quit = 1;
 }
 
+static void HandleCoapMessage(int fd, void * context)
+{
+    coap_HandleMessage();
+}
+
+static void HandleIpcMessage(int fd, void * context)
+{
+    xmlif_process(fd);
+}
+
 static void RegisterObjects(Lwm2mContextType * context, Options * options)
 {
     Lwm2m_Debug("Register built-in objects\n");
@@ -170,6 +181,7 @@ static int Lwm2mClient_Start(Options * options)
     uint8_t * loadedClientCert = NULL;
     int result = 0;
     uint8_t * key = NULL;
+    EventLoop * loop = NULL;
 
     if (options->Daemonise)
     {
@@ -236,6 +248,11 @@ static int Lwm2mClient_Start(Options * options)
         goto error_close_log;
     }
 
+    if (!coap_SetBatchSize(COAP_BATCH_SIZE))
+    {
+        Lwm2m_Warning("CoAP datagrams will not be batched\n");
+    }
+
     // always set key
     if (options->CertificateFile)
     {
@@ -291,6 +308,7 @@ static int Lwm2mClient_Start(Options * options)
     }
 
     Lwm2mContextType * context = Lwm2mCore_Init(coap, options->EndPointName);
+    Lwm2mCore_SetNotificationCoalescePeriod(context, options->NotificationCoalescePeriod);
 
     // Must happen after coap_Init().
     RegisterObjects(context, options);
@@ -320,46 +338,32 @@ static int Lwm2mClient_Start(Options * options)
     xmlif_RegisterHandlers();
 
     // Wait for messages on both the IPC and CoAP interfaces
-    while (!quit)
+    loop = EventLoop_New();
+    if ((loop == NULL) ||
+        (EventLoop_AddSignal(loop, SIGINT) != 0) ||
+        (EventLoop_AddSignal(loop, SIGTERM) != 0) ||
+        (EventLoop_AddReader(loop, coap->fd, HandleCoapMessage, NULL) != 0) ||
+        (EventLoop_AddReader(loop, xmlFd, HandleIpcMessage, NULL) != 0))
     {
-        int loop_result;
-        struct pollfd fds[2];
-        int nfds = 2;
-        int timeout;
-
-        fds[0].fd = coap->fd;
-        fds[0].events = POLLIN;
-
-        fds[1].fd = xmlFd;
-        fds[1].events = POLLIN;
+        result = 1;
+        goto error_xmlif;
+    }
 
-        timeout = Lwm2mCore_Process(context);
+    while (!quit)
+    {
+        // coap_Process() last, to send the datagrams queued by the core
+        int timeout = Lwm2mCore_Process(context);
+        timeout = EventLoop_EarliestTimeout(timeout, coap_Process());
 
-        loop_result = poll(fds, nfds, timeout);
-        if (loop_result < 0)
+        if (EventLoop_Wait(loop, timeout) < 0)
         {
-            if (errno == EINTR)
-            {
-                continue;
-            }
-            perror("poll:");
             break;
         }
-        else if (loop_result > 0)
-        {
-            if (fds[0].revents == POLLIN)
-            {
-                coap_HandleMessage();
-            }
-            if (fds[1].revents == POLLIN)
-            {
-                xmlif_process(fds[1].fd);
-            }
-        }
-        coap_Process();
     }
     Lwm2m_Debug("Exit triggered\n");
 
+error_xmlif:
+    EventLoop_Free(&loop);
     xmlif_DestroyExecuteHandlers();
     xmlif_destroy(xmlFd);
 error_core:
@@ -446,6 +450,7 @@ static void PrintOptions(const Options * options)
             printf("\n");
             break;
     }
+    printf("  NotificationCoalescePeriod (--notificationCoalescePeriod) : %d\n", options->NotificationCoalescePeriod);
     int i;
     for (i = 0; i < options->NumObjDefsFiles; ++i)
     {
@@ -488,6 +493,12 @@ static int ParseOptions(int argc, char ** argv, struct gengetopt_args_info * ai,
         {
             options->DefaultContentType = (AwaContentType)ai->defaultContentType_arg;
         }
+        if (ai->notificationCoalescePeriod_arg < 0)
+        {
+            printf("Error: notificationCoalescePeriod must not be negative\n\n");
+            result = EXIT_FAILURE;
+        }
+        options->NotificationCoalescePeriod = ai->notificationCoalescePeriod_arg;
         options->NumObjDefsFiles = ai->objDefs_given;
         options->Daemonise = ai->daemonize_flag;
         options->Verbose = ai->verbose_flag;
@@ -524,6 +535,7 @@ int main(int argc, char ** argv)
         .CertificateFile = NULL,
         .FactoryBootstrapFile = NULL,
         .DefaultContentType = AwaContentType_ApplicationPlainText,
+        .NotificationCoalescePeriod = 0,
         .ObjDefsFiles = {0},
         .NumObjDefsFiles = 0,
         .Daemonise = false,
@@ -0,0 +1,304 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include "lwm2m_event_loop.h"
+#include "lwm2m_list.h"
+#include "lwm2m_debug.h"
+
+#define EVENT_LOOP_MAX_EVENTS (16)
+
+typedef struct
+{
+    struct ListHead list;
+    int Fd;
+    EventLoopHandler Handler;
+    void * Context;
+
+} EventLoopReader;
+
+struct _EventLoop
+{
+    int EpollFd;
+    int TimerFd;                       // Registered with a NULL data pointer to tell it apart from the readers
+    uint64_t ArmedDeadline;            // CLOCK_MONOTONIC time in ms the timer is armed for, 0 if disarmed
+    struct ListHead Readers;
+    sigset_t Signals;                  // Signals blocked by the loop
+    sigset_t WaitMask;                 // Signal mask while waiting, with Signals unblocked
+
+};
+
+static uint64_t GetMonotonicTimeMs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+// Re-arm the timer only when the deadline moves, as most waits are for the same deadline
+static int ArmTimer(EventLoop * loop, uint64_t deadline)
+{
+    int result = 0;
+    if (deadline != loop->ArmedDeadline)
+    {
+        struct itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        spec.it_value.tv_sec = deadline / 1000;
+        spec.it_value.tv_nsec = (deadline % 1000) * 1000000;
+
+        // a zero it_value disarms the timer
+        result = timerfd_settime(loop->TimerFd, (deadline != 0) ? TFD_TIMER_ABSTIME : 0, &spec, NULL);
+        if (result == 0)
+        {
+            loop->ArmedDeadline = deadline;
+        }
+        else
+        {
+            Lwm2m_Error("Failed to set event loop timer: %s\n", strerror(errno));
+        }
+    }
+    return result;
+}
+
+EventLoop * EventLoop_New(void)
+{
+    struct epoll_event event;
+    EventLoop * loop = malloc(sizeof(EventLoop));
+    if (loop == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for event loop\n");
+        goto error;
+    }
+
+    memset(loop, 0, sizeof(EventLoop));
+    ListInit(&loop->Readers);
+    loop->TimerFd = -1;
+    sigemptyset(&loop->Signals);
+    sigprocmask(SIG_BLOCK, NULL, &loop->WaitMask);
+
+    loop->EpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->EpollFd < 0)
+    {
+        Lwm2m_Error("Failed to create epoll instance: %s\n", strerror(errno));
+        goto error;
+    }
+
+    loop->TimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (loop->TimerFd < 0)
+    {
+        Lwm2m_Error("Failed to create event loop timer: %s\n", strerror(errno));
+        goto error;
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(loop->EpollFd, EPOLL_CTL_ADD, loop->TimerFd, &event) != 0)
+    {
+        Lwm2m_Error("Failed to add event loop timer: %s\n", strerror(errno));
+        goto error;
+    }
+    return loop;
+
+error:
+    EventLoop_Free(&loop);
+    return NULL;
+}
+
+void EventLoop_Free(EventLoop ** loop)
+{
+    if ((loop != NULL) && (*loop != NULL))
+    {
+        struct ListHead * i, * n;
+        ListForEachSafe(i, n, &(*loop)->Readers)
+        {
+            EventLoopReader * reader = ListEntry(i, EventLoopReader, list);
+            ListRemove(&reader->list);
+            free(reader);
+        }
+        sigprocmask(SIG_UNBLOCK, &(*loop)->Signals, NULL);
+        if ((*loop)->TimerFd >= 0)
+        {
+            close((*loop)->TimerFd);
+        }
+        if ((*loop)->EpollFd >= 0)
+        {
+            close((*loop)->EpollFd);
+        }
+        free(*loop);
+        *loop = NULL;
+    }
+}
+
+int EventLoop_AddReader(EventLoop * loop, int fd, EventLoopHandler handler, void * context)
+{
+    struct epoll_event event;
+    EventLoopReader * reader;
+
+    if ((loop == NULL) || (fd < 0) || (handler == NULL))
+    {
+        return -1;
+    }
+
+    reader = malloc(sizeof(EventLoopReader));
+    if (reader == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for event loop reader\n");
+        return -1;
+    }
+    reader->Fd = fd;
+    reader->Handler = handler;
+    reader->Context = context;
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = reader;
+    if (epoll_ctl(loop->EpollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        Lwm2m_Error("Failed to add fd %d to event loop: %s\n", fd, strerror(errno));
+        free(reader);
+        return -1;
+    }
+
+    ListAdd(&reader->list, &loop->Readers);
+    return 0;
+}
+
+int EventLoop_RemoveReader(EventLoop * loop, int fd)
+{
+    if (loop != NULL)
+    {
+        struct ListHead * i;
+        ListForEach(i, &loop->Readers)
+        {
+            EventLoopReader * reader = ListEntry(i, EventLoopReader, list);
+            if (reader->Fd == fd)
+            {
+                // the fd may already have been closed, which removes it from the epoll set
+                epoll_ctl(loop->EpollFd, EPOLL_CTL_DEL, fd, NULL);
+                ListRemove(&reader->list);
+                free(reader);
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+int EventLoop_AddSignal(EventLoop * loop, int signum)
+{
+    sigset_t signals;
+
+    if (loop == NULL)
+    {
+        return -1;
+    }
+
+    sigemptyset(&signals);
+    sigaddset(&signals, signum);
+    if (sigprocmask(SIG_BLOCK, &signals, NULL) != 0)
+    {
+        Lwm2m_Error("Failed to block signal %d: %s\n", signum, strerror(errno));
+        return -1;
+    }
+    sigaddset(&loop->Signals, signum);
+    sigdelset(&loop->WaitMask, signum);
+    return 0;
+}
+
+int EventLoop_Wait(EventLoop * loop, int timeoutMs)
+{
+    struct epoll_event events[EVENT_LOOP_MAX_EVENTS];
+    int numEvents, i;
+    int handled = 0;
+
+    if (loop == NULL)
+    {
+        return -1;
+    }
+
+    if (timeoutMs > 0)
+    {
+        if (ArmTimer(loop, GetMonotonicTimeMs() + timeoutMs) != 0)
+        {
+            return -1;
+        }
+    }
+    else if (ArmTimer(loop, 0) != 0)
+    {
+        return -1;
+    }
+
+    // with a zero timeout, only poll; otherwise only the timer or a signal ends the wait
+    numEvents = epoll_pwait(loop->EpollFd, events, EVENT_LOOP_MAX_EVENTS, (timeoutMs == 0) ? 0 : -1, &loop->WaitMask);
+    if (numEvents < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        Lwm2m_Error("epoll_wait failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    for (i = 0; i < numEvents; i++)
+    {
+        EventLoopReader * reader = events[i].data.ptr;
+        if (reader == NULL)
+        {
+            uint64_t expirations;
+            if (read(loop->TimerFd, &expirations, sizeof(expirations)) < 0)
+            {
+                // spurious wakeup, the timer was re-armed since it fired
+            }
+            loop->ArmedDeadline = 0;
+        }
+        else
+        {
+            reader->Handler(reader->Fd, reader->Context);
+            handled++;
+        }
+    }
+    return handled;
+}
+
+int EventLoop_EarliestTimeout(int timeout1, int timeout2)
+{
+    if (timeout1 < 0)
+    {
+        return timeout2;
+    }
+    if (timeout2 < 0)
+    {
+        return timeout1;
+    }
+    return (timeout1 < timeout2) ? timeout1 : timeout2;
+}
@@ -0,0 +1,74 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#ifndef LWM2M_EVENT_LOOP_H
+#define LWM2M_EVENT_LOOP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Daemon main loop, built on epoll with a timerfd for the next deadline. The daemons register the file descriptors
+ * they read from, then repeatedly ask each module for the time until its next deadline and wait for the earliest:
+ *
+ *     while (!quit)
+ *     {
+ *         int timeout = Lwm2mCore_Process(context);
+ *         timeout = EventLoop_EarliestTimeout(timeout, coap_Process());
+ *         if (EventLoop_Wait(loop, timeout) < 0)
+ *             break;
+ *     }
+ *
+ * The loop sleeps until a file descriptor is readable or the deadline passes, so an idle daemon does not wake up.
+ * Signals that end the loop (by setting quit) are added with EventLoop_AddSignal, so they are only delivered while the
+ * loop waits and cannot be lost between checking quit and starting to wait.
+ */
+typedef struct _EventLoop EventLoop;
+
+// Called when fd is readable. Handlers may add readers, but must not remove any.
+typedef void (*EventLoopHandler)(int fd, void * context);
+
+EventLoop * EventLoop_New(void);
+void EventLoop_Free(EventLoop ** loop);
+
+int EventLoop_AddReader(EventLoop * loop, int fd, EventLoopHandler handler, void * context);
+int EventLoop_RemoveReader(EventLoop * loop, int fd);
+
+/* Block signum, except while the loop waits. A handler for signum then interrupts the wait, even if the signal was
+ * raised before the wait started. The signal is unblocked again when the loop is freed.
+ */
+int EventLoop_AddSignal(EventLoop * loop, int signum);
+
+/* Wait until a reader is readable or timeoutMs has elapsed (-1 waits indefinitely), then call the handlers of the
+ * readable file descriptors. Returns the number of handlers called (0 if the timeout expired or a signal was
+ * delivered), or -1 on error.
+ */
+int EventLoop_Wait(EventLoop * loop, int timeoutMs);
+
+// Earliest of two timeouts in milliseconds, where -1 means no timeout
+int EventLoop_EarliestTimeout(int timeout1, int timeout2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LWM2M_EVENT_LOOP_H
@@ -22,6 +22,8 @@
 
 
 #include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
 
 #include "lwm2m_ipc.h"
 
@@ -114,6 +116,18 @@ TreeNode IPC_AddClientNode(TreeNode clientsNode, const char * clientID)
     return clientNode;
 }
 
+void IPC_SetClientUpdateTime(TreeNode clientNode, uint64_t updateTime)
+{
+    TreeNode updateTimeNode = Xml_CreateNodeWithValue("UpdateTime", "%" PRIu64, updateTime);
+    TreeNode_AddChild(clientNode, updateTimeNode);
+}
+
+uint64_t IPC_GetClientUpdateTime(const TreeNode clientNode)
+{
+    const char * updateTime = (const char *)TreeNode_GetValue(TreeNode_Navigate(clientNode, "Client/UpdateTime"));
+    return (updateTime != NULL) ? strtoull(updateTime, NULL, 10) : 0;
+}
+
 int IPC_SendResponse(TreeNode responseNode, int sockfd, const struct sockaddr * fromAddr, int addrLen)
 {
     int rc = 0;
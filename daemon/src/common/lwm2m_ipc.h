@@ -24,6 +24,8 @@
 #ifndef LWM2M_IPC_H
 #define LWM2M_IPC_H
 
+#include <stdint.h>
+
 #include "lwm2m_result.h"
 #include "xmltree.h"
 #include "../../api/src/ipc_defs.h"
@@ -46,6 +48,12 @@ TreeNode IPC_NewClientsNode();
 TreeNode IPC_NewContentNode();
 TreeNode IPC_AddClientNode(TreeNode clientsNode, const char * clientID);
 
+/* Time a client last registered or updated its registration, in ms since the epoch, so that the newer of two
+ * registrations of the same client (in different server processes) can be told apart. 0 if not known.
+ */
+void IPC_SetClientUpdateTime(TreeNode clientNode, uint64_t updateTime);
+uint64_t IPC_GetClientUpdateTime(const TreeNode clientNode);
+
 // Serialise and send the IPC response back to the originator
 int IPC_SendResponse(TreeNode responseNode, int sockfd, const struct sockaddr * fromAddr, int addrLen);
 
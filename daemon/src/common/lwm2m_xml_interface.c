@@ -136,6 +136,11 @@ int xmlif_init(void * context, int port)
 
     freeaddrinfo(servinfo);
 
+    return xmlif_initSocket(context, sockfd);
+}
+
+int xmlif_initSocket(void * context, int sockfd)
+{
     // Keep track of context to use.
     g_context = context;
     ListInit(&handlerList);
@@ -206,8 +211,10 @@ int xmlif_process(int sockfd)
                         // Ensure requests have a valid SessionID
                         if (strcmp(IPC_MESSAGE_SUB_TYPE_CONNECT, value) == 0)
                         {
-                            // CONNECT requests should have no session ID - allocate one
-                            request->SessionID = IPCSession_AssignSessionID();
+                            // CONNECT requests should have no session ID - allocate one. A sharded server's
+                            // router allocates the ID itself, so that the session has the same ID in every shard.
+                            IPCSessionID sessionID = IPC_GetSessionID(root);
+                            request->SessionID = (sessionID > 0) ? sessionID : IPCSession_AssignSessionID();
                         }
                         else
                         {
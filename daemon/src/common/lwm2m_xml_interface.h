@@ -70,6 +70,9 @@ ssize_t xmlif_SendTo(int sockfd, const void *buf, size_t len, int flags,
 // Initialise XML interface
 int xmlif_init(void * context, int port);
 
+// Initialise XML interface on a socket that is already connected, such as a sharded server's link to its router
+int xmlif_initSocket(void * context, int sockfd);
+
 // Blocking call to process data on the XML interface socket
 int xmlif_process(int sockfd);
 
@@ -45,6 +45,10 @@ const char *gengetopt_args_info_help[] = {
   "  -d, --daemonize         Detach process from terminal and run in the\n                            background  (default=off)",
   "  -v, --verbose           Generate verbose output  (default=off)",
   "  -l, --logFile=FILE      Log output to FILE",
+  "  -r, --registrationStore=FILE\n                          Save client registrations to FILE and restore them\n                            on startup",
+  "  -n, --shards=N          Serve clients with N processes sharing the CoAP\n                            port  (default=`1')",
+  "  -k, --pskFile=FILE      Look up the PSK of each client identity in FILE",
+  "  -w, --handshakeWorkers=N\n                          Run DTLS handshakes on N worker threads\n                            (default=`0')",
   "  -V, --version           Print version and exit  (default=off)",
   "\nExample:\n    awa_serverd --interface eth0 --addressFamily 4 --port 5683\n\n",
     0
@@ -89,6 +93,10 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->daemonize_given = 0 ;
   args_info->verbose_given = 0 ;
   args_info->logFile_given = 0 ;
+  args_info->registrationStore_given = 0 ;
+  args_info->shards_given = 0 ;
+  args_info->pskFile_given = 0 ;
+  args_info->handshakeWorkers_given = 0 ;
   args_info->version_given = 0 ;
 }
 
@@ -115,6 +123,14 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->verbose_flag = 0;
   args_info->logFile_arg = NULL;
   args_info->logFile_orig = NULL;
+  args_info->registrationStore_arg = NULL;
+  args_info->registrationStore_orig = NULL;
+  args_info->shards_arg = 1;
+  args_info->shards_orig = NULL;
+  args_info->pskFile_arg = NULL;
+  args_info->pskFile_orig = NULL;
+  args_info->handshakeWorkers_arg = 0;
+  args_info->handshakeWorkers_orig = NULL;
   args_info->version_flag = 0;
 
 }
@@ -138,7 +154,11 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->daemonize_help = gengetopt_args_info_help[9] ;
   args_info->verbose_help = gengetopt_args_info_help[10] ;
   args_info->logFile_help = gengetopt_args_info_help[11] ;
-  args_info->version_help = gengetopt_args_info_help[12] ;
+  args_info->registrationStore_help = gengetopt_args_info_help[12] ;
+  args_info->shards_help = gengetopt_args_info_help[13] ;
+  args_info->pskFile_help = gengetopt_args_info_help[14] ;
+  args_info->handshakeWorkers_help = gengetopt_args_info_help[15] ;
+  args_info->version_help = gengetopt_args_info_help[16] ;
 
 }
 
@@ -281,6 +301,12 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   free_multiple_string_field (args_info->objDefs_given, &(args_info->objDefs_arg), &(args_info->objDefs_orig));
   free_string_field (&(args_info->logFile_arg));
   free_string_field (&(args_info->logFile_orig));
+  free_string_field (&(args_info->pskFile_arg));
+  free_string_field (&(args_info->pskFile_orig));
+  free_string_field (&(args_info->handshakeWorkers_orig));
+  free_string_field (&(args_info->registrationStore_arg));
+  free_string_field (&(args_info->registrationStore_orig));
+  free_string_field (&(args_info->shards_orig));
 
 
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -388,6 +414,14 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "verbose", 0, 0 );
   if (args_info->logFile_given)
     write_into_file(outfile, "logFile", args_info->logFile_orig, 0);
+  if (args_info->registrationStore_given)
+    write_into_file(outfile, "registrationStore", args_info->registrationStore_orig, 0);
+  if (args_info->shards_given)
+    write_into_file(outfile, "shards", args_info->shards_orig, 0);
+  if (args_info->pskFile_given)
+    write_into_file(outfile, "pskFile", args_info->pskFile_orig, 0);
+  if (args_info->handshakeWorkers_given)
+    write_into_file(outfile, "handshakeWorkers", args_info->handshakeWorkers_orig, 0);
   if (args_info->version_given)
     write_into_file(outfile, "version", 0, 0 );
 
@@ -1556,6 +1590,10 @@ cmdline_parser_internal (
         { "daemonize",	0, NULL, 'd' },
         { "verbose",	0, NULL, 'v' },
         { "logFile",	1, NULL, 'l' },
+        { "registrationStore",	1, NULL, 'r' },
+        { "shards",	1, NULL, 'n' },
+        { "pskFile",	1, NULL, 'k' },
+        { "handshakeWorkers",	1, NULL, 'w' },
         { "version",	0, NULL, 'V' },
         { 0,  0, 0, 0 }
       };
@@ -1565,7 +1603,7 @@ cmdline_parser_internal (
       custom_opterr = opterr;
       custom_optopt = optopt;
 
-      c = custom_getopt_long (argc, argv, "ha:e:f:p:i:m:so:dvl:V", long_options, &option_index);
+      c = custom_getopt_long (argc, argv, "ha:e:f:p:i:m:so:dvl:r:n:k:w:V", long_options, &option_index);
 
       optarg = custom_optarg;
       optind = custom_optind;
@@ -1703,6 +1741,54 @@ cmdline_parser_internal (
                          additional_error))
             goto failure;
 
+          break;
+        case 'r':	/* Save client registrations to FILE and restore them on startup.  */
+
+
+          if (update_arg( (void *)&(args_info->registrationStore_arg),
+                         &(args_info->registrationStore_orig), &(args_info->registrationStore_given),
+                         &(local_args_info.registrationStore_given), optarg, 0, 0, ARG_STRING,
+                         check_ambiguity, override, 0, 0,
+                         "registrationStore", 'r',
+                         additional_error))
+            goto failure;
+
+          break;
+        case 'n':	/* Serve clients with N processes sharing the CoAP port.  */
+
+
+          if (update_arg( (void *)&(args_info->shards_arg),
+                         &(args_info->shards_orig), &(args_info->shards_given),
+                         &(local_args_info.shards_given), optarg, 0, "1", ARG_INT,
+                         check_ambiguity, override, 0, 0,
+                         "shards", 'n',
+                         additional_error))
+            goto failure;
+
+          break;
+        case 'k':	/* Look up the PSK of each client identity in FILE.  */
+
+
+          if (update_arg( (void *)&(args_info->pskFile_arg),
+                         &(args_info->pskFile_orig), &(args_info->pskFile_given),
+                         &(local_args_info.pskFile_given), optarg, 0, 0, ARG_STRING,
+                         check_ambiguity, override, 0, 0,
+                         "pskFile", 'k',
+                         additional_error))
+            goto failure;
+
+          break;
+        case 'w':	/* Run DTLS handshakes on N worker threads.  */
+
+
+          if (update_arg( (void *)&(args_info->handshakeWorkers_arg),
+                         &(args_info->handshakeWorkers_orig), &(args_info->handshakeWorkers_given),
+                         &(local_args_info.handshakeWorkers_given), optarg, 0, "0", ARG_INT,
+                         check_ambiguity, override, 0, 0,
+                         "handshakeWorkers", 'w',
+                         additional_error))
+            goto failure;
+
           break;
         case 'V':	/* Print version and exit.  */
 
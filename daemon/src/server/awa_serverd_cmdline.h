@@ -70,6 +70,18 @@ struct gengetopt_args_info
   char * logFile_arg;	/**< @brief Log output to FILE.  */
   char * logFile_orig;	/**< @brief Log output to FILE original value given at command line.  */
   const char *logFile_help; /**< @brief Log output to FILE help description.  */
+  char * registrationStore_arg;	/**< @brief Save client registrations to FILE and restore them on startup.  */
+  char * registrationStore_orig;	/**< @brief Save client registrations to FILE and restore them on startup original value given at command line.  */
+  const char *registrationStore_help; /**< @brief Save client registrations to FILE and restore them on startup help description.  */
+  int shards_arg;	/**< @brief Serve clients with N processes sharing the CoAP port (default='1').  */
+  char * shards_orig;	/**< @brief Serve clients with N processes sharing the CoAP port original value given at command line.  */
+  const char *shards_help; /**< @brief Serve clients with N processes sharing the CoAP port help description.  */
+  char * pskFile_arg;	/**< @brief Look up the PSK of each client identity in FILE.  */
+  char * pskFile_orig;	/**< @brief Look up the PSK of each client identity in FILE original value given at command line.  */
+  const char *pskFile_help; /**< @brief Look up the PSK of each client identity in FILE help description.  */
+  int handshakeWorkers_arg;	/**< @brief Run DTLS handshakes on N worker threads (default='0').  */
+  char * handshakeWorkers_orig;	/**< @brief Run DTLS handshakes on N worker threads original value given at command line.  */
+  const char *handshakeWorkers_help; /**< @brief Run DTLS handshakes on N worker threads help description.  */
   int version_flag;	/**< @brief Print version and exit (default=off).  */
   const char *version_help; /**< @brief Print version and exit help description.  */
 
@@ -85,6 +97,10 @@ struct gengetopt_args_info
   unsigned int daemonize_given ;	/**< @brief Whether daemonize was given.  */
   unsigned int verbose_given ;	/**< @brief Whether verbose was given.  */
   unsigned int logFile_given ;	/**< @brief Whether logFile was given.  */
+  unsigned int registrationStore_given ;	/**< @brief Whether registrationStore was given.  */
+  unsigned int shards_given ;	/**< @brief Whether shards was given.  */
+  unsigned int pskFile_given ;	/**< @brief Whether pskFile was given.  */
+  unsigned int handshakeWorkers_given ;	/**< @brief Whether handshakeWorkers was given.  */
   unsigned int version_given ;	/**< @brief Whether version was given.  */
 
   char **inputs ; /**< @brief unamed options (options without names) */
@@ -20,7 +20,6 @@
  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ************************************************************************************************************************/
 
-#include <poll.h>
 #include <stdio.h>
 #include <getopt.h>
 #include <string.h>
@@ -38,6 +37,8 @@
 #include <errno.h>
 #include <signal.h>
 #include <time.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
 
 #include "awa_serverd_cmdline.h"
 #include "objdefs.h"
@@ -45,6 +46,9 @@
 #include "coap_abstraction.h"
 #include "dtls_abstraction.h"
 #include "lwm2m_server_xml_handlers.h"
+#include "lwm2m_server_registration_store.h"
+#include "lwm2m_server_shard_router.h"
+#include "lwm2m_event_loop.h"
 #include "lwm2m_xml_interface.h"
 #include "lwm2m_core.h"
 #include "lwm2m_serdes.h"
@@ -70,12 +74,17 @@ typedef struct
     bool Daemonise;
     bool Verbose;
     char * LogFile;
+    char * RegistrationStoreFile;
+    int Shards;
+    char * PskFile;
+    int HandshakeWorkers;
     bool Version;
 } Options;
 
 static FILE * logFile = NULL;
 static const char * version = VERSION;  // from Makefile
 static volatile int quit = 0;
+static volatile int shardExited = 0;
 
 static void PrintOptions(const Options * options);
 
@@ -84,6 +93,31 @@ static void Lwm2m_CtrlCSignalHandler(int dummy)
     quit = 1;
 }
 
+static void Lwm2m_ChildSignalHandler(int dummy)
+{
+    shardExited = 1;
+}
+
+static void HandleCoapMessage(int fd, void * context)
+{
+    coap_HandleMessage();
+}
+
+static void HandleIpcMessage(int fd, void * context)
+{
+    xmlif_process(fd);
+}
+
+static void HandleRouterRequest(int fd, void * context)
+{
+    ShardRouter_HandleRequest((ShardRouter *)context);
+}
+
+static void HandleShardMessage(int fd, void * context)
+{
+    ShardRouter_HandleShardMessage((ShardRouter *)context, fd);
+}
+
 // Fork off a daemon process, the parent will exit at this point
 static void Daemonise(bool verbose)
 {
@@ -120,9 +154,302 @@ static void Daemonise(bool verbose)
     close (STDERR_FILENO);
 }
 
+/* Serve clients until told to quit. A shard (linkFd >= 0) shares the CoAP port with the other shards and serves
+ * IPC requests from the router on linkFd, instead of on the IPC port.
+ */
+static int RunServer(Options * options, const char * ipAddress, int linkFd, const char * registrationStoreFile)
+{
+    int xmlFd = -1;
+    int result = 0;
+    RegistrationStore * registrationStore = NULL;
+    DTLS_KeyStore * keyStore = NULL;
+    EventLoop * loop = NULL;
+    CoapInfo * coap;
+
+    srandom((int)time(NULL)*getpid());
+
+    if (linkFd >= 0)
+    {
+        coap = coap_InitShared(ipAddress, options->CoapPort, options->Secure, (options->Verbose) ? DebugLevel_Debug : DebugLevel_Info);
+    }
+    else
+    {
+        coap = coap_Init(ipAddress, options->CoapPort, options->Secure, (options->Verbose) ? DebugLevel_Debug : DebugLevel_Info);
+    }
+    if (coap == NULL)
+    {
+        printf("Unable to map address to network interface\n");
+        return 1;
+    }
+
+    if (!coap_SetBatchSize(COAP_BATCH_SIZE))
+    {
+        Lwm2m_Warning("CoAP datagrams will not be batched\n");
+    }
+
+    if (options->Secure)
+    {
+    	coap_SetCertificate(serverCert, sizeof(serverCert), AwaCertificateFormat_PEM);
+        coap_SetPSK(pskIdentity, pskKey, sizeof(pskKey));
+
+        // mapped rather than loaded when sorted, so that shards share the pages of a large file
+        if (options->PskFile != NULL)
+        {
+            keyStore = DTLS_KeyStore_Open(options->PskFile);
+            if (keyStore == NULL)
+            {
+                coap_Destroy();
+                return 1;
+            }
+            Lwm2m_Debug("Looking up %zu client PSKs in %s\n", DTLS_KeyStore_Count(keyStore), options->PskFile);
+            coap_SetKeyStore(keyStore);
+        }
+
+        if ((options->HandshakeWorkers > 0) && !coap_SetHandshakeWorkers(options->HandshakeWorkers))
+        {
+            Lwm2m_Warning("DTLS handshakes will run on the main thread\n");
+        }
+    }
+
+    Lwm2mContextType * context = Lwm2mCore_Init(NULL, options->ContentType);  // NULL, don't map coap with objectStore
+
+    // must happen after coap_Init()
+    Lwm2m_RegisterObjectTypes(context);
+
+    // load any specified objDef files
+    if (LoadObjectDefinitionsFromFiles(context, options->ObjDefsFiles, options->NumObjDefsFiles) != 0)
+    {
+        result = 1;
+        goto error_destroy_core;
+    }
+
+    // restore registrations saved by the previous server before servicing the CoAP socket, so that registered
+    // clients are served without having to register again
+    if (registrationStoreFile != NULL)
+    {
+        registrationStore = RegistrationStore_New(context, registrationStoreFile);
+        if (registrationStore == NULL)
+        {
+            result = 1;
+            goto error_destroy_core;
+        }
+    }
+
+    // listen for UDP packets on IPC port, or for requests from the router
+    xmlFd = (linkFd >= 0) ? xmlif_initSocket(context, linkFd) : xmlif_init(context, options->IpcPort);
+    if (xmlFd < 0)
+    {
+        result = 1;
+        goto error_destroy;
+    }
+    xmlif_RegisterHandlers();
+
+    // wait for messages on both the IPC and CoAP interfaces
+    loop = EventLoop_New();
+    if ((loop == NULL) ||
+        (EventLoop_AddSignal(loop, SIGINT) != 0) ||
+        (EventLoop_AddSignal(loop, SIGTERM) != 0) ||
+        (EventLoop_AddReader(loop, coap->fd, HandleCoapMessage, NULL) != 0) ||
+        (EventLoop_AddReader(loop, xmlFd, HandleIpcMessage, NULL) != 0))
+    {
+        result = 1;
+        goto error_destroy;
+    }
+
+    // sleep until a message arrives, or until the earliest registration expiry, CoAP retransmission or snapshot
+    while (!quit)
+    {
+        int timeout = Lwm2mCore_Process(context);
+        timeout = EventLoop_EarliestTimeout(timeout, coap_Process());
+        timeout = EventLoop_EarliestTimeout(timeout, RegistrationStore_Process(registrationStore));
+
+        if (EventLoop_Wait(loop, timeout) < 0)
+        {
+            break;
+        }
+    }
+    Lwm2m_Debug("Exit triggered\n");
+
+error_destroy:
+    EventLoop_Free(&loop);
+    xmlif_destroy(xmlFd);
+    RegistrationStore_Free(&registrationStore);
+error_destroy_core:
+    Lwm2mCore_Destroy(context);
+    coap_Destroy();
+    coap_SetKeyStore(NULL);
+    DTLS_KeyStore_Free(&keyStore);
+    return result;
+}
+
+// Start a shard process, which serves the clients the kernel assigns to it until the router exits
+static pid_t StartShard(Options * options, const char * ipAddress, int shard, int * linkFd, const int * otherFds, int numOtherFds)
+{
+    int link[2];
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, link) != 0)
+    {
+        Lwm2m_Error("Failed to create shard link: %s\n", strerror(errno));
+        return -1;
+    }
+
+    // don't let the shard flush output buffered before the fork a second time
+    fflush(NULL);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        int result = 1;
+        int i;
+        for (i = 0; i < numOtherFds; i++)
+        {
+            close(otherFds[i]);
+        }
+        close(link[0]);
+        signal(SIGCHLD, SIG_DFL);
+        prctl(PR_SET_PDEATHSIG, SIGTERM);
+
+        // each shard keeps the registrations of its own clients
+        char * registrationStoreFile = NULL;
+        if (options->RegistrationStoreFile != NULL)
+        {
+            registrationStoreFile = malloc(strlen(options->RegistrationStoreFile) + 16);
+            if (registrationStoreFile == NULL)
+            {
+                exit(result);
+            }
+            sprintf(registrationStoreFile, "%s.%d", options->RegistrationStoreFile, shard);
+        }
+
+        result = RunServer(options, ipAddress, link[1], registrationStoreFile);
+        free(registrationStoreFile);
+        exit(result);
+    }
+
+    close(link[1]);
+    if (pid < 0)
+    {
+        Lwm2m_Error("Failed to start shard: %s\n", strerror(errno));
+        close(link[0]);
+        return -1;
+    }
+    *linkFd = link[0];
+    return pid;
+}
+
+/* Serve clients with options->Shards processes sharing the CoAP port, and route IPC requests to them. Exits when
+ * told to quit, or if a shard exits.
+ */
+static int RunShards(Options * options, const char * ipAddress)
+{
+    int result = 1;
+    int ipcFd = -1;
+    int numShards = 0;
+    bool serving = false;
+    ShardRouter * router = NULL;
+    EventLoop * loop = NULL;
+    pid_t * pids = malloc(options->Shards * sizeof(pid_t));
+    int * fds = malloc((options->Shards + 1) * sizeof(int));   // IPC socket, then shard links
+    int i;
+
+    if ((pids == NULL) || (fds == NULL))
+    {
+        Lwm2m_Error("Failed to allocate memory for shards\n");
+        goto error;
+    }
+
+    ipcFd = xmlif_init(NULL, options->IpcPort);
+    if (ipcFd < 0)
+    {
+        goto error;
+    }
+    fds[0] = ipcFd;
+
+    router = ShardRouter_New(ipcFd);
+    loop = EventLoop_New();
+    signal(SIGCHLD, Lwm2m_ChildSignalHandler);
+    if ((router == NULL) || (loop == NULL) ||
+        (EventLoop_AddSignal(loop, SIGINT) != 0) ||
+        (EventLoop_AddSignal(loop, SIGTERM) != 0) ||
+        (EventLoop_AddSignal(loop, SIGCHLD) != 0))
+    {
+        goto error;
+    }
+
+    while (!quit && !shardExited)
+    {
+        int timeout = ShardRouter_Process(router);
+        ShardRouterState state = ShardRouter_GetState(router);
+        if (state == ShardRouterState_Failed)
+        {
+            goto error;
+        }
+
+        // start the shards one at a time, so that they join the port in the same order every time and the kernel
+        // assigns clients to the same shards after a restart
+        if ((state == ShardRouterState_Ready) && (numShards < options->Shards))
+        {
+            int linkFd;
+            pid_t pid = StartShard(options, ipAddress, numShards, &linkFd, fds, numShards + 1);
+            if (pid < 0)
+            {
+                goto error;
+            }
+            pids[numShards] = pid;
+            fds[++numShards] = linkFd;
+            Lwm2m_Info("  Shard %d        : process %d\n", numShards - 1, pid);
+
+            if ((ShardRouter_AddShard(router, linkFd) != 0) || (EventLoop_AddReader(loop, linkFd, HandleShardMessage, router) != 0))
+            {
+                goto error;
+            }
+            continue;
+        }
+
+        // serve the API once every shard is ready, so that every session is connected to all of them
+        if ((state == ShardRouterState_Ready) && !serving)
+        {
+            if (EventLoop_AddReader(loop, ipcFd, HandleRouterRequest, router) != 0)
+            {
+                goto error;
+            }
+            serving = true;
+        }
+
+        if (EventLoop_Wait(loop, timeout) < 0)
+        {
+            break;
+        }
+    }
+
+    if (shardExited)
+    {
+        Lwm2m_Error("Shard exited unexpectedly\n");
+    }
+    else
+    {
+        result = 0;
+    }
+
+error:
+    for (i = 0; i < numShards; i++)
+    {
+        kill(pids[i], SIGTERM);
+    }
+    for (i = 0; i < numShards; i++)
+    {
+        waitpid(pids[i], NULL, 0);
+        close(fds[i + 1]);
+    }
+    EventLoop_Free(&loop);
+    ShardRouter_Free(&router);
+    xmlif_destroy(ipcFd);
+    free(fds);
+    free(pids);
+    return result;
+}
+
 static int Lwm2mServer_Start(Options * options)
 {
-    int xmlFd;
     int result = 0;
 
     if (options->Daemonise)
@@ -173,6 +500,18 @@ static int Lwm2mServer_Start(Options * options)
     Lwm2m_Info("  CoAP port      : %d\n", options->CoapPort);
     Lwm2m_Info("  CoAP Security  : %s\n", options->Secure ? "DTLS": "None");
     Lwm2m_Info("  IPC port       : %d\n", options->IpcPort);
+    if (options->RegistrationStoreFile != NULL)
+    {
+        Lwm2m_Info("  Registrations  : %s\n", options->RegistrationStoreFile);
+    }
+    if (options->PskFile != NULL)
+    {
+        Lwm2m_Info("  PSK file       : %s\n", options->PskFile);
+    }
+    if (options->HandshakeWorkers > 0)
+    {
+        Lwm2m_Info("  DTLS workers   : %d\n", options->HandshakeWorkers);
+    }
 
     if (options->InterfaceName != NULL)
     {
@@ -199,88 +538,15 @@ static int Lwm2mServer_Start(Options * options)
         ipAddress[NI_MAXHOST - 1] = '\0'; // Defensive
     }
 
-    srandom((int)time(NULL)*getpid());
-
-    CoapInfo * coap = coap_Init(ipAddress, options->CoapPort, options->Secure, (options->Verbose) ? DebugLevel_Debug : DebugLevel_Info);
-    if (coap == NULL)
+    if (options->Shards > 1)
     {
-        printf("Unable to map address to network interface\n");
-        result = 1;
-        goto error_close_log;
+        Lwm2m_Info("  Shards         : %d\n", options->Shards);
+        result = RunShards(options, ipAddress);
     }
-
-    if (options->Secure)
-    {
-    	coap_SetCertificate(serverCert, sizeof(serverCert), AwaCertificateFormat_PEM);
-        coap_SetPSK(pskIdentity, pskKey, sizeof(pskKey));
-    }
-
-    Lwm2mContextType * context = Lwm2mCore_Init(NULL, options->ContentType);  // NULL, don't map coap with objectStore
-
-    // must happen after coap_Init()
-    Lwm2m_RegisterObjectTypes(context);
-
-    // load any specified objDef files
-    if (LoadObjectDefinitionsFromFiles(context, options->ObjDefsFiles, options->NumObjDefsFiles) != 0)
-    {
-        goto error_close_log;
-    }
-
-    // listen for UDP packets on IPC port
-    xmlFd = xmlif_init(context, options->IpcPort);
-    if (xmlFd < 0)
+    else
     {
-        result = 1;
-        goto error_destroy;
+        result = RunServer(options, ipAddress, -1, options->RegistrationStoreFile);
     }
-    xmlif_RegisterHandlers();
-
-    // wait for messages on both the IPC and CoAP interfaces
-    while (!quit)
-    {
-        int loop_result;
-        struct pollfd fds[2];
-        int nfds = 2;
-        int timeout;
-
-        fds[0].fd = coap->fd;
-        fds[0].events = POLLIN;
-
-        fds[1].fd = xmlFd;
-        fds[1].events = POLLIN;
-
-        timeout = Lwm2mCore_Process(context);
-
-        loop_result = poll(fds, nfds, timeout);
-
-        if (loop_result < 0)
-        {
-            if (errno == EINTR)
-            {
-                continue;
-            }
-            perror("poll:");
-            break;
-        }
-        else if (loop_result > 0)
-        {
-            if (fds[0].revents == POLLIN)
-            {
-                coap_HandleMessage();
-            }
-            if (fds[1].revents == POLLIN)
-            {
-                xmlif_process(fds[1].fd);
-            }
-        }
-        coap_Process();
-    }
-    Lwm2m_Debug("Exit triggered\n");
-
-error_destroy:
-    xmlif_destroy(xmlFd);
-    Lwm2mCore_Destroy(context);
-    coap_Destroy();
 
 error_close_log:
     Lwm2m_Info("Server exiting\n");
@@ -310,6 +576,10 @@ static void PrintOptions(const Options * options)
     printf("  Daemonize         (--daemonize)      : %d\n", options->Daemonise);
     printf("  Verbose           (--verbose)        : %d\n", options->Verbose);
     printf("  LogFile           (--logFile)        : %s\n", options->LogFile ? options->LogFile : "");
+    printf("  RegistrationStore (--registrationStore) : %s\n", options->RegistrationStoreFile ? options->RegistrationStoreFile : "");
+    printf("  Shards            (--shards)         : %d\n", options->Shards);
+    printf("  PskFile           (--pskFile)        : %s\n", options->PskFile ? options->PskFile : "");
+    printf("  HandshakeWorkers  (--handshakeWorkers) : %d\n", options->HandshakeWorkers);
     printf("  Version           (--version)        : %d\n", options->Version);
 }
 
@@ -334,6 +604,10 @@ static int ParseOptions(int argc, char ** argv, struct gengetopt_args_info * ai,
         options->Daemonise = ai->daemonize_flag;
         options->Verbose = ai->verbose_flag;
         options->LogFile = ai->logFile_arg;
+        options->RegistrationStoreFile = ai->registrationStore_arg;
+        options->Shards = ai->shards_arg;
+        options->PskFile = ai->pskFile_arg;
+        options->HandshakeWorkers = ai->handshakeWorkers_arg;
         options->Version = ai->version_flag;
 
         if (options->Secure && strcmp(DTLS_LibraryName, "None") == 0)
@@ -341,6 +615,30 @@ static int ParseOptions(int argc, char ** argv, struct gengetopt_args_info * ai,
             printf("Error: not built with DTLS support\n\n");
             result = EXIT_FAILURE;
         }
+
+        if ((options->PskFile != NULL) && !options->Secure)
+        {
+            printf("Error: a PSK file requires --secure\n\n");
+            result = EXIT_FAILURE;
+        }
+
+        if ((options->HandshakeWorkers > 0) && !options->Secure)
+        {
+            printf("Error: handshake workers require --secure\n\n");
+            result = EXIT_FAILURE;
+        }
+
+        if (options->HandshakeWorkers < 0)
+        {
+            printf("Error: handshake workers must not be negative\n\n");
+            result = EXIT_FAILURE;
+        }
+
+        if (options->Shards < 1)
+        {
+            printf("Error: shards must be at least 1\n\n");
+            result = EXIT_FAILURE;
+        }
     }
     else
     {
@@ -367,6 +665,10 @@ int main(int argc, char ** argv)
         .Daemonise = false,
         .Verbose = false,
         .LogFile = NULL,
+        .RegistrationStoreFile = NULL,
+        .Shards = 1,
+        .PskFile = NULL,
+        .HandshakeWorkers = 0,
         .Version = false,
     };
 
@@ -0,0 +1,605 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "lwm2m_server_registration_store.h"
+#include "lwm2m_core.h"
+#include "lwm2m_debug.h"
+#include "lwm2m_list.h"
+#include "lwm2m_util.h"
+#include "lwm2m_hash_table.h"
+
+#define REGISTRATION_STORE_MAGIC              "AWRS"
+#define REGISTRATION_STORE_VERSION            (1)
+#define REGISTRATION_STORE_JOURNAL_SUFFIX     ".journal"
+#define REGISTRATION_STORE_TEMP_SUFFIX        ".tmp"
+
+// Compact the journal at least this often, or as soon as it outgrows the snapshot (and this minimum size)
+#define REGISTRATION_STORE_SNAPSHOT_INTERVAL_MS  (60 * 1000)
+#define REGISTRATION_STORE_MIN_COMPACT_SIZE      (64 * 1024)
+
+#define RECORD_ALIGNMENT (8)
+#define ALIGN_RECORD(x) (((x) + RECORD_ALIGNMENT - 1) & ~((size_t)RECORD_ALIGNMENT - 1))
+
+typedef enum
+{
+    RegistrationRecordType_Register = 1,      // Full client state, replaces any earlier record for the client
+    RegistrationRecordType_Deregister = 2,
+
+} RegistrationRecordType;
+
+// Snapshot and journal files start with this header. Files are only read back on the host that wrote them.
+typedef struct
+{
+    char Magic[4];
+    uint32_t Version;
+    uint32_t RecordHeaderSize;                // Guards against reading a file written by an incompatible build
+    uint32_t Reserved;
+
+} StoreFileHeader;
+
+/* Each record is a RecordHeader, NumEntries ObjectListEntry structures and the NUL terminated endpoint name,
+ * padded to RECORD_ALIGNMENT so that the next record (and the entries) can be used in place when mapped.
+ */
+typedef struct
+{
+    uint32_t Length;                          // Bytes following Checksum, including padding
+    uint32_t Checksum;                        // Hash of the bytes following this field
+    int64_t ExpiryTime;                       // Wall clock time the registration expires, in ms since the epoch
+    int32_t Location;
+    int32_t LifeTime;
+    uint32_t NumEntries;
+    uint16_t NameLength;                      // Including NUL terminator
+    uint8_t Type;
+    uint8_t BindingMode;
+    uint8_t SupportsJson;
+    uint8_t Reserved[7];
+    AddressType Address;
+
+} RecordHeader;
+
+#define RECORD_CHECKSUM_OFFSET (offsetof(RecordHeader, ExpiryTime))
+
+struct _RegistrationStore
+{
+    Lwm2mContextType * Context;
+    char * SnapshotPath;
+    char * JournalPath;
+    char * TempPath;
+    int JournalFd;
+    size_t JournalSize;
+    size_t SnapshotSize;
+    uint64_t LastSnapshotTime;
+
+};
+
+static int64_t GetWallClockMs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static void InitFileHeader(StoreFileHeader * header)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->Magic, REGISTRATION_STORE_MAGIC, sizeof(header->Magic));
+    header->Version = REGISTRATION_STORE_VERSION;
+    header->RecordHeaderSize = sizeof(RecordHeader);
+}
+
+static bool IsValidFileHeader(const StoreFileHeader * header)
+{
+    StoreFileHeader expected;
+    InitFileHeader(&expected);
+    return memcmp(header, &expected, sizeof(expected)) == 0;
+}
+
+static char * MakePath(const char * path, const char * suffix)
+{
+    char * result = malloc(strlen(path) + strlen(suffix) + 1);
+    if (result != NULL)
+    {
+        sprintf(result, "%s%s", path, suffix);
+    }
+    return result;
+}
+
+static int WriteAll(int fd, const void * buffer, size_t length)
+{
+    const char * data = buffer;
+    while (length > 0)
+    {
+        ssize_t written = write(fd, data, length);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+        data += written;
+        length -= written;
+    }
+    return 0;
+}
+
+/* Encode the client's registration into a newly allocated record. The expiry is converted from the monotonic
+ * tick count to wall clock time, as tick counts are not comparable across restarts.
+ */
+static void * EncodeRecord(RegistrationRecordType type, const Lwm2mClientType * client, int64_t nowWallMs, uint64_t nowTickMs, size_t * recordLength)
+{
+    size_t numEntries = ((type == RegistrationRecordType_Register) && (client->ObjectList != NULL)) ? client->ObjectList->Count : 0;
+    size_t nameLength = strlen(client->EndPointName) + 1;
+    size_t entriesLength = numEntries * sizeof(ObjectListEntry);
+    size_t length = ALIGN_RECORD(sizeof(RecordHeader) + entriesLength + nameLength);
+    int64_t remainingMs = 0;
+
+    if (nameLength > UINT16_MAX)
+    {
+        Lwm2m_Error("Endpoint name too long to store: \'%s\'\n", client->EndPointName);
+        return NULL;
+    }
+
+    char * record = malloc(length);
+    if (record == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for registration record\n");
+        return NULL;
+    }
+    memset(record, 0, length);
+
+    if (client->ExpiryEntry.Deadline > nowTickMs)
+    {
+        remainingMs = client->ExpiryEntry.Deadline - nowTickMs;
+    }
+
+    RecordHeader * header = (RecordHeader *)record;
+    header->Length = length - RECORD_CHECKSUM_OFFSET;
+    header->ExpiryTime = nowWallMs + remainingMs;
+    header->Location = client->Location;
+    header->LifeTime = client->LifeTime;
+    header->NumEntries = numEntries;
+    header->NameLength = nameLength;
+    header->Type = type;
+    header->BindingMode = client->BindingMode;
+    header->SupportsJson = client->SupportsJson ? 1 : 0;
+    memcpy(&header->Address, &client->Address, sizeof(AddressType));
+
+    if (numEntries > 0)
+    {
+        memcpy(record + sizeof(RecordHeader), client->ObjectList->Entries, entriesLength);
+    }
+    memcpy(record + sizeof(RecordHeader) + entriesLength, client->EndPointName, nameLength);
+
+    header->Checksum = HashTable_HashBytes(0, record + RECORD_CHECKSUM_OFFSET, header->Length);
+
+    *recordLength = length;
+    return record;
+}
+
+// Validate the record at data and return its total length, or 0 if it is truncated or corrupt
+static size_t DecodeRecord(const char * data, size_t available, const RecordHeader ** header, const ObjectListEntry ** entries, const char ** name)
+{
+    const RecordHeader * record = (const RecordHeader *)data;
+    size_t length;
+
+    if (available < sizeof(RecordHeader))
+    {
+        return 0;
+    }
+
+    length = RECORD_CHECKSUM_OFFSET + (size_t)record->Length;
+    if ((length > available) || (length < sizeof(RecordHeader)) || (length != ALIGN_RECORD(length)))
+    {
+        return 0;
+    }
+    if (HashTable_HashBytes(0, data + RECORD_CHECKSUM_OFFSET, record->Length) != record->Checksum)
+    {
+        return 0;
+    }
+    if ((record->NameLength == 0) || ((size_t)record->NumEntries > (length - sizeof(RecordHeader)) / sizeof(ObjectListEntry)) ||
+        (sizeof(RecordHeader) + (size_t)record->NumEntries * sizeof(ObjectListEntry) + record->NameLength > length))
+    {
+        return 0;
+    }
+
+    *header = record;
+    *entries = (const ObjectListEntry *)(data + sizeof(RecordHeader));
+    *name = data + sizeof(RecordHeader) + record->NumEntries * sizeof(ObjectListEntry);
+
+    if ((*name)[record->NameLength - 1] != '\0')
+    {
+        return 0;
+    }
+    return length;
+}
+
+static void ReplayRecord(Lwm2mContextType * context, const RecordHeader * header, const ObjectListEntry * entries, const char * name, int64_t nowWallMs)
+{
+    Lwm2mClientType * client;
+
+    if ((header->Type == RegistrationRecordType_Register) && (header->ExpiryTime > nowWallMs))
+    {
+        int64_t remainingMs = header->ExpiryTime - nowWallMs;
+        AddressType address;
+
+        memcpy(&address, &header->Address, sizeof(AddressType));
+        Lwm2m_RestoreClient(context, name, header->Location, header->LifeTime, header->BindingMode, header->SupportsJson != 0,
+                            &address, entries, header->NumEntries, (remainingMs > UINT32_MAX) ? UINT32_MAX : (uint32_t)remainingMs);
+    }
+    else if ((client = Lwm2m_LookupClientByName(context, name)) != NULL)
+    {
+        // deregistered, or expired while the server was down
+        Lwm2m_RemoveClient(context, client);
+    }
+}
+
+/* Replay the records in the file at path into the context. A missing file is treated as empty. Replay stops at
+ * the first truncated or corrupt record, which can only be the tail of a journal written when the server stopped.
+ * Returns the number of records replayed, or -1 if the file exists but is not a registration store.
+ */
+static int ReplayFile(Lwm2mContextType * context, const char * path)
+{
+    int result = -1;
+    struct stat st;
+    char * data = MAP_FAILED;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        if (errno == ENOENT)
+        {
+            result = 0;
+        }
+        else
+        {
+            Lwm2m_Error("Failed to open %s: %s\n", path, strerror(errno));
+        }
+        goto done;
+    }
+
+    if (fstat(fd, &st) != 0)
+    {
+        Lwm2m_Error("Failed to stat %s: %s\n", path, strerror(errno));
+        goto done;
+    }
+
+    if (st.st_size == 0)
+    {
+        result = 0;
+        goto done;
+    }
+
+    if ((size_t)st.st_size < sizeof(StoreFileHeader))
+    {
+        Lwm2m_Error("%s is not a registration store\n", path);
+        goto done;
+    }
+
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        Lwm2m_Error("Failed to map %s: %s\n", path, strerror(errno));
+        goto done;
+    }
+
+    if (!IsValidFileHeader((const StoreFileHeader *)data))
+    {
+        Lwm2m_Error("%s is not a registration store, or was written by an incompatible server\n", path);
+        goto done;
+    }
+
+    int64_t nowWallMs = GetWallClockMs();
+    size_t offset = sizeof(StoreFileHeader);
+    result = 0;
+    while (offset < (size_t)st.st_size)
+    {
+        const RecordHeader * header;
+        const ObjectListEntry * entries;
+        const char * name;
+        size_t length = DecodeRecord(data + offset, st.st_size - offset, &header, &entries, &name);
+        if (length == 0)
+        {
+            Lwm2m_Warning("Ignoring incomplete registration record at offset %zu in %s\n", offset, path);
+            break;
+        }
+
+        ReplayRecord(context, header, entries, name, nowWallMs);
+        offset += length;
+        result++;
+    }
+
+done:
+    if (data != MAP_FAILED)
+    {
+        munmap(data, st.st_size);
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return result;
+}
+
+// Sync the directory containing path, so that a file renamed into it survives a power failure
+static int SyncDirectory(const char * path)
+{
+    int result = -1;
+    int fd = -1;
+    char * directory = strdup(path);
+
+    if (directory == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for path %s\n", path);
+        goto done;
+    }
+
+    fd = open(dirname(directory), O_RDONLY | O_DIRECTORY);
+    if ((fd < 0) || (fsync(fd) != 0))
+    {
+        Lwm2m_Error("Failed to sync directory of %s: %s\n", path, strerror(errno));
+        goto done;
+    }
+    result = 0;
+
+done:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    free(directory);
+    return result;
+}
+
+// Start a new, empty journal. Everything journalled so far must already be in the snapshot.
+static int ResetJournal(RegistrationStore * store)
+{
+    StoreFileHeader header;
+    InitFileHeader(&header);
+
+    if ((ftruncate(store->JournalFd, 0) != 0) || (WriteAll(store->JournalFd, &header, sizeof(header)) != 0))
+    {
+        Lwm2m_Error("Failed to reset journal %s: %s\n", store->JournalPath, strerror(errno));
+        return -1;
+    }
+    store->JournalSize = sizeof(header);
+    return 0;
+}
+
+/* Write every current registration to a new snapshot, atomically replace the old snapshot with it and empty the
+ * journal. If the server stops between the rename and the journal reset, replaying the old journal over the new
+ * snapshot yields the same registrations, as each record carries the client's full state.
+ */
+static int WriteSnapshot(RegistrationStore * store)
+{
+    int result = -1;
+    StoreFileHeader header;
+    int64_t nowWallMs = GetWallClockMs();
+    uint64_t nowTickMs = Lwm2mCore_GetTickCountMs();
+    size_t snapshotSize = sizeof(header);
+    struct ListHead * i;
+
+    // registrations include client addresses, keep them private
+    FILE * file = NULL;
+    int fd = open(store->TempPath, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if ((fd < 0) || ((file = fdopen(fd, "wb")) == NULL))
+    {
+        Lwm2m_Error("Failed to create %s: %s\n", store->TempPath, strerror(errno));
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        goto done;
+    }
+
+    InitFileHeader(&header);
+    if (fwrite(&header, sizeof(header), 1, file) != 1)
+    {
+        goto write_error;
+    }
+
+    ListForEach(i, Lwm2mCore_GetClientList(store->Context))
+    {
+        Lwm2mClientType * client = ListEntry(i, Lwm2mClientType, list);
+        size_t length;
+        void * record = EncodeRecord(RegistrationRecordType_Register, client, nowWallMs, nowTickMs, &length);
+        if (record != NULL)
+        {
+            size_t written = fwrite(record, length, 1, file);
+            free(record);
+            if (written != 1)
+            {
+                goto write_error;
+            }
+            snapshotSize += length;
+        }
+    }
+
+    if ((fflush(file) != 0) || (fsync(fileno(file)) != 0))
+    {
+        goto write_error;
+    }
+    fclose(file);
+    file = NULL;
+
+    if (rename(store->TempPath, store->SnapshotPath) != 0)
+    {
+        Lwm2m_Error("Failed to replace %s: %s\n", store->SnapshotPath, strerror(errno));
+        goto done;
+    }
+
+    // the journal must not be reset until the new snapshot is durable
+    if (SyncDirectory(store->SnapshotPath) != 0)
+    {
+        goto done;
+    }
+
+    store->SnapshotSize = snapshotSize;
+    store->LastSnapshotTime = nowTickMs;
+    result = ResetJournal(store);
+    Lwm2m_Debug("Registration snapshot written to %s (%zu bytes)\n", store->SnapshotPath, snapshotSize);
+    goto done;
+
+write_error:
+    Lwm2m_Error("Failed to write %s: %s\n", store->TempPath, strerror(errno));
+    fclose(file);
+    file = NULL;
+    unlink(store->TempPath);
+done:
+    return result;
+}
+
+static void JournalRegistrationEvent(RegistrationEventType eventType, void * context, void * parameter)
+{
+    RegistrationStore * store = (RegistrationStore *)context;
+    const Lwm2mClientType * client = (const Lwm2mClientType *)parameter;
+    RegistrationRecordType type = (eventType == RegistrationEventType_Deregister) ? RegistrationRecordType_Deregister : RegistrationRecordType_Register;
+    size_t length;
+
+    void * record = EncodeRecord(type, client, GetWallClockMs(), Lwm2mCore_GetTickCountMs(), &length);
+    if (record != NULL)
+    {
+        // Not synced: a server crash keeps the record in the page cache, only a power failure can lose the tail
+        if (WriteAll(store->JournalFd, record, length) == 0)
+        {
+            store->JournalSize += length;
+        }
+        else
+        {
+            Lwm2m_Error("Failed to write journal %s: %s\n", store->JournalPath, strerror(errno));
+        }
+        free(record);
+    }
+}
+
+RegistrationStore * RegistrationStore_New(Lwm2mContextType * context, const char * path)
+{
+    int snapshotRecords, journalRecords;
+    RegistrationStore * store = malloc(sizeof(RegistrationStore));
+    if (store == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for registration store\n");
+        goto error;
+    }
+
+    memset(store, 0, sizeof(RegistrationStore));
+    store->Context = context;
+    store->JournalFd = -1;
+    store->SnapshotPath = strdup(path);
+    store->JournalPath = MakePath(path, REGISTRATION_STORE_JOURNAL_SUFFIX);
+    store->TempPath = MakePath(path, REGISTRATION_STORE_TEMP_SUFFIX);
+    if ((store->SnapshotPath == NULL) || (store->JournalPath == NULL) || (store->TempPath == NULL))
+    {
+        Lwm2m_Error("Failed to allocate memory for registration store\n");
+        goto error;
+    }
+
+    if (((snapshotRecords = ReplayFile(context, store->SnapshotPath)) < 0) ||
+        ((journalRecords = ReplayFile(context, store->JournalPath)) < 0))
+    {
+        goto error;
+    }
+
+    store->JournalFd = open(store->JournalPath, O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+    if (store->JournalFd < 0)
+    {
+        Lwm2m_Error("Failed to open journal %s: %s\n", store->JournalPath, strerror(errno));
+        goto error;
+    }
+
+    // Fold the replayed journal (and any incomplete record at its tail) into a fresh snapshot
+    if (WriteSnapshot(store) != 0)
+    {
+        goto error;
+    }
+
+    Lwm2m_Info("Restored %d client registrations from %s (%d snapshot, %d journal records)\n",
+               ListCount(Lwm2mCore_GetClientList(context)), path, snapshotRecords, journalRecords);
+
+    Lwm2m_SetRegistrationJournal(context, JournalRegistrationEvent, store);
+    return store;
+
+error:
+    RegistrationStore_Free(&store);
+    return NULL;
+}
+
+int RegistrationStore_Process(RegistrationStore * store)
+{
+    int timeout = -1;
+    if ((store != NULL) && (store->JournalSize > sizeof(StoreFileHeader)))
+    {
+        size_t compactSize = (store->SnapshotSize > REGISTRATION_STORE_MIN_COMPACT_SIZE) ? store->SnapshotSize : REGISTRATION_STORE_MIN_COMPACT_SIZE;
+        uint64_t elapsed = Lwm2mCore_GetTickCountMs() - store->LastSnapshotTime;
+
+        if ((store->JournalSize >= compactSize) || (elapsed >= REGISTRATION_STORE_SNAPSHOT_INTERVAL_MS))
+        {
+            // on failure, retry at the next interval rather than on every wakeup
+            if (WriteSnapshot(store) != 0)
+            {
+                store->LastSnapshotTime = Lwm2mCore_GetTickCountMs();
+                timeout = REGISTRATION_STORE_SNAPSHOT_INTERVAL_MS;
+            }
+        }
+        else
+        {
+            timeout = REGISTRATION_STORE_SNAPSHOT_INTERVAL_MS - elapsed;
+        }
+    }
+    return timeout;
+}
+
+void RegistrationStore_Free(RegistrationStore ** store)
+{
+    if ((store != NULL) && (*store != NULL))
+    {
+        RegistrationJournal * journal = Lwm2mCore_GetRegistrationJournal((*store)->Context);
+        if (journal->Context == *store)
+        {
+            WriteSnapshot(*store);
+            Lwm2m_SetRegistrationJournal((*store)->Context, NULL, NULL);
+        }
+        if ((*store)->JournalFd >= 0)
+        {
+            close((*store)->JournalFd);
+        }
+        free((*store)->SnapshotPath);
+        free((*store)->JournalPath);
+        free((*store)->TempPath);
+        free(*store);
+        *store = NULL;
+    }
+}
@@ -0,0 +1,61 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#ifndef LWM2M_SERVER_REGISTRATION_STORE_H
+#define LWM2M_SERVER_REGISTRATION_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lwm2m_registration.h"
+#include "lwm2m_context.h"
+
+/* Persistent copy of the client registrations, so that a restarted server resumes serving registered clients
+ * instead of waiting for every client to register again.
+ *
+ * The store is a compacted snapshot file plus an append-only journal (<path>.journal) of the registrations,
+ * updates and deregistrations applied since the snapshot was written. Snapshots are written to a temporary
+ * file and renamed into place, and journal records are checksummed, so a crash at any point loses at most
+ * the record being written.
+ */
+typedef struct _RegistrationStore RegistrationStore;
+
+/* Open the store at path, restore the registrations it holds into the context and start journalling
+ * registration changes. Registrations that expired while the server was down are dropped.
+ * Returns NULL if the store cannot be opened or is not a registration store.
+ */
+RegistrationStore * RegistrationStore_New(Lwm2mContextType * context, const char * path);
+
+/* Compact the journal into a new snapshot when it has grown large, or periodically. Returns the time in
+ * milliseconds until the next periodic compaction, or -1 if the journal is empty.
+ */
+int RegistrationStore_Process(RegistrationStore * store);
+
+// Write a final snapshot, stop journalling and free the store
+void RegistrationStore_Free(RegistrationStore ** store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LWM2M_SERVER_REGISTRATION_STORE_H
@@ -0,0 +1,782 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include "lwm2m_server_shard_router.h"
+#include "lwm2m_hash_table.h"
+#include "lwm2m_list.h"
+#include "lwm2m_debug.h"
+#include "lwm2m_result.h"
+#include "lwm2m_util.h"
+#include "lwm2m_ipc.h"
+#include "lwm2m_xml_interface.h"
+#include "ipc_session.h"
+#include "xml.h"
+#include "../../api/src/ipc_defs.h"
+
+// Time to wait for a new shard to respond to each of the router's requests
+#define SHARD_RESPONSE_TIMEOUT_MS (5000)
+
+// Requests of the router's own session that set up a new shard, in order. Shards bind the CoAP port before they serve
+// IPC, so a shard that has connected is listening.
+static const char * SetupRequests[] = { IPC_MESSAGE_SUB_TYPE_CONNECT, IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY, IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS };
+#define NUM_SETUP_REQUESTS (sizeof(SetupRequests) / sizeof(SetupRequests[0]))
+
+typedef struct
+{
+    struct ListHead list;
+    HashTableEntry NameEntry;
+    char * Name;
+    size_t Shard;
+    uint64_t UpdateTime;                    // Time of the registration the owning shard holds, 0 if not known
+
+} ClientOwner;
+
+typedef struct
+{
+    struct ListHead list;
+    IPCSessionID SessionID;
+    struct sockaddr_storage ReplyAddr;      // API socket that sent the last request, which expects the response
+    socklen_t ReplyAddrLen;
+    struct sockaddr_storage NotifyAddr;     // API socket for notifications, once the session has established it
+    socklen_t NotifyAddrLen;
+    char * PendingType;                     // Type of the request sent to every shard, NULL if none is in progress
+    size_t PendingCount;                    // Number of shards yet to respond to it
+    TreeNode PendingResponse;               // Responses of the shards that have responded, merged
+
+} RouterSession;
+
+typedef struct
+{
+    int LinkFd;
+    size_t SetupStep;                       // Index of the setup request awaiting a response, NUM_SETUP_REQUESTS once set up
+    uint64_t SetupDeadline;                 // Time by which the shard must respond to it
+
+} Shard;
+
+struct _ShardRouter
+{
+    int IpcFd;
+    Shard * Shards;
+    size_t NumShards;
+    bool Failed;                            // A shard failed to set up
+    IPCSessionID SessionID;                 // The router's own session in every shard, which receives registration events
+    struct ListHead Sessions;
+    struct ListHead OwnerList;
+    HashTable Owners;                       // OwnerList indexed by client ID
+
+};
+
+// Parse an IPC message, returning its root node and setting type to its type (Read, ClientRegister, ...)
+static TreeNode ParseMessage(char * buffer, size_t length, const char ** type)
+{
+    TreeNode root = TreeNode_ParseXML((uint8_t *)buffer, length, true);
+    *type = NULL;
+    if ((root != NULL) && (TreeNode_GetName(root) != NULL))
+    {
+        char path[32];
+        snprintf(path, sizeof(path), "%s/Type", TreeNode_GetName(root));
+        *type = (const char *)TreeNode_GetValue(TreeNode_Navigate(root, path));
+    }
+    return root;
+}
+
+static bool IsResponse(TreeNode message)
+{
+    return strcmp(TreeNode_GetName(message), IPC_MESSAGE_TYPE_RESPONSE) == 0;
+}
+
+static AwaResult GetResponseCode(TreeNode response)
+{
+    const char * code = (const char *)TreeNode_GetValue(TreeNode_Navigate(response, "Response/Code"));
+    return (code != NULL) ? atoi(code) : AwaResult_Unspecified;
+}
+
+static ClientOwner * LookupOwner(ShardRouter * router, const char * clientID)
+{
+    HashTableEntry * entry;
+    HashTable_ForEachWithHash(entry, &router->Owners, HashTable_HashString(clientID))
+    {
+        ClientOwner * owner = HashTableContainer(entry, ClientOwner, NameEntry);
+        if (strcmp(owner->Name, clientID) == 0)
+        {
+            return owner;
+        }
+    }
+    return NULL;
+}
+
+static void SetOwner(ShardRouter * router, const char * clientID, size_t shard, uint64_t updateTime)
+{
+    ClientOwner * owner = LookupOwner(router, clientID);
+    if ((owner != NULL) && (owner->Shard != shard) && (updateTime < owner->UpdateTime))
+    {
+        // a stale registration left on the shard the client has moved away from
+        return;
+    }
+    if (owner == NULL)
+    {
+        owner = malloc(sizeof(ClientOwner));
+        if (owner == NULL)
+        {
+            Lwm2m_Error("Failed to allocate memory for client %s\n", clientID);
+            return;
+        }
+        memset(owner, 0, sizeof(ClientOwner));
+        owner->Name = strdup(clientID);
+        if (owner->Name == NULL)
+        {
+            Lwm2m_Error("Failed to allocate memory for client %s\n", clientID);
+            free(owner);
+            return;
+        }
+        ListAdd(&owner->list, &router->OwnerList);
+        HashTable_Add(&router->Owners, &owner->NameEntry, HashTable_HashString(clientID));
+    }
+    owner->Shard = shard;
+    owner->UpdateTime = updateTime;
+}
+
+static void RemoveOwner(ShardRouter * router, const char * clientID, size_t shard)
+{
+    // a client whose address changed registers with the shard its new address is assigned to, and the
+    // registration with its old shard expires later
+    ClientOwner * owner = LookupOwner(router, clientID);
+    if ((owner != NULL) && (owner->Shard == shard))
+    {
+        HashTable_Remove(&router->Owners, &owner->NameEntry);
+        ListRemove(&owner->list);
+        free(owner->Name);
+        free(owner);
+    }
+}
+
+// List a client once, from the shard serving it, even if a shard it has moved away from still has a registration
+static bool IsServedBy(ShardRouter * router, const char * clientID, size_t shard)
+{
+    ClientOwner * owner = LookupOwner(router, clientID);
+    return (owner == NULL) || (owner->Shard == shard);
+}
+
+static void UpdateOwners(ShardRouter * router, size_t shard, TreeNode message, const char * type)
+{
+    bool registered;
+    if ((strcmp(type, IPC_MESSAGE_SUB_TYPE_CLIENT_REGISTER) == 0) || (strcmp(type, IPC_MESSAGE_SUB_TYPE_CLIENT_UPDATE) == 0) ||
+        (strcmp(type, IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS) == 0))
+    {
+        registered = true;
+    }
+    else if (strcmp(type, IPC_MESSAGE_SUB_TYPE_CLIENT_DEREGISTER) == 0)
+    {
+        registered = false;
+    }
+    else
+    {
+        return;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s/Content/Clients", TreeNode_GetName(message));
+    TreeNode clientsNode = TreeNode_Navigate(message, path);
+    TreeNode clientNode;
+    uint32_t index = 0;
+    while ((clientNode = TreeNode_GetChild(clientsNode, index++)) != NULL)
+    {
+        const char * clientID = (const char *)TreeNode_GetValue(TreeNode_Navigate(clientNode, "Client/ID"));
+        if (clientID != NULL)
+        {
+            if (registered)
+            {
+                SetOwner(router, clientID, shard, IPC_GetClientUpdateTime(clientNode));
+            }
+            else
+            {
+                RemoveOwner(router, clientID, shard);
+            }
+        }
+    }
+}
+
+static RouterSession * LookupSession(ShardRouter * router, IPCSessionID sessionID)
+{
+    struct ListHead * i;
+    ListForEach(i, &router->Sessions)
+    {
+        RouterSession * session = ListEntry(i, RouterSession, list);
+        if (session->SessionID == sessionID)
+        {
+            return session;
+        }
+    }
+    return NULL;
+}
+
+static RouterSession * NewSession(ShardRouter * router)
+{
+    RouterSession * session = malloc(sizeof(RouterSession));
+    if (session == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for IPC session\n");
+        return NULL;
+    }
+    memset(session, 0, sizeof(RouterSession));
+
+    do
+    {
+        session->SessionID = IPCSession_AssignSessionID();
+    }
+    while ((session->SessionID == router->SessionID) || (LookupSession(router, session->SessionID) != NULL));
+
+    ListAdd(&session->list, &router->Sessions);
+    return session;
+}
+
+static void ClearPending(RouterSession * session)
+{
+    free(session->PendingType);
+    session->PendingType = NULL;
+    session->PendingCount = 0;
+    Tree_Delete(session->PendingResponse);
+    session->PendingResponse = NULL;
+}
+
+static void FreeSession(RouterSession * session)
+{
+    ClearPending(session);
+    ListRemove(&session->list);
+    free(session);
+}
+
+// Wait for the responses of numShards shards to a request of the given type, and reply once all have responded
+static int StartPending(RouterSession * session, const char * type, size_t numShards)
+{
+    if (session->PendingType != NULL)
+    {
+        // the API gave up waiting for the previous response
+        Lwm2m_Warning("Session %d: %s sent before all shards responded to %s\n", session->SessionID, type, session->PendingType);
+        ClearPending(session);
+    }
+
+    session->PendingType = strdup(type);
+    if (session->PendingType == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for %s request\n", type);
+        return -1;
+    }
+    session->PendingCount = numShards;
+    return 0;
+}
+
+static void Broadcast(ShardRouter * router, RouterSession * session, const char * type, const char * buffer, size_t length)
+{
+    size_t shard;
+
+    if (StartPending(session, type, router->NumShards) != 0)
+    {
+        return;
+    }
+
+    for (shard = 0; shard < router->NumShards; shard++)
+    {
+        xmlif_SendTo(router->Shards[shard].LinkFd, buffer, length, 0, NULL, 0);
+    }
+}
+
+// Requests for an unknown client go to the first shard, which responds that the client was not found
+static size_t GetServingShard(ShardRouter * router, TreeNode clientNode)
+{
+    const char * clientID = (const char *)TreeNode_GetValue(TreeNode_Navigate(clientNode, "Client/ID"));
+    ClientOwner * owner = (clientID != NULL) ? LookupOwner(router, clientID) : NULL;
+    return (owner != NULL) ? owner->Shard : 0;
+}
+
+static bool ServesAnyClient(ShardRouter * router, TreeNode clientsNode, size_t shard)
+{
+    TreeNode clientNode;
+    uint32_t index = 0;
+    while ((clientNode = TreeNode_GetChild(clientsNode, index++)) != NULL)
+    {
+        if (GetServingShard(router, clientNode) == shard)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Send a request addressed to clients (Read, Write, Observe, ...) to the shards serving them. A request for clients
+ * served by more than one shard is split into a request for each of those shards holding only the clients it serves,
+ * and the per-client responses are merged into one reply. The request is serialised into buffer, of size bufferSize.
+ */
+static int SendToServingShards(ShardRouter * router, RouterSession * session, const char * type, TreeNode request, char * buffer, size_t bufferSize, size_t length)
+{
+    TreeNode clientsNode = TreeNode_Navigate(request, "Request/Content/Clients");
+    size_t numServingShards = 0;
+    size_t shard;
+
+    for (shard = 0; shard < router->NumShards; shard++)
+    {
+        if (ServesAnyClient(router, clientsNode, shard))
+        {
+            numServingShards++;
+        }
+    }
+    if (numServingShards <= 1)
+    {
+        xmlif_SendTo(router->Shards[GetServingShard(router, TreeNode_GetChild(clientsNode, 0))].LinkFd, buffer, length, 0, NULL, 0);
+        return 0;
+    }
+
+    if (StartPending(session, type, numServingShards) != 0)
+    {
+        return -1;
+    }
+    for (shard = 0; shard < router->NumShards; shard++)
+    {
+        if (ServesAnyClient(router, clientsNode, shard))
+        {
+            TreeNode shardRequest = Tree_Copy(request);
+            TreeNode shardClientsNode = TreeNode_Navigate(shardRequest, "Request/Content/Clients");
+            TreeNode clientNode;
+            uint32_t index = 0;
+            while ((clientNode = TreeNode_GetChild(shardClientsNode, index)) != NULL)
+            {
+                if (GetServingShard(router, clientNode) != shard)
+                {
+                    Tree_DetachNode(clientNode);
+                    Tree_Delete(clientNode);
+                }
+                else
+                {
+                    index++;
+                }
+            }
+
+            // smaller than the whole request, which fitted the buffer
+            Xml_TreeToString(shardRequest, buffer, bufferSize);
+            xmlif_SendTo(router->Shards[shard].LinkFd, buffer, strlen(buffer), 0, NULL, 0);
+            Tree_Delete(shardRequest);
+        }
+    }
+    return 0;
+}
+
+static bool IsBroadcast(const char * type)
+{
+    return (strcmp(type, IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY) == 0) ||
+           (strcmp(type, IPC_MESSAGE_SUB_TYPE_DISCONNECT) == 0) ||
+           (strcmp(type, IPC_MESSAGE_SUB_TYPE_DEFINE) == 0) ||
+           (strcmp(type, IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS) == 0) ||
+           (strcmp(type, IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS_WITH_OBJECT) == 0);
+}
+
+/* Merge a shard's response into the session's pending response, taking ownership of it. The clients of the responses
+ * (the clients listed, or the results of a request for clients served by more than one shard) are merged.
+ */
+static void MergeResponse(ShardRouter * router, RouterSession * session, size_t shard, TreeNode response)
+{
+    TreeNode clientsNode = TreeNode_Navigate(response, "Response/Content/Clients");
+    TreeNode clientNode;
+    uint32_t index = 0;
+
+    if (session->PendingResponse == NULL)
+    {
+        session->PendingResponse = response;
+        while ((clientNode = TreeNode_GetChild(clientsNode, index)) != NULL)
+        {
+            const char * clientID = (const char *)TreeNode_GetValue(TreeNode_Navigate(clientNode, "Client/ID"));
+            if ((clientID != NULL) && !IsServedBy(router, clientID, shard))
+            {
+                Tree_DetachNode(clientNode);
+                Tree_Delete(clientNode);
+            }
+            else
+            {
+                index++;
+            }
+        }
+        return;
+    }
+
+    TreeNode mergedClientsNode = TreeNode_Navigate(session->PendingResponse, "Response/Content/Clients");
+    if (mergedClientsNode != NULL)
+    {
+        while ((clientNode = TreeNode_GetChild(clientsNode, index++)) != NULL)
+        {
+            const char * clientID = (const char *)TreeNode_GetValue(TreeNode_Navigate(clientNode, "Client/ID"));
+            if ((clientID != NULL) && IsServedBy(router, clientID, shard))
+            {
+                // list a client registered with more than one shard once, with its newest registration
+                TreeNode mergedClientNode = Xml_FindChildWithGrandchildValue(mergedClientsNode, "Client", "ID", clientID);
+                if (mergedClientNode == NULL)
+                {
+                    TreeNode_AddChild(mergedClientsNode, Tree_Copy(clientNode));
+                }
+                else if (IPC_GetClientUpdateTime(clientNode) > IPC_GetClientUpdateTime(mergedClientNode))
+                {
+                    Tree_DetachNode(mergedClientNode);
+                    Tree_Delete(mergedClientNode);
+                    TreeNode_AddChild(mergedClientsNode, Tree_Copy(clientNode));
+                }
+            }
+        }
+    }
+
+    // report the first failure
+    if (AwaResult_IsSuccess(GetResponseCode(session->PendingResponse)) && !AwaResult_IsSuccess(GetResponseCode(response)))
+    {
+        TreeNode mergedCodeNode = TreeNode_Navigate(session->PendingResponse, "Response/Code");
+        const char * code = (const char *)TreeNode_GetValue(TreeNode_Navigate(response, "Response/Code"));
+        TreeNode_SetValue(mergedCodeNode, (const uint8_t *)code, strlen(code));
+    }
+    Tree_Delete(response);
+}
+
+static void CompletePending(ShardRouter * router, RouterSession * session)
+{
+    IPC_SendResponse(session->PendingResponse, router->IpcFd, (struct sockaddr *)&session->ReplyAddr, session->ReplyAddrLen);
+    if (strcmp(session->PendingType, IPC_MESSAGE_SUB_TYPE_DISCONNECT) == 0)
+    {
+        FreeSession(session);
+    }
+    else
+    {
+        ClearPending(session);
+    }
+}
+
+// Send the next setup request of the router's own session to a new shard. Its response is handled by ContinueSetup.
+static int SendSetupRequest(ShardRouter * router, size_t shard)
+{
+    int result = -1;
+    char buffer[IPC_MAX_BUFFER_LEN];
+    const char * type = SetupRequests[router->Shards[shard].SetupStep];
+    TreeNode request = Xml_CreateNode(IPC_MESSAGE_TYPE_REQUEST);
+    TreeNode_AddChild(request, Xml_CreateNodeWithValue("Type", "%s", type));
+    IPC_SetSessionID(request, router->SessionID);
+
+    if (Xml_TreeToString(request, buffer, sizeof(buffer)) <= 0)
+    {
+        Lwm2m_Error("Xml_TreeToString failed\n");
+        goto error;
+    }
+    if (xmlif_SendTo(router->Shards[shard].LinkFd, buffer, strlen(buffer), 0, NULL, 0) < 0)
+    {
+        goto error;
+    }
+    router->Shards[shard].SetupDeadline = Lwm2mCore_GetTickCountMs() + SHARD_RESPONSE_TIMEOUT_MS;
+    result = 0;
+
+error:
+    Tree_Delete(request);
+    return result;
+}
+
+static void ContinueSetup(ShardRouter * router, size_t shard, TreeNode response, const char * type)
+{
+    Shard * setupShard = &router->Shards[shard];
+    if ((setupShard->SetupStep == NUM_SETUP_REQUESTS) || (strcmp(type, SetupRequests[setupShard->SetupStep]) != 0))
+    {
+        Lwm2m_Warning("Unexpected %s response from shard %zu\n", type, shard);
+        return;
+    }
+    if (!AwaResult_IsSuccess(GetResponseCode(response)))
+    {
+        Lwm2m_Error("Shard %zu failed %s: %d\n", shard, type, GetResponseCode(response));
+        router->Failed = true;
+        return;
+    }
+
+    UpdateOwners(router, shard, response, type);
+    if ((++setupShard->SetupStep < NUM_SETUP_REQUESTS) && (SendSetupRequest(router, shard) != 0))
+    {
+        router->Failed = true;
+    }
+}
+
+// Handle a message from a shard
+static void ProcessShardMessage(ShardRouter * router, size_t shard, char * buffer, size_t length)
+{
+    const char * type;
+    TreeNode message = ParseMessage(buffer, length, &type);
+    if (type == NULL)
+    {
+        Lwm2m_Error("Invalid message from shard %zu\n", shard);
+        Tree_Delete(message);
+        return;
+    }
+
+    IPCSessionID sessionID = IPC_GetSessionID(message);
+    if (sessionID == router->SessionID)
+    {
+        if (IsResponse(message))
+        {
+            ContinueSetup(router, shard, message, type);
+        }
+        else
+        {
+            UpdateOwners(router, shard, message, type);
+        }
+    }
+    else
+    {
+        RouterSession * session = LookupSession(router, sessionID);
+        if (session == NULL)
+        {
+            Lwm2m_Warning("Dropping %s from shard %zu for unknown session %d\n", type, shard, sessionID);
+        }
+        else if (IsResponse(message) && (session->PendingType != NULL) && (strcmp(type, session->PendingType) == 0))
+        {
+            MergeResponse(router, session, shard, message);
+            message = NULL;
+            if (--session->PendingCount == 0)
+            {
+                CompletePending(router, session);
+            }
+        }
+        else if (IsResponse(message))
+        {
+            xmlif_SendTo(router->IpcFd, buffer, length, 0, (struct sockaddr *)&session->ReplyAddr, session->ReplyAddrLen);
+        }
+        else if (session->NotifyAddrLen > 0)
+        {
+            xmlif_SendTo(router->IpcFd, buffer, length, 0, (struct sockaddr *)&session->NotifyAddr, session->NotifyAddrLen);
+        }
+    }
+    Tree_Delete(message);
+}
+
+ShardRouter * ShardRouter_New(int ipcFd)
+{
+    ShardRouter * router = malloc(sizeof(ShardRouter));
+    if (router == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for shard router\n");
+        return NULL;
+    }
+    memset(router, 0, sizeof(ShardRouter));
+    router->IpcFd = ipcFd;
+    router->SessionID = IPCSession_AssignSessionID();
+    ListInit(&router->Sessions);
+    ListInit(&router->OwnerList);
+    if (HashTable_Init(&router->Owners, 0) != 0)
+    {
+        Lwm2m_Error("Failed to allocate memory for shard router\n");
+        free(router);
+        return NULL;
+    }
+    return router;
+}
+
+int ShardRouter_AddShard(ShardRouter * router, int linkFd)
+{
+    Shard * shards = realloc(router->Shards, (router->NumShards + 1) * sizeof(Shard));
+    if (shards == NULL)
+    {
+        Lwm2m_Error("Failed to allocate memory for shard\n");
+        return -1;
+    }
+    router->Shards = shards;
+    memset(&router->Shards[router->NumShards], 0, sizeof(Shard));
+    router->Shards[router->NumShards].LinkFd = linkFd;
+    router->NumShards++;
+
+    return SendSetupRequest(router, router->NumShards - 1);
+}
+
+ShardRouterState ShardRouter_GetState(ShardRouter * router)
+{
+    size_t shard;
+    if (router->Failed)
+    {
+        return ShardRouterState_Failed;
+    }
+    for (shard = 0; shard < router->NumShards; shard++)
+    {
+        if (router->Shards[shard].SetupStep < NUM_SETUP_REQUESTS)
+        {
+            return ShardRouterState_Starting;
+        }
+    }
+    return ShardRouterState_Ready;
+}
+
+int ShardRouter_Process(ShardRouter * router)
+{
+    int timeout = -1;
+    uint64_t now = Lwm2mCore_GetTickCountMs();
+    size_t shard;
+
+    for (shard = 0; (shard < router->NumShards) && !router->Failed; shard++)
+    {
+        Shard * setupShard = &router->Shards[shard];
+        if (setupShard->SetupStep == NUM_SETUP_REQUESTS)
+        {
+            continue;
+        }
+        if (now >= setupShard->SetupDeadline)
+        {
+            Lwm2m_Error("Shard %zu did not respond to %s\n", shard, SetupRequests[setupShard->SetupStep]);
+            router->Failed = true;
+        }
+        else if ((timeout < 0) || (setupShard->SetupDeadline - now < (uint64_t)timeout))
+        {
+            timeout = (int)(setupShard->SetupDeadline - now);
+        }
+    }
+    return router->Failed ? -1 : timeout;
+}
+
+void ShardRouter_HandleRequest(ShardRouter * router)
+{
+    char buffer[IPC_MAX_BUFFER_LEN];
+    struct sockaddr_storage fromAddr;
+    socklen_t fromAddrLen = sizeof(fromAddr);
+    const char * type;
+    TreeNode request = NULL;
+    RouterSession * session;
+
+    ssize_t length = recvfrom(router->IpcFd, buffer, sizeof(buffer) - 1, 0, (struct sockaddr *)&fromAddr, &fromAddrLen);
+    if (length < 0)
+    {
+        Lwm2m_Error("Failed to read IPC request: %s\n", strerror(errno));
+        return;
+    }
+    buffer[length] = '\0';
+
+    request = ParseMessage(buffer, length, &type);
+    if (type == NULL)
+    {
+        Lwm2m_Error("Invalid Request\n");
+        goto error;
+    }
+
+    if (strcmp(type, IPC_MESSAGE_SUB_TYPE_CONNECT) == 0)
+    {
+        // allocate the session ID here, so that the session has the same ID in every shard
+        session = NewSession(router);
+        if (session == NULL)
+        {
+            goto error;
+        }
+        IPC_SetSessionID(request, session->SessionID);
+        if (Xml_TreeToString(request, buffer, sizeof(buffer)) <= 0)
+        {
+            FreeSession(session);
+            goto error;
+        }
+        length = strlen(buffer);
+    }
+    else
+    {
+        session = LookupSession(router, IPC_GetSessionID(request));
+        if (session == NULL)
+        {
+            Lwm2m_Error("Invalid Session ID %d\n", IPC_GetSessionID(request));
+            goto error;
+        }
+    }
+
+    memcpy(&session->ReplyAddr, &fromAddr, fromAddrLen);
+    session->ReplyAddrLen = fromAddrLen;
+    if (strcmp(type, IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY) == 0)
+    {
+        memcpy(&session->NotifyAddr, &fromAddr, fromAddrLen);
+        session->NotifyAddrLen = fromAddrLen;
+    }
+
+    if ((strcmp(type, IPC_MESSAGE_SUB_TYPE_CONNECT) == 0) || IsBroadcast(type))
+    {
+        Broadcast(router, session, type, buffer, length);
+    }
+    else if (SendToServingShards(router, session, type, request, buffer, sizeof(buffer), length) != 0)
+    {
+        goto error;
+    }
+
+    Tree_Delete(request);
+    return;
+
+error:
+    Tree_Delete(request);
+    TreeNode response = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_INVALID, AwaResult_BadRequest, 0);
+    IPC_SendResponse(response, router->IpcFd, (struct sockaddr *)&fromAddr, fromAddrLen);
+    Tree_Delete(response);
+}
+
+void ShardRouter_HandleShardMessage(ShardRouter * router, int linkFd)
+{
+    char buffer[IPC_MAX_BUFFER_LEN];
+    size_t shard;
+
+    for (shard = 0; shard < router->NumShards; shard++)
+    {
+        if (router->Shards[shard].LinkFd == linkFd)
+        {
+            break;
+        }
+    }
+    if (shard == router->NumShards)
+    {
+        Lwm2m_Error("Unknown shard link %d\n", linkFd);
+        return;
+    }
+
+    ssize_t length = recv(linkFd, buffer, sizeof(buffer) - 1, 0);
+    if (length < 0)
+    {
+        Lwm2m_Error("Failed to read from shard %zu: %s\n", shard, strerror(errno));
+        return;
+    }
+    buffer[length] = '\0';
+    ProcessShardMessage(router, shard, buffer, length);
+}
+
+void ShardRouter_Free(ShardRouter ** router)
+{
+    if ((router != NULL) && (*router != NULL))
+    {
+        struct ListHead * i, * n;
+        ListForEachSafe(i, n, &(*router)->Sessions)
+        {
+            RouterSession * session = ListEntry(i, RouterSession, list);
+            FreeSession(session);
+        }
+        ListForEachSafe(i, n, &(*router)->OwnerList)
+        {
+            ClientOwner * owner = ListEntry(i, ClientOwner, list);
+            free(owner->Name);
+            free(owner);
+        }
+        HashTable_Destroy(&(*router)->Owners);
+
+        free((*router)->Shards);
+        free(*router);
+        *router = NULL;
+    }
+}
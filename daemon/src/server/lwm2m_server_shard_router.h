@@ -0,0 +1,85 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#ifndef LWM2M_SERVER_SHARD_ROUTER_H
+#define LWM2M_SERVER_SHARD_ROUTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* IPC front end of a sharded server.
+ *
+ * A sharded server runs one server process per shard. Each shard binds the CoAP port with SO_REUSEPORT, so the
+ * kernel assigns every client to one shard by its address, and each shard serves its IPC requests over a link
+ * socket to the router instead of the IPC port. The router owns the IPC port and:
+ *
+ *   - sends requests addressed to clients (Read, Write, Observe, ...) to the shards serving those clients, splitting
+ *     a request for clients served by more than one shard, and merges the per-client responses into one reply;
+ *   - sends session and definition requests (Connect, Define, ...) to every shard, so sessions and object
+ *     definitions are the same in all shards, and replies once all shards have responded;
+ *   - merges the client lists of ListClients responses;
+ *   - relays notifications from the shards to the API session they belong to.
+ *
+ * The router learns which shard serves each client from the registration events of its own session in each shard.
+ */
+typedef struct _ShardRouter ShardRouter;
+
+// Route the requests received on the IPC socket ipcFd to the shards
+ShardRouter * ShardRouter_New(int ipcFd);
+
+typedef enum
+{
+    ShardRouterState_Starting,      // A shard has yet to connect, or to list the clients it already serves
+    ShardRouterState_Ready,
+    ShardRouterState_Failed,        // A shard failed to connect, or did not respond in time
+
+} ShardRouterState;
+
+/* Add the shard at the other end of linkFd, and start connecting to it. The router does not wait for the shard: its
+ * responses are handled by ShardRouter_HandleShardMessage, and the router is Starting until the shard has connected
+ * (by which time it has bound the CoAP port) and listed the clients it already serves. Returns 0 on success, or -1
+ * if the shard could not be sent the request.
+ */
+int ShardRouter_AddShard(ShardRouter * router, int linkFd);
+
+ShardRouterState ShardRouter_GetState(ShardRouter * router);
+
+/* Fail the router if a shard being added has not responded in time. Returns the time in milliseconds until the next
+ * shard must respond, or -1 if no response is awaited.
+ */
+int ShardRouter_Process(ShardRouter * router);
+
+// Handle a request from the API on the IPC socket
+void ShardRouter_HandleRequest(ShardRouter * router);
+
+// Handle a response or notification from the shard at the other end of linkFd
+void ShardRouter_HandleShardMessage(ShardRouter * router, int linkFd);
+
+// Free the router. The IPC socket and shard links are owned by the caller and are not closed.
+void ShardRouter_Free(ShardRouter ** router);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LWM2M_SERVER_SHARD_ROUTER_H
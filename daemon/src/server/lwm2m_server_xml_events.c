@@ -42,6 +42,8 @@ void xmlif_HandleRegistrationEvent(RegistrationEventType eventType, void * conte
 
         if ((eventType == RegistrationEventType_Register) || (eventType == RegistrationEventType_Update))
         {
+            IPC_SetClientUpdateTime(clientNode, client->LastUpdateTime);
+
             // add tree of registered entities (objects and object instances)
             TreeNode objectsTree = BuildRegisteredEntityTree(client);
             TreeNode_AddChild(clientNode, objectsTree);
@@ -85,6 +85,7 @@ static int xmlif_HandlerConnectRequest(RequestInfoType * request, TreeNode conte
 static int xmlif_HandlerEstablishNotifyRequest(RequestInfoType * request, TreeNode content);
 static int xmlif_HandlerDisconnectRequest(RequestInfoType * request, TreeNode content);
 static int xmlif_HandlerListClients(RequestInfoType * request, TreeNode content);
+static int xmlif_HandlerListClientsWithObject(RequestInfoType * request, TreeNode content);
 static int xmlif_HandlerDefineRequest(RequestInfoType * request, TreeNode content);
 static int xmlif_HandlerObserveRequest(RequestInfoType * request, TreeNode content);
 static int xmlif_HandlerReadRequest(RequestInfoType * request, TreeNode content);
@@ -141,6 +142,11 @@ static void xmlif_HandlerSuccessfulWriteAttributesResponse(IpcCoapRequestContext
 
 static void xmlif_HandlerFreeIpcCoapRequestContext(void * ctxt);
 
+// Longest path of an object, object instance or resource, such as "/65535/65535/65535"
+#define XMLIF_MAX_KEY_PATH_LENGTH (40)
+
+static void xmlif_GetPathForKey(ObjectInstanceResourceKey * key, char * path, size_t pathSize);
+
 static int xmlif_SerialiseResourceIntoExistingObjectsTree(Lwm2mTreeNode * resourceNode, TreeNode destResourceNode, const DefinitionRegistry * definitionRegistry,
                                                           ObjectIDType objectID, ObjectIDType objectInstanceID, ResourceIDType ResourceID)
 {
@@ -285,6 +291,7 @@ void xmlif_RegisterHandlers(void)
     xmlif_AddRequestHandler(IPC_MESSAGE_SUB_TYPE_ESTABLISH_NOTIFY,  xmlif_HandlerEstablishNotifyRequest);
     xmlif_AddRequestHandler(IPC_MESSAGE_SUB_TYPE_DISCONNECT,        xmlif_HandlerDisconnectRequest);
     xmlif_AddRequestHandler(IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS,      xmlif_HandlerListClients);
+    xmlif_AddRequestHandler(IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS_WITH_OBJECT, xmlif_HandlerListClientsWithObject);
     xmlif_AddRequestHandler(IPC_MESSAGE_SUB_TYPE_DEFINE,            xmlif_HandlerDefineRequest);
     xmlif_AddRequestHandler(IPC_MESSAGE_SUB_TYPE_DELETE,            xmlif_HandlerDeleteRequest);
     xmlif_AddRequestHandler(IPC_MESSAGE_SUB_TYPE_READ,              xmlif_HandlerReadRequest);
@@ -328,20 +335,48 @@ const char * xmlif_GetURIForClient(Lwm2mClientType * client, ObjectInstanceResou
         path++;
     }
 
+    char keyPath[XMLIF_MAX_KEY_PATH_LENGTH];
+    xmlif_GetPathForKey(key, keyPath, sizeof(keyPath));
+    sprintf(path, "://%s%s", addr, keyPath);
+
+    return (const char *)&uri[0];
+}
+
+static void xmlif_GetPathForKey(ObjectInstanceResourceKey * key, char * path, size_t pathSize)
+{
     if (key->ResourceID != -1)
     {
-        sprintf(path, "://%s/%d/%d/%d", addr, key->ObjectID, key->InstanceID, key->ResourceID);
+        snprintf(path, pathSize, "/%d/%d/%d", key->ObjectID, key->InstanceID, key->ResourceID);
     }
     else if (key->InstanceID != -1)
     {
-        sprintf(path, "://%s/%d/%d", addr, key->ObjectID, key->InstanceID);
+        snprintf(path, pathSize, "/%d/%d", key->ObjectID, key->InstanceID);
     }
     else
     {
-        sprintf(path, "://%s/%d", addr, key->ObjectID);
+        snprintf(path, pathSize, "/%d", key->ObjectID);
     }
+}
 
-    return (const char *)&uri[0];
+// Send a request for key to the client's address, rather than formatting a URI that the CoAP layer parses and resolves again
+static void xmlif_SendCoapRequest(void * context, int type, Lwm2mClientType * client, ObjectInstanceResourceKey * key, const char * query,
+                                  AwaContentType contentType, const char * payload, int payloadLen,
+                                  TransactionCallback callback, NotificationFreeCallback notificationFreeCallback)
+{
+    char path[XMLIF_MAX_KEY_PATH_LENGTH];
+    CoapRequest request;
+
+    xmlif_GetPathForKey(key, path, sizeof(path));
+    memset(&request, 0, sizeof(request));
+    request.type = type;
+    request.ctxt = context;
+    request.addr = client->Address;
+    request.path = path;
+    request.query = query;
+    request.contentType = contentType;
+    request.requestContent = payload;
+    request.requestContentLen = (payloadLen > 0) ? payloadLen : 0;
+    coap_SubmitRequest(&request, callback, notificationFreeCallback);
 }
 
 static int xmlif_ParseRequest(RequestInfoType * request, TreeNode content, Lwm2mClientType ** client,
@@ -513,6 +548,7 @@ static int xmlif_HandlerListClients(RequestInfoType * request, TreeNode content)
         const Lwm2mClientType * client = ListEntry(i, Lwm2mClientType, list);
 
         TreeNode clientNode = IPC_AddClientNode(clientsNode, client->EndPointName);
+        IPC_SetClientUpdateTime(clientNode, client->LastUpdateTime);
 
         // add tree of registered entities (objects and object instances)
         TreeNode objectsTree = BuildRegisteredEntityTree(client);
@@ -532,6 +568,54 @@ static int xmlif_HandlerListClients(RequestInfoType * request, TreeNode content)
     return rc;
 }
 
+/* Handle incoming ListClientsWithObject requests.
+ * For each registered client that supports the requested object, add a Client node to the response
+ * containing the Client ID and the requested object and its registered instances only.
+ */
+static int xmlif_HandlerListClientsWithObject(RequestInfoType * request, TreeNode content)
+{
+    int rc = 0;
+    Lwm2mContextType * context = (Lwm2mContextType *)request->Context;
+    TreeNode responseNode = NULL;
+
+    TreeNode objectNode = TreeNode_Navigate(content, "Content/Objects/Object");
+    int objectID = (objectNode != NULL) ? xmlif_GetInteger(objectNode, "Object/ID") : -1;
+    if (objectID == -1)
+    {
+        responseNode = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS_WITH_OBJECT, AwaResult_BadRequest, request->SessionID);
+    }
+    else
+    {
+        TreeNode clientsNode = IPC_NewClientsNode();
+
+        const struct ListHead * clients = Lwm2m_GetClientsWithObject(context, objectID);
+        if (clients != NULL)
+        {
+            struct ListHead * i;
+            ListForEach(i, clients)
+            {
+                const ObjectClientLink * link = ListEntry(i, ObjectClientLink, list);
+
+                TreeNode clientNode = IPC_AddClientNode(clientsNode, link->Client->EndPointName);
+                IPC_SetClientUpdateTime(clientNode, link->Client->LastUpdateTime);
+                TreeNode_AddChild(clientNode, BuildRegisteredEntityTreeForObject(link->Client, objectID));
+            }
+        }
+
+        TreeNode contentNode = IPC_NewContentNode();
+        TreeNode_AddChild(contentNode, clientsNode);
+
+        responseNode = IPC_NewResponseNode(IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS_WITH_OBJECT, AwaResult_Success, request->SessionID);
+        TreeNode_AddChild(responseNode, contentNode);
+    }
+
+    rc = IPC_SendResponse(responseNode, request->Sockfd, &request->FromAddr, request->AddrLen);
+
+    Tree_Delete(responseNode);
+    free(request);
+    return rc;
+}
+
 static int xmlif_HandlerDefineRequest(RequestInfoType * request, TreeNode content)
 {
     Lwm2mContextType * context = (Lwm2mContextType *)request->Context;
@@ -977,7 +1061,7 @@ static bool xmlif_HandlerSendCoapReadRequest(IpcCoapRequestContext * requestCont
     AwaContentType contentType = requestContext != NULL &&
                               requestContext->Request != NULL &&
                               requestContext->Request->Context != NULL ? Lwm2mCore_GetContentType((Lwm2mContextType *)requestContext->Request->Context) : AwaContentType_ApplicationOmaLwm2mTLV_Old;
-    coap_GetRequest(requestContext, xmlif_GetURIForClient(client, key), contentType, xmlif_HandlerReadResponse);
+    xmlif_SendCoapRequest(requestContext, COAP_GET_REQUEST, client, key, NULL, contentType, NULL, 0, xmlif_HandlerReadResponse, NULL);
     return true;
 }
 
@@ -1070,12 +1154,12 @@ static bool xmlif_HandlerSendCoapObserveRequest(IpcCoapRequestContext * requestC
     if ((observeTypeNode = Xml_Find(currentLeafNode, IPC_MESSAGE_TAG_OBSERVE)) != NULL)
     {
         TreeNode_AddChild(currentResponsePathNode, Tree_Copy(observeTypeNode));
-        coap_Observe(requestContext, xmlif_GetURIForClient(client, key), contentType, xmlif_HandlerObserveResponse, xmlif_HandlerFreeIpcCoapRequestContext);
+        xmlif_SendCoapRequest(requestContext, COAP_OBSERVE_REQUEST, client, key, NULL, contentType, NULL, 0, xmlif_HandlerObserveResponse, xmlif_HandlerFreeIpcCoapRequestContext);
     }
     else if ((observeTypeNode = Xml_Find(currentLeafNode, IPC_MESSAGE_TAG_CANCEL_OBSERVATION)) != NULL)
     {
         TreeNode_AddChild(currentResponsePathNode, Tree_Copy(observeTypeNode));
-        coap_CancelObserve(requestContext, xmlif_GetURIForClient(client, key), contentType, xmlif_HandlerCancelObserveResponse);
+        xmlif_SendCoapRequest(requestContext, COAP_CANCEL_OBSERVE_REQUEST, client, key, NULL, contentType, NULL, 0, xmlif_HandlerCancelObserveResponse, NULL);
     }
     else
     {
@@ -1170,7 +1254,7 @@ static int xmlif_HandlerDeleteRequest(RequestInfoType * request, TreeNode conten
             }
             else if (client != NULL)
             {
-                coap_DeleteRequest(requestContext, xmlif_GetURIForClient(client, &key), xmlif_HandlerDeleteResponse);
+                xmlif_SendCoapRequest(requestContext, COAP_DELETE_REQUEST, client, &key, NULL, AwaContentType_None, NULL, 0, xmlif_HandlerDeleteResponse, NULL);
                 numCoapRequests++;
             }
             else
@@ -1207,7 +1291,7 @@ static int xmlif_HandlerDiscoverRequest(RequestInfoType * request, TreeNode cont
     result = xmlif_ParseRequest(request, content, &client, &key, NULL);
     if (result == AwaResult_Success)
     {
-        coap_GetRequest(request, xmlif_GetURIForClient(client, &key), AwaContentType_ApplicationLinkFormat, xmlif_HandlerDiscoverResponse);
+        xmlif_SendCoapRequest(request, COAP_GET_REQUEST, client, &key, NULL, AwaContentType_ApplicationLinkFormat, NULL, 0, xmlif_HandlerDiscoverResponse, NULL);
     }
     else
     {
@@ -1400,7 +1484,7 @@ static int xmlif_SendCoapCreateRequest(RequestInfoType * request, Lwm2mClientTyp
     if (len >= 0)
     {
         ObjectInstanceResourceKey key = { .ObjectID = objectID, .InstanceID = -1, .ResourceID = -1, };
-        coap_PostRequest(context, xmlif_GetURIForClient(client, &key), contentType, payload, len, callback);
+        xmlif_SendCoapRequest(context, COAP_POST_REQUEST, client, &key, NULL, contentType, payload, len, callback, NULL);
     }
     return len;
 }
@@ -1460,10 +1544,10 @@ static int xmlif_SendCoapWriteRequest(RequestInfoType * request, Lwm2mClientType
     switch(writeMode)
     {
         case AwaWriteMode_Replace:
-            coap_PutRequest(context, xmlif_GetURIForClient(client, &key), contentType, payload, len, callback);
+            xmlif_SendCoapRequest(context, COAP_PUT_REQUEST, client, &key, NULL, contentType, payload, len, callback, NULL);
             break;
         case AwaWriteMode_Update:
-            coap_PostRequest(context, xmlif_GetURIForClient(client, &key), contentType, payload, len, callback);
+            xmlif_SendCoapRequest(context, COAP_POST_REQUEST, client, &key, NULL, contentType, payload, len, callback, NULL);
             break;
         default:
             Lwm2m_Error("Invalid write mode: %s\n", AwaWriteMode_ToString(writeMode));
@@ -1811,8 +1895,7 @@ static bool xmlif_HandlerSendCoapWriteAttributesRequest(IpcCoapRequestContext *
 {
     bool result = true;
     int numValidAttributes = 0;
-    char * query = NULL;
-    msprintf(&query, "%s?", xmlif_GetURIForClient(client, key));
+    char * query = strdup("");
 
     // Build up our query from reading attribute link-value pairs
     TreeNode attributeNode = NULL;
@@ -1916,7 +1999,7 @@ static bool xmlif_HandlerSendCoapWriteAttributesRequest(IpcCoapRequestContext *
     if (numValidAttributes > 0)
     {
         Lwm2m_Error("PUT attributes WITH QUERY %s\n", query);
-        coap_PutRequest(requestContext, query, AwaContentType_None, NULL, 0, xmlif_HandlerWriteAttributesResponse);
+        xmlif_SendCoapRequest(requestContext, COAP_PUT_REQUEST, client, key, query, AwaContentType_None, NULL, 0, xmlif_HandlerWriteAttributesResponse, NULL);
         result = true;
     }
     else
@@ -1981,7 +2064,7 @@ static bool xmlif_HandlerSendCoapExecuteRequest(IpcCoapRequestContext * requestC
             }
         }
 
-        coap_PostRequest(requestContext, xmlif_GetURIForClient(client, key), (dataLength > 0) ? AwaContentType_ApplicationOctetStream : AwaContentType_None, dataValue, dataLength, xmlif_HandlerExecuteResponse);
+        xmlif_SendCoapRequest(requestContext, COAP_POST_REQUEST, client, key, NULL, (dataLength > 0) ? AwaContentType_ApplicationOctetStream : AwaContentType_None, dataValue, dataLength, xmlif_HandlerExecuteResponse, NULL);
         free(dataValue);
         result = true;
     }
@@ -26,23 +26,50 @@
 #include "../../api/src/path.h"
 #include "../../api/src/objects_tree.h"
 
-TreeNode BuildRegisteredEntityTree(const Lwm2mClientType * client)
+static TreeNode BuildTree(const Lwm2mClientType * client, ObjectIDType objectID)
 {
     // returns an <Objects> node containing all registered entities as <Object> and <ObjectInstance> nodes.
     TreeNode objectsTree = ObjectsTree_New();
+    TreeNode objectNode = NULL;
+    ObjectIDType objectNodeID = AWA_INVALID_ID;
 
-    // build object/instance list
-    struct ListHead * j;
-    ListForEach(j, &client->ObjectList)
+    // the object list is sorted and unique, so each object's entries are adjacent and each node is added once
+    size_t j;
+    for (j = 0; (client->ObjectList != NULL) && (j < client->ObjectList->Count); j++)
     {
-        ObjectListEntry * entry = ListEntry(j, ObjectListEntry, list);
+        const ObjectListEntry * entry = &client->ObjectList->Entries[j];
+
+        if (objectID != AWA_INVALID_ID)
+        {
+            if (entry->ObjectID < objectID)
+            {
+                continue;
+            }
+            if (entry->ObjectID > objectID)
+            {
+                break;
+            }
+        }
 
-        char path[MAX_PATH_LENGTH] = { 0 };
-        if (Path_MakePath(path, MAX_PATH_LENGTH, entry->ObjectID, entry->InstanceID, AWA_INVALID_ID) == AwaError_Success)
+        if ((objectNode == NULL) || (entry->ObjectID != objectNodeID))
+        {
+            objectNode = ObjectsTreeInternal_AddNodeToTree(objectsTree, entry->ObjectID, "Object");
+            objectNodeID = entry->ObjectID;
+        }
+        if ((objectNode != NULL) && (entry->InstanceID != -1))
         {
-            ObjectsTree_AddPath(objectsTree, path, NULL);
+            ObjectsTreeInternal_AddNodeToTree(objectNode, entry->InstanceID, "ObjectInstance");
         }
     }
     return objectsTree;
 }
 
+TreeNode BuildRegisteredEntityTree(const Lwm2mClientType * client)
+{
+    return BuildTree(client, AWA_INVALID_ID);
+}
+
+TreeNode BuildRegisteredEntityTreeForObject(const Lwm2mClientType * client, ObjectIDType objectID)
+{
+    return BuildTree(client, objectID);
+}
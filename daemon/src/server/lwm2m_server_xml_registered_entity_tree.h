@@ -23,8 +23,21 @@
 #ifndef LWM2M_SERVER_XML_REGISTERED_ENTITY_TREE_H
 #define LWM2M_SERVER_XML_REGISTERED_ENTITY_TREE_H
 
+#include <xmltree.h>
+
 #include "lwm2m_registration.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 TreeNode BuildRegisteredEntityTree(const Lwm2mClientType * client);
 
+// As BuildRegisteredEntityTree, but only includes the specified object and its instances
+TreeNode BuildRegisteredEntityTreeForObject(const Lwm2mClientType * client, ObjectIDType objectID);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // LWM2M_SERVER_XML_REGISTERED_ENTITY_TREE_H
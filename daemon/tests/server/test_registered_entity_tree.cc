@@ -0,0 +1,107 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+
+#include "lwm2m_server_xml_registered_entity_tree.h"
+#include "lwm2m_registration.h"
+#include "lwm2m_core.h"
+#include "objects_tree.h"
+
+class RegisteredEntityTreeTestSuite : public testing::Test
+{
+    void SetUp()
+    {
+        const ObjectListEntry entries[] = { { 5, -1 }, { 3, 1 }, { 1, 0 }, { 3, 0 }, { 1, -1 } };
+        AddressType address;
+        memset(&address, 0, sizeof(address));
+        address.Size = sizeof(struct sockaddr_in);
+        address.Addr.Sin.sin_family = AF_INET;
+        address.Addr.Sin.sin_port = htons(5001);
+        address.Addr.Sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        context_ = Lwm2mCore_Init(NULL, AwaContentType_ApplicationOmaLwm2mTLV);
+        client_ = Lwm2m_RestoreClient(context_, "client1", 1, 60, BindingMode_Udp, false, &address,
+                                      entries, sizeof(entries) / sizeof(entries[0]), 60000);
+        ASSERT_TRUE(client_ != NULL);
+    }
+
+    void TearDown()
+    {
+        Lwm2mCore_Destroy(context_);
+    }
+
+protected:
+    Lwm2mContextType * context_;
+    Lwm2mClientType * client_;
+};
+
+TEST_F(RegisteredEntityTreeTestSuite, test_tree_has_one_node_per_entity)
+{
+    TreeNode tree = BuildRegisteredEntityTree(client_);
+    ASSERT_TRUE(tree != NULL);
+
+    EXPECT_EQ(3u, ObjectsTree_GetNumChildrenWithName(tree, "Object"));
+    EXPECT_TRUE(ObjectsTree_ContainsPath(tree, "/1"));
+    EXPECT_TRUE(ObjectsTree_ContainsPath(tree, "/1/0"));
+    EXPECT_TRUE(ObjectsTree_ContainsPath(tree, "/3/0"));
+    EXPECT_TRUE(ObjectsTree_ContainsPath(tree, "/3/1"));
+    EXPECT_TRUE(ObjectsTree_ContainsPath(tree, "/5"));
+    EXPECT_FALSE(ObjectsTree_ContainsPath(tree, "/5/0"));
+
+    // objects are listed in ID order, each once
+    TreeNode objectNode = TreeNode_GetChild(tree, 0);
+    TreeNode foundNode = NULL;
+    ASSERT_EQ(0, ObjectsTree_FindPathNode(tree, "/1", &foundNode));
+    EXPECT_EQ(objectNode, foundNode);
+    EXPECT_EQ(1u, ObjectsTree_GetNumChildrenWithName(objectNode, "ObjectInstance"));
+    ASSERT_EQ(0, ObjectsTree_FindPathNode(tree, "/3", &objectNode));
+    EXPECT_EQ(2u, ObjectsTree_GetNumChildrenWithName(objectNode, "ObjectInstance"));
+    ASSERT_EQ(0, ObjectsTree_FindPathNode(tree, "/5", &objectNode));
+    EXPECT_EQ(0u, ObjectsTree_GetNumChildrenWithName(objectNode, "ObjectInstance"));
+
+    ObjectsTree_Free(tree);
+}
+
+TEST_F(RegisteredEntityTreeTestSuite, test_tree_for_object_has_only_that_object)
+{
+    TreeNode tree = BuildRegisteredEntityTreeForObject(client_, 3);
+    ASSERT_TRUE(tree != NULL);
+    EXPECT_EQ(1u, ObjectsTree_GetNumChildrenWithName(tree, "Object"));
+    EXPECT_TRUE(ObjectsTree_ContainsPath(tree, "/3/0"));
+    EXPECT_TRUE(ObjectsTree_ContainsPath(tree, "/3/1"));
+    EXPECT_FALSE(ObjectsTree_ContainsPath(tree, "/1"));
+    EXPECT_FALSE(ObjectsTree_ContainsPath(tree, "/5"));
+    ObjectsTree_Free(tree);
+
+    tree = BuildRegisteredEntityTreeForObject(client_, 1);
+    ASSERT_TRUE(tree != NULL);
+    EXPECT_EQ(1u, ObjectsTree_GetNumChildrenWithName(tree, "Object"));
+    EXPECT_TRUE(ObjectsTree_ContainsPath(tree, "/1/0"));
+    ObjectsTree_Free(tree);
+
+    tree = BuildRegisteredEntityTreeForObject(client_, 4);
+    ASSERT_TRUE(tree != NULL);
+    EXPECT_EQ(0u, ObjectsTree_GetNumChildrenWithName(tree, "Object"));
+    ObjectsTree_Free(tree);
+}
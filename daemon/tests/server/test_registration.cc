@@ -0,0 +1,202 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+
+#include "lwm2m_registration.h"
+#include "lwm2m_core.h"
+
+class RegistrationTestSuite : public testing::Test
+{
+    void SetUp()
+    {
+        context_ = Lwm2mCore_Init(NULL, AwaContentType_ApplicationOmaLwm2mTLV);
+    }
+
+    void TearDown()
+    {
+        Lwm2mCore_Destroy(context_);
+    }
+
+protected:
+    Lwm2mClientType * Restore(const char * name, int location, const ObjectListEntry * entries, size_t count)
+    {
+        AddressType address;
+        memset(&address, 0, sizeof(address));
+        address.Size = sizeof(struct sockaddr_in);
+        address.Addr.Sin.sin_family = AF_INET;
+        address.Addr.Sin.sin_port = htons(5000 + location);
+        address.Addr.Sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return Lwm2m_RestoreClient(context_, name, location, 60, BindingMode_Udp, false, &address, entries, count, 60000);
+    }
+
+    size_t InternedListCount()
+    {
+        return HashTable_Count(&Lwm2mCore_GetClientIndex(context_)->ObjectLists);
+    }
+
+    Lwm2mContextType * context_;
+};
+
+TEST_F(RegistrationTestSuite, test_object_list_is_sorted_and_deduplicated)
+{
+    const ObjectListEntry entries[] = { { 1000, 1 }, { 3, 0 }, { 1, 1 }, { 1000, 0 }, { 1, -1 }, { 3, 0 }, { 1, 0 } };
+    const ObjectListEntry expected[] = { { 1, -1 }, { 1, 0 }, { 1, 1 }, { 3, 0 }, { 1000, 0 }, { 1000, 1 } };
+
+    Lwm2mClientType * client = Restore("client1", 1, entries, sizeof(entries) / sizeof(entries[0]));
+    ASSERT_TRUE(client != NULL);
+    ASSERT_TRUE(client->ObjectList != NULL);
+    ASSERT_EQ(sizeof(expected) / sizeof(expected[0]), client->ObjectList->Count);
+    for (size_t i = 0; i < client->ObjectList->Count; i++)
+    {
+        EXPECT_EQ(expected[i].ObjectID, client->ObjectList->Entries[i].ObjectID) << "entry " << i;
+        EXPECT_EQ(expected[i].InstanceID, client->ObjectList->Entries[i].InstanceID) << "entry " << i;
+    }
+}
+
+TEST_F(RegistrationTestSuite, test_equal_object_lists_are_shared)
+{
+    const ObjectListEntry entries1[] = { { 3, 0 }, { 1, 0 }, { 5, -1 } };
+    const ObjectListEntry entries2[] = { { 5, -1 }, { 1, 0 }, { 3, 0 }, { 1, 0 } };
+    const ObjectListEntry entries3[] = { { 3, 0 }, { 1, 0 } };
+
+    Lwm2mClientType * client1 = Restore("client1", 1, entries1, sizeof(entries1) / sizeof(entries1[0]));
+    Lwm2mClientType * client2 = Restore("client2", 2, entries2, sizeof(entries2) / sizeof(entries2[0]));
+    Lwm2mClientType * client3 = Restore("client3", 3, entries3, sizeof(entries3) / sizeof(entries3[0]));
+    ASSERT_TRUE((client1 != NULL) && (client2 != NULL) && (client3 != NULL));
+
+    // the same objects in a different order, or repeated, are the same list
+    EXPECT_EQ(client1->ObjectList, client2->ObjectList);
+    EXPECT_NE(client1->ObjectList, client3->ObjectList);
+    EXPECT_EQ(2u, client1->ObjectList->RefCount);
+    EXPECT_EQ(1u, client3->ObjectList->RefCount);
+    EXPECT_EQ(2u, InternedListCount());
+
+    ClientObjectList * shared = client1->ObjectList;
+    Lwm2m_RemoveClient(context_, client1);
+    EXPECT_EQ(1u, shared->RefCount);
+    EXPECT_EQ(2u, InternedListCount());
+
+    Lwm2m_RemoveClient(context_, client2);
+    Lwm2m_RemoveClient(context_, client3);
+    EXPECT_EQ(0u, InternedListCount());
+}
+
+TEST_F(RegistrationTestSuite, test_restored_client_replaces_object_list)
+{
+    const ObjectListEntry entries1[] = { { 3, 0 }, { 1, 0 } };
+    const ObjectListEntry entries2[] = { { 3, 0 } };
+
+    ASSERT_TRUE(Restore("client1", 1, entries1, sizeof(entries1) / sizeof(entries1[0])) != NULL);
+    Lwm2mClientType * client = Restore("client1", 1, entries2, sizeof(entries2) / sizeof(entries2[0]));
+    ASSERT_TRUE(client != NULL);
+    EXPECT_EQ(1u, client->ObjectList->Count);
+    EXPECT_EQ(1u, client->ObjectList->RefCount);
+    EXPECT_EQ(1u, InternedListCount());
+    EXPECT_EQ(1, ListCount(Lwm2mCore_GetClientList(context_)));
+}
+
+static void CountEvents(RegistrationEventType eventType, void * context, void * parameter)
+{
+    (*(int *)context)++;
+}
+
+TEST_F(RegistrationTestSuite, test_restoring_client_calls_no_event_callbacks)
+{
+    int events = 0;
+    Lwm2m_SetRegistrationJournal(context_, CountEvents, &events);
+
+    ASSERT_TRUE(Restore("client1", 1, NULL, 0) != NULL);
+    ASSERT_TRUE(Restore("client2", 2, NULL, 0) != NULL);
+
+    // replacing registrations with the same endpoint name or location does not deregister them
+    ASSERT_TRUE(Restore("client1", 3, NULL, 0) != NULL);
+    Lwm2mClientType * client = Restore("client3", 2, NULL, 0);
+    ASSERT_TRUE(client != NULL);
+    EXPECT_EQ(0, events);
+    EXPECT_EQ(2, ListCount(Lwm2mCore_GetClientList(context_)));
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "client2") == NULL);
+
+    Lwm2m_RemoveClient(context_, client);
+    EXPECT_EQ(1, events);
+    Lwm2m_SetRegistrationJournal(context_, NULL, NULL);
+}
+
+TEST_F(RegistrationTestSuite, test_client_supports_object)
+{
+    const ObjectListEntry entries[] = { { 1, 0 }, { 3, 0 }, { 3, 2 }, { 5, -1 }, { 1000, 7 } };
+    Lwm2mClientType * client = Restore("client1", 1, entries, sizeof(entries) / sizeof(entries[0]));
+    ASSERT_TRUE(client != NULL);
+
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 1, 0));
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 3, 0));
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 3, 2));
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 1000, 7));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 3, 1));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 3, 3));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 0, 0));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 4, 0));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 2000, 0));
+
+    // -1 matches any instance of the object
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 1, -1));
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 3, -1));
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 1000, -1));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 4, -1));
+
+    // an object registered without instances only matches -1
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 5, -1));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 5, 0));
+}
+
+TEST_F(RegistrationTestSuite, test_client_without_objects_supports_none)
+{
+    Lwm2mClientType * client = Restore("client1", 1, NULL, 0);
+    ASSERT_TRUE(client != NULL);
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 1, -1));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 1, 0));
+}
+
+TEST_F(RegistrationTestSuite, test_clients_with_object)
+{
+    const ObjectListEntry entries1[] = { { 3, 0 }, { 3, 1 }, { 5, -1 } };
+    const ObjectListEntry entries2[] = { { 3, 0 } };
+    Lwm2mClientType * client1 = Restore("client1", 1, entries1, sizeof(entries1) / sizeof(entries1[0]));
+    Lwm2mClientType * client2 = Restore("client2", 2, entries2, sizeof(entries2) / sizeof(entries2[0]));
+    ASSERT_TRUE((client1 != NULL) && (client2 != NULL));
+
+    const struct ListHead * clients = Lwm2m_GetClientsWithObject(context_, 3);
+    ASSERT_TRUE(clients != NULL);
+    EXPECT_EQ(2, ListCount(clients));
+
+    clients = Lwm2m_GetClientsWithObject(context_, 5);
+    ASSERT_TRUE(clients != NULL);
+    ASSERT_EQ(1, ListCount(clients));
+    ObjectClientLink * link = ListEntry(clients->Next, ObjectClientLink, list);
+    EXPECT_EQ(client1, link->Client);
+
+    EXPECT_TRUE(Lwm2m_GetClientsWithObject(context_, 4) == NULL);
+
+    Lwm2m_RemoveClient(context_, client1);
+    EXPECT_TRUE(Lwm2m_GetClientsWithObject(context_, 5) == NULL);
+}
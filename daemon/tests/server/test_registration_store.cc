@@ -0,0 +1,242 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <arpa/inet.h>
+
+#include "lwm2m_server_registration_store.h"
+#include "lwm2m_registration.h"
+#include "lwm2m_core.h"
+#include "lwm2m_util.h"
+
+class RegistrationStoreTestSuite : public testing::Test
+{
+    void SetUp()
+    {
+        char directory[] = "/tmp/awa_registration_store_XXXXXX";
+        ASSERT_TRUE(mkdtemp(directory) != NULL);
+        directory_ = directory;
+        path_ = directory_ + "/registrations";
+        context_ = Lwm2mCore_Init(NULL, AwaContentType_ApplicationOmaLwm2mTLV);
+        store_ = NULL;
+    }
+
+    void TearDown()
+    {
+        RegistrationStore_Free(&store_);
+        Lwm2mCore_Destroy(context_);
+        unlink(path_.c_str());
+        unlink((path_ + ".journal").c_str());
+        unlink((path_ + ".tmp").c_str());
+        rmdir(directory_.c_str());
+    }
+
+protected:
+    // Restart the server, with no registrations until the store is opened again
+    void Restart()
+    {
+        RegistrationStore_Free(&store_);
+        Lwm2mCore_Destroy(context_);
+        context_ = Lwm2mCore_Init(NULL, AwaContentType_ApplicationOmaLwm2mTLV);
+    }
+
+    // Stop the server without the final snapshot, leaving the journal as it was
+    void Crash()
+    {
+        Lwm2m_SetRegistrationJournal(context_, NULL, NULL);
+        RegistrationStore_Free(&store_);
+        Lwm2mCore_Destroy(context_);
+        context_ = Lwm2mCore_Init(NULL, AwaContentType_ApplicationOmaLwm2mTLV);
+    }
+
+    // Register a client and journal the registration, as the registration endpoint does
+    Lwm2mClientType * Register(const char * name, int location, uint32_t remainingLifeTimeMs = 60000)
+    {
+        const ObjectListEntry entries[] = { { 3, 0 }, { 1, -1 }, { 1000, 2 } };
+        AddressType address;
+        memset(&address, 0, sizeof(address));
+        address.Size = sizeof(struct sockaddr_in);
+        address.Addr.Sin.sin_family = AF_INET;
+        address.Addr.Sin.sin_port = htons(5000 + location);
+        address.Addr.Sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        Lwm2mClientType * client = Lwm2m_RestoreClient(context_, name, location, 60, BindingMode_Udp, false, &address,
+                                                       entries, sizeof(entries) / sizeof(entries[0]), remainingLifeTimeMs);
+        RegistrationJournal * journal = Lwm2mCore_GetRegistrationJournal(context_);
+        if ((client != NULL) && (journal->Callback != NULL))
+        {
+            journal->Callback(RegistrationEventType_Register, journal->Context, client);
+        }
+        return client;
+    }
+
+    off_t FileSize(const std::string & path)
+    {
+        struct stat st;
+        return (stat(path.c_str(), &st) == 0) ? st.st_size : -1;
+    }
+
+    std::string directory_;
+    std::string path_;
+    Lwm2mContextType * context_;
+    RegistrationStore * store_;
+};
+
+TEST_F(RegistrationStoreTestSuite, test_registrations_are_restored_after_restart)
+{
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    ASSERT_TRUE(Register("client1", 1) != NULL);
+    ASSERT_TRUE(Register("client2", 2, 30000) != NULL);
+    uint64_t registered = Lwm2mCore_GetTickCountMs();
+
+    Restart();
+    ASSERT_TRUE(Lwm2m_LookupClientByName(context_, "client1") == NULL);
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+
+    Lwm2mClientType * client = Lwm2m_LookupClientByName(context_, "client1");
+    ASSERT_TRUE(client != NULL);
+    EXPECT_EQ(1, client->Location);
+    EXPECT_EQ(60, client->LifeTime);
+    EXPECT_EQ(BindingMode_Udp, client->BindingMode);
+    EXPECT_EQ(htons(5001), client->Address.Addr.Sin.sin_port);
+    EXPECT_EQ(client, Lwm2m_LookupClientByLocation(context_, 1));
+    EXPECT_EQ(client, Lwm2m_LookupClientByAddress(context_, &client->Address));
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 3, 0));
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 1, -1));
+    EXPECT_TRUE(Lwm2m_ClientSupportsObject(client, 1000, 2));
+    EXPECT_FALSE(Lwm2m_ClientSupportsObject(client, 1000, 0));
+    EXPECT_EQ(2, Lwm2mCore_GetLastLocation(context_));
+
+    // the restored registration expires when the original would have, it is not renewed by the restart
+    client = Lwm2m_LookupClientByName(context_, "client2");
+    ASSERT_TRUE(client != NULL);
+    EXPECT_LE(client->ExpiryEntry.Deadline, registered + 30000 + 10);
+    EXPECT_GT(client->ExpiryEntry.Deadline, registered + 30000 - 1000);
+    EXPECT_EQ(client->ExpiryEntry.Deadline - 60000, client->LastUpdateTime);
+}
+
+TEST_F(RegistrationStoreTestSuite, test_registrations_are_restored_from_journal_after_crash)
+{
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    ASSERT_TRUE(Register("client1", 1) != NULL);
+    ASSERT_TRUE(Register("client2", 2) != NULL);
+
+    Crash();
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "client1") != NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "client2") != NULL);
+}
+
+TEST_F(RegistrationStoreTestSuite, test_torn_journal_tail_is_ignored)
+{
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    off_t emptyJournalSize = FileSize(path_ + ".journal");
+    ASSERT_TRUE(Register("client1", 1) != NULL);
+    off_t journalSize = FileSize(path_ + ".journal");
+    ASSERT_TRUE(Register("client2", 2) != NULL);
+
+    Crash();
+    off_t tornSize = journalSize + (FileSize(path_ + ".journal") - journalSize) / 2;
+    ASSERT_EQ(0, truncate((path_ + ".journal").c_str(), tornSize));
+
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "client1") != NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "client2") == NULL);
+
+    // the torn record is discarded when the replayed journal is folded into the snapshot
+    EXPECT_EQ(emptyJournalSize, FileSize(path_ + ".journal"));
+}
+
+TEST_F(RegistrationStoreTestSuite, test_corrupt_journal_tail_is_ignored)
+{
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    ASSERT_TRUE(Register("client1", 1) != NULL);
+    ASSERT_TRUE(Register("client2", 2) != NULL);
+
+    Crash();
+    FILE * journal = fopen((path_ + ".journal").c_str(), "r+b");
+    ASSERT_TRUE(journal != NULL);
+    ASSERT_EQ(0, fseek(journal, -1, SEEK_END));
+    int last = fgetc(journal);
+    ASSERT_EQ(0, fseek(journal, -1, SEEK_END));
+    fputc(last ^ 0xff, journal);
+    fclose(journal);
+
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "client1") != NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "client2") == NULL);
+}
+
+TEST_F(RegistrationStoreTestSuite, test_deregistered_and_expired_registrations_are_dropped)
+{
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    Lwm2mClientType * deregistered = Register("deregistered", 1);
+    ASSERT_TRUE(deregistered != NULL);
+    ASSERT_TRUE(Register("expired", 2, 50) != NULL);
+    ASSERT_TRUE(Register("registered", 3) != NULL);
+    Lwm2m_RemoveClient(context_, deregistered);
+
+    Crash();
+    usleep(100 * 1000);
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "deregistered") == NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "expired") == NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "registered") != NULL);
+    EXPECT_EQ(1, ListCount(Lwm2mCore_GetClientList(context_)));
+}
+
+TEST_F(RegistrationStoreTestSuite, test_snapshot_resets_journal)
+{
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    off_t emptyJournalSize = FileSize(path_ + ".journal");
+    off_t emptySnapshotSize = FileSize(path_);
+    EXPECT_GT(emptyJournalSize, 0);
+    ASSERT_TRUE(Register("client1", 1) != NULL);
+    EXPECT_GT(FileSize(path_ + ".journal"), emptyJournalSize);
+
+    // the final snapshot holds the journalled registration, and the journal is empty again
+    RegistrationStore_Free(&store_);
+    EXPECT_EQ(emptyJournalSize, FileSize(path_ + ".journal"));
+    EXPECT_GT(FileSize(path_), emptySnapshotSize);
+    EXPECT_EQ(-1, FileSize(path_ + ".tmp"));
+
+    Restart();
+    store_ = RegistrationStore_New(context_, path_.c_str());
+    ASSERT_TRUE(store_ != NULL);
+    EXPECT_TRUE(Lwm2m_LookupClientByName(context_, "client1") != NULL);
+}
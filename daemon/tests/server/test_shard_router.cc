@@ -0,0 +1,413 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "lwm2m_server_shard_router.h"
+#include "lwm2m_ipc.h"
+#include "xml.h"
+
+namespace {
+
+struct Registration
+{
+    std::string ClientID;
+    uint64_t UpdateTime;
+};
+
+// Return the value of the first <tag> element in message, or "" if there is none
+std::string GetElement(const std::string & message, const std::string & tag)
+{
+    size_t start = message.find("<" + tag + ">");
+    if (start == std::string::npos)
+    {
+        return "";
+    }
+    start += tag.length() + 2;
+    return message.substr(start, message.find("</" + tag + ">", start) - start);
+}
+
+size_t CountElements(const std::string & message, const std::string & tag)
+{
+    size_t count = 0;
+    for (size_t i = message.find("<" + tag + ">"); i != std::string::npos; i = message.find("<" + tag + ">", i + 1))
+    {
+        count++;
+    }
+    return count;
+}
+
+std::string ClientsXml(const std::vector<Registration> & registrations)
+{
+    std::string xml = "<Content><Clients>";
+    for (const Registration & registration : registrations)
+    {
+        xml += "<Client><ID>" + registration.ClientID + "</ID><UpdateTime>" + std::to_string(registration.UpdateTime) +
+               "</UpdateTime><Objects/></Client>";
+    }
+    return xml + "</Clients></Content>";
+}
+
+std::string Message(const std::string & kind, const std::string & type, const std::string & sessionID, const std::string & content = "", int code = AwaResult_Success)
+{
+    std::string xml = "<" + kind + "><Type>" + type + "</Type>";
+    if (!sessionID.empty())
+    {
+        xml += "<SessionID>" + sessionID + "</SessionID>";
+    }
+    if (kind == "Response")
+    {
+        xml += "<Code>" + std::to_string(code) + "</Code>";
+    }
+    return xml + content + "</" + kind + ">";
+}
+
+void Send(int fd, const std::string & message)
+{
+    ASSERT_EQ((ssize_t)message.length(), send(fd, message.c_str(), message.length(), 0));
+}
+
+// Return the next message received on fd, or "" if none arrives within timeoutMs
+std::string Receive(int fd, int timeoutMs = 1000)
+{
+    char buffer[IPC_MAX_BUFFER_LEN];
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    if (poll(&pfd, 1, timeoutMs) != 1)
+    {
+        return "";
+    }
+    ssize_t length = recv(fd, buffer, sizeof(buffer), 0);
+    return (length > 0) ? std::string(buffer, length) : "";
+}
+
+int BindLoopback(void)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if ((fd >= 0) && (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0))
+    {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+class ShardRouterTestSuite : public testing::Test
+{
+    void SetUp()
+    {
+        ipcFd_ = BindLoopback();
+        apiFd_ = BindLoopback();
+        ASSERT_GE(ipcFd_, 0);
+        ASSERT_GE(apiFd_, 0);
+
+        struct sockaddr_in address;
+        socklen_t addressLength = sizeof(address);
+        ASSERT_EQ(0, getsockname(ipcFd_, (struct sockaddr *)&address, &addressLength));
+        ASSERT_EQ(0, connect(apiFd_, (struct sockaddr *)&address, addressLength));
+
+        router_ = ShardRouter_New(ipcFd_);
+        ASSERT_TRUE(router_ != NULL);
+    }
+
+    void TearDown()
+    {
+        ShardRouter_Free(&router_);
+        for (size_t shard = 0; shard < routerFds_.size(); shard++)
+        {
+            close(routerFds_[shard]);
+            close(shardFds_[shard]);
+        }
+        close(apiFd_);
+        close(ipcFd_);
+    }
+
+protected:
+    // Start adding a shard, returning its index
+    size_t StartShard()
+    {
+        int link[2];
+        EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_DGRAM, 0, link));
+        routerFds_.push_back(link[0]);
+        shardFds_.push_back(link[1]);
+        EXPECT_EQ(0, ShardRouter_AddShard(router_, link[0]));
+        return shardFds_.size() - 1;
+    }
+
+    // Add a shard already serving registrations, answering the router's requests as the shard would
+    void AddShard(const std::vector<Registration> & registrations)
+    {
+        size_t shard = StartShard();
+        for (int i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(ShardRouterState_Starting, ShardRouter_GetState(router_));
+            std::string request = Receive(shardFds_[shard]);
+            std::string type = GetElement(request, "Type");
+            routerSessionID_ = GetElement(request, "SessionID");
+            ShardMessage(shard, Message("Response", type, routerSessionID_, (type == IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS) ? ClientsXml(registrations) : ""));
+        }
+        ASSERT_EQ(ShardRouterState_Ready, ShardRouter_GetState(router_));
+        ASSERT_EQ(-1, ShardRouter_Process(router_));
+    }
+
+    // Send a request from the API to the router
+    void Request(const std::string & request)
+    {
+        Send(apiFd_, request);
+        ShardRouter_HandleRequest(router_);
+    }
+
+    // Respond to, or notify, the router from a shard
+    void ShardMessage(size_t shard, const std::string & message)
+    {
+        Send(shardFds_[shard], message);
+        ShardRouter_HandleShardMessage(router_, routerFds_[shard]);
+    }
+
+    // Connect an API session through the router, returning its session ID
+    std::string Connect()
+    {
+        std::string sessionID;
+        Request(Message("Request", IPC_MESSAGE_SUB_TYPE_CONNECT, ""));
+        for (size_t shard = 0; shard < shardFds_.size(); shard++)
+        {
+            std::string request = Receive(shardFds_[shard]);
+            EXPECT_EQ(IPC_MESSAGE_SUB_TYPE_CONNECT, GetElement(request, "Type"));
+            sessionID = GetElement(request, "SessionID");
+            ShardMessage(shard, Message("Response", IPC_MESSAGE_SUB_TYPE_CONNECT, sessionID));
+        }
+        EXPECT_EQ(std::to_string(AwaResult_Success), GetElement(Receive(apiFd_), "Code"));
+        return sessionID;
+    }
+
+    std::string ClientRequest(const std::string & type, const std::string & sessionID, const std::string & clientID)
+    {
+        return Message("Request", type, sessionID, "<Content><Clients><Client><ID>" + clientID + "</ID></Client></Clients></Content>");
+    }
+
+    // Return the shard the request for clientID was routed to, or -1
+    int RoutedShard(const std::string & sessionID, const std::string & clientID)
+    {
+        int routedShard = -1;
+        Request(ClientRequest(IPC_MESSAGE_SUB_TYPE_READ, sessionID, clientID));
+        for (size_t shard = 0; shard < shardFds_.size(); shard++)
+        {
+            std::string request = Receive(shardFds_[shard], 100);
+            if (!request.empty())
+            {
+                EXPECT_EQ(-1, routedShard);
+                EXPECT_EQ(clientID, GetElement(request, "ID"));
+                routedShard = shard;
+            }
+        }
+        return routedShard;
+    }
+
+    int ipcFd_;
+    int apiFd_;
+    ShardRouter * router_;
+    std::vector<int> routerFds_;
+    std::vector<int> shardFds_;
+    std::string routerSessionID_;
+};
+
+TEST_F(ShardRouterTestSuite, test_shard_is_added_without_waiting_for_it)
+{
+    size_t shard = StartShard();
+    EXPECT_EQ(IPC_MESSAGE_SUB_TYPE_CONNECT, GetElement(Receive(shardFds_[shard]), "Type"));
+    EXPECT_EQ(ShardRouterState_Starting, ShardRouter_GetState(router_));
+
+    // the router waits for the shard's response from the event loop
+    int timeout = ShardRouter_Process(router_);
+    EXPECT_GT(timeout, 0);
+    EXPECT_LE(timeout, 5000);
+    EXPECT_EQ(ShardRouterState_Starting, ShardRouter_GetState(router_));
+}
+
+TEST_F(ShardRouterTestSuite, test_shard_failing_to_connect_fails_router)
+{
+    size_t shard = StartShard();
+    std::string request = Receive(shardFds_[shard]);
+    ShardMessage(shard, Message("Response", IPC_MESSAGE_SUB_TYPE_CONNECT, GetElement(request, "SessionID"), "", AwaResult_BadRequest));
+    EXPECT_EQ(ShardRouterState_Failed, ShardRouter_GetState(router_));
+    EXPECT_EQ(-1, ShardRouter_Process(router_));
+}
+
+TEST_F(ShardRouterTestSuite, test_client_requests_are_routed_to_serving_shard)
+{
+    AddShard({ { "client1", 100 } });
+    AddShard({ { "client2", 100 } });
+    std::string sessionID = Connect();
+
+    EXPECT_EQ(0, RoutedShard(sessionID, "client1"));
+    EXPECT_EQ(1, RoutedShard(sessionID, "client2"));
+
+    // the first shard responds that an unknown client is not found
+    EXPECT_EQ(0, RoutedShard(sessionID, "unknown"));
+
+    // the shard's response is relayed to the API unchanged
+    std::string response = Message("Response", IPC_MESSAGE_SUB_TYPE_READ, sessionID, "", AwaResult_NotFound);
+    ShardMessage(0, response);
+    EXPECT_EQ(response, Receive(apiFd_));
+}
+
+TEST_F(ShardRouterTestSuite, test_request_for_clients_of_several_shards_is_split)
+{
+    AddShard({ { "client1", 100 } });
+    AddShard({ { "client2", 100 } });
+    std::string sessionID = Connect();
+
+    Request(Message("Request", IPC_MESSAGE_SUB_TYPE_READ, sessionID, "<Content><Clients>"
+                    "<Client><ID>client1</ID><Objects/></Client><Client><ID>client2</ID><Objects/></Client>"
+                    "<Client><ID>unknown</ID><Objects/></Client></Clients></Content>"));
+
+    // each shard is sent only the clients it serves, and the first shard also the unknown client
+    std::string request = Receive(shardFds_[0]);
+    EXPECT_EQ(2u, CountElements(request, "Client"));
+    EXPECT_EQ(1u, CountElements(request, "ID>client1</ID"));
+    EXPECT_EQ(1u, CountElements(request, "ID>unknown</ID"));
+    request = Receive(shardFds_[1]);
+    EXPECT_EQ(1u, CountElements(request, "Client"));
+    EXPECT_EQ(1u, CountElements(request, "ID>client2</ID"));
+
+    ShardMessage(1, Message("Response", IPC_MESSAGE_SUB_TYPE_READ, sessionID, "<Content><Clients><Client><ID>client2</ID>"
+                            "<Objects><Object><ID>3</ID></Object></Objects></Client></Clients></Content>"));
+    EXPECT_EQ("", Receive(apiFd_, 100));
+    ShardMessage(0, Message("Response", IPC_MESSAGE_SUB_TYPE_READ, sessionID, "<Content><Clients><Client><ID>client1</ID>"
+                            "<Objects><Object><ID>4</ID></Object></Objects></Client></Clients></Content>"));
+
+    // the results of both clients are in one reply
+    std::string response = Receive(apiFd_);
+    EXPECT_EQ(IPC_MESSAGE_SUB_TYPE_READ, GetElement(response, "Type"));
+    EXPECT_EQ(std::to_string(AwaResult_Success), GetElement(response, "Code"));
+    EXPECT_EQ(2u, CountElements(response, "Client"));
+    EXPECT_EQ(1u, CountElements(response, "ID>client1</ID"));
+    EXPECT_EQ(1u, CountElements(response, "ID>client2</ID"));
+    EXPECT_EQ(1u, CountElements(response, "ID>3</ID"));
+    EXPECT_EQ(1u, CountElements(response, "ID>4</ID"));
+    EXPECT_EQ("", Receive(apiFd_, 100));
+}
+
+TEST_F(ShardRouterTestSuite, test_registration_events_move_clients_between_shards)
+{
+    AddShard({ { "client1", 100 } });
+    AddShard({});
+    std::string sessionID = Connect();
+    EXPECT_EQ(0, RoutedShard(sessionID, "client1"));
+
+    ShardMessage(1, Message("Notification", IPC_MESSAGE_SUB_TYPE_CLIENT_REGISTER, routerSessionID_, ClientsXml({ { "client1", 200 } })));
+    EXPECT_EQ(1, RoutedShard(sessionID, "client1"));
+
+    // the stale registration expiring on the old shard does not affect the client
+    ShardMessage(0, Message("Notification", IPC_MESSAGE_SUB_TYPE_CLIENT_DEREGISTER, routerSessionID_, ClientsXml({ { "client1", 0 } })));
+    EXPECT_EQ(1, RoutedShard(sessionID, "client1"));
+
+    ShardMessage(1, Message("Notification", IPC_MESSAGE_SUB_TYPE_CLIENT_DEREGISTER, routerSessionID_, ClientsXml({ { "client1", 0 } })));
+    EXPECT_EQ(0, RoutedShard(sessionID, "client1"));
+}
+
+TEST_F(ShardRouterTestSuite, test_newest_registration_owns_client_when_shards_are_added)
+{
+    // the client moved from the second shard to the first, leaving a stale registration behind
+    AddShard({ { "client1", 200 } });
+    AddShard({ { "client1", 100 }, { "client2", 100 } });
+    std::string sessionID = Connect();
+
+    EXPECT_EQ(0, RoutedShard(sessionID, "client1"));
+    EXPECT_EQ(1, RoutedShard(sessionID, "client2"));
+}
+
+TEST_F(ShardRouterTestSuite, test_list_clients_merges_shard_responses)
+{
+    AddShard({ { "client1", 200 }, { "client3", 100 } });
+    AddShard({ { "client1", 100 }, { "client2", 100 } });
+    std::string sessionID = Connect();
+
+    Request(Message("Request", IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, sessionID));
+    EXPECT_EQ(IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, GetElement(Receive(shardFds_[0]), "Type"));
+    EXPECT_EQ(IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, GetElement(Receive(shardFds_[1]), "Type"));
+
+    ShardMessage(1, Message("Response", IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, sessionID, ClientsXml({ { "client1", 100 }, { "client2", 100 } })));
+    EXPECT_EQ("", Receive(apiFd_, 100));
+    ShardMessage(0, Message("Response", IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, sessionID, ClientsXml({ { "client1", 200 }, { "client3", 100 } })));
+
+    // the stale registration of client1 is not listed
+    std::string response = Receive(apiFd_);
+    EXPECT_EQ(std::to_string(AwaResult_Success), GetElement(response, "Code"));
+    EXPECT_EQ(3u, CountElements(response, "Client"));
+    EXPECT_EQ(1u, CountElements(response, "ID>client1</ID"));
+    EXPECT_EQ(1u, CountElements(response, "UpdateTime>200</UpdateTime"));
+    EXPECT_EQ(1u, CountElements(response, "ID>client2</ID"));
+    EXPECT_EQ(1u, CountElements(response, "ID>client3</ID"));
+}
+
+TEST_F(ShardRouterTestSuite, test_list_clients_lists_unowned_client_once)
+{
+    AddShard({});
+    AddShard({});
+    std::string sessionID = Connect();
+
+    // both shards registered the client before the router learnt of either registration
+    Request(Message("Request", IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, sessionID));
+    Receive(shardFds_[0]);
+    Receive(shardFds_[1]);
+    ShardMessage(0, Message("Response", IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, sessionID, ClientsXml({ { "client1", 100 } })));
+    ShardMessage(1, Message("Response", IPC_MESSAGE_SUB_TYPE_LIST_CLIENTS, sessionID, ClientsXml({ { "client1", 200 } })));
+
+    std::string response = Receive(apiFd_);
+    EXPECT_EQ(1u, CountElements(response, "Client"));
+    EXPECT_EQ("200", GetElement(response, "UpdateTime"));
+}
+
+TEST_F(ShardRouterTestSuite, test_broadcast_replies_once_all_shards_respond)
+{
+    AddShard({});
+    AddShard({});
+    std::string sessionID = Connect();
+
+    std::string define = Message("Request", IPC_MESSAGE_SUB_TYPE_DEFINE, sessionID, "<Content><ObjectDefinitions/></Content>");
+    Request(define);
+    EXPECT_EQ(define, Receive(shardFds_[0]));
+    EXPECT_EQ(define, Receive(shardFds_[1]));
+
+    ShardMessage(0, Message("Response", IPC_MESSAGE_SUB_TYPE_DEFINE, sessionID));
+    EXPECT_EQ("", Receive(apiFd_, 100));
+
+    // the first failure is reported
+    ShardMessage(1, Message("Response", IPC_MESSAGE_SUB_TYPE_DEFINE, sessionID, "", AwaResult_BadRequest));
+    std::string response = Receive(apiFd_);
+    EXPECT_EQ(IPC_MESSAGE_SUB_TYPE_DEFINE, GetElement(response, "Type"));
+    EXPECT_EQ(std::to_string(AwaResult_BadRequest), GetElement(response, "Code"));
+    EXPECT_EQ("", Receive(apiFd_, 100));
+}
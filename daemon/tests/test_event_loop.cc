@@ -0,0 +1,148 @@
+/************************************************************************************************************************
+ Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group companies.
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ following conditions are met:
+     1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+        following disclaimer.
+     2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+        following disclaimer in the documentation and/or other materials provided with the distribution.
+     3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+        products derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+************************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <signal.h>
+
+#include "common/lwm2m_event_loop.h"
+#include "lwm2m_util.h"
+
+class EventLoopTestSuite : public testing::Test
+{
+    void SetUp()
+    {
+        loop = EventLoop_New();
+        ASSERT_TRUE(loop != NULL);
+        ASSERT_EQ(0, pipe(fds));
+    }
+
+    void TearDown()
+    {
+        EventLoop_Free(&loop);
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+protected:
+    EventLoop * loop;
+    int fds[2];
+};
+
+static void ReadByte(int fd, void * context)
+{
+    char byte;
+    if (read(fd, &byte, 1) == 1)
+    {
+        (*(int *)context)++;
+    }
+}
+
+TEST_F(EventLoopTestSuite, test_wait_calls_handler_when_readable)
+{
+    int count = 0;
+    ASSERT_EQ(0, EventLoop_AddReader(loop, fds[0], ReadByte, &count));
+    ASSERT_EQ(1, write(fds[1], "x", 1));
+
+    EXPECT_EQ(1, EventLoop_Wait(loop, 1000));
+    EXPECT_EQ(1, count);
+}
+
+TEST_F(EventLoopTestSuite, test_wait_times_out)
+{
+    int count = 0;
+    ASSERT_EQ(0, EventLoop_AddReader(loop, fds[0], ReadByte, &count));
+
+    uint64_t start = Lwm2mCore_GetTickCountMs();
+    EXPECT_EQ(0, EventLoop_Wait(loop, 50));
+    EXPECT_GE(Lwm2mCore_GetTickCountMs() - start, 45u);
+    EXPECT_EQ(0, count);
+
+    // zero timeout polls without blocking
+    EXPECT_EQ(0, EventLoop_Wait(loop, 0));
+}
+
+TEST_F(EventLoopTestSuite, test_earlier_timeout_rearms_timer)
+{
+    EXPECT_EQ(0, EventLoop_Wait(loop, 10));
+
+    uint64_t start = Lwm2mCore_GetTickCountMs();
+    EXPECT_EQ(0, EventLoop_Wait(loop, 20));
+    EXPECT_LT(Lwm2mCore_GetTickCountMs() - start, 1000u);
+}
+
+TEST_F(EventLoopTestSuite, test_removed_reader_is_not_called)
+{
+    int count = 0;
+    ASSERT_EQ(0, EventLoop_AddReader(loop, fds[0], ReadByte, &count));
+    EXPECT_EQ(0, EventLoop_RemoveReader(loop, fds[0]));
+    EXPECT_EQ(-1, EventLoop_RemoveReader(loop, fds[0]));
+    ASSERT_EQ(1, write(fds[1], "x", 1));
+
+    EXPECT_EQ(0, EventLoop_Wait(loop, 10));
+    EXPECT_EQ(0, count);
+}
+
+static volatile sig_atomic_t signalled;
+
+static void SetSignalled(int signum)
+{
+    signalled = 1;
+}
+
+TEST_F(EventLoopTestSuite, test_signal_raised_before_wait_interrupts_wait)
+{
+    struct sigaction action = {};
+    struct sigaction oldAction;
+    action.sa_handler = SetSignalled;
+    ASSERT_EQ(0, sigaction(SIGUSR1, &action, &oldAction));
+    ASSERT_EQ(0, EventLoop_AddSignal(loop, SIGUSR1));
+
+    // held pending until the wait, rather than delivered between a quit check and the wait
+    signalled = 0;
+    raise(SIGUSR1);
+    EXPECT_EQ(0, signalled);
+
+    uint64_t start = Lwm2mCore_GetTickCountMs();
+    EXPECT_EQ(0, EventLoop_Wait(loop, 5000));
+    EXPECT_LT(Lwm2mCore_GetTickCountMs() - start, 1000u);
+    EXPECT_EQ(1, signalled);
+
+    EventLoop_Free(&loop);
+    sigaction(SIGUSR1, &oldAction, NULL);
+}
+
+TEST_F(EventLoopTestSuite, test_add_reader_handles_invalid_arguments)
+{
+    EXPECT_EQ(-1, EventLoop_AddReader(NULL, fds[0], ReadByte, NULL));
+    EXPECT_EQ(-1, EventLoop_AddReader(loop, -1, ReadByte, NULL));
+    EXPECT_EQ(-1, EventLoop_AddReader(loop, fds[0], NULL, NULL));
+}
+
+TEST_F(EventLoopTestSuite, test_earliest_timeout)
+{
+    EXPECT_EQ(-1, EventLoop_EarliestTimeout(-1, -1));
+    EXPECT_EQ(5, EventLoop_EarliestTimeout(-1, 5));
+    EXPECT_EQ(5, EventLoop_EarliestTimeout(5, -1));
+    EXPECT_EQ(0, EventLoop_EarliestTimeout(0, 5));
+    EXPECT_EQ(3, EventLoop_EarliestTimeout(7, 3));
+}